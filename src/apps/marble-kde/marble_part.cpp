@@ -1443,7 +1443,7 @@ void MarblePart::updateSettings()
 
     QNetworkProxy::setApplicationProxy(proxy);
 
-    m_controlView->marbleWidget()->update();
+    m_controlView->marbleWidget()->repaintLayers();
 
     // Time
     if (MarbleSettings::systemTimezone() == true) {
@@ -1468,7 +1468,7 @@ void MainWindow::updateSettings()
     cloudSyncManager->routeSyncManager()->setRouteSyncEnabled(m_configDialog->syncRoutes());
     cloudSyncManager->bookmarkSyncManager()->setBookmarkSyncEnabled(m_configDialog->syncBookmarks());
 
-    m_controlView->marbleWidget()->update();
+    m_controlView->marbleWidget()->repaintLayers();
 }
 
 void MainWindow::showDownloadRegionDialog()
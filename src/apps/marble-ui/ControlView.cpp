@@ -198,7 +198,7 @@ void ControlView::printMapScreenShot(const QPointer<QPrintDialog> &printDialog)
             // Temporarily remove the black background and layers painting on it
             m_marbleWidget->setShowBackground(false);
             m_marbleWidget->setPalette(QPalette(Qt::white));
-            m_marbleWidget->update();
+            m_marbleWidget->repaintLayers();
         }
 
         if (printOptions->printMap()) {
@@ -228,7 +228,7 @@ void ControlView::printMapScreenShot(const QPointer<QPrintDialog> &printDialog)
         if (hideBackground) {
             m_marbleWidget->setShowBackground(wasBackgroundVisible);
             m_marbleWidget->setPalette(originalPalette);
-            m_marbleWidget->update();
+            m_marbleWidget->repaintLayers();
         }
     }
 #endif
@@ -0,0 +1,361 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "BatchRenderer.h"
+
+#include "GeoPainter.h"
+#include "MarbleDebug.h"
+#include "MarbleMap.h"
+#include "MarbleModel.h"
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QMutex>
+#include <QPair>
+#include <QSharedPointer>
+#include <QThread>
+#include <QTimer>
+
+namespace Marble
+{
+
+/**
+ * The state shared by BatchRenderer and its workers.
+ */
+class BatchRenderQueue
+{
+public:
+    BatchRenderQueue();
+
+    /**
+     * Takes the next job, preferring the first one of @p mapThemeId.
+     * Returns false if there is none left.
+     */
+    bool take(const QString &mapThemeId, int &index, BatchRenderJob &job);
+
+    QMutex m_mutex;
+    QList<QPair<int, BatchRenderJob>> m_jobs;
+    QAtomicInt m_timeout;
+    QAtomicInt m_stopping;
+};
+
+BatchRenderQueue::BatchRenderQueue()
+    : m_timeout(30000)
+    , m_stopping(false)
+{
+}
+
+bool BatchRenderQueue::take(const QString &mapThemeId, int &index, BatchRenderJob &job)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_jobs.isEmpty()) {
+        return false;
+    }
+
+    int position = 0;
+    for (int i = 0; i < m_jobs.size(); ++i) {
+        if (m_jobs.at(i).second.mapThemeId == mapThemeId) {
+            position = i;
+            break;
+        }
+    }
+
+    index = m_jobs.at(position).first;
+    job = m_jobs.takeAt(position).second;
+    return true;
+}
+
+class BatchRendererPrivate;
+
+/**
+ * Renders jobs on a worker thread, with a map created on that thread.
+ */
+class BatchRenderWorker : public QObject
+{
+public:
+    BatchRenderWorker(BatchRendererPrivate *renderer, const QSharedPointer<BatchRenderQueue> &queue);
+    ~BatchRenderWorker() override;
+
+    /// Renders jobs until the queue is empty
+    void processJobs();
+
+private:
+    BatchRenderResult render(const BatchRenderJob &job);
+
+    BatchRendererPrivate *const m_renderer;
+    const QSharedPointer<BatchRenderQueue> m_queue;
+    MarbleModel *m_model;
+    MarbleMap *m_map;
+    // Waiting for data runs an event loop, which may call processJobs() again
+    bool m_busy;
+};
+
+class BatchRendererPrivate
+{
+public:
+    explicit BatchRendererPrivate(BatchRenderer *parent);
+
+    void startThreads();
+    void stopThreads();
+
+    void finishJob(const BatchRenderResult &result);
+
+    BatchRenderer *const q;
+    const QSharedPointer<BatchRenderQueue> m_queue;
+    QList<QThread *> m_threads;
+    QList<BatchRenderWorker *> m_workers;
+    int m_threadCount;
+    // Jobs queued or being rendered
+    int m_remaining;
+};
+
+BatchRenderWorker::BatchRenderWorker(BatchRendererPrivate *renderer, const QSharedPointer<BatchRenderQueue> &queue)
+    : m_renderer(renderer)
+    , m_queue(queue)
+    , m_model(nullptr)
+    , m_map(nullptr)
+    , m_busy(false)
+{
+}
+
+BatchRenderWorker::~BatchRenderWorker()
+{
+    delete m_map;
+    delete m_model;
+}
+
+void BatchRenderWorker::processJobs()
+{
+    if (m_busy) {
+        return;
+    }
+    m_busy = true;
+
+    int index;
+    BatchRenderJob job;
+    while (!m_queue->m_stopping.loadRelaxed() && m_queue->take(m_map ? m_map->mapThemeId() : QString(), index, job)) {
+        BatchRenderResult result = render(job);
+        result.index = index;
+
+        // Deliver on the thread of the renderer, nothing gets delivered once it is gone
+        BatchRendererPrivate *const renderer = m_renderer;
+        QMetaObject::invokeMethod(
+            renderer->q,
+            [renderer, result]() {
+                renderer->finishJob(result);
+            },
+            Qt::QueuedConnection);
+    }
+
+    m_busy = false;
+}
+
+BatchRenderResult BatchRenderWorker::render(const BatchRenderJob &job)
+{
+    BatchRenderResult result;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!m_map) {
+        m_model = new MarbleModel;
+        m_map = new MarbleMap(m_model);
+    }
+
+    if (m_map->mapThemeId() != job.mapThemeId) {
+        m_map->setMapThemeId(job.mapThemeId);
+    }
+    m_map->setProjection(job.projection);
+    m_map->setSize(job.size);
+    m_map->setRadius(job.radius);
+    m_map->centerOn(job.longitude, job.latitude);
+
+    result.setupTime = timer.restart();
+
+    QEventLoop loop;
+    bool repaintNeeded = false;
+    const QMetaObject::Connection connection = QObject::connect(m_map, &MarbleMap::repaintNeeded, &loop, [&loop, &repaintNeeded]() {
+        repaintNeeded = true;
+        loop.quit();
+    });
+
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    timeout.start(m_queue->m_timeout.loadRelaxed());
+
+    QImage image(job.size, QImage::Format_ARGB32_Premultiplied);
+    QElapsedTimer paintTimer;
+    while (true) {
+        repaintNeeded = false;
+        image.fill(Qt::transparent);
+
+        paintTimer.start();
+        {
+            GeoPainter painter(&image, m_map->viewport(), m_map->mapQuality());
+            m_map->paint(painter, QRect());
+        }
+        result.paintTime += paintTimer.elapsed();
+
+        result.complete = m_map->renderStatus() == Complete;
+        if (result.complete || !timeout.isActive() || m_queue->m_stopping.loadRelaxed()) {
+            break;
+        }
+
+        // A repaint may have been requested while painting already
+        if (!repaintNeeded) {
+            loop.exec();
+        }
+    }
+
+    QObject::disconnect(connection);
+
+    if (!result.complete) {
+        mDebug() << "Batch render job of" << job.mapThemeId << "timed out";
+    }
+
+    result.waitTime = timer.elapsed() - result.paintTime;
+    result.image = image;
+    return result;
+}
+
+BatchRendererPrivate::BatchRendererPrivate(BatchRenderer *parent)
+    : q(parent)
+    , m_queue(new BatchRenderQueue)
+    , m_threadCount(qMax(1, QThread::idealThreadCount()))
+    , m_remaining(0)
+{
+}
+
+void BatchRendererPrivate::startThreads()
+{
+    m_queue->m_stopping.storeRelaxed(false);
+    for (int i = 0; i < m_threadCount; ++i) {
+        auto thread = new QThread;
+        thread->setObjectName(QStringLiteral("BatchRenderer %1").arg(i));
+        auto worker = new BatchRenderWorker(this, m_queue);
+        worker->moveToThread(thread);
+        QObject::connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+        thread->start();
+
+        m_threads << thread;
+        m_workers << worker;
+    }
+}
+
+void BatchRendererPrivate::stopThreads()
+{
+    m_queue->m_stopping.storeRelaxed(true);
+    for (QThread *thread : std::as_const(m_threads)) {
+        thread->quit();
+    }
+    for (QThread *thread : std::as_const(m_threads)) {
+        thread->wait();
+        delete thread;
+    }
+    m_threads.clear();
+    m_workers.clear();
+}
+
+void BatchRendererPrivate::finishJob(const BatchRenderResult &result)
+{
+    --m_remaining;
+    Q_EMIT q->jobFinished(result);
+    if (m_remaining == 0) {
+        Q_EMIT q->finished();
+    }
+}
+
+BatchRenderer::BatchRenderer(QObject *parent)
+    : QObject(parent)
+    , d(new BatchRendererPrivate(this))
+{
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    {
+        QMutexLocker locker(&d->m_queue->m_mutex);
+        d->m_queue->m_jobs.clear();
+    }
+    d->stopThreads();
+    delete d;
+}
+
+void BatchRenderer::setThreadCount(int count)
+{
+    d->m_threadCount = qMax(1, count);
+}
+
+int BatchRenderer::threadCount() const
+{
+    return d->m_threadCount;
+}
+
+void BatchRenderer::setTimeout(int msecs)
+{
+    d->m_queue->m_timeout.storeRelaxed(msecs);
+}
+
+int BatchRenderer::timeout() const
+{
+    return d->m_queue->m_timeout.loadRelaxed();
+}
+
+void BatchRenderer::render(const QList<BatchRenderJob> &jobs)
+{
+    if (jobs.isEmpty()) {
+        return;
+    }
+
+    if (d->m_remaining == 0 && d->m_threads.size() != d->m_threadCount) {
+        d->stopThreads();
+        d->startThreads();
+    }
+
+    {
+        QMutexLocker locker(&d->m_queue->m_mutex);
+        for (int i = 0; i < jobs.size(); ++i) {
+            d->m_queue->m_jobs << qMakePair(i, jobs.at(i));
+        }
+    }
+    d->m_remaining += jobs.size();
+
+    for (BatchRenderWorker *worker : std::as_const(d->m_workers)) {
+        QMetaObject::invokeMethod(
+            worker,
+            [worker]() {
+                worker->processJobs();
+            },
+            Qt::QueuedConnection);
+    }
+}
+
+void BatchRenderer::cancel()
+{
+    int dropped;
+    {
+        QMutexLocker locker(&d->m_queue->m_mutex);
+        dropped = d->m_queue->m_jobs.size();
+        d->m_queue->m_jobs.clear();
+    }
+
+    if (dropped > 0) {
+        d->m_remaining -= dropped;
+        if (d->m_remaining == 0) {
+            Q_EMIT finished();
+        }
+    }
+}
+
+bool BatchRenderer::isRunning() const
+{
+    return d->m_remaining > 0;
+}
+
+}
+
+#include "moc_BatchRenderer.cpp"
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_BATCHRENDERER_H
+#define MARBLE_BATCHRENDERER_H
+
+#include "MarbleGlobal.h"
+#include "marble_export.h"
+
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QSize>
+#include <QString>
+
+namespace Marble
+{
+
+class BatchRendererPrivate;
+
+/**
+ * @short A map to render by BatchRenderer.
+ */
+class MARBLE_EXPORT BatchRenderJob
+{
+public:
+    QString mapThemeId;
+    Projection projection = Spherical;
+    /// The center of the map, in degrees
+    qreal longitude = 0.0;
+    qreal latitude = 0.0;
+    /// The zoom, as the radius of the globe in pixels
+    int radius = 1000;
+    QSize size = QSize(256, 256);
+};
+
+/**
+ * @short A map rendered by BatchRenderer.
+ */
+class MARBLE_EXPORT BatchRenderResult
+{
+public:
+    /// The position of the job in the list passed to BatchRenderer::render()
+    int index = -1;
+    QImage image;
+    /// False if the map was still waiting for data when the timeout expired
+    bool complete = false;
+    /// Milliseconds spent on preparing the map, e.g. loading the map theme
+    qint64 setupTime = 0;
+    /// Milliseconds spent on waiting for tiles and data
+    qint64 waitTime = 0;
+    /// Milliseconds spent on painting, for all attempts
+    qint64 paintTime = 0;
+};
+
+/**
+ * @short Renders many maps without a widget, on several threads.
+ *
+ * Each of the worker threads owns a MarbleModel and a MarbleMap, which are
+ * kept across jobs and batches. Workers prefer jobs of the map theme they
+ * have loaded already, so that themes are loaded as seldom as possible and
+ * the tiles cached in memory get reused by jobs showing nearby areas. The
+ * tiles cached on disk are shared by all workers.
+ *
+ * A job is painted again whenever the map requests a repaint, until it
+ * reports that all data is there or the timeout expires.
+ *
+ * MarbleModel is not thread-safe, therefore the workers do not share one.
+ * Pixmaps only work on the GUI thread, so the layers draw images instead on
+ * the worker threads.
+ */
+class MARBLE_EXPORT BatchRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BatchRenderer(QObject *parent = nullptr);
+    ~BatchRenderer() override;
+
+    /**
+     * Sets the number of worker threads, which defaults to the ideal thread
+     * count. Takes effect when no batch is being rendered.
+     */
+    void setThreadCount(int count);
+    int threadCount() const;
+
+    /// Sets how many milliseconds a job waits for data at most
+    void setTimeout(int msecs);
+    int timeout() const;
+
+    /**
+     * Queues @p jobs for rendering. jobFinished() is emitted for each of
+     * them, in the order they complete, and finished() once all are done.
+     */
+    void render(const QList<BatchRenderJob> &jobs);
+
+    /// Drops the jobs not started yet
+    void cancel();
+
+    bool isRunning() const;
+
+Q_SIGNALS:
+    void jobFinished(const Marble::BatchRenderResult &result);
+
+    void finished();
+
+private:
+    Q_DISABLE_COPY(BatchRenderer)
+
+    BatchRendererPrivate *const d;
+};
+
+}
+
+#endif
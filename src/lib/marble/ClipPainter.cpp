@@ -1139,11 +1139,21 @@ void ClipPainter::setDebugPolygonsLevel(int level)
     d->m_debugPolygonsLevel = level;
 }
 
+int ClipPainter::debugPolygonsLevel() const
+{
+    return d->m_debugPolygonsLevel;
+}
+
 void ClipPainter::setDebugBatchRender(bool enabled)
 {
     d->m_debugBatchRender = enabled;
 }
 
+bool ClipPainter::debugBatchRender() const
+{
+    return d->m_debugBatchRender;
+}
+
 void ClipPainterPrivate::debugDrawNodes(const QPolygonF &polygon)
 {
     q->save();
@@ -66,7 +66,9 @@ public:
     void setBrush(const QBrush &brush);
 
     void setDebugPolygonsLevel(int);
+    int debugPolygonsLevel() const;
     void setDebugBatchRender(bool);
+    bool debugBatchRender() const;
 
     //	void clearNodeCount(){ m_debugNodeCount = 0; }
     //	int nodeCount(){ return m_debugNodeCount; }
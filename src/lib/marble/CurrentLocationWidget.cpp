@@ -160,7 +160,9 @@ void CurrentLocationWidget::setMarbleWidget(MarbleWidget *widget)
     connect(d->m_widget->model()->routingManager(), SIGNAL(guidanceModeEnabledChanged(bool)), this, SLOT(updateGuidanceMode()));
 
     connect(d->m_currentLocationUi.showTrackCheckBox, SIGNAL(clicked(bool)), d->m_widget->model()->positionTracking(), SLOT(setTrackVisible(bool)));
-    connect(d->m_currentLocationUi.showTrackCheckBox, SIGNAL(clicked(bool)), d->m_widget, SLOT(update()));
+    connect(d->m_currentLocationUi.showTrackCheckBox, &QCheckBox::clicked, d->m_widget, [this]() {
+        d->m_widget->repaintLayers();
+    });
     if (d->m_widget->model()->positionTracking()->trackVisible()) {
         d->m_currentLocationUi.showTrackCheckBox->setCheckState(Qt::Checked);
     }
@@ -314,7 +316,7 @@ void CurrentLocationWidget::changePositionProvider(const QString &provider)
             PositionProviderPlugin *instance = plugin->newInstance();
             PositionTracking *tracking = d->m_widget->model()->positionTracking();
             tracking->setPositionProviderPlugin(instance);
-            d->m_widget->update();
+            d->m_widget->repaintLayers();
             return;
         }
     }
@@ -322,7 +324,7 @@ void CurrentLocationWidget::changePositionProvider(const QString &provider)
     // requested provider not found -> disable position tracking
     d->m_currentLocationUi.locationLabel->setEnabled(false);
     d->m_widget->model()->positionTracking()->setPositionProviderPlugin(nullptr);
-    d->m_widget->update();
+    d->m_widget->repaintLayers();
 }
 
 void CurrentLocationWidget::trackPlacemark()
@@ -402,7 +404,7 @@ void CurrentLocationWidgetPrivate::clearTrack()
 
     if (result == QMessageBox::Yes) {
         m_widget->model()->positionTracking()->clearTrack();
-        m_widget->update();
+        m_widget->repaintLayers();
         m_currentLocationUi.saveTrackButton->setEnabled(false);
         m_currentLocationUi.clearTrackButton->setEnabled(false);
     }
@@ -8,9 +8,15 @@
 
 #include "HttpJob.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace Marble
 {
 
+// Each tile level away from the one on screen counts like being this many viewport radii away
+static const qreal tileLevelWeight = 0.5;
+
 DownloadQueueSet::DownloadQueueSet(QObject *const parent)
     : QObject(parent)
 {
@@ -60,7 +66,7 @@ bool DownloadQueueSet::canAcceptJob(const QUrl &sourceUrl, const QString &destin
 
 void DownloadQueueSet::addJob(HttpJob *const job)
 {
-    m_jobs.push(job);
+    m_jobs.push(job, priority(job));
     mDebug() << "addJob: new job queue size:" << m_jobs.count();
     Q_EMIT jobAdded();
     Q_EMIT progressChanged(m_activeJobs.size(), m_jobs.count());
@@ -105,13 +111,101 @@ void DownloadQueueSet::purgeJobs()
     Q_EMIT progressChanged(m_activeJobs.size(), m_jobs.count());
 }
 
+int DownloadQueueSet::pendingJobCount() const
+{
+    return m_activeJobs.size() + m_jobs.count();
+}
+
+void DownloadQueueSet::setViewports(const QList<Viewport> &viewports)
+{
+    m_viewports.clear();
+    m_extendedViewports.clear();
+    for (const Viewport &viewport : viewports) {
+        if (!viewport.box.isEmpty()) {
+            m_viewports << viewport;
+            m_extendedViewports << viewport.box.scaled(2.0, 2.0);
+        }
+    }
+
+    if (m_jobs.isEmpty()) {
+        return;
+    }
+
+    const QList<HttpJob *> staleJobs = m_jobs.takeIf([this](const HttpJob *job) {
+        return isStale(job);
+    });
+    m_jobs.reprioritize([this](const HttpJob *job) {
+        return priority(job);
+    });
+
+    if (!staleJobs.isEmpty()) {
+        mDebug() << "Cancelling" << staleJobs.size() << "downloads of tiles out of view";
+        for (HttpJob *job : staleJobs) {
+            Q_EMIT jobCancelled(job->initiatorId());
+            job->deleteLater();
+        }
+        Q_EMIT progressChanged(m_activeJobs.size(), m_jobs.count());
+    }
+}
+
+qreal DownloadQueueSet::priority(const HttpJob *job) const
+{
+    const GeoDataLatLonBox tileBox = job->tileBox();
+    if (m_viewports.isEmpty() || tileBox.isEmpty()) {
+        return 0.0;
+    }
+
+    // Tiles are as urgent as for the view they are closest to
+    qreal result = std::numeric_limits<qreal>::max();
+    for (const Viewport &viewport : m_viewports) {
+        const qreal viewportRadius = qMax(qMax(viewport.box.width(), viewport.box.height()) / 2.0, 1e-6);
+        qreal distance = tileBox.center().sphericalDistanceTo(viewport.box.center()) / viewportRadius;
+        if (viewport.tileLevel >= 0 && job->tileLevel() >= 0) {
+            distance += tileLevelWeight * qAbs(job->tileLevel() - viewport.tileLevel);
+        }
+        result = qMin(result, distance);
+    }
+    return result;
+}
+
+bool DownloadQueueSet::isStale(const HttpJob *job) const
+{
+    if (job->downloadUsage() != DownloadBrowse || m_viewports.isEmpty()) {
+        return false;
+    }
+
+    const GeoDataLatLonBox tileBox = job->tileBox();
+    if (tileBox.isEmpty()) {
+        return false;
+    }
+    for (const GeoDataLatLonBox &extendedViewport : m_extendedViewports) {
+        if (extendedViewport.intersects(tileBox)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void DownloadQueueSet::finishJob(HttpJob *job, const QByteArray &data)
 {
     mDebug() << job->sourceUrl() << job->destinationFileName();
 
     deactivateJob(job);
     Q_EMIT jobRemoved();
-    Q_EMIT jobFinished(data, job->destinationFileName(), job->initiatorId());
+    // Only tiles get revalidated once expired, other files are not worth keeping validators for
+    const CacheValidators validators = job->tileLevel() >= 0 ? job->cacheValidators() : CacheValidators();
+    Q_EMIT jobFinished(data, job->destinationFileName(), job->initiatorId(), validators);
+    job->deleteLater();
+    activateJobs();
+}
+
+void DownloadQueueSet::refreshJob(HttpJob *job)
+{
+    mDebug() << job->sourceUrl() << "not modified";
+
+    deactivateJob(job);
+    Q_EMIT jobRemoved();
+    Q_EMIT jobNotModified(job->destinationFileName(), job->initiatorId());
     job->deleteLater();
     activateJobs();
 }
@@ -122,7 +216,7 @@ void DownloadQueueSet::redirectJob(HttpJob *job, const QUrl &newSourceUrl)
 
     deactivateJob(job);
     Q_EMIT jobRemoved();
-    Q_EMIT jobRedirected(newSourceUrl, job->destinationFileName(), job->initiatorId(), job->downloadUsage());
+    Q_EMIT jobRedirected(newSourceUrl, job->destinationFileName(), job->initiatorId(), job->downloadUsage(), job->tileBox(), job->tileLevel());
     job->deleteLater();
 }
 
@@ -160,6 +254,7 @@ void DownloadQueueSet::activateJob(HttpJob *const job)
     connect(job, SIGNAL(jobDone(HttpJob *, int)), SLOT(retryOrBlacklistJob(HttpJob *, int)));
     connect(job, SIGNAL(redirected(HttpJob *, QUrl)), SLOT(redirectJob(HttpJob *, QUrl)));
     connect(job, SIGNAL(dataReceived(HttpJob *, QByteArray)), SLOT(finishJob(HttpJob *, QByteArray)));
+    connect(job, SIGNAL(notModified(HttpJob *)), SLOT(refreshJob(HttpJob *)));
 
     job->execute();
 }
@@ -217,36 +312,71 @@ bool DownloadQueueSet::jobIsBlackListed(const QUrl &sourceUrl) const
     return pos != m_jobBlackList.constEnd();
 }
 
-inline bool DownloadQueueSet::JobStack::contains(const QString &destinationFileName) const
+inline bool DownloadQueueSet::JobQueue::contains(const QString &destinationFileName) const
 {
     return m_jobsContent.contains(destinationFileName);
 }
 
-inline int DownloadQueueSet::JobStack::count() const
+inline int DownloadQueueSet::JobQueue::count() const
 {
     return m_jobs.count();
 }
 
-inline bool DownloadQueueSet::JobStack::isEmpty() const
+inline bool DownloadQueueSet::JobQueue::isEmpty() const
 {
     return m_jobs.isEmpty();
 }
 
-inline HttpJob *DownloadQueueSet::JobStack::pop()
+inline bool DownloadQueueSet::JobQueue::lessUrgent(const Entry &a, const Entry &b)
 {
-    HttpJob *const job = m_jobs.pop();
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+    return a.sequence < b.sequence;
+}
+
+inline HttpJob *DownloadQueueSet::JobQueue::pop()
+{
+    std::pop_heap(m_jobs.begin(), m_jobs.end(), lessUrgent);
+    HttpJob *const job = m_jobs.takeLast().job;
     bool const removed = m_jobsContent.remove(job->destinationFileName());
     Q_UNUSED(removed); // for Q_ASSERT in release mode
     Q_ASSERT(removed);
     return job;
 }
 
-inline void DownloadQueueSet::JobStack::push(HttpJob *const job)
+inline void DownloadQueueSet::JobQueue::push(HttpJob *const job, qreal priority)
 {
-    m_jobs.push(job);
+    m_jobs.append(Entry{priority, m_sequence++, job});
+    std::push_heap(m_jobs.begin(), m_jobs.end(), lessUrgent);
     m_jobsContent.insert(job->destinationFileName());
 }
 
+QList<HttpJob *> DownloadQueueSet::JobQueue::takeIf(const std::function<bool(const HttpJob *)> &isStale)
+{
+    QList<HttpJob *> result;
+    m_jobs.removeIf([&](const Entry &entry) {
+        if (!isStale(entry.job)) {
+            return false;
+        }
+        m_jobsContent.remove(entry.job->destinationFileName());
+        result << entry.job;
+        return true;
+    });
+    if (!result.isEmpty()) {
+        std::make_heap(m_jobs.begin(), m_jobs.end(), lessUrgent);
+    }
+    return result;
+}
+
+void DownloadQueueSet::JobQueue::reprioritize(const std::function<qreal(const HttpJob *)> &priority)
+{
+    for (Entry &entry : m_jobs) {
+        entry.priority = priority(entry.job);
+    }
+    std::make_heap(m_jobs.begin(), m_jobs.end(), lessUrgent);
+}
+
 }
 
 #include "moc_DownloadQueueSet.cpp"
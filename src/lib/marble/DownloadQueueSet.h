@@ -9,9 +9,12 @@
 #include <QObject>
 #include <QQueue>
 #include <QSet>
-#include <QStack>
+
+#include <functional>
 
 #include "DownloadPolicy.h"
+#include "GeoDataLatLonBox.h"
+#include "StoragePolicy.h"
 
 class QUrl;
 
@@ -27,7 +30,7 @@ class HttpJob;
      the HttpJob is put into the m_jobQueue where it waits for "activation"
      signal jobAdded is emitted
    - Job is activated
-     Job is moved from m_jobQueue to m_activeJobs and signals of the job
+     The most urgent job is moved from m_jobQueue to m_activeJobs and signals of the job
      are connected to slots (local or HttpDownloadManager)
      Job is executed by calling the jobs execute() method
 
@@ -47,6 +50,15 @@ class HttpJob;
       Job is removed from m_activeJobs, disconnected and destroyed
       signal jobRemoved is emitted
 
+   4) Job emits notModified
+      Job is removed from m_activeJobs, disconnected and destroyed
+      signal jobRemoved is emitted
+      (HttpDownloadManager marks the stored file as up to date)
+
+   5) Job is still waiting when the viewport moves far away from its tile
+      Browse jobs are removed from m_jobQueue and destroyed
+      signal jobCancelled is emitted
+
    so we can conclude following rules:
    - Job is only connected to signals when in "active" state
 
@@ -78,16 +90,41 @@ public:
     void retryJobs();
     void purgeJobs();
 
+    /// The number of jobs being downloaded or waiting for it
+    int pendingJobCount() const;
+
+    /// A region on screen and the tile level shown there
+    struct Viewport {
+        GeoDataLatLonBox box;
+        int tileLevel = -1;
+    };
+
+    /**
+     * Sets the regions shown by all views. Waiting tile jobs are then activated
+     * by the distance of their tile to the center of the closest region and the
+     * difference to its tile level. Waiting browse jobs of tiles far off every
+     * region are cancelled.
+     */
+    void setViewports(const QList<Viewport> &viewports);
+
 Q_SIGNALS:
     void jobAdded();
     void jobRemoved();
     void jobRetry();
-    void jobFinished(const QByteArray &data, const QString &destinationFileName, const QString &id);
-    void jobRedirected(const QUrl &newSourceUrl, const QString &destinationFileName, const QString &id, DownloadUsage);
+    void jobFinished(const QByteArray &data, const QString &destinationFileName, const QString &id, const CacheValidators &validators);
+    void jobNotModified(const QString &destinationFileName, const QString &id);
+    void jobRedirected(const QUrl &newSourceUrl,
+                       const QString &destinationFileName,
+                       const QString &id,
+                       DownloadUsage,
+                       const GeoDataLatLonBox &tileBox,
+                       int tileLevel);
+    void jobCancelled(const QString &id);
     void progressChanged(int active, int queued);
 
 private Q_SLOTS:
     void finishJob(HttpJob *job, const QByteArray &data);
+    void refreshJob(HttpJob *job);
     void redirectJob(HttpJob *job, const QUrl &newSourceUrl);
     void retryOrBlacklistJob(HttpJob *job, const int errorCode);
 
@@ -99,25 +136,47 @@ private:
     bool jobIsWaitingForRetry(const QString &destinationFileName) const;
     bool jobIsBlackListed(const QUrl &sourceUrl) const;
 
+    /// Lower values are more urgent
+    qreal priority(const HttpJob *job) const;
+    bool isStale(const HttpJob *job) const;
+
     DownloadPolicy m_downloadPolicy;
 
+    QList<Viewport> m_viewports;
+    /// The boxes of m_viewports doubled in size, jobs outside all of them are stale
+    QList<GeoDataLatLonBox> m_extendedViewports;
+
     /** This is the first stage a job enters, from this queue it will get
-     *  into the activatedJobs container.
+     *  into the activatedJobs container. The most urgent job is taken
+     *  first, the most recent one among equally urgent jobs.
      */
-    class JobStack
+    class JobQueue
     {
     public:
         bool contains(const QString &destinationFileName) const;
         int count() const;
         bool isEmpty() const;
         HttpJob *pop();
-        void push(HttpJob *const);
+        void push(HttpJob *const, qreal priority);
+
+        /// Removes and returns the jobs @p isStale holds for
+        QList<HttpJob *> takeIf(const std::function<bool(const HttpJob *)> &isStale);
+        void reprioritize(const std::function<qreal(const HttpJob *)> &priority);
 
     private:
-        QStack<HttpJob *> m_jobs;
+        struct Entry {
+            qreal priority;
+            quint64 sequence;
+            HttpJob *job;
+        };
+        static bool lessUrgent(const Entry &a, const Entry &b);
+
+        /// A binary heap with the most urgent job on top
+        QList<Entry> m_jobs;
         QSet<QString> m_jobsContent;
+        quint64 m_sequence = 0;
     };
-    JobStack m_jobs;
+    JobQueue m_jobs;
 
     /// Contains the jobs which are currently being downloaded.
     QList<HttpJob *> m_activeJobs;
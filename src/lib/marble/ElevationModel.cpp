@@ -64,9 +64,24 @@ public:
         delete m_srtmTheme;
     }
 
+    // The downloads of all tile loaders are reported to every loader, keep only ours
+    bool isElevationTile(const TileId &tileId) const
+    {
+        return m_textureLayer && TileId(m_textureLayer->sourceDir(), 0, 0, 0).mapThemeIdHash() == tileId.mapThemeIdHash();
+    }
+
+    // Tiles are cached without their source, as there is only one
+    static TileId cacheId(const TileId &tileId)
+    {
+        return TileId(0, tileId.zoomLevel(), tileId.x(), tileId.y());
+    }
+
     void tileCompleted(const TileId &tileId, const QImage &image)
     {
-        m_cache.insert(tileId, new QImage(image));
+        if (!isElevationTile(tileId)) {
+            return;
+        }
+        m_cache.insert(cacheId(tileId), new QImage(image));
         Q_EMIT q->updateAvailable();
     }
 
@@ -84,6 +99,11 @@ ElevationModel::ElevationModel(HttpDownloadManager *downloadManager, PluginManag
     , d(new ElevationModelPrivate(this, downloadManager, pluginManager))
 {
     connect(&d->m_tileLoader, SIGNAL(tileCompleted(TileId, QImage)), this, SLOT(tileCompleted(TileId, QImage)));
+    connect(&d->m_tileLoader, &TileLoader::tileCancelled, this, [this](const TileId &tileId) {
+        if (d->isElevationTile(tileId)) {
+            d->m_cache.remove(ElevationModelPrivate::cacheId(tileId));
+        }
+    });
 }
 
 ElevationModel::~ElevationModel()
@@ -7,10 +7,12 @@
 #include "FileStoragePolicy.h"
 
 // Qt
+#include <QDateTime>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 
 // Marble
 #include "MarbleDebug.h"
@@ -19,6 +21,9 @@
 
 using namespace Marble;
 
+// Suffix of the files keeping the validators of a downloaded file
+static const QLatin1StringView validatorsSuffix(".validators");
+
 FileStoragePolicy::FileStoragePolicy(const QString &dataDirectory, QObject *parent)
     : StoragePolicy(parent)
     , m_dataDirectory(dataDirectory)
@@ -38,10 +43,15 @@ bool FileStoragePolicy::fileExists(const QString &fileName) const
     return QFile::exists(fullName);
 }
 
-bool FileStoragePolicy::updateFile(const QString &fileName, const QByteArray &data)
+QString FileStoragePolicy::filePath(const QString &fileName) const
 {
     QFileInfo const dirInfo(fileName);
-    QString const fullName = dirInfo.isAbsolute() ? fileName : m_dataDirectory + QLatin1Char('/') + fileName;
+    return dirInfo.isAbsolute() ? fileName : m_dataDirectory + QLatin1Char('/') + fileName;
+}
+
+bool FileStoragePolicy::updateFile(const QString &fileName, const QByteArray &data)
+{
+    QString const fullName = filePath(fileName);
 
     // Create directory if it doesn't exist yet...
     QFileInfo info(fullName);
@@ -52,29 +62,99 @@ bool FileStoragePolicy::updateFile(const QString &fileName, const QByteArray &da
     if (!QDir(localFileDirPath).exists())
         QDir::root().mkpath(localFileDirPath);
 
-    // ... and save the file content
-    QFile file(fullName);
+    // ... and save the file content. Several renderers may share the cache, so
+    // the file is replaced at once instead of being truncated and rewritten
+    // while others read it.
+    const qint64 oldSize = info.exists() ? info.size() : 0;
+    QSaveFile file(fullName);
     if (!file.open(QIODevice::WriteOnly)) {
         m_errorMsg = fullName + QLatin1StringView(": ") + file.errorString();
         qCritical() << "file.open" << m_errorMsg;
         return false;
     }
 
-    quint64 oldSize = file.size();
-
-    if (!file.write(data)) {
+    if (file.write(data) != data.size()) {
         m_errorMsg = fullName + QLatin1StringView(": ") + file.errorString();
         qCritical() << "file.write" << m_errorMsg;
-        Q_EMIT sizeChanged(file.size() - oldSize);
+        file.cancelWriting();
+        return false;
+    }
+
+    if (!file.commit()) {
+        m_errorMsg = fullName + QLatin1StringView(": ") + file.errorString();
+        qCritical() << "file.commit" << m_errorMsg;
         return false;
     }
 
-    Q_EMIT sizeChanged(file.size() - oldSize);
-    file.close();
+    Q_EMIT sizeChanged(data.size() - oldSize);
 
     return true;
 }
 
+CacheValidators FileStoragePolicy::validators(const QString &fileName) const
+{
+    QString const fullName = filePath(fileName);
+    QFile file(fullName + validatorsSuffix);
+    if (!QFile::exists(fullName) || !file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    // Stored like the HTTP headers they came with
+    CacheValidators result;
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        const qsizetype colon = line.indexOf(':');
+        if (colon < 0) {
+            continue;
+        }
+        const QByteArray name = line.left(colon).trimmed();
+        if (name == "ETag") {
+            result.eTag = line.mid(colon + 1).trimmed();
+        } else if (name == "Last-Modified") {
+            result.lastModified = line.mid(colon + 1).trimmed();
+        }
+    }
+    return result;
+}
+
+void FileStoragePolicy::setValidators(const QString &fileName, const CacheValidators &validators)
+{
+    // The validators count towards the cache size like the file they belong to
+    QFile file(filePath(fileName) + validatorsSuffix);
+    const qint64 oldSize = file.size();
+    if (validators.isEmpty()) {
+        if (file.remove()) {
+            Q_EMIT sizeChanged(-oldSize);
+        }
+        return;
+    }
+
+    QByteArray data;
+    if (!validators.eTag.isEmpty()) {
+        data += "ETag: " + validators.eTag + '\n';
+    }
+    if (!validators.lastModified.isEmpty()) {
+        data += "Last-Modified: " + validators.lastModified + '\n';
+    }
+
+    QSaveFile saveFile(file.fileName());
+    if (!saveFile.open(QIODevice::WriteOnly) || saveFile.write(data) != data.size() || !saveFile.commit()) {
+        mDebug() << "Cannot store validators of" << fileName << saveFile.errorString();
+        return;
+    }
+    Q_EMIT sizeChanged(data.size() - oldSize);
+}
+
+bool FileStoragePolicy::refreshFile(const QString &fileName)
+{
+    QFile file(filePath(fileName));
+    if (!file.open(QIODevice::ReadWrite)) {
+        m_errorMsg = file.fileName() + QLatin1StringView(": ") + file.errorString();
+        return false;
+    }
+    return file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+}
+
 void FileStoragePolicy::clearCache()
 {
     mDebug();
@@ -123,6 +203,10 @@ void FileStoragePolicy::clearCache()
                         QFile file(filePath);
                         Q_EMIT sizeChanged(-file.size());
                         file.remove();
+                    } else if (filePath.endsWith(validatorsSuffix)) {
+                        QFile file(filePath);
+                        Q_EMIT sizeChanged(-file.size());
+                        file.remove();
                     }
                 }
             }
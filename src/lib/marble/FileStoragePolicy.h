@@ -8,10 +8,12 @@
 
 #include "StoragePolicy.h"
 
+#include "marble_export.h"
+
 namespace Marble
 {
 
-class FileStoragePolicy : public StoragePolicy
+class MARBLE_EXPORT FileStoragePolicy : public StoragePolicy
 {
     Q_OBJECT
 
@@ -39,6 +41,21 @@ public:
      */
     bool updateFile(const QString &fileName, const QByteArray &data) override;
 
+    /**
+     * Returns the validators stored next to @p fileName.
+     */
+    CacheValidators validators(const QString &fileName) const override;
+
+    /**
+     * Stores the @p validators in a small file next to @p fileName.
+     */
+    void setValidators(const QString &fileName, const CacheValidators &validators) override;
+
+    /**
+     * Sets the modification time of @p fileName to now.
+     */
+    bool refreshFile(const QString &fileName) override;
+
     /**
      * Clears the cache.
      */
@@ -52,6 +69,8 @@ public:
 private:
     Q_DISABLE_COPY(FileStoragePolicy)
 
+    QString filePath(const QString &fileName) const;
+
     QString m_dataDirectory;
     QString m_errorMsg;
 };
@@ -9,6 +9,7 @@
 // Qt
 #include <QDir>
 #include <QDirIterator>
+#include <QFile>
 #include <QFileInfo>
 #include <QTimer>
 
@@ -24,6 +25,9 @@ using namespace Marble;
 static const int maxFilesDelete = 20;
 static const int softLimitPercent = 5;
 
+// Suffix of the files FileStoragePolicy keeps the validators of a downloaded file in
+static const QLatin1StringView validatorsSuffix(".validators");
+
 // Methods of FileStorageWatcherThread
 FileStorageWatcherThread::FileStorageWatcherThread(const QString &dataDirectory, QObject *parent)
     : QObject(parent)
@@ -86,6 +90,15 @@ void FileStorageWatcherThread::getCurrentCacheSize()
     while (it.hasNext() && !m_willQuit) {
         it.next();
         QFileInfo file = it.fileInfo();
+        // Validators are counted and deleted along with their file, drop those left behind
+        if (file.fileName().endsWith(validatorsSuffix)) {
+            const QString filePath = file.absoluteFilePath();
+            if (!QFileInfo::exists(filePath.chopped(validatorsSuffix.size()))) {
+                QFile::remove(filePath);
+            }
+            continue;
+        }
+
         // We try to be very careful and just delete images
         QString suffix = file.suffix().toLower();
         const QStringList path = file.path().split(QLatin1Char('/'));
@@ -101,7 +114,7 @@ void FileStorageWatcherThread::getCurrentCacheSize()
             if ((ok && tileLevel >= maxBaseTileLevel)
                 && (suffix == QLatin1StringView("jpg") || suffix == QLatin1StringView("png") || suffix == QLatin1StringView("gif")
                     || suffix == QLatin1StringView("svg") || suffix == QLatin1StringView("o5m"))) {
-                dataSize += file.size();
+                dataSize += file.size() + QFileInfo(file.absoluteFilePath() + validatorsSuffix).size();
                 m_filesCache.insert(file.lastModified(), file.absoluteFilePath());
             }
         }
@@ -130,14 +143,18 @@ void FileStorageWatcherThread::ensureCacheSize()
         while (it != m_filesCache.end() && keepDeleting()) {
             QString filePath = it.value();
             QFileInfo info(filePath);
+            QFileInfo validatorsInfo(filePath + validatorsSuffix);
 
             ++m_filesDeleted;
-            m_currentCacheSize -= info.size();
+            m_currentCacheSize -= info.size() + validatorsInfo.size();
             it = m_filesCache.erase(it);
             bool success = QFile::remove(filePath);
             if (!success) {
                 mDebug() << "Failed to remove:" << filePath;
             }
+            if (validatorsInfo.exists()) {
+                QFile::remove(validatorsInfo.absoluteFilePath());
+            }
         }
         // There might be more chunks left for deletion which we
         // process with a delay to account for for load-reduction.
@@ -11,11 +11,13 @@
 #include <QMutex>
 #include <QThread>
 
+#include "marble_export.h"
+
 namespace Marble
 {
 
 // Worker object that lives inside the new Thread
-class FileStorageWatcherThread : public QObject
+class MARBLE_EXPORT FileStorageWatcherThread : public QObject
 {
     Q_OBJECT
 
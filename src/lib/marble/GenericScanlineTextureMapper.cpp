@@ -15,6 +15,7 @@
 // Marble
 #include "AbstractProjection.h"
 #include "GeoPainter.h"
+#include "InverseProjectionGrid.h"
 #include "MarbleDebug.h"
 #include "MarbleDirs.h"
 #include "MathHelper.h"
@@ -29,7 +30,7 @@ using namespace Marble;
 class GenericScanlineTextureMapper::RenderJob : public QRunnable
 {
 public:
-    RenderJob(StackedTileLoader *tileLoader, int tileLevel, QImage *canvasImage, const ViewportParams *viewport, MapQuality mapQuality, int yTop, int yBottom);
+    RenderJob(StackedTileLoader *tileLoader, int tileLevel, QImage *canvasImage, const ViewportParams *viewport, MapQuality mapQuality, ScanlineRowScheduler *rowScheduler);
 
     void run() override;
 
@@ -39,8 +40,7 @@ private:
     QImage *const m_canvasImage;
     const ViewportParams *const m_viewport;
     const MapQuality m_mapQuality;
-    const int m_yTop;
-    const int m_yBottom;
+    ScanlineRowScheduler *const m_rowScheduler;
 };
 
 GenericScanlineTextureMapper::RenderJob::RenderJob(StackedTileLoader *tileLoader,
@@ -48,15 +48,13 @@ GenericScanlineTextureMapper::RenderJob::RenderJob(StackedTileLoader *tileLoader
                                                    QImage *canvasImage,
                                                    const ViewportParams *viewport,
                                                    MapQuality mapQuality,
-                                                   int yTop,
-                                                   int yBottom)
+                                                   ScanlineRowScheduler *rowScheduler)
     : m_tileLoader(tileLoader)
     , m_tileLevel(tileLevel)
     , m_canvasImage(canvasImage)
     , m_viewport(viewport)
     , m_mapQuality(mapQuality)
-    , m_yTop(yTop)
-    , m_yBottom(yBottom)
+    , m_rowScheduler(rowScheduler)
 {
 }
 
@@ -119,12 +117,11 @@ void GenericScanlineTextureMapper::mapTexture(const ViewportParams *viewport, in
     const int yTop = (imageHeight / 2 - radius >= 0) ? imageHeight / 2 - radius : 0;
     const int yBottom = (yTop == 0) ? imageHeight - skip : yTop + radius + radius - skip;
 
-    const int numThreads = m_threadPool.maxThreadCount();
-    const int yStep = qCeil(qreal(yBottom - yTop) / qreal(numThreads));
+    // Larger blocks let the render jobs approximate the inverse projection on larger cells
+    ScanlineRowScheduler rowScheduler(QList<QRect>() << QRect(0, yTop, m_canvasImage.width(), yBottom - yTop), 32);
+    const int numThreads = qMin(m_threadPool.maxThreadCount(), rowScheduler.blockCount());
     for (int i = 0; i < numThreads; ++i) {
-        const int yStart = yTop + i * yStep;
-        const int yEnd = qMin(yBottom, yTop + (i + 1) * yStep);
-        QRunnable *const job = new RenderJob(m_tileLoader, tileZoomLevel, &m_canvasImage, viewport, mapQuality, yStart, yEnd);
+        QRunnable *const job = new RenderJob(m_tileLoader, tileZoomLevel, &m_canvasImage, viewport, mapQuality, &rowScheduler);
         m_threadPool.start(job);
     }
 
@@ -158,88 +155,108 @@ void GenericScanlineTextureMapper::RenderJob::run()
 
     qreal clipRadius = radius * m_viewport->currentProjection()->clippingRadius();
 
+    // Allow half a pixel of error, in the texture or on the screen, whichever is coarser
+    const qreal tolerance = 0.5 / qMin<qreal>(radius, context.globalWidth() / (2 * M_PI));
+    InverseProjectionGrid grid(m_viewport, tolerance);
+
     // Paint the map.
-    for (int y = m_yTop; y < m_yBottom; ++y) {
-        // rx is the radius component in x direction
-        const int rx = (int)sqrt((qreal)(clipRadius * clipRadius - ((y - imageHeight / 2) * (y - imageHeight / 2))));
-
-        // Calculate the actual x-range of the map within the current scanline.
-        //
-        // If the circular border of the earth disk is still visible then xLeft
-        // equals the scanline position of the most left pixel that gets covered
-        // by the earth disk. In terms of math this equals the half image width minus
-        // the radius component on the current scanline in x direction ("rx").
-        //
-        // If the zoom factor is high enough then the whole screen gets covered
-        // by the earth and the border of the earth disk isn't visible anymore.
-        // In that situation xLeft equals zero.
-        // For xRight the situation is similar.
-
-        const int xLeft = (imageWidth / 2 - rx > 0) ? imageWidth / 2 - rx : 0;
-        const int xRight = (imageWidth / 2 - rx > 0) ? xLeft + rx + rx : imageWidth;
-
-        QRgb *scanLine = (QRgb *)(m_canvasImage->scanLine(y)) + xLeft;
-
-        const int xIpLeft = (imageWidth / 2 - rx > 0) ? n * (int)(xLeft / n + 1) : 1;
-        const int xIpRight = (imageWidth / 2 - rx > 0) ? n * (int)(xRight / n - 1) : n * (int)(xRight / n - 1) + 1;
-
-        // Decrease pole distortion due to linear approximation ( y-axis )
-        bool crossingPoleArea = false;
-        if (!globeHidesNorthPole && northPoleY - (n * 0.75) <= y && northPoleY + (n * 0.75) >= y) {
-            crossingPoleArea = true;
+    QRect block;
+    while (m_rowScheduler->nextBlock(block)) {
+        if (!printQuality) {
+            // The widest row of the block is the one closest to the center
+            const int yWidest = qBound(block.top(), imageHeight / 2, block.bottom());
+            const int rx = (int)sqrt((qreal)(clipRadius * clipRadius - ((yWidest - imageHeight / 2) * (yWidest - imageHeight / 2))));
+            const int xLeft = (imageWidth / 2 - rx > 0) ? imageWidth / 2 - rx : 0;
+            const int xRight = (imageWidth / 2 - rx > 0) ? xLeft + rx + rx : imageWidth;
+            grid.reset(QRect(xLeft, block.top(), xRight - xLeft, block.height()));
         }
 
-        int ncount = 0;
+        for (int y = block.top(); y <= block.bottom(); ++y) {
+            // rx is the radius component in x direction
+            const int rx = (int)sqrt((qreal)(clipRadius * clipRadius - ((y - imageHeight / 2) * (y - imageHeight / 2))));
+
+            // Calculate the actual x-range of the map within the current scanline.
+            //
+            // If the circular border of the earth disk is still visible then xLeft
+            // equals the scanline position of the most left pixel that gets covered
+            // by the earth disk. In terms of math this equals the half image width minus
+            // the radius component on the current scanline in x direction ("rx").
+            //
+            // If the zoom factor is high enough then the whole screen gets covered
+            // by the earth and the border of the earth disk isn't visible anymore.
+            // In that situation xLeft equals zero.
+            // For xRight the situation is similar.
+
+            const int xLeft = (imageWidth / 2 - rx > 0) ? imageWidth / 2 - rx : 0;
+            const int xRight = (imageWidth / 2 - rx > 0) ? xLeft + rx + rx : imageWidth;
+
+            QRgb *scanLine = (QRgb *)(m_canvasImage->scanLine(y)) + xLeft;
+
+            const int xIpLeft = (imageWidth / 2 - rx > 0) ? n * (int)(xLeft / n + 1) : 1;
+            const int xIpRight = (imageWidth / 2 - rx > 0) ? n * (int)(xRight / n - 1) : n * (int)(xRight / n - 1) + 1;
+
+            // Decrease pole distortion due to linear approximation ( y-axis )
+            bool crossingPoleArea = false;
+            if (!globeHidesNorthPole && northPoleY - (n * 0.75) <= y && northPoleY + (n * 0.75) >= y) {
+                crossingPoleArea = true;
+            }
+
+            int ncount = 0;
 
-        for (int x = xLeft; x < xRight; ++x) {
-            // Prepare for interpolation
-            const int leftInterval = xIpLeft + ncount * n;
+            for (int x = xLeft; x < xRight; ++x) {
+                // Prepare for interpolation
+                const int leftInterval = xIpLeft + ncount * n;
 
-            bool interpolate = false;
+                bool interpolate = false;
 
-            if (x >= xIpLeft && x <= xIpRight) {
-                // Decrease pole distortion due to linear approximation ( x-axis )
-                if (crossingPoleArea && northPoleX >= leftInterval + n && northPoleX < leftInterval + 2 * n && x < leftInterval + 3 * n) {
+                if (x >= xIpLeft && x <= xIpRight) {
+                    // Decrease pole distortion due to linear approximation ( x-axis )
+                    if (crossingPoleArea && northPoleX >= leftInterval + n && northPoleX < leftInterval + 2 * n && x < leftInterval + 3 * n) {
+                        interpolate = false;
+                    } else {
+                        x += n - 1;
+                        interpolate = !printQuality;
+                        ++ncount;
+                    }
+                } else
                     interpolate = false;
+
+                qreal lon;
+                qreal lat;
+                if (printQuality) {
+                    m_viewport->geoCoordinates(x, y, lon, lat, GeoDataCoordinates::Radian);
                 } else {
-                    x += n - 1;
-                    interpolate = !printQuality;
-                    ++ncount;
+                    grid.geoCoordinates(x, y, lon, lat);
                 }
-            } else
-                interpolate = false;
 
-            qreal lon;
-            qreal lat;
-            m_viewport->geoCoordinates(x, y, lon, lat, GeoDataCoordinates::Radian);
+                if (interpolate) {
+                    if (highQuality)
+                        context.pixelValueApproxF(lon, lat, scanLine, n);
+                    else
+                        context.pixelValueApprox(lon, lat, scanLine, n);
 
-            if (interpolate) {
-                if (highQuality)
-                    context.pixelValueApproxF(lon, lat, scanLine, n);
-                else
-                    context.pixelValueApprox(lon, lat, scanLine, n);
+                    scanLine += (n - 1);
+                }
 
-                scanLine += (n - 1);
-            }
+                if (x < imageWidth) {
+                    if (highQuality)
+                        context.pixelValueF(lon, lat, scanLine);
+                    else
+                        context.pixelValue(lon, lat, scanLine);
+                }
 
-            if (x < imageWidth) {
-                if (highQuality)
-                    context.pixelValueF(lon, lat, scanLine);
-                else
-                    context.pixelValue(lon, lat, scanLine);
+                ++scanLine;
             }
 
-            ++scanLine;
-        }
+            // copy scanline to improve performance
+            if (interlaced && y < block.bottom()) {
+                const int pixelByteSize = m_canvasImage->bytesPerLine() / imageWidth;
 
-        // copy scanline to improve performance
-        if (interlaced && y + 1 < m_yBottom) {
-            const int pixelByteSize = m_canvasImage->bytesPerLine() / imageWidth;
-
-            memcpy(m_canvasImage->scanLine(y + 1) + xLeft * pixelByteSize,
-                   m_canvasImage->scanLine(y) + xLeft * pixelByteSize,
-                   (xRight - xLeft) * pixelByteSize);
-            ++y;
+                memcpy(m_canvasImage->scanLine(y + 1) + xLeft * pixelByteSize,
+                       m_canvasImage->scanLine(y) + xLeft * pixelByteSize,
+                       (xRight - xLeft) * pixelByteSize);
+                ++y;
+            }
         }
     }
 }
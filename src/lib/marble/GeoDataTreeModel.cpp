@@ -581,9 +581,8 @@ QModelIndex GeoDataTreeModel::index(const GeoDataObject *object) const
     if (object == nullptr)
         return {};
 
-    // It first runs bottom-top, storing every ancestor of the object, and
-    // then goes top-down retrieving the QModelIndex of every ancestor until reaching the
-    // index of the requested object.
+    // The row of the object is its position within its parent, so only the
+    // parent chain has to be followed to make sure the object is in the tree.
     // The TreeModel contains: Documents, Folders, Placemarks, MultiGeometries
     // and Geometries that are children of MultiGeometries
     // You can not call this function with an element that does not belong to the tree
@@ -597,57 +596,43 @@ QModelIndex GeoDataTreeModel::index(const GeoDataObject *object) const
              || (geodata_cast<GeoDataPoint>(object) && geodata_cast<GeoDataMultiGeometry>(object->parent()))
              || (geodata_cast<GeoDataPolygon>(object) && geodata_cast<GeoDataMultiGeometry>(object->parent())) || geodata_cast<GeoDataMultiGeometry>(object));
 
-    QList<const GeoDataObject *> ancestors;
-
-    const GeoDataObject *itup = object; // Iterator to reach the top of the GeoDataDocument (bottom-up)
-
-    while (itup && (itup != d->m_rootDocument)) { // We reach up to the rootDocument
-
-        ancestors.append(itup);
-        itup = itup->parent();
-    }
-
-    QModelIndex itdown;
-    if (!ancestors.isEmpty()) {
-        itdown = index(d->m_rootDocument->childPosition(static_cast<const GeoDataFeature *>(ancestors.last())), 0, QModelIndex()); // Iterator to go top down
-
-        while ((ancestors.size() > 1)) {
-            const auto parent = static_cast<const GeoDataObject *>(ancestors.last());
-
-            if (const auto container = dynamic_cast<const GeoDataContainer *>(parent)) {
-                ancestors.removeLast();
-                itdown = index(container->childPosition(static_cast<const GeoDataFeature *>(ancestors.last())), 0, itdown);
-            } else if (geodata_cast<GeoDataPlacemark>(parent)) {
-                // The only child of the model is a Geometry or MultiGeometry object
-                // If it is a geometry object, we should be on the bottom of the list
-                ancestors.removeLast();
-                if (geodata_cast<GeoDataMultiGeometry>(ancestors.last()))
-                    itdown = index(0, 0, itdown);
-                else
-                    itdown = QModelIndex();
-
-            } else if (auto multiGeometry = geodata_cast<GeoDataMultiGeometry>(parent)) {
-                // The child is one of the geometry children of MultiGeometry
-                ancestors.removeLast();
-                itdown = index(multiGeometry->childPosition(static_cast<const GeoDataGeometry *>(ancestors.last())), 0, itdown);
-            } else if (geodata_cast<GeoDataTour>(parent)) {
-                ancestors.removeLast();
-                itdown = index(0, 0, itdown);
-            } else if (auto playlist = geodata_cast<GeoDataPlaylist>(parent)) {
-                for (int i = 0; i < playlist->size(); i++) {
-                    if (playlist->primitive(i) == ancestors.last()) {
-                        ancestors.removeLast();
-                        itdown = index(i, 0, itdown);
-                        break;
-                    }
-                }
-            } else { // If the element is not found on the tree, it will be added under m_rootDocument
-                itdown = QModelIndex();
+    const GeoDataObject *parent = object->parent();
+    if (object == d->m_rootDocument || parent == nullptr) {
+        return {};
+    }
+
+    for (const GeoDataObject *ancestor = parent; ancestor != d->m_rootDocument; ancestor = ancestor->parent()) {
+        if (ancestor == nullptr) { // The element is not found on the tree
+            return {};
+        }
+    }
+
+    int row = -1;
+    if (const auto container = dynamic_cast<const GeoDataContainer *>(parent)) {
+        row = container->childPosition(static_cast<const GeoDataFeature *>(object));
+    } else if (geodata_cast<GeoDataPlacemark>(parent)) {
+        // The only child of the placemark in the tree is a MultiGeometry,
+        // other geometries are not part of the tree
+        if (geodata_cast<GeoDataMultiGeometry>(object)) {
+            row = 0;
+        }
+    } else if (const auto multiGeometry = geodata_cast<GeoDataMultiGeometry>(parent)) {
+        row = multiGeometry->childPosition(static_cast<const GeoDataGeometry *>(object));
+    } else if (geodata_cast<GeoDataTour>(parent)) {
+        row = 0;
+    } else if (const auto playlist = geodata_cast<GeoDataPlaylist>(parent)) {
+        for (int i = 0; i < playlist->size(); i++) {
+            if (playlist->primitive(i) == object) {
+                row = i;
                 break;
             }
         }
     }
-    return itdown;
+
+    if (row < 0) {
+        return {};
+    }
+    return createIndex(row, 0, object);
 }
 
 QItemSelectionModel *GeoDataTreeModel::selectionModel()
@@ -5,10 +5,12 @@
 #include "GeoPainter.h"
 #include "GeoPainter_p.h"
 
+#include <QCoreApplication>
 #include <QList>
 #include <QPainterPath>
 #include <QPixmapCache>
 #include <QRegion>
+#include <QThread>
 #include <qmath.h>
 
 #include "MarbleDebug.h"
@@ -946,25 +948,27 @@ void GeoPainter::drawTextFragment(const QPoint &position, const QString &text, c
 {
     const QString key = text + QString::fromLatin1(":") + QString::number(static_cast<int>(flags));
 
+    // Pixmaps and QPixmapCache only work on the GUI thread, other threads draw the image
+    const bool guiThread = QThread::currentThread() == QCoreApplication::instance()->thread();
     QPixmap pixmap;
 
-    if (!QPixmapCache::find(key, &pixmap)) {
+    if (!guiThread || !QPixmapCache::find(key, &pixmap)) {
         const bool hasRoundFrame = flags.testFlag(RoundFrame);
 
-        QPixmap pixmap(10, 10);
+        QImage image(10, 10, QImage::Format_ARGB32_Premultiplied);
         QPainter textPainter;
 
-        textPainter.begin(&pixmap);
+        textPainter.begin(&image);
         const QFontMetrics metrics = textPainter.fontMetrics();
         textPainter.end();
 
         const int width = metrics.horizontalAdvance(text);
         const int height = metrics.height();
         const QSize size = hasRoundFrame ? QSize(qMax(1.2 * width, 1.1 * height), 1.2 * height) : QSize(width, height);
-        pixmap = QPixmap(size);
-        pixmap.fill(Qt::transparent);
+        image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
         const QRect labelRect(QPoint(), size);
-        textPainter.begin(&pixmap);
+        textPainter.begin(&image);
         QFont textFont = textPainter.font();
         textFont.setPointSize(fontSize);
         textPainter.setFont(textFont);
@@ -986,6 +990,12 @@ void GeoPainter::drawTextFragment(const QPoint &position, const QString &text, c
         }
 
         textPainter.end();
+
+        if (!guiThread) {
+            QPainter::drawImage(position.x() - image.width() / 2, position.y() - image.height() / 2, image);
+            return;
+        }
+        pixmap = QPixmap::fromImage(image);
         QPixmapCache::insert(key, pixmap);
     }
 
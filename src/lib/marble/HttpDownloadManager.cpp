@@ -8,6 +8,7 @@
 #include "HttpDownloadManager.h"
 
 #include <QCoreApplication>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QNetworkAccessManager>
@@ -15,6 +16,7 @@
 
 #include "DownloadPolicy.h"
 #include "DownloadQueueSet.h"
+#include "GeoDataLatLonBox.h"
 #include "HttpJob.h"
 #include "MarbleDebug.h"
 #include "StoragePolicy.h"
@@ -33,9 +35,11 @@ public:
     void connectDefaultQueueSets();
     void connectQueueSet(DownloadQueueSet *);
     bool hasDownloadPolicy(const DownloadPolicy &policy) const;
-    void finishJob(const QByteArray &, const QString &, const QString &id);
+    void finishJob(const QByteArray &, const QString &, const QString &id, const CacheValidators &validators);
+    void refreshFile(const QString &destinationFileName);
     void requeue();
     void startRetryTimer();
+    void updateViewports();
 
     DownloadQueueSet *findQueues(const QString &hostName, const DownloadUsage usage);
 
@@ -48,6 +52,8 @@ public:
      * - a queue for retries of failed downloads */
     QList<QPair<DownloadPolicyKey, DownloadQueueSet *>> m_queueSets;
     QMap<DownloadUsage, DownloadQueueSet *> m_defaultQueueSets;
+    /// The region shown by each view sharing the manager
+    QHash<const QObject *, DownloadQueueSet::Viewport> m_viewports;
     StoragePolicy *const m_storagePolicy;
     QNetworkAccessManager m_networkAccessManager;
     bool m_acceptJobs;
@@ -127,11 +133,64 @@ void HttpDownloadManager::addDownloadPolicy(const DownloadPolicy &policy)
     if (d->hasDownloadPolicy(policy))
         return;
     auto const queueSet = new DownloadQueueSet(policy, this);
+    queueSet->setViewports(d->m_viewports.values());
     d->connectQueueSet(queueSet);
     d->m_queueSets.append(QPair<DownloadPolicyKey, DownloadQueueSet *>(queueSet->downloadPolicy().key(), queueSet));
 }
 
+void HttpDownloadManager::setViewport(const QObject *view, const GeoDataLatLonBox &viewport, int tileLevel)
+{
+    if (!d->m_viewports.contains(view)) {
+        connect(view, &QObject::destroyed, this, [this, view]() {
+            removeViewport(view);
+        });
+    }
+    d->m_viewports.insert(view, DownloadQueueSet::Viewport{viewport, tileLevel});
+    d->updateViewports();
+}
+
+void HttpDownloadManager::removeViewport(const QObject *view)
+{
+    if (d->m_viewports.remove(view)) {
+        disconnect(view, &QObject::destroyed, this, nullptr);
+        d->updateViewports();
+    }
+}
+
+void HttpDownloadManager::Private::updateViewports()
+{
+    const QList<DownloadQueueSet::Viewport> viewports = m_viewports.values();
+    for (const auto &queueSet : std::as_const(m_queueSets)) {
+        queueSet.second->setViewports(viewports);
+    }
+    for (DownloadQueueSet *queueSet : std::as_const(m_defaultQueueSets)) {
+        queueSet->setViewports(viewports);
+    }
+}
+
+int HttpDownloadManager::pendingJobCount() const
+{
+    int result = 0;
+    for (const auto &queueSet : std::as_const(d->m_queueSets)) {
+        result += queueSet.second->pendingJobCount();
+    }
+    for (const DownloadQueueSet *queueSet : std::as_const(d->m_defaultQueueSets)) {
+        result += queueSet->pendingJobCount();
+    }
+    return result;
+}
+
 void HttpDownloadManager::addJob(const QUrl &sourceUrl, const QString &destFileName, const QString &id, const DownloadUsage usage)
+{
+    addTileJob(sourceUrl, destFileName, id, usage, GeoDataLatLonBox(), -1);
+}
+
+void HttpDownloadManager::addTileJob(const QUrl &sourceUrl,
+                                     const QString &destFileName,
+                                     const QString &id,
+                                     const DownloadUsage usage,
+                                     const GeoDataLatLonBox &tileBox,
+                                     int tileLevel)
 {
     if (!d->m_acceptJobs) {
         mDebug() << "Working offline, not adding job";
@@ -143,18 +202,28 @@ void HttpDownloadManager::addJob(const QUrl &sourceUrl, const QString &destFileN
         auto const job = new HttpJob(sourceUrl, destFileName, id, &d->m_networkAccessManager);
         job->setUserAgentPluginId(QStringLiteral("QNamNetworkPlugin"));
         job->setDownloadUsage(usage);
+        job->setTileBox(tileBox);
+        job->setTileLevel(tileLevel);
+        // Tiles are only requested again once expired, so ask whether they changed at all
+        if (d->m_storagePolicy && tileLevel >= 0) {
+            job->setCacheValidators(d->m_storagePolicy->validators(destFileName));
+        }
         mDebug() << "adding job " << sourceUrl;
         queueSet->addJob(job);
     }
 }
 
-void HttpDownloadManager::Private::finishJob(const QByteArray &data, const QString &destinationFileName, const QString &id)
+void HttpDownloadManager::Private::finishJob(const QByteArray &data,
+                                             const QString &destinationFileName,
+                                             const QString &id,
+                                             const CacheValidators &validators)
 {
     mDebug() << "emitting downloadComplete( QByteArray, " << id << ")";
     Q_EMIT m_downloadManager->downloadComplete(data, id);
     if (m_storagePolicy) {
         const bool saved = m_storagePolicy->updateFile(destinationFileName, data);
         if (saved) {
+            m_storagePolicy->setValidators(destinationFileName, validators);
             mDebug() << "emitting downloadComplete( " << destinationFileName << ", " << id << ")";
             Q_EMIT m_downloadManager->downloadComplete(destinationFileName, id);
         } else {
@@ -163,6 +232,14 @@ void HttpDownloadManager::Private::finishJob(const QByteArray &data, const QStri
     }
 }
 
+void HttpDownloadManager::Private::refreshFile(const QString &destinationFileName)
+{
+    // The stored file is what the initiator already got, so there is nothing to tell it
+    if (m_storagePolicy && !m_storagePolicy->refreshFile(destinationFileName)) {
+        qWarning() << "Could not refresh:" << destinationFileName << m_storagePolicy->lastErrorMessage();
+    }
+}
+
 void HttpDownloadManager::Private::requeue()
 {
     m_requeueTimer.stop();
@@ -190,9 +267,18 @@ void HttpDownloadManager::Private::connectDefaultQueueSets()
 
 void HttpDownloadManager::Private::connectQueueSet(DownloadQueueSet *queueSet)
 {
-    connect(queueSet, SIGNAL(jobFinished(QByteArray, QString, QString)), m_downloadManager, SLOT(finishJob(QByteArray, QString, QString)));
+    connect(queueSet,
+            &DownloadQueueSet::jobFinished,
+            m_downloadManager,
+            [this](const QByteArray &data, const QString &destinationFileName, const QString &id, const CacheValidators &validators) {
+                finishJob(data, destinationFileName, id, validators);
+            });
+    connect(queueSet, &DownloadQueueSet::jobNotModified, m_downloadManager, [this](const QString &destinationFileName) {
+        refreshFile(destinationFileName);
+    });
     connect(queueSet, SIGNAL(jobRetry()), m_downloadManager, SLOT(startRetryTimer()));
-    connect(queueSet, SIGNAL(jobRedirected(QUrl, QString, QString, DownloadUsage)), m_downloadManager, SLOT(addJob(QUrl, QString, QString, DownloadUsage)));
+    connect(queueSet, &DownloadQueueSet::jobRedirected, m_downloadManager, &HttpDownloadManager::addTileJob);
+    connect(queueSet, &DownloadQueueSet::jobCancelled, m_downloadManager, &HttpDownloadManager::downloadCancelled);
     // relay jobAdded/jobRemoved signals (interesting for progress bar)
     connect(queueSet, SIGNAL(jobAdded()), m_downloadManager, SIGNAL(jobAdded()));
     connect(queueSet, SIGNAL(jobRemoved()), m_downloadManager, SIGNAL(jobRemoved()));
@@ -23,6 +23,7 @@ namespace Marble
 {
 
 class DownloadPolicy;
+class GeoDataLatLonBox;
 class StoragePolicy;
 
 /**
@@ -60,6 +61,24 @@ public:
     void setDownloadEnabled(const bool enable);
     void addDownloadPolicy(const DownloadPolicy &);
 
+    /**
+     * Sets the region on screen of @p view and the tile level shown there. Waiting
+     * tile downloads are reordered to fetch the tiles closest to the center of any
+     * view first, browse downloads of tiles far off all views are cancelled. The
+     * view is forgotten when it is destroyed.
+     */
+    void setViewport(const QObject *view, const GeoDataLatLonBox &viewport, int tileLevel);
+
+    /**
+     * Stops taking the region of @p view into account.
+     */
+    void removeViewport(const QObject *view);
+
+    /**
+     * Returns the number of downloads running or waiting to run.
+     */
+    int pendingJobCount() const;
+
     static QByteArray userAgent(const QString &platform, const QString &plugin);
 
 public Q_SLOTS:
@@ -69,6 +88,16 @@ public Q_SLOTS:
      */
     void addJob(const QUrl &sourceUrl, const QString &destFilename, const QString &id, const DownloadUsage usage);
 
+    /**
+     * Adds a new job downloading the map tile covering @p tileBox on the given tile level.
+     */
+    void addTileJob(const QUrl &sourceUrl,
+                    const QString &destFilename,
+                    const QString &id,
+                    const DownloadUsage usage,
+                    const GeoDataLatLonBox &tileBox,
+                    int tileLevel);
+
 Q_SIGNALS:
     void downloadComplete(const QString &, const QString &);
 
@@ -90,6 +119,12 @@ Q_SIGNALS:
      */
     void jobRemoved();
 
+    /**
+     * This signal is emitted if a waiting download was dropped as its tile went
+     * out of view. The initiator needs to request it again if still interested.
+     */
+    void downloadCancelled(const QString &initiatorId);
+
     /**
      * A job was queued, activated or removed (finished, failed)
      */
@@ -101,7 +136,6 @@ private:
     class Private;
     Private *const d;
 
-    Q_PRIVATE_SLOT(d, void finishJob(const QByteArray &, const QString &, const QString &id))
     Q_PRIVATE_SLOT(d, void requeue())
     Q_PRIVATE_SLOT(d, void startRetryTimer())
 };
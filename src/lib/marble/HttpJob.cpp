@@ -8,6 +8,7 @@
 
 #include "HttpJob.h"
 
+#include "GeoDataLatLonBox.h"
 #include "HttpDownloadManager.h"
 #include "MarbleDebug.h"
 
@@ -25,6 +26,9 @@ public:
     QString m_initiatorId;
     int m_trialsLeft;
     DownloadUsage m_downloadUsage;
+    GeoDataLatLonBox m_tileBox;
+    int m_tileLevel;
+    CacheValidators m_cacheValidators;
     QString m_userAgent;
     QNetworkAccessManager *const m_networkAccessManager;
     QNetworkReply *m_networkReply;
@@ -36,6 +40,7 @@ HttpJobPrivate::HttpJobPrivate(const QUrl &sourceUrl, const QString &destFileNam
     , m_initiatorId(id)
     , m_trialsLeft(3)
     , m_downloadUsage(DownloadBrowse)
+    , m_tileLevel(-1)
     ,
     // FIXME: remove initialization depending on if empty pluginId
     // results in valid user agent string
@@ -105,6 +110,36 @@ void HttpJob::setDownloadUsage(const DownloadUsage usage)
     d->m_downloadUsage = usage;
 }
 
+GeoDataLatLonBox HttpJob::tileBox() const
+{
+    return d->m_tileBox;
+}
+
+void HttpJob::setTileBox(const GeoDataLatLonBox &box)
+{
+    d->m_tileBox = box;
+}
+
+int HttpJob::tileLevel() const
+{
+    return d->m_tileLevel;
+}
+
+void HttpJob::setTileLevel(int level)
+{
+    d->m_tileLevel = level;
+}
+
+CacheValidators HttpJob::cacheValidators() const
+{
+    return d->m_cacheValidators;
+}
+
+void HttpJob::setCacheValidators(const CacheValidators &validators)
+{
+    d->m_cacheValidators = validators;
+}
+
 void HttpJob::setUserAgentPluginId(const QString &pluginId) const
 {
     d->m_userAgent = pluginId;
@@ -128,6 +163,12 @@ void HttpJob::execute()
     QNetworkRequest request(d->m_sourceUrl);
     request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
     request.setRawHeader("User-Agent", userAgent());
+    if (!d->m_cacheValidators.eTag.isEmpty()) {
+        request.setRawHeader("If-None-Match", d->m_cacheValidators.eTag);
+    }
+    if (!d->m_cacheValidators.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", d->m_cacheValidators.lastModified);
+    }
     d->m_networkReply = d->m_networkAccessManager->get(request);
 
     connect(d->m_networkReply, &QNetworkReply::downloadProgress, this, &HttpJob::downloadProgress);
@@ -161,10 +202,15 @@ void HttpJob::finished()
     case QNetworkReply::NoError: {
         // check if we are redirected
         const QVariant redirectionAttribute = d->m_networkReply->attribute(QNetworkRequest::RedirectionTargetAttribute);
-        if (!redirectionAttribute.isNull()) {
+        const int statusCode = d->m_networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (statusCode == 304) {
+            Q_EMIT notModified(this);
+        } else if (!redirectionAttribute.isNull()) {
             Q_EMIT redirected(this, redirectionAttribute.toUrl());
         } else {
             // no redirection occurred
+            d->m_cacheValidators.eTag = d->m_networkReply->rawHeader("ETag");
+            d->m_cacheValidators.lastModified = d->m_networkReply->rawHeader("Last-Modified");
             const QByteArray data = d->m_networkReply->readAll();
             Q_EMIT dataReceived(this, data);
         }
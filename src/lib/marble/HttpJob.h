@@ -13,6 +13,7 @@
 #include <QObject>
 
 #include "MarbleGlobal.h"
+#include "StoragePolicy.h"
 
 #include "marble_export.h"
 
@@ -23,6 +24,7 @@ class QUrl;
 
 namespace Marble
 {
+class GeoDataLatLonBox;
 class HttpJobPrivate;
 
 class MARBLE_EXPORT HttpJob : public QObject
@@ -47,6 +49,25 @@ public:
     DownloadUsage downloadUsage() const;
     void setDownloadUsage(const DownloadUsage);
 
+    /**
+     * The area covered by the map tile being downloaded, if any. Together with
+     * the tile level it is used to download the tiles in view first.
+     */
+    GeoDataLatLonBox tileBox() const;
+    void setTileBox(const GeoDataLatLonBox &box);
+
+    int tileLevel() const;
+    void setTileLevel(int level);
+
+    /**
+     * The validators of the file already stored at the destination. They are
+     * sent along with the request, so that the server can answer that the file
+     * did not change. Once data was received, the validators of the reply are
+     * returned.
+     */
+    CacheValidators cacheValidators() const;
+    void setCacheValidators(const CacheValidators &validators);
+
     void setUserAgentPluginId(const QString &pluginId) const;
 
     QByteArray userAgent() const;
@@ -64,6 +85,12 @@ Q_SIGNALS:
      */
     void dataReceived(HttpJob *job, const QByteArray &data);
 
+    /**
+     * This signal is emitted if the server confirmed that the file stored
+     * at the destination is still up to date.
+     */
+    void notModified(HttpJob *job);
+
 public Q_SLOTS:
     void execute();
 
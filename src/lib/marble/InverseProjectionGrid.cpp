@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "InverseProjectionGrid.h"
+
+#include "GeoDataCoordinates.h"
+#include "ViewportParams.h"
+
+#include <qmath.h>
+
+namespace Marble
+{
+
+InverseProjectionGrid::InverseProjectionGrid(const ViewportParams *viewport, qreal tolerance)
+    : m_viewport(viewport)
+    , m_tolerance(tolerance)
+{
+}
+
+void InverseProjectionGrid::reset(const QRect &area)
+{
+    m_area = area;
+    m_cells.clear();
+
+    const int columns = (area.width() + cellWidth - 1) / cellWidth;
+    QList<Sample> top;
+    QList<Sample> bottom;
+    top.reserve(columns + 1);
+    bottom.reserve(columns + 1);
+    for (int i = 0; i <= columns; ++i) {
+        const int x = area.left() + qMin(i * cellWidth, area.width());
+        top << sample(x, area.top());
+        bottom << sample(x, area.bottom() + 1);
+    }
+
+    // The coarse cells come first, so that the cell of a column is found by its index
+    m_cells.resize(columns);
+    for (int i = 0; i < columns; ++i) {
+        const int x = area.left() + i * cellWidth;
+        const int width = qMin(cellWidth, area.right() + 1 - x);
+        setCell(i, x, area.top(), width, area.height(), top.at(i), top.at(i + 1), bottom.at(i), bottom.at(i + 1), 0);
+    }
+}
+
+void InverseProjectionGrid::setCell(int index,
+                                    int x,
+                                    int y,
+                                    int width,
+                                    int height,
+                                    const Sample &topLeft,
+                                    const Sample &topRight,
+                                    const Sample &bottomLeft,
+                                    const Sample &bottomRight,
+                                    int depth)
+{
+    Cell cell;
+    cell.x = x;
+    cell.y = y;
+    cell.width = width;
+    cell.height = height;
+    cell.corners[0] = topLeft;
+    cell.corners[1] = topRight;
+    cell.corners[2] = bottomLeft;
+    cell.corners[3] = bottomRight;
+    cell.children = -1;
+    cell.exact = false;
+
+    bool smooth = topLeft.valid && topRight.valid && bottomLeft.valid && bottomRight.valid;
+    for (int i = 1; smooth && i < 4; ++i) {
+        qreal &lon = cell.corners[i].lon;
+        if (lon - topLeft.lon > M_PI) {
+            lon -= 2 * M_PI;
+        } else if (lon - topLeft.lon < -M_PI) {
+            lon += 2 * M_PI;
+        }
+        // Longitudes change too fast close to the poles
+        smooth = qAbs(lon - topLeft.lon) < M_PI / 4;
+    }
+
+    // Besides the corners, the interpolation is checked at the lattice of the quarter points of the cell
+    for (int j = 0; smooth && j <= 4; ++j) {
+        for (int i = 0; smooth && i <= 4; ++i) {
+            if ((i == 0 || i == 4) && (j == 0 || j == 4)) {
+                continue;
+            }
+            const int sampleX = x + (i * width) / 4;
+            const int sampleY = y + (j * height) / 4;
+            smooth = matches(cell, sampleX, sampleY, sample(sampleX, sampleY));
+        }
+    }
+
+    if (!smooth) {
+        if (depth < maximumDepth && width >= 4 && height >= 4) {
+            // The center and the middle of the edges become corners of the children
+            const int leftWidth = width / 2;
+            const int topHeight = height / 2;
+            const Sample center = sample(x + leftWidth, y + topHeight);
+            const Sample top = sample(x + leftWidth, y);
+            const Sample left = sample(x, y + topHeight);
+            const Sample right = sample(x + width, y + topHeight);
+            const Sample bottom = sample(x + leftWidth, y + height);
+
+            // The four children are stored next to each other
+            cell.children = m_cells.size();
+            m_cells.resize(cell.children + 4);
+            setCell(cell.children, x, y, leftWidth, topHeight, topLeft, top, left, center, depth + 1);
+            setCell(cell.children + 1, x + leftWidth, y, width - leftWidth, topHeight, top, topRight, center, right, depth + 1);
+            setCell(cell.children + 2, x, y + topHeight, leftWidth, height - topHeight, left, center, bottomLeft, bottom, depth + 1);
+            setCell(cell.children + 3, x + leftWidth, y + topHeight, width - leftWidth, height - topHeight, center, right, bottom, bottomRight, depth + 1);
+        } else {
+            cell.exact = true;
+        }
+    }
+
+    m_cells[index] = cell;
+}
+
+bool InverseProjectionGrid::matches(const Cell &cell, int x, int y, const Sample &exact) const
+{
+    if (!exact.valid) {
+        return false;
+    }
+
+    qreal lon;
+    qreal lat;
+    interpolate(cell, x, y, lon, lat);
+
+    qreal deltaLon = lon - exact.lon;
+    if (deltaLon > M_PI) {
+        deltaLon -= 2 * M_PI;
+    } else if (deltaLon < -M_PI) {
+        deltaLon += 2 * M_PI;
+    }
+    deltaLon *= cos(exact.lat);
+    const qreal deltaLat = lat - exact.lat;
+    // Half of the tolerance leaves room for the pixels between the samples
+    return 4 * (deltaLon * deltaLon + deltaLat * deltaLat) <= m_tolerance * m_tolerance;
+}
+
+void InverseProjectionGrid::interpolate(const Cell &cell, int x, int y, qreal &lon, qreal &lat)
+{
+    const qreal u = qreal(x - cell.x) / cell.width;
+    const qreal v = qreal(y - cell.y) / cell.height;
+    const Sample *const corners = cell.corners;
+    lon = (1 - v) * ((1 - u) * corners[0].lon + u * corners[1].lon) + v * ((1 - u) * corners[2].lon + u * corners[3].lon);
+    lat = (1 - v) * ((1 - u) * corners[0].lat + u * corners[1].lat) + v * ((1 - u) * corners[2].lat + u * corners[3].lat);
+}
+
+void InverseProjectionGrid::geoCoordinates(int x, int y, qreal &lon, qreal &lat) const
+{
+    if (!m_area.contains(x, y)) {
+        m_viewport->geoCoordinates(x, y, lon, lat, GeoDataCoordinates::Radian);
+        return;
+    }
+
+    const Cell *cell = &m_cells.at((x - m_area.left()) / cellWidth);
+    while (cell->children >= 0) {
+        const int child = (x >= cell->x + cell->width / 2 ? 1 : 0) + (y >= cell->y + cell->height / 2 ? 2 : 0);
+        cell = &m_cells.at(cell->children + child);
+    }
+
+    if (cell->exact) {
+        m_viewport->geoCoordinates(x, y, lon, lat, GeoDataCoordinates::Radian);
+        return;
+    }
+
+    interpolate(*cell, x, y, lon, lat);
+    if (lon > M_PI) {
+        lon -= 2 * M_PI;
+    } else if (lon < -M_PI) {
+        lon += 2 * M_PI;
+    }
+}
+
+InverseProjectionGrid::Sample InverseProjectionGrid::sample(int x, int y) const
+{
+    Sample result;
+    result.valid = m_viewport->geoCoordinates(x, y, result.lon, result.lat, GeoDataCoordinates::Radian);
+    return result;
+}
+
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_INVERSEPROJECTIONGRID_H
+#define MARBLE_INVERSEPROJECTIONGRID_H
+
+#include <QList>
+#include <QRect>
+
+#include "marble_export.h"
+
+namespace Marble
+{
+
+class ViewportParams;
+
+/**
+ * @short Approximates the inverse projection within a block of rows.
+ *
+ * The block is covered by cells whose corners are projected exactly. A cell
+ * is interpolated bilinearly if the interpolation stays within half of the
+ * tolerance at the quarter points of the cell, including the middle of each
+ * edge. Other cells are split into four, down to a minimum size, below which the
+ * exact inverse projection is used. Smooth areas thus need a few exact
+ * projections per cell instead of several per row, while the pole areas, the
+ * dateline and the border of the globe stay precise.
+ */
+class MARBLE_EXPORT InverseProjectionGrid
+{
+public:
+    /**
+     * @param tolerance The largest error of an interpolated position, in
+     *                  radian on the sphere
+     */
+    InverseProjectionGrid(const ViewportParams *viewport, qreal tolerance);
+
+    /// Covers the pixels of @p area with cells
+    void reset(const QRect &area);
+
+    /// Returns the position of the pixel in radian, like ViewportParams::geoCoordinates()
+    void geoCoordinates(int x, int y, qreal &lon, qreal &lat) const;
+
+private:
+    struct Sample {
+        qreal lon;
+        qreal lat;
+        bool valid;
+    };
+
+    struct Cell {
+        int x;
+        int y;
+        int width;
+        int height;
+        // top left, top right, bottom left, bottom right, longitudes unwrapped relative to the first
+        Sample corners[4];
+        // index of the first of the four children, -1 for leaves
+        int children;
+        bool exact;
+    };
+
+    Sample sample(int x, int y) const;
+    void setCell(int index,
+                 int x,
+                 int y,
+                 int width,
+                 int height,
+                 const Sample &topLeft,
+                 const Sample &topRight,
+                 const Sample &bottomLeft,
+                 const Sample &bottomRight,
+                 int depth);
+
+    static void interpolate(const Cell &cell, int x, int y, qreal &lon, qreal &lat);
+
+    /// Whether the interpolation of @p cell at the sample is close enough to it
+    bool matches(const Cell &cell, int x, int y, const Sample &exact) const;
+
+    // Cells are split this often at most
+    static constexpr int maximumDepth = 2;
+    // Coarse cells are this wide, and as high as the block
+    static constexpr int cellWidth = 32;
+
+    const ViewportParams *const m_viewport;
+    const qreal m_tolerance;
+    QRect m_area;
+    QList<Cell> m_cells;
+};
+
+}
+
+#endif
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "LabelAtlas.h"
+
+#include "MarbleDebug.h"
+#include "VisiblePlacemark.h"
+
+#include <QApplication>
+#include <QFontMetrics>
+#include <QMultiHash>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPalette>
+#include <QSet>
+#include <QtConcurrentMap>
+
+namespace Marble
+{
+
+// Pages are this large unless a single label needs more room
+static const int pageSize = 1024;
+// Beyond this many pages the least recently used page gets cleared
+static const int maximumPageCount = 4;
+
+bool LabelAtlas::Key::operator==(const Key &other) const
+{
+    return style == other.style && glow == other.glow && color == other.color && text == other.text && font == other.font;
+}
+
+size_t qHash(const LabelAtlas::Key &key, size_t seed)
+{
+    return qHashMulti(seed, key.text, key.font, key.color.rgba(), int(key.style), key.glow);
+}
+
+LabelAtlas::LabelAtlas()
+    : m_frame(0)
+{
+}
+
+QList<LabelAtlas::Entry> LabelAtlas::prepare(const QList<Key> &keys)
+{
+    ++m_frame;
+
+    // Selected labels are drawn in the colors of the palette, which must not be accessed from worker threads
+    const QPalette palette = QApplication::palette();
+    if (palette.highlight().color() != m_highlight || palette.highlightedText().color() != m_highlightedText) {
+        clear();
+        m_highlight = palette.highlight().color();
+        m_highlightedText = palette.highlightedText().color();
+    }
+
+    // Mark the pages in use first, so that none of them gets evicted below
+    QList<Key> missing;
+    QSet<Key> missingKeys;
+    for (const Key &key : keys) {
+        if (key.text.isEmpty()) {
+            continue;
+        }
+        const auto iterator = m_entries.constFind(key);
+        if (iterator != m_entries.constEnd()) {
+            m_pages[iterator->page].lastUsed = m_frame;
+        } else if (!missingKeys.contains(key)) {
+            missingKeys.insert(key);
+            missing << key;
+        }
+    }
+
+    if (!missing.isEmpty()) {
+        const QColor highlight = m_highlight;
+        const QColor highlightedText = m_highlightedText;
+        const QList<QImage> images = QtConcurrent::blockingMapped<QList<QImage>>(missing, [highlight, highlightedText](const Key &key) {
+            return render(key, highlight, highlightedText);
+        });
+
+        // Place all labels before painting, as adding pages moves the existing ones
+        QMultiHash<int, int> labelsOfPage;
+        for (int i = 0; i < missing.size(); ++i) {
+            const Entry entry = allocate(images.at(i).size());
+            m_entries.insert(missing.at(i), entry);
+            labelsOfPage.insert(entry.page, i);
+        }
+
+        const QList<int> pages = labelsOfPage.uniqueKeys();
+        for (int page : pages) {
+            m_pages[page].pixmap = QPixmap();
+            QPainter painter(&m_pages[page].image);
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            for (auto it = labelsOfPage.constFind(page); it != labelsOfPage.constEnd() && it.key() == page; ++it) {
+                painter.drawImage(m_entries.value(missing.at(it.value())).rect.topLeft(), images.at(it.value()));
+            }
+        }
+    }
+
+    QList<Entry> result;
+    result.reserve(keys.size());
+    for (const Key &key : keys) {
+        result << (key.text.isEmpty() ? Entry() : m_entries.value(key));
+    }
+    return result;
+}
+
+const QImage &LabelAtlas::page(int index) const
+{
+    return m_pages.at(index).image;
+}
+
+const QPixmap &LabelAtlas::pagePixmap(int index)
+{
+    Page &page = m_pages[index];
+    if (page.pixmap.isNull()) {
+        page.pixmap = QPixmap::fromImage(page.image);
+    }
+    return page.pixmap;
+}
+
+int LabelAtlas::pageCount() const
+{
+    return m_pages.size();
+}
+
+void LabelAtlas::clear()
+{
+    m_pages.clear();
+    m_entries.clear();
+}
+
+QSize LabelAtlas::labelSize(const Key &key)
+{
+    QFont labelFont = key.font;
+    const int textHeight = QFontMetrics(labelFont).height();
+    if (key.glow) {
+        labelFont.setWeight(QFont::Bold); // Needed to calculate the correct pixmap size;
+        return {QFontMetrics(labelFont).horizontalAdvance(key.text) + qRound(2 * s_labelOutlineWidth), textHeight};
+    }
+    return {QFontMetrics(labelFont).horizontalAdvance(key.text), textHeight};
+}
+
+QImage LabelAtlas::render(const Key &key, const QColor &highlight, const QColor &highlightedText)
+{
+    QImage image(labelSize(key), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    if (image.isNull()) {
+        return image;
+    }
+
+    QPainter labelPainter(&image);
+    QFont font = key.font;
+    QFontMetrics metrics = QFontMetrics(font);
+    int fontAscent = metrics.ascent();
+
+    switch (key.style) {
+    case Selected: {
+        labelPainter.setFont(font);
+        QRect textRect(0, 0, metrics.horizontalAdvance(key.text), metrics.height());
+        labelPainter.fillRect(textRect, highlight);
+        labelPainter.setPen(QPen(highlightedText, 1));
+        labelPainter.drawText(0, fontAscent, key.text);
+        break;
+    }
+    case Glow: {
+        font.setWeight(QFont::Bold);
+        fontAscent = QFontMetrics(font).ascent();
+
+        const QColor &color = key.color;
+        QPen outlinepen((color.red() + color.green() + color.blue()) / 3 < 160 ? Qt::white : Qt::black);
+        outlinepen.setWidthF(s_labelOutlineWidth);
+        QBrush outlinebrush(color);
+
+        QPainterPath outlinepath;
+
+        const QPointF baseline(s_labelOutlineWidth / 2.0, fontAscent);
+        outlinepath.addText(baseline, font, key.text);
+        labelPainter.setRenderHint(QPainter::Antialiasing, true);
+        labelPainter.setPen(outlinepen);
+        labelPainter.setBrush(outlinebrush);
+        labelPainter.drawPath(outlinepath);
+        labelPainter.setPen(Qt::NoPen);
+        labelPainter.drawPath(outlinepath);
+        labelPainter.setRenderHint(QPainter::Antialiasing, false);
+        break;
+    }
+    default: {
+        labelPainter.setPen(key.color);
+        labelPainter.setFont(font);
+        labelPainter.drawText(0, fontAscent, key.text);
+    }
+    }
+
+    return image;
+}
+
+LabelAtlas::Entry LabelAtlas::allocate(const QSize &size)
+{
+    Entry entry;
+    for (int i = 0; i < m_pages.size(); ++i) {
+        if (allocate(m_pages[i], size, entry.rect)) {
+            entry.page = i;
+            m_pages[i].lastUsed = m_frame;
+            return entry;
+        }
+    }
+
+    // Reuse the least recently used page, unless it is needed for the current frame as well
+    int page = -1;
+    if (m_pages.size() >= maximumPageCount) {
+        for (int i = 0; i < m_pages.size(); ++i) {
+            if (m_pages.at(i).lastUsed < m_frame && (page < 0 || m_pages.at(i).lastUsed < m_pages.at(page).lastUsed)) {
+                page = i;
+            }
+        }
+    }
+
+    const QSize pageExtent(qMax(pageSize, size.width()), qMax(pageSize, size.height()));
+    if (page < 0) {
+        page = m_pages.size();
+        m_pages.append(Page());
+    } else {
+        evict(page);
+    }
+
+    Page &newPage = m_pages[page];
+    if (newPage.image.size() != pageExtent) {
+        newPage.image = QImage(pageExtent, QImage::Format_ARGB32_Premultiplied);
+    }
+    newPage.image.fill(Qt::transparent);
+    newPage.pixmap = QPixmap();
+    newPage.lastUsed = m_frame;
+
+    const bool allocated = allocate(newPage, size, entry.rect);
+    Q_ASSERT(allocated);
+    Q_UNUSED(allocated);
+    entry.page = page;
+    return entry;
+}
+
+bool LabelAtlas::allocate(Page &page, const QSize &size, QRect &rect) const
+{
+    const int width = page.image.width();
+
+    // Labels of the same font share a shelf, avoid wasting too much of taller ones
+    for (Shelf &shelf : page.shelves) {
+        if (size.height() <= shelf.height && size.height() * 4 >= shelf.height * 3 && shelf.x + size.width() <= width) {
+            rect = QRect(QPoint(shelf.x, shelf.y), size);
+            shelf.x += size.width();
+            return true;
+        }
+    }
+
+    if (page.usedHeight + size.height() > page.image.height() || size.width() > width) {
+        return false;
+    }
+
+    page.shelves << Shelf{page.usedHeight, size.height(), size.width()};
+    rect = QRect(QPoint(0, page.usedHeight), size);
+    page.usedHeight += size.height();
+    return true;
+}
+
+void LabelAtlas::evict(int index)
+{
+    mDebug() << "Evicting label atlas page" << index;
+    m_entries.removeIf([index](const QHash<Key, Entry>::iterator &iterator) {
+        return iterator->page == index;
+    });
+    m_pages[index].shelves.clear();
+    m_pages[index].usedHeight = 0;
+}
+
+}
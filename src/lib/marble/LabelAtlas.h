@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_LABELATLAS_H
+#define MARBLE_LABELATLAS_H
+
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+
+#include "marble_export.h"
+
+namespace Marble
+{
+
+/**
+ * @short Shared storage of rendered placemark labels.
+ *
+ * Labels are rendered into a few large images, the pages of the atlas. On
+ * the GUI thread, all labels on one page can be drawn with a single call to
+ * QPainter::drawPixmapFragments() using pagePixmap(), other threads draw
+ * them from page(). Labels are identified by their text and look,
+ * placemarks sharing both share the label.
+ *
+ * Labels missing from the atlas are rendered on worker threads. Once the
+ * atlas is full, the page used least recently is cleared to make room.
+ */
+class MARBLE_EXPORT LabelAtlas
+{
+public:
+    enum LabelStyle {
+        Normal = 0,
+        Glow,
+        Selected
+    };
+
+    struct Key {
+        QString text;
+        QFont font;
+        QColor color;
+        LabelStyle style = Normal;
+        // Glowing labels are wider, even when drawn selected
+        bool glow = false;
+
+        bool operator==(const Key &other) const;
+    };
+
+    /// Where a label is found in the atlas, the page is -1 for empty labels
+    struct Entry {
+        int page = -1;
+        QRect rect;
+    };
+
+    LabelAtlas();
+
+    /**
+     * Makes sure all labels of @p keys are in the atlas and returns their
+     * location, in the order of @p keys. The locations are valid until the
+     * next call.
+     */
+    QList<Entry> prepare(const QList<Key> &keys);
+
+    const QImage &page(int index) const;
+
+    /// Returns the page as pixmap, which must only be used on the GUI thread
+    const QPixmap &pagePixmap(int index);
+
+    int pageCount() const;
+
+    /// Drops all labels
+    void clear();
+
+    /**
+     * Returns the size of the label, which matches the size PlacemarkLayout
+     * reserves for it.
+     */
+    static QSize labelSize(const Key &key);
+
+private:
+    struct Shelf {
+        int y;
+        int height;
+        int x;
+    };
+
+    struct Page {
+        QImage image;
+        // Converted from the image when needed
+        QPixmap pixmap;
+        QList<Shelf> shelves;
+        int usedHeight = 0;
+        quint64 lastUsed = 0;
+    };
+
+    static QImage render(const Key &key, const QColor &highlight, const QColor &highlightedText);
+
+    Entry allocate(const QSize &size);
+    bool allocate(Page &page, const QSize &size, QRect &rect) const;
+    void evict(int index);
+
+    QList<Page> m_pages;
+    QHash<Key, Entry> m_entries;
+    quint64 m_frame;
+    QColor m_highlight;
+    QColor m_highlightedText;
+};
+
+MARBLE_EXPORT size_t qHash(const LabelAtlas::Key &key, size_t seed = 0);
+
+}
+
+#endif
@@ -15,9 +15,13 @@
 #include "LayerInterface.h"
 #include "MarbleDebug.h"
 #include "RenderPlugin.h"
+#include "RenderProfiler.h"
 #include "RenderState.h"
 
 #include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QSet>
 
 namespace Marble
 {
@@ -30,23 +34,58 @@ public:
 
     void updateVisibility(bool visible, const QString &nameId);
 
+    /// All render positions, including the ones behind the globe
+    static QStringList allRenderPositions();
+
+    /// Returns the layers at @p renderPosition, in the order they are rendered in
+    QList<LayerInterface *> layers(const QString &renderPosition);
+
+    /// Renders @p layers at @p renderPosition and marks the render position as clean
+    void renderLayers(GeoPainter *painter,
+                      ViewportParams *viewport,
+                      const QString &renderPosition,
+                      const QList<LayerInterface *> &layers,
+                      QStringList &traceList);
+
+    /**
+     * Renders the dirty parts of the render positions into their back buffers
+     * and composes the back buffers. Layers at USER_TOOLS are always rendered
+     * directly, as applications repaint them without telling which parts changed.
+     */
+    void renderBuffered(GeoPainter *painter, ViewportParams *viewport, QStringList &traceList);
+
+    void renderRuntimeTrace(GeoPainter *painter, QStringList traceList, qint64 totalElapsed) const;
+
     LayerManager *const q;
 
     QList<RenderPlugin *> m_renderPlugins;
     QList<AbstractDataPlugin *> m_dataPlugins;
     QList<LayerInterface *> m_internalLayers;
 
-    RenderState m_renderState;
+    // The render states of the layers, as of the last rendering of their render position
+    QHash<QString, QList<RenderState>> m_layerStates;
+    // Render positions that changed completely, and the ones that changed in parts
+    QSet<QString> m_dirtyRenderPositions;
+    QHash<QString, QRegion> m_dirtyRegions;
+    RenderProfiler *m_renderProfiler;
 
     bool m_showBackground;
     bool m_showRuntimeTrace;
+
+    bool m_backBuffersEnabled;
+    QHash<QString, QImage> m_backBuffers;
+    QSize m_backBufferSize;
+    qreal m_backBufferDevicePixelRatio;
 };
 
 LayerManager::Private::Private(LayerManager *parent)
     : q(parent)
     , m_renderPlugins()
+    , m_renderProfiler(nullptr)
     , m_showBackground(true)
     , m_showRuntimeTrace(false)
+    , m_backBuffersEnabled(false)
+    , m_backBufferDevicePixelRatio(1.0)
 {
 }
 
@@ -57,10 +96,18 @@ void LayerManager::Private::updateVisibility(bool visible, const QString &nameId
     Q_EMIT q->visibilityChanged(nameId, visible);
 }
 
+QStringList LayerManager::Private::allRenderPositions()
+{
+    return QStringList() << QStringLiteral("STARS") << QStringLiteral("BEHIND_TARGET") << QStringLiteral("SURFACE") << QStringLiteral("HOVERS_ABOVE_SURFACE")
+                         << QStringLiteral("GRATICULE") << QStringLiteral("PLACEMARKS") << QStringLiteral("ATMOSPHERE") << QStringLiteral("ORBIT")
+                         << QStringLiteral("ALWAYS_ON_TOP") << QStringLiteral("FLOAT_ITEM") << QStringLiteral("USER_TOOLS");
+}
+
 LayerManager::LayerManager(QObject *parent)
     : QObject(parent)
     , d(new Private(this))
 {
+    setDirty();
 }
 
 LayerManager::~LayerManager()
@@ -83,9 +130,21 @@ void LayerManager::addRenderPlugin(RenderPlugin *renderPlugin)
     d->m_renderPlugins.append(renderPlugin);
 
     connect(renderPlugin, SIGNAL(settingsChanged(QString)), this, SIGNAL(pluginSettingsChanged()));
-    connect(renderPlugin, SIGNAL(repaintNeeded(QRegion)), this, SIGNAL(repaintNeeded(QRegion)));
+    connect(renderPlugin, &RenderPlugin::repaintNeeded, this, [this, renderPlugin](const QRegion &dirtyRegion) {
+        setDirty(renderPlugin->renderPosition(), dirtyRegion);
+        Q_EMIT repaintNeeded(dirtyRegion);
+    });
     connect(renderPlugin, SIGNAL(visibilityChanged(bool, QString)), this, SLOT(updateVisibility(bool, QString)));
 
+    // Showing, hiding or reconfiguring a plugin changes all of its render positions
+    const auto layerChanged = [this, renderPlugin]() {
+        setDirty(renderPlugin->renderPosition());
+        Q_EMIT repaintNeeded();
+    };
+    connect(renderPlugin, &RenderPlugin::visibilityChanged, this, layerChanged);
+    connect(renderPlugin, &RenderPlugin::enabledChanged, this, layerChanged);
+    connect(renderPlugin, &RenderPlugin::settingsChanged, this, layerChanged);
+
     // get data plugins
     auto const dataPlugin = qobject_cast<AbstractDataPlugin *>(renderPlugin);
     if (dataPlugin) {
@@ -108,89 +167,236 @@ QList<AbstractDataPluginItem *> LayerManager::whichItemAt(const QPoint &curpos)
     return itemList;
 }
 
-void LayerManager::renderLayers(GeoPainter *painter, ViewportParams *viewport)
+QStringList LayerManager::renderPositions() const
 {
-    d->m_renderState = RenderState(QStringLiteral("Marble"));
-    QElapsedTimer totalTime;
-    totalTime.start();
+    QStringList renderPositions = Private::allRenderPositions();
+    if (!d->m_showBackground) {
+        renderPositions.removeAll(QStringLiteral("STARS"));
+        renderPositions.removeAll(QStringLiteral("BEHIND_TARGET"));
+    }
+    return renderPositions;
+}
 
-    QStringList renderPositions;
+QList<LayerInterface *> LayerManager::Private::layers(const QString &renderPosition)
+{
+    QList<LayerInterface *> layers;
+
+    // collect all RenderPlugins of current renderPosition
+    for (auto renderPlugin : m_renderPlugins) {
+        if (renderPlugin && renderPlugin->renderPosition().contains(renderPosition)) {
+            if (renderPlugin->enabled() && renderPlugin->visible()) {
+                if (!renderPlugin->isInitialized()) {
+                    renderPlugin->initialize();
+                    Q_EMIT q->renderPluginInitialized(renderPlugin);
+                }
+                layers.push_back(renderPlugin);
+            }
+        }
+    }
 
-    if (d->m_showBackground) {
-        renderPositions << QStringLiteral("STARS") << QStringLiteral("BEHIND_TARGET");
+    // collect all internal LayerInterfaces of current renderPosition
+    for (auto layer : m_internalLayers) {
+        if (layer && layer->renderPosition().contains(renderPosition)) {
+            layers.push_back(layer);
+        }
     }
 
-    renderPositions << QStringLiteral("SURFACE") << QStringLiteral("HOVERS_ABOVE_SURFACE") << QStringLiteral("GRATICULE") << QStringLiteral("PLACEMARKS")
-                    << QStringLiteral("ATMOSPHERE") << QStringLiteral("ORBIT") << QStringLiteral("ALWAYS_ON_TOP") << QStringLiteral("FLOAT_ITEM")
-                    << QStringLiteral("USER_TOOLS");
+    // sort them according to their zValue()s
+    std::sort(layers.begin(), layers.end(), [](const LayerInterface *const one, const LayerInterface *const two) -> bool {
+        Q_ASSERT(one && two);
+        return one->zValue() < two->zValue();
+    });
 
-    QStringList traceList;
+    return layers;
+}
+
+void LayerManager::Private::renderLayers(GeoPainter *painter,
+                                         ViewportParams *viewport,
+                                         const QString &renderPosition,
+                                         const QList<LayerInterface *> &layers,
+                                         QStringList &traceList)
+{
+    RenderProfiler *const profiler = m_renderProfiler && m_renderProfiler->isEnabled() ? m_renderProfiler : nullptr;
+
+    // Layers may become dirty again while being rendered
+    m_dirtyRenderPositions.remove(renderPosition);
+    m_dirtyRegions.remove(renderPosition);
+
+    // render the layers of the current renderPosition
+    QElapsedTimer timer;
+    const qint64 positionStart = profiler ? profiler->now() : 0;
+    QList<RenderState> &layerStates = m_layerStates[renderPosition];
+    layerStates.clear();
+    for (auto layer : layers) {
+        const qint64 layerStart = profiler ? profiler->now() : 0;
+        timer.start();
+        layer->render(painter, viewport, renderPosition, nullptr);
+        const qint64 layerEnd = profiler ? profiler->now() : 0;
+        const RenderState layerState = layer->renderState();
+        layerStates << layerState;
+        traceList.append(QStringLiteral("%2 ms %3").arg(timer.elapsed(), 3).arg(layer->runtimeTrace()));
+        if (profiler) {
+            const QString name = layerState.name().isEmpty() ? renderPosition : layerState.name();
+            profiler->addDuration(name, renderPosition, layerStart, layerEnd - layerStart);
+        }
+    }
+    if (profiler && !layers.isEmpty()) {
+        profiler->addDuration(renderPosition, QStringLiteral("RenderPosition"), positionStart, profiler->now() - positionStart);
+    }
+}
+
+void LayerManager::Private::renderBuffered(GeoPainter *painter, ViewportParams *viewport, QStringList &traceList)
+{
+    const QString userTools = allRenderPositions().last();
+    const QStringList renderPositions = q->renderPositions();
+
+    QList<QList<LayerInterface *>> positionLayers;
+    bool allDirty = true;
     for (const auto &renderPosition : renderPositions) {
-        QList<LayerInterface *> layers;
-
-        // collect all RenderPlugins of current renderPosition
-        for (auto renderPlugin : d->m_renderPlugins) {
-            if (renderPlugin && renderPlugin->renderPosition().contains(renderPosition)) {
-                if (renderPlugin->enabled() && renderPlugin->visible()) {
-                    if (!renderPlugin->isInitialized()) {
-                        renderPlugin->initialize();
-                        Q_EMIT renderPluginInitialized(renderPlugin);
-                    }
-                    layers.push_back(renderPlugin);
-                }
-            }
+        positionLayers << layers(renderPosition);
+        if (renderPosition != userTools && !positionLayers.last().isEmpty() && !m_dirtyRenderPositions.contains(renderPosition)) {
+            allDirty = false;
         }
+    }
 
-        // collect all internal LayerInterfaces of current renderPosition
-        for (auto layer : d->m_internalLayers) {
-            if (layer && layer->renderPosition().contains(renderPosition)) {
-                layers.push_back(layer);
-            }
+    const qreal devicePixelRatio = painter->device()->devicePixelRatioF();
+    if (m_backBufferSize != viewport->size() || m_backBufferDevicePixelRatio != devicePixelRatio) {
+        m_backBuffers.clear();
+        m_backBufferSize = viewport->size();
+        m_backBufferDevicePixelRatio = devicePixelRatio;
+        allDirty = true;
+    }
+
+    // Buffering would only add the cost of composing, e.g. while the view moves
+    if (allDirty || !painter->worldTransform().isIdentity()) {
+        m_backBuffers.clear();
+        for (int i = 0; i < renderPositions.size(); ++i) {
+            renderLayers(painter, viewport, renderPositions.at(i), positionLayers.at(i), traceList);
+        }
+        return;
+    }
+
+    int reused = 0;
+    for (int i = 0; i < renderPositions.size(); ++i) {
+        const QString &renderPosition = renderPositions.at(i);
+        const QList<LayerInterface *> &layers = positionLayers.at(i);
+        if (renderPosition == userTools || layers.isEmpty()) {
+            m_backBuffers.remove(renderPosition);
+            renderLayers(painter, viewport, renderPosition, layers, traceList);
+            continue;
+        }
+
+        if (m_dirtyRenderPositions.contains(renderPosition)) {
+            // Changed completely, a back buffer would only add the cost of composing
+            m_backBuffers.remove(renderPosition);
+            renderLayers(painter, viewport, renderPosition, layers, traceList);
+            continue;
         }
 
-        // sort them according to their zValue()s
-        std::sort(layers.begin(), layers.end(), [](const LayerInterface *const one, const LayerInterface *const two) -> bool {
-            Q_ASSERT(one && two);
-            return one->zValue() < two->zValue();
-        });
-
-        // render the layers of the current renderPosition
-        QElapsedTimer timer;
-        for (auto layer : layers) {
-            timer.start();
-            layer->render(painter, viewport, renderPosition, nullptr);
-            d->m_renderState.addChild(layer->renderState());
-            traceList.append(QStringLiteral("%2 ms %3").arg(timer.elapsed(), 3).arg(layer->runtimeTrace()));
+        // Buffers are only kept for render positions that get reused or repainted in parts
+        QImage &buffer = m_backBuffers[renderPosition];
+        QRegion dirtyRegion;
+        if (buffer.isNull()) {
+            buffer = QImage(m_backBufferSize * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+            buffer.setDevicePixelRatio(devicePixelRatio);
+            dirtyRegion = QRect(QPoint(0, 0), m_backBufferSize);
+        } else {
+            dirtyRegion = m_dirtyRegions.value(renderPosition);
         }
+
+        if (dirtyRegion.isEmpty()) {
+            ++reused;
+        } else {
+            {
+                QPainter clearPainter(&buffer);
+                clearPainter.setCompositionMode(QPainter::CompositionMode_Source);
+                clearPainter.setClipRegion(dirtyRegion);
+                clearPainter.fillRect(QRect(QPoint(0, 0), m_backBufferSize), Qt::transparent);
+            }
+            {
+                GeoPainter bufferPainter(&buffer, viewport, painter->mapQuality());
+                bufferPainter.setDebugPolygonsLevel(painter->debugPolygonsLevel());
+                bufferPainter.setDebugBatchRender(painter->debugBatchRender());
+                bufferPainter.setClipRegion(dirtyRegion);
+                renderLayers(&bufferPainter, viewport, renderPosition, layers, traceList);
+            }
+        }
+
+        painter->drawImage(QPoint(0, 0), buffer);
+    }
+
+    if (m_renderProfiler && m_renderProfiler->isEnabled()) {
+        m_renderProfiler->addCounter(QStringLiteral("Back buffers reused"), reused);
     }
+}
+
+void LayerManager::Private::renderRuntimeTrace(GeoPainter *painter, QStringList traceList, qint64 totalElapsed) const
+{
+    const int fps = 1000.0 / totalElapsed;
+    traceList.append(QStringLiteral("Total: %1 ms (%2 fps)").arg(totalElapsed, 3).arg(fps));
+
+    painter->save();
+    painter->setBackgroundMode(Qt::OpaqueMode);
+    painter->setBackground(Qt::gray);
+    painter->setFont(QFont(QStringLiteral("Sans Serif"), 10, QFont::Bold));
+
+    int i = 0;
+    int const top = 150;
+    int const lineHeight = painter->fontMetrics().height();
+    for (const auto &text : traceList) {
+        painter->setPen(Qt::black);
+        painter->drawText(QPoint(10, top + 1 + lineHeight * i), text);
+        painter->setPen(Qt::white);
+        painter->drawText(QPoint(9, top + lineHeight * i), text);
+        ++i;
+    }
+    painter->restore();
+}
+
+void LayerManager::renderLayers(GeoPainter *painter, ViewportParams *viewport)
+{
+    if (!d->m_backBuffersEnabled) {
+        renderLayers(painter, viewport, renderPositions());
+        return;
+    }
+
+    QElapsedTimer totalTime;
+    totalTime.start();
+
+    QStringList traceList;
+    d->renderBuffered(painter, viewport, traceList);
 
     if (d->m_showRuntimeTrace) {
-        const int totalElapsed = totalTime.elapsed();
-        const int fps = 1000.0 / totalElapsed;
-        traceList.append(QStringLiteral("Total: %1 ms (%2 fps)").arg(totalElapsed, 3).arg(fps));
-
-        painter->save();
-        painter->setBackgroundMode(Qt::OpaqueMode);
-        painter->setBackground(Qt::gray);
-        painter->setFont(QFont(QStringLiteral("Sans Serif"), 10, QFont::Bold));
-
-        int i = 0;
-        int const top = 150;
-        int const lineHeight = painter->fontMetrics().height();
-        for (const auto &text : traceList) {
-            painter->setPen(Qt::black);
-            painter->drawText(QPoint(10, top + 1 + lineHeight * i), text);
-            painter->setPen(Qt::white);
-            painter->drawText(QPoint(9, top + lineHeight * i), text);
-            ++i;
+        d->renderRuntimeTrace(painter, traceList, totalTime.elapsed());
+    }
+}
+
+void LayerManager::renderLayers(GeoPainter *painter, ViewportParams *viewport, const QStringList &positions)
+{
+    QElapsedTimer totalTime;
+    totalTime.start();
+
+    QStringList traceList;
+    for (const auto &renderPosition : renderPositions()) {
+        if (positions.contains(renderPosition)) {
+            // The back buffer misses what gets rendered here
+            d->m_backBuffers.remove(renderPosition);
+            d->renderLayers(painter, viewport, renderPosition, d->layers(renderPosition), traceList);
         }
-        painter->restore();
+    }
+
+    // The trace goes on top of everything, i.e. it is drawn along with the last render position
+    if (d->m_showRuntimeTrace && positions.contains(Private::allRenderPositions().last())) {
+        d->renderRuntimeTrace(painter, traceList, totalTime.elapsed());
     }
 }
 
 void LayerManager::setShowBackground(bool show)
 {
-    d->m_showBackground = show;
+    if (show != d->m_showBackground) {
+        d->m_showBackground = show;
+        setDirty();
+    }
 }
 
 void LayerManager::setShowRuntimeTrace(bool show)
@@ -202,12 +408,15 @@ void LayerManager::addLayer(LayerInterface *layer)
 {
     if (!d->m_internalLayers.contains(layer)) {
         d->m_internalLayers.push_back(layer);
+        setDirty(layer->renderPosition());
     }
 }
 
 void LayerManager::removeLayer(LayerInterface *layer)
 {
-    d->m_internalLayers.removeAll(layer);
+    if (d->m_internalLayers.removeAll(layer) > 0) {
+        setDirty(layer->renderPosition());
+    }
 }
 
 QList<LayerInterface *> LayerManager::internalLayers() const
@@ -217,7 +426,67 @@ QList<LayerInterface *> LayerManager::internalLayers() const
 
 RenderState LayerManager::renderState() const
 {
-    return d->m_renderState;
+    RenderState renderState(QStringLiteral("Marble"));
+    for (const auto &renderPosition : renderPositions()) {
+        for (const RenderState &layerState : d->m_layerStates.value(renderPosition)) {
+            renderState.addChild(layerState);
+        }
+    }
+    return renderState;
+}
+
+void LayerManager::setDirty(const QStringList &renderPositions, const QRegion &dirtyRegion)
+{
+    const QStringList positions = renderPositions.isEmpty() ? Private::allRenderPositions() : renderPositions;
+    for (const auto &renderPosition : positions) {
+        if (dirtyRegion.isEmpty()) {
+            d->m_dirtyRenderPositions.insert(renderPosition);
+            d->m_dirtyRegions.remove(renderPosition);
+        } else if (!d->m_dirtyRenderPositions.contains(renderPosition)) {
+            d->m_dirtyRegions[renderPosition] += dirtyRegion;
+        }
+    }
+}
+
+QStringList LayerManager::dirtyRenderPositions() const
+{
+    QStringList result;
+    for (const auto &renderPosition : renderPositions()) {
+        if (d->m_dirtyRenderPositions.contains(renderPosition) || d->m_dirtyRegions.contains(renderPosition)) {
+            result << renderPosition;
+        }
+    }
+    return result;
+}
+
+QRegion LayerManager::dirtyRegion(const QRect &viewportRect) const
+{
+    QRegion result;
+    for (const auto &renderPosition : renderPositions()) {
+        if (d->m_dirtyRenderPositions.contains(renderPosition)) {
+            return viewportRect;
+        }
+        result += d->m_dirtyRegions.value(renderPosition);
+    }
+    return result & viewportRect;
+}
+
+void LayerManager::setBackBuffersEnabled(bool enabled)
+{
+    d->m_backBuffersEnabled = enabled;
+    if (!enabled) {
+        d->m_backBuffers.clear();
+    }
+}
+
+bool LayerManager::backBuffersEnabled() const
+{
+    return d->m_backBuffersEnabled;
+}
+
+void LayerManager::setRenderProfiler(RenderProfiler *profiler)
+{
+    d->m_renderProfiler = profiler;
 }
 
 }
@@ -11,6 +11,7 @@
 #include <QList>
 #include <QObject>
 #include <QRegion>
+#include <QStringList>
 
 class QPoint;
 class QString;
@@ -23,6 +24,7 @@ class AbstractDataPluginItem;
 class GeoPainter;
 class ViewportParams;
 class RenderPlugin;
+class RenderProfiler;
 class RenderState;
 class LayerInterface;
 
@@ -41,6 +43,53 @@ public:
 
     void renderLayers(GeoPainter *painter, ViewportParams *viewport);
 
+    /**
+     * @brief Renders the layers at the given render positions only.
+     *
+     * The render state of the layers at the other render positions is kept
+     * from the last time they were rendered. This allows to cache the result
+     * for groups of render positions and to render them again only once they
+     * are dirty.
+     */
+    void renderLayers(GeoPainter *painter, ViewportParams *viewport, const QStringList &renderPositions);
+
+    /**
+     * @brief Returns the render positions in the order they are rendered in.
+     */
+    QStringList renderPositions() const;
+
+    /**
+     * @brief Marks the layers at @p renderPositions as changed, all layers if it is empty.
+     * @param dirtyRegion the region the layers changed in, or an empty region
+     *        if they changed everywhere
+     */
+    void setDirty(const QStringList &renderPositions = QStringList(), const QRegion &dirtyRegion = QRegion());
+
+    /**
+     * @brief Returns the render positions whose layers changed since they were rendered last.
+     */
+    QStringList dirtyRenderPositions() const;
+
+    /**
+     * @brief Returns the region of @p viewportRect the layers changed in since they were rendered last.
+     */
+    QRegion dirtyRegion(const QRect &viewportRect) const;
+
+    /**
+     * @brief Keeps the layers of each render position in a back buffer.
+     *
+     * renderLayers() then renders only the dirty parts of the render positions
+     * into their back buffers and composes the back buffers, unless all render
+     * positions are dirty anyway. Render positions that changed completely are
+     * rendered directly. Each of the others costs an ARGB32 image of the size
+     * of the viewport, about 8 MiB for 1920x1080. Disabled by default.
+     *
+     * Only enable this if all changes of the layers are reported through
+     * setDirty(), otherwise outdated back buffers get composed.
+     */
+    void setBackBuffersEnabled(bool enabled);
+    bool backBuffersEnabled() const;
+
     bool showBackground() const;
 
     bool showRuntimeTrace() const;
@@ -72,6 +121,12 @@ public:
 
     RenderState renderState() const;
 
+    /**
+     * @brief Set the profiler to record the time spent in each layer to.
+     * @note LayerManager doesn't take ownership of @p profiler.
+     */
+    void setRenderProfiler(RenderProfiler *profiler);
+
 Q_SIGNALS:
     /**
      * @brief Signal that a render item has been initialized
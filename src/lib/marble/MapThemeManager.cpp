@@ -8,11 +8,17 @@
 #include "MapThemeManager.h"
 
 // Qt
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
+#include <QHash>
+#include <QImage>
+#include <QSaveFile>
 #include <QScopedPointer>
+#include <QSet>
 
 // Local dir
 #include "GeoDataPhotoOverlay.h"
@@ -37,6 +43,8 @@ namespace
 {
 static const QString mapDirName = QStringLiteral("maps");
 static const int columnRelativePath = 1;
+static const quint32 catalogMagic = 0x4d544331; // "MTC1"
+static const quint32 catalogVersion = 1;
 }
 
 namespace Marble
@@ -45,6 +53,23 @@ namespace Marble
 class Q_DECL_HIDDEN MapThemeManager::Private
 {
 public:
+    /**
+     * @brief What the theme list shows about a map theme.
+     *
+     * Entries are kept in a catalog that persists across sessions, so that
+     * only map themes whose .dgml file changed need to be parsed on startup.
+     */
+    struct CatalogEntry {
+        QString dgmlPath;
+        qint64 lastModified = 0;
+        bool visible = false;
+        QString name;
+        QString description;
+        QString iconPath;
+        qint64 iconLastModified = 0;
+        QImage icon;
+    };
+
     Private(MapThemeManager *parent);
     ~Private();
 
@@ -82,7 +107,17 @@ public:
     /**
      * @brief Helper method for updateMapThemeModel().
      */
-    static QList<QStandardItem *> createMapThemeRow(const QString &mapThemeID);
+    QList<QStandardItem *> createMapThemeRow(const QString &mapThemeID);
+
+    /**
+     * @brief Returns the catalog entry of the given map theme, parsing its
+     *        .dgml file only if the cached entry is missing or outdated.
+     */
+    const CatalogEntry *catalogEntry(const QString &mapThemeId);
+
+    static QString catalogPath();
+    void readCatalog();
+    void writeCatalog();
 
     /**
      * @brief Deletes any directory with its contents.
@@ -96,6 +131,9 @@ public:
     QStandardItemModel m_celestialList;
     QFileSystemWatcher m_fileSystemWatcher;
     bool m_isInitialized;
+    QHash<QString, CatalogEntry> m_catalog;
+    bool m_catalogRead;
+    bool m_catalogChanged;
 
 private:
     /**
@@ -111,6 +149,8 @@ MapThemeManager::Private::Private(MapThemeManager *parent)
     , m_celestialList()
     , m_fileSystemWatcher()
     , m_isInitialized(false)
+    , m_catalogRead(false)
+    , m_catalogChanged(false)
 {
 }
 
@@ -323,35 +363,20 @@ QList<QStandardItem *> MapThemeManager::Private::createMapThemeRow(QString const
 {
     QList<QStandardItem *> itemList;
 
-    QScopedPointer<GeoSceneDocument> mapTheme(loadMapThemeFile(mapThemeID));
-    if (!mapTheme || !mapTheme->head()->visible()) {
+    const CatalogEntry *entry = catalogEntry(mapThemeID);
+    if (!entry || !entry->visible) {
         return itemList;
     }
 
-    QPixmap themeIconPixmap;
-
-    QString relativePath = mapDirName + QLatin1Char('/') + mapTheme->head()->target() + QLatin1Char('/') + mapTheme->head()->theme() + QLatin1Char('/')
-        + mapTheme->head()->icon()->pixmap();
-    themeIconPixmap.load(MarbleDirs::path(relativePath));
-
+    QPixmap themeIconPixmap = QPixmap::fromImage(entry->icon);
     if (themeIconPixmap.isNull()) {
-        relativePath = QStringLiteral("svg/application-x-marble-gray.png");
-        themeIconPixmap.load(MarbleDirs::path(relativePath));
-    } else {
-        // Make sure we don't keep excessively large previews in memory
-        // TODO: Scale the icon down to the default icon size in MarbleSelectView.
-        //       For now maxIconSize already equals what's expected by the listview.
-        QSize maxIconSize(136, 136);
-        if (themeIconPixmap.size() != maxIconSize) {
-            mDebug() << "Smooth scaling theme icon";
-            themeIconPixmap = themeIconPixmap.scaled(maxIconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        }
+        themeIconPixmap.load(MarbleDirs::path(QStringLiteral("svg/application-x-marble-gray.png")));
     }
 
     QIcon mapThemeIcon = QIcon(themeIconPixmap);
 
-    QString name = mapTheme->head()->name();
-    const QString translatedDescription = QCoreApplication::translate("DGML", mapTheme->head()->description().toUtf8().constData());
+    QString name = entry->name;
+    const QString translatedDescription = QCoreApplication::translate("DGML", entry->description.toUtf8().constData());
     const QString toolTip = QLatin1StringView("<span style=\" max-width: 150 px;\"> ") + translatedDescription + QLatin1StringView(" </span>");
 
     auto item = new QStandardItem(name);
@@ -366,6 +391,124 @@ QList<QStandardItem *> MapThemeManager::Private::createMapThemeRow(QString const
     return itemList;
 }
 
+const MapThemeManager::Private::CatalogEntry *MapThemeManager::Private::catalogEntry(const QString &mapThemeId)
+{
+    readCatalog();
+
+    const QFileInfo dgmlFile(MarbleDirs::path(mapDirName + QLatin1Char('/') + mapThemeId));
+    const qint64 lastModified = dgmlFile.lastModified().toMSecsSinceEpoch();
+
+    auto it = m_catalog.constFind(mapThemeId);
+    if (it != m_catalog.constEnd() && it->dgmlPath == dgmlFile.absoluteFilePath() && it->lastModified == lastModified
+        && (it->iconPath.isEmpty() || QFileInfo(it->iconPath).lastModified().toMSecsSinceEpoch() == it->iconLastModified)) {
+        return &it.value();
+    }
+
+    QScopedPointer<GeoSceneDocument> mapTheme(loadMapThemeFile(mapThemeId));
+    if (!mapTheme) {
+        if (m_catalog.remove(mapThemeId)) {
+            m_catalogChanged = true;
+        }
+        return nullptr;
+    }
+
+    CatalogEntry entry;
+    entry.dgmlPath = dgmlFile.absoluteFilePath();
+    entry.lastModified = lastModified;
+    entry.visible = mapTheme->head()->visible();
+    entry.name = mapTheme->head()->name();
+    entry.description = mapTheme->head()->description();
+
+    const QString relativePath = mapDirName + QLatin1Char('/') + mapTheme->head()->target() + QLatin1Char('/') + mapTheme->head()->theme() + QLatin1Char('/')
+        + mapTheme->head()->icon()->pixmap();
+    const QFileInfo iconFile(MarbleDirs::path(relativePath));
+    if (entry.visible && entry.icon.load(iconFile.absoluteFilePath())) {
+        entry.iconPath = iconFile.absoluteFilePath();
+        entry.iconLastModified = iconFile.lastModified().toMSecsSinceEpoch();
+        // Make sure we don't keep excessively large previews in memory
+        // TODO: Scale the icon down to the default icon size in MarbleSelectView.
+        //       For now maxIconSize already equals what's expected by the listview.
+        QSize maxIconSize(136, 136);
+        if (entry.icon.size() != maxIconSize) {
+            mDebug() << "Smooth scaling theme icon";
+            entry.icon = entry.icon.scaled(maxIconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+    }
+
+    m_catalogChanged = true;
+    return &m_catalog.insert(mapThemeId, entry).value();
+}
+
+QString MapThemeManager::Private::catalogPath()
+{
+    return MarbleDirs::cachePath() + QLatin1StringView("/mapthemes.cache");
+}
+
+void MapThemeManager::Private::readCatalog()
+{
+    if (m_catalogRead) {
+        return;
+    }
+    m_catalogRead = true;
+
+    QFile file(catalogPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic;
+    quint32 version;
+    stream >> magic >> version;
+    if (magic != catalogMagic || version != catalogVersion) {
+        mDebug() << "Ignoring map theme catalog of unknown format:" << file.fileName();
+        return;
+    }
+
+    quint32 size;
+    stream >> size;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        QString mapThemeId;
+        CatalogEntry entry;
+        stream >> mapThemeId >> entry.dgmlPath >> entry.lastModified >> entry.visible >> entry.name >> entry.description >> entry.iconPath
+            >> entry.iconLastModified >> entry.icon;
+        m_catalog.insert(mapThemeId, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        mDebug() << "Ignoring corrupt map theme catalog:" << file.fileName();
+        m_catalog.clear();
+    }
+}
+
+void MapThemeManager::Private::writeCatalog()
+{
+    if (!m_catalogChanged) {
+        return;
+    }
+
+    QDir().mkpath(MarbleDirs::cachePath());
+    QSaveFile file(catalogPath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        mDebug() << "Unable to write map theme catalog:" << file.fileName();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << catalogMagic << catalogVersion << quint32(m_catalog.size());
+    for (auto it = m_catalog.constBegin(), end = m_catalog.constEnd(); it != end; ++it) {
+        const CatalogEntry &entry = it.value();
+        stream << it.key() << entry.dgmlPath << entry.lastModified << entry.visible << entry.name << entry.description << entry.iconPath
+               << entry.iconLastModified << entry.icon;
+    }
+
+    if (file.commit()) {
+        m_catalogChanged = false;
+    }
+}
+
 void MapThemeManager::Private::updateMapThemeModel()
 {
     mDebug();
@@ -385,6 +528,13 @@ void MapThemeManager::Private::updateMapThemeModel()
         }
     }
 
+    // Forget about map themes that are gone
+    const QSet<QString> mapThemeIds(stringlist.constBegin(), stringlist.constEnd());
+    m_catalogChanged |= m_catalog.removeIf([&mapThemeIds](const QHash<QString, CatalogEntry>::iterator &entry) {
+        return !mapThemeIds.contains(entry.key());
+    }) > 0;
+    writeCatalog();
+
     for (const QString &mapThemeId : std::as_const(stringlist)) {
         const QString celestialBodyId = mapThemeId.section(QLatin1Char('/'), 0, 0);
         QString celestialBodyName = PlanetFactory::localizedName(celestialBodyId);
@@ -445,6 +595,11 @@ void MapThemeManager::Private::fileChanged(const QString &path)
         }
     }
 
+    // The modification time might not have changed within its resolution
+    if (m_catalog.remove(mapThemeId)) {
+        m_catalogChanged = true;
+    }
+
     QFileInfo fileInfo(path);
     if (fileInfo.exists()) {
         QList<QStandardItem *> newMapThemeRow = createMapThemeRow(mapThemeId);
@@ -452,6 +607,7 @@ void MapThemeManager::Private::fileChanged(const QString &path)
             m_mapThemeModel.insertRow(insertAtRow, newMapThemeRow);
         }
     }
+    writeCatalog();
 
     Q_EMIT q->themesChanged();
 }
@@ -40,6 +40,7 @@
 #include "GeoSceneVector.h"
 #include "GeoSceneVectorTileDataset.h"
 #include "GeoSceneZoom.h"
+#include "HttpDownloadManager.h"
 #include "LayerManager.h"
 #include "MapThemeManager.h"
 #include "MarbleDebug.h"
@@ -47,6 +48,7 @@
 #include "MarbleModel.h"
 #include "PluginManager.h"
 #include "RenderPlugin.h"
+#include "RenderProfiler.h"
 #include "RenderState.h"
 #include "StyleBuilder.h"
 #include "SunLocator.h"
@@ -128,8 +130,20 @@ public:
 
     void updateTileLevel();
 
+    void updateDownloadViewport();
+
+    void recordFrameCounters();
+
     void addPlugins();
 
+    /**
+     * Marks the layers at @p renderPositions as dirty, all layers if it is
+     * empty, and requests a repaint.
+     */
+    void requestRepaint(const QStringList &renderPositions = QStringList(), const QRegion &dirtyRegion = QRegion());
+
+    void paint(GeoPainter &painter, const QStringList &renderPositions);
+
     MarbleMap *const q;
 
     // The model we are showing.
@@ -161,6 +175,10 @@ public:
     bool m_isLockedToSubSolarPoint;
     bool m_isSubSolarPointIconVisible;
     RenderState m_renderState;
+
+    RenderProfiler m_renderProfiler;
+    quint64 m_profiledTileHits;
+    quint64 m_profiledTileMisses;
 };
 
 MarbleMapPrivate::MarbleMapPrivate(MarbleMap *parent, MarbleModel *model)
@@ -174,14 +192,17 @@ MarbleMapPrivate::MarbleMapPrivate(MarbleMap *parent, MarbleModel *model)
     , m_styleBuilder()
     , m_layerManager(parent)
     , m_customPaintLayer(parent)
-    , m_geometryLayer(model->treeModel(), &m_styleBuilder)
+    , m_geometryLayer(model->treeModel(), model->placemarkRegistry(), &m_styleBuilder)
     , m_floatItemsLayer(parent)
     , m_textureLayer(model->downloadManager(), model->pluginManager(), model->sunLocator(), model->groundOverlayModel())
-    , m_placemarkLayer(model->placemarkModel(), model->placemarkSelectionModel(), model->clock(), &m_styleBuilder)
+    , m_placemarkLayer(model->placemarkRegistry(), model->placemarkSelectionModel(), model->clock(), &m_styleBuilder)
     , m_vectorTileLayer(model->downloadManager(), model->pluginManager(), model->treeModel())
     , m_isLockedToSubSolarPoint(false)
     , m_isSubSolarPointIconVisible(false)
+    , m_profiledTileHits(0)
+    , m_profiledTileMisses(0)
 {
+    m_layerManager.setRenderProfiler(&m_renderProfiler);
     m_layerManager.addLayer(&m_floatItemsLayer);
     m_layerManager.addLayer(&m_fogLayer);
     m_layerManager.addLayer(&m_groundLayer);
@@ -194,14 +215,18 @@ MarbleMapPrivate::MarbleMapPrivate(MarbleMap *parent, MarbleModel *model)
     QObject::connect(m_model, SIGNAL(themeChanged(QString)), parent, SLOT(updateMapTheme()));
     QObject::connect(m_model->fileManager(), SIGNAL(fileAdded(QString)), parent, SLOT(setDocument(QString)));
 
-    QObject::connect(&m_placemarkLayer, SIGNAL(repaintNeeded()), parent, SIGNAL(repaintNeeded()));
+    QObject::connect(&m_placemarkLayer, &PlacemarkLayer::repaintNeeded, parent, [this]() {
+        requestRepaint(m_placemarkLayer.renderPosition());
+    });
 
     QObject::connect(&m_layerManager, SIGNAL(pluginSettingsChanged()), parent, SIGNAL(pluginSettingsChanged()));
     QObject::connect(&m_layerManager, SIGNAL(repaintNeeded(QRegion)), parent, SIGNAL(repaintNeeded(QRegion)));
     QObject::connect(&m_layerManager, SIGNAL(renderPluginInitialized(RenderPlugin *)), parent, SIGNAL(renderPluginInitialized(RenderPlugin *)));
     QObject::connect(&m_layerManager, SIGNAL(visibilityChanged(QString, bool)), parent, SLOT(setPropertyValue(QString, bool)));
 
-    QObject::connect(&m_geometryLayer, SIGNAL(repaintNeeded()), parent, SIGNAL(repaintNeeded()));
+    QObject::connect(&m_geometryLayer, &GeometryLayer::repaintNeeded, parent, [this]() {
+        requestRepaint(m_geometryLayer.renderPosition());
+    });
 
     /*
      * Slot handleHighlight finds all placemarks
@@ -217,7 +242,9 @@ MarbleMapPrivate::MarbleMapPrivate(MarbleMap *parent, MarbleModel *model)
                      &m_geometryLayer,
                      SLOT(handleHighlight(qreal, qreal, GeoDataCoordinates::Unit)));
 
-    QObject::connect(&m_floatItemsLayer, SIGNAL(repaintNeeded(QRegion)), parent, SIGNAL(repaintNeeded(QRegion)));
+    QObject::connect(&m_floatItemsLayer, &FloatItemsLayer::repaintNeeded, parent, [this](const QRegion &dirtyRegion) {
+        requestRepaint(m_floatItemsLayer.renderPosition(), dirtyRegion);
+    });
     QObject::connect(&m_floatItemsLayer, SIGNAL(renderPluginInitialized(RenderPlugin *)), parent, SIGNAL(renderPluginInitialized(RenderPlugin *)));
     QObject::connect(&m_floatItemsLayer, SIGNAL(visibilityChanged(QString, bool)), parent, SLOT(setPropertyValue(QString, bool)));
     QObject::connect(&m_floatItemsLayer, SIGNAL(pluginSettingsChanged()), parent, SIGNAL(pluginSettingsChanged()));
@@ -226,8 +253,13 @@ MarbleMapPrivate::MarbleMapPrivate(MarbleMap *parent, MarbleModel *model)
     QObject::connect(&m_vectorTileLayer, SIGNAL(tileLevelChanged(int)), parent, SLOT(updateTileLevel()));
     QObject::connect(parent, SIGNAL(radiusChanged(int)), parent, SLOT(updateTileLevel()));
 
-    QObject::connect(&m_textureLayer, SIGNAL(repaintNeeded()), parent, SIGNAL(repaintNeeded()));
-    QObject::connect(parent, SIGNAL(visibleLatLonAltBoxChanged(GeoDataLatLonAltBox)), parent, SIGNAL(repaintNeeded()));
+    QObject::connect(&m_textureLayer, &TextureLayer::repaintNeeded, parent, [this]() {
+        requestRepaint(m_textureLayer.renderPosition());
+    });
+    QObject::connect(parent, &MarbleMap::visibleLatLonAltBoxChanged, parent, [this]() {
+        requestRepaint();
+    });
+    QObject::connect(parent, SIGNAL(visibleLatLonAltBoxChanged(GeoDataLatLonAltBox)), parent, SLOT(updateDownloadViewport()));
 
     addPlugins();
     QObject::connect(model->pluginManager(), SIGNAL(renderPluginsChanged()), parent, SLOT(addPlugins()));
@@ -270,6 +302,9 @@ void MarbleMapPrivate::updateProperty(const QString &name, bool show)
             break;
         }
     }
+
+    // Map themes may tie properties to any layer, e.g. to the files shown by the geometry layer
+    requestRepaint();
 }
 
 void MarbleMapPrivate::addPlugins()
@@ -377,7 +412,7 @@ void MarbleMap::setViewContext(ViewContext viewContext)
         // Update texture map during the repaint that follows:
         d->m_textureLayer.setNeedsUpdate();
 
-        Q_EMIT repaintNeeded();
+        d->requestRepaint();
     }
 }
 
@@ -802,6 +837,13 @@ void MarbleMapPrivate::updateTileLevel()
     m_geometryLayer.setTileLevel(tileZoomLevel);
     m_placemarkLayer.setTileLevel(tileZoomLevel);
     Q_EMIT q->tileLevelChanged(tileZoomLevel);
+    updateDownloadViewport();
+}
+
+void MarbleMapPrivate::updateDownloadViewport()
+{
+    // Lets the download queues serve the tiles closest to the view first
+    m_model->downloadManager()->setViewport(q, m_viewport.viewLatLonAltBox(), q->tileZoomLevel());
 }
 
 // Used to be paintEvent()
@@ -809,42 +851,121 @@ void MarbleMap::paint(GeoPainter &painter, const QRect &dirtyRect)
 {
     Q_UNUSED(dirtyRect);
 
-    if (d->m_showDebugPolygons) {
-        if (viewContext() == Animation) {
+    d->paint(painter, d->m_layerManager.renderPositions());
+}
+
+void MarbleMap::paintLayers(GeoPainter &painter, const QStringList &renderPositions)
+{
+    d->paint(painter, renderPositions);
+}
+
+QStringList MarbleMap::renderPositions() const
+{
+    return d->m_layerManager.renderPositions();
+}
+
+QStringList MarbleMap::dirtyRenderPositions() const
+{
+    return d->m_layerManager.dirtyRenderPositions();
+}
+
+void MarbleMap::setLayersDirty(const QStringList &renderPositions, const QRegion &dirtyRegion)
+{
+    d->m_layerManager.setDirty(renderPositions, dirtyRegion);
+}
+
+QRegion MarbleMap::dirtyRegion() const
+{
+    return d->m_layerManager.dirtyRegion(QRect(0, 0, width(), height()));
+}
+
+void MarbleMap::setBackBuffersEnabled(bool enabled)
+{
+    d->m_layerManager.setBackBuffersEnabled(enabled);
+}
+
+bool MarbleMap::backBuffersEnabled() const
+{
+    return d->m_layerManager.backBuffersEnabled();
+}
+
+void MarbleMapPrivate::paint(GeoPainter &painter, const QStringList &renderPositions)
+{
+    if (m_showDebugPolygons) {
+        if (q->viewContext() == Animation) {
             painter.setDebugPolygonsLevel(1);
         } else {
             painter.setDebugPolygonsLevel(2);
         }
     }
-    painter.setDebugBatchRender(d->m_showDebugBatchRender);
+    painter.setDebugBatchRender(m_showDebugBatchRender);
 
-    if (!d->m_model->mapTheme()) {
+    if (!m_model->mapTheme()) {
         mDebug() << "No theme yet!";
-        d->m_marbleSplashLayer.render(&painter, &d->m_viewport);
+        if (renderPositions.contains(QStringLiteral("SURFACE"))) {
+            m_marbleSplashLayer.render(&painter, &m_viewport);
+        }
         return;
     }
 
     QElapsedTimer t;
     t.start();
 
-    RenderStatus const oldRenderStatus = d->m_renderState.status();
-    d->m_layerManager.renderLayers(&painter, &d->m_viewport);
-    d->m_renderState = d->m_layerManager.renderState();
-    bool const parsing = d->m_model->fileManager()->pendingFiles() > 0;
-    d->m_renderState.addChild(RenderState(QStringLiteral("Files"), parsing ? WaitingForData : Complete));
-    RenderStatus const newRenderStatus = d->m_renderState.status();
+    m_renderProfiler.beginFrame();
+    RenderStatus const oldRenderStatus = m_renderState.status();
+    if (renderPositions == m_layerManager.renderPositions()) {
+        // Composes the back buffers, if enabled
+        m_layerManager.renderLayers(&painter, &m_viewport);
+    } else {
+        m_layerManager.renderLayers(&painter, &m_viewport, renderPositions);
+    }
+    if (m_renderProfiler.isEnabled()) {
+        recordFrameCounters();
+    }
+    m_renderProfiler.endFrame();
+    m_renderState = m_layerManager.renderState();
+    bool const parsing = m_model->fileManager()->pendingFiles() > 0;
+    m_renderState.addChild(RenderState(QStringLiteral("Files"), parsing ? WaitingForData : Complete));
+    RenderStatus const newRenderStatus = m_renderState.status();
     if (oldRenderStatus != newRenderStatus) {
-        Q_EMIT renderStatusChanged(newRenderStatus);
+        Q_EMIT q->renderStatusChanged(newRenderStatus);
     }
-    Q_EMIT renderStateChanged(d->m_renderState);
+    Q_EMIT q->renderStateChanged(m_renderState);
 
-    if (d->m_showFrameRate) {
+    // The frame rate goes on top of everything
+    if (m_showFrameRate && renderPositions.contains(QStringLiteral("USER_TOOLS"))) {
         FpsLayer fpsPainter(&t);
         fpsPainter.paint(&painter);
     }
 
     const qreal fps = 1000.0 / (qreal)(t.elapsed());
-    Q_EMIT framesPerSecond(fps);
+    Q_EMIT q->framesPerSecond(fps);
+}
+
+void MarbleMapPrivate::requestRepaint(const QStringList &renderPositions, const QRegion &dirtyRegion)
+{
+    m_layerManager.setDirty(renderPositions, dirtyRegion);
+    Q_EMIT q->repaintNeeded(dirtyRegion);
+}
+
+void MarbleMapPrivate::recordFrameCounters()
+{
+    // The hit rate of the tiles requested during this frame
+    const quint64 hits = m_textureLayer.tileHitCount();
+    const quint64 misses = m_textureLayer.tileMissCount();
+    const quint64 frameHits = hits - m_profiledTileHits;
+    const quint64 frameMisses = misses - m_profiledTileMisses;
+    const quint64 requests = frameHits + frameMisses;
+    if (requests > 0) {
+        m_renderProfiler.addCounter(QStringLiteral("Tile cache hit rate (%)"), qint64(100 * frameHits / requests));
+    }
+    m_profiledTileHits = hits;
+    m_profiledTileMisses = misses;
+
+    m_renderProfiler.addCounter(QStringLiteral("Tiles loaded from disk"), qint64(frameMisses));
+    m_renderProfiler.addCounter(QStringLiteral("Pending downloads"), m_model->downloadManager()->pendingJobCount());
+    m_renderProfiler.addCounter(QStringLiteral("Placemarks considered"), m_placemarkLayer.consideredPlacemarkCount());
+    m_renderProfiler.addCounter(QStringLiteral("Placemarks drawn"), m_placemarkLayer.drawnPlacemarkCount());
 }
 
 void MarbleMap::customPaint(GeoPainter *painter)
@@ -1207,7 +1328,7 @@ void MarbleMap::setShowRuntimeTrace(bool visible)
 {
     if (visible != d->m_layerManager.showRuntimeTrace()) {
         d->m_layerManager.setShowRuntimeTrace(visible);
-        Q_EMIT repaintNeeded();
+        d->requestRepaint();
     }
 }
 
@@ -1216,11 +1337,16 @@ bool MarbleMap::showRuntimeTrace() const
     return d->m_layerManager.showRuntimeTrace();
 }
 
+RenderProfiler *MarbleMap::renderProfiler() const
+{
+    return &d->m_renderProfiler;
+}
+
 void MarbleMap::setShowDebugPolygons(bool visible)
 {
     if (visible != d->m_showDebugPolygons) {
         d->m_showDebugPolygons = visible;
-        Q_EMIT repaintNeeded();
+        d->requestRepaint();
     }
 }
 
@@ -1234,7 +1360,7 @@ void MarbleMap::setShowDebugBatchRender(bool visible)
     qDebug() << visible;
     if (visible != d->m_showDebugBatchRender) {
         d->m_showDebugBatchRender = visible;
-        Q_EMIT repaintNeeded();
+        d->requestRepaint();
     }
 }
 
@@ -1247,7 +1373,7 @@ void MarbleMap::setShowDebugPlacemarks(bool visible)
 {
     if (visible != d->m_placemarkLayer.isDebugModeEnabled()) {
         d->m_placemarkLayer.setDebugModeEnabled(visible);
-        Q_EMIT repaintNeeded();
+        d->requestRepaint();
     }
 }
 
@@ -1261,7 +1387,7 @@ void MarbleMap::setLevelTagDebugModeEnabled(bool visible)
     if (visible != d->m_geometryLayer.levelTagDebugModeEnabled()) {
         d->m_geometryLayer.setLevelTagDebugModeEnabled(visible);
         d->m_placemarkLayer.setLevelTagDebugModeEnabled(visible);
-        Q_EMIT repaintNeeded();
+        d->requestRepaint();
     }
 }
 
@@ -22,6 +22,7 @@
 // Qt
 #include <QObject>
 #include <QRegion>
+#include <QStringList>
 
 class QFont;
 class QString;
@@ -40,6 +41,7 @@ class ViewportParams;
 class GeoPainter;
 class LayerInterface;
 class RenderPlugin;
+class RenderProfiler;
 class RenderState;
 class AbstractDataPlugin;
 class AbstractDataPluginItem;
@@ -352,6 +354,12 @@ public:
      */
     bool showFrameRate() const;
 
+    /**
+     * @brief Returns the profiler recording the timings of the rendered frames.
+     * Recording is switched off initially, see RenderProfiler::setEnabled().
+     */
+    RenderProfiler *renderProfiler() const;
+
     bool showBackground() const;
 
     GeoDataRelation::RelationTypes visibleRelationTypes() const;
@@ -419,6 +427,57 @@ public:
 
     RenderState renderState() const;
 
+    /**
+     * @brief Paints the layers at @p renderPositions only.
+     *
+     * Allows to keep groups of render positions in separate images, which
+     * only need to be painted again once dirtyRenderPositions() contains
+     * one of their render positions. The images are composed in the order
+     * of renderPositions().
+     */
+    void paintLayers(GeoPainter &painter, const QStringList &renderPositions);
+
+    /**
+     * @brief Returns the render positions in the order they are painted in.
+     */
+    QStringList renderPositions() const;
+
+    /**
+     * @brief Returns the render positions whose layers changed since they were painted last.
+     */
+    QStringList dirtyRenderPositions() const;
+
+    /**
+     * @brief Marks the layers at @p renderPositions as changed, all layers if it is empty.
+     *
+     * Needed for layers whose changes are not reported through repaintNeeded().
+     * @param dirtyRegion the region the layers changed in, or an empty region
+     *        if they changed everywhere
+     */
+    void setLayersDirty(const QStringList &renderPositions = QStringList(), const QRegion &dirtyRegion = QRegion());
+
+    /**
+     * @brief Returns the region the layers changed in since they were painted last.
+     */
+    QRegion dirtyRegion() const;
+
+    /**
+     * @brief Keeps the layers of each render position in a back buffer.
+     *
+     * Repaints then only render the layers that changed, in the region they
+     * changed in, and compose the back buffers. Pays off for views that are
+     * repainted in parts, e.g. for ticking float items or a moving position
+     * marker. Each render position that is reused or repainted in parts costs
+     * an ARGB32 image of the size of the view. Disabled by default.
+     *
+     * Only enable this if all changes of layers added from outside are
+     * reported through setLayersDirty(), otherwise outdated back buffers get
+     * composed.
+     * @see dirtyRegion()
+     */
+    void setBackBuffersEnabled(bool enabled);
+    bool backBuffersEnabled() const;
+
     /**
      * @since 0.26.0
      */
@@ -734,6 +793,7 @@ Q_SIGNALS:
      * This signal is emitted when the repaint of the view was requested.
      * If available with the @p dirtyRegion which is the region the view will change in.
      * If dirtyRegion.isEmpty() returns true, the whole viewport has to be repainted.
+     * The layers that changed are marked in dirtyRenderPositions() before.
      */
     void repaintNeeded(const QRegion &dirtyRegion = QRegion());
 
@@ -784,6 +844,7 @@ private:
     Q_PRIVATE_SLOT(d, void updateProperty(const QString &, bool))
     Q_PRIVATE_SLOT(d, void setDocument(QString))
     Q_PRIVATE_SLOT(d, void updateTileLevel())
+    Q_PRIVATE_SLOT(d, void updateDownloadViewport())
     Q_PRIVATE_SLOT(d, void addPlugins())
 
 private:
@@ -55,6 +55,7 @@
 #include "MarbleClock.h"
 #include "MarbleDirs.h"
 #include "PlacemarkPositionProviderPlugin.h"
+#include "PlacemarkRegistry.h"
 #include "Planet.h"
 #include "PlanetFactory.h"
 #include "PluginManager.h"
@@ -86,6 +87,7 @@ public:
         , m_downloadManager(&m_storagePolicy)
         , m_storageWatcher(MarbleDirs::cachePath())
         , m_treeModel()
+        , m_placemarkRegistry(&m_treeModel)
         , m_descendantProxy()
         , m_placemarkProxyModel()
         , m_placemarkSelectionModel(nullptr)
@@ -148,6 +150,7 @@ public:
 
     // Places on the map
     GeoDataTreeModel m_treeModel;
+    PlacemarkRegistry m_placemarkRegistry;
     KDescendantsProxyModel m_descendantProxy;
     QSortFilterProxyModel m_placemarkProxyModel;
     QSortFilterProxyModel m_groundOverlayProxyModel;
@@ -477,6 +480,11 @@ const QAbstractItemModel *MarbleModel::placemarkModel() const
     return &d->m_placemarkProxyModel;
 }
 
+const PlacemarkRegistry *MarbleModel::placemarkRegistry() const
+{
+    return &d->m_placemarkRegistry;
+}
+
 QAbstractItemModel *MarbleModel::groundOverlayModel()
 {
     return &d->m_groundOverlayProxyModel;
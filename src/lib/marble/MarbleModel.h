@@ -37,6 +37,7 @@ namespace Marble
 class GeoDataPlacemark;
 class GeoPainter;
 class MeasureTool;
+class PlacemarkRegistry;
 class PositionTracking;
 class HttpDownloadManager;
 class MarbleModelPrivate;
@@ -110,6 +111,11 @@ public:
     QAbstractItemModel *placemarkModel();
     const QAbstractItemModel *placemarkModel() const;
 
+    /**
+     * @brief Return all placemarks and overlays of the tree model in flat lists
+     */
+    const PlacemarkRegistry *placemarkRegistry() const;
+
     QItemSelectionModel *placemarkSelectionModel();
 
     /**
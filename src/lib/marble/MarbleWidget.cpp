@@ -130,6 +130,11 @@ public:
      */
     void updateSystemBackgroundAttribute();
 
+    /**
+     * @brief Repaint the region of the widget the layers of the map changed in
+     */
+    void repaintDirtyRegion();
+
     MarbleWidget *const m_widget;
 
     MarbleModel m_model;
@@ -146,6 +151,9 @@ public:
     MarbleWidgetPopupMenu *m_popupmenu;
 
     bool m_showFrameRate;
+
+    // The region repaints were requested for since the last paint event, with the layers marked dirty
+    QRegion m_requestedRegion;
 };
 
 MarbleWidget::MarbleWidget(QWidget *parent)
@@ -187,6 +195,9 @@ void MarbleWidgetPrivate::construct()
     m_map.setSize(m_widget->width(), m_widget->height());
     m_map.setShowFrameRate(false); // never let the map draw the frame rate,
                                    // we do this differently here in the widget
+    // Repaints of parts of the map, e.g. of float items, need not render all layers.
+    // Costs an image of the size of the widget per render position that is reused.
+    m_map.setBackBuffersEnabled(true);
 
     m_widget->connect(&m_presenter, SIGNAL(regionSelected(GeoDataLatLonBox)), m_widget, SIGNAL(regionSelected(GeoDataLatLonBox)));
 
@@ -206,7 +217,9 @@ void MarbleWidgetPrivate::construct()
     // react to some signals of m_map
     m_widget->connect(&m_map, SIGNAL(themeChanged(QString)), m_widget, SLOT(updateMapTheme()));
     m_widget->connect(&m_map, SIGNAL(viewContextChanged(ViewContext)), m_widget, SIGNAL(viewContextChanged(ViewContext)));
-    m_widget->connect(&m_map, SIGNAL(repaintNeeded(QRegion)), m_widget, SLOT(update()));
+    QObject::connect(&m_map, &MarbleMap::repaintNeeded, m_widget, [this]() {
+        repaintDirtyRegion();
+    });
     m_widget->connect(&m_map, SIGNAL(visibleLatLonAltBoxChanged(GeoDataLatLonAltBox)), m_widget, SLOT(updateSystemBackgroundAttribute()));
     m_widget->connect(&m_map, SIGNAL(renderStatusChanged(RenderStatus)), m_widget, SIGNAL(renderStatusChanged(RenderStatus)));
     m_widget->connect(&m_map, SIGNAL(renderStateChanged(RenderState)), m_widget, SIGNAL(renderStateChanged(RenderState)));
@@ -225,11 +238,17 @@ void MarbleWidgetPrivate::construct()
 
     m_routingLayer = new RoutingLayer(m_widget, m_widget);
     m_routingLayer->setPlacemarkModel(nullptr);
-    QObject::connect(m_routingLayer, SIGNAL(repaintNeeded(QRect)), m_widget, SLOT(update()));
+    QObject::connect(m_routingLayer, &RoutingLayer::repaintNeeded, m_widget, [this](const QRect &rect) {
+        m_map.setLayersDirty(m_routingLayer->renderPosition(), rect);
+        repaintDirtyRegion();
+    });
 
     m_mapInfoDialog = new PopupLayer(m_widget, m_widget);
     m_mapInfoDialog->setVisible(false);
-    m_widget->connect(m_mapInfoDialog, SIGNAL(repaintNeeded()), m_widget, SLOT(update()));
+    QObject::connect(m_mapInfoDialog, &PopupLayer::repaintNeeded, m_widget, [this]() {
+        m_map.setLayersDirty(m_mapInfoDialog->renderPosition());
+        repaintDirtyRegion();
+    });
     m_map.addLayer(m_mapInfoDialog);
 
     setInputHandler();
@@ -244,6 +263,13 @@ void MarbleWidgetPrivate::construct()
     m_widget->setHighlightEnabled(true);
 }
 
+void MarbleWidgetPrivate::repaintDirtyRegion()
+{
+    const QRegion dirtyRegion = m_map.dirtyRegion();
+    m_requestedRegion += dirtyRegion;
+    m_widget->update(dirtyRegion);
+}
+
 void MarbleWidgetPrivate::setInputHandler()
 {
     setInputHandler(new MarbleWidgetInputHandler(&m_presenter, m_widget));
@@ -363,6 +389,12 @@ void MarbleWidget::removeLayer(LayerInterface *layer)
     d->m_map.removeLayer(layer);
 }
 
+void MarbleWidget::repaintLayers(const QStringList &renderPositions)
+{
+    d->m_map.setLayersDirty(renderPositions);
+    d->repaintDirtyRegion();
+}
+
 Marble::TextureLayer *MarbleWidget::textureLayer() const
 {
     return d->m_map.textureLayer();
@@ -688,6 +720,13 @@ void MarbleWidget::paintEvent(QPaintEvent *evt)
     QElapsedTimer t;
     t.start();
 
+    // Other parts are painted because of update() calls elsewhere or because they got
+    // exposed. The layers there may have changed without telling, so render all of them.
+    if (!(evt->region() - d->m_requestedRegion).isEmpty()) {
+        d->m_map.setLayersDirty();
+    }
+    d->m_requestedRegion = QRegion();
+
     QPaintDevice *paintDevice = this;
     QImage image;
     if (!isEnabled()) {
@@ -767,7 +806,8 @@ void MarbleWidgetPrivate::updateMapTheme()
     // Now we want a full repaint as the atmosphere might differ
     m_widget->setAttribute(Qt::WA_NoSystemBackground, false);
 
-    m_widget->update();
+    m_map.setLayersDirty();
+    repaintDirtyRegion();
 }
 
 GeoSceneDocument *MarbleWidget::mapTheme() const
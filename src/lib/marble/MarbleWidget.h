@@ -238,6 +238,15 @@ public:
      */
     void removeLayer(LayerInterface *layer);
 
+    /**
+     * @brief Repaints the layers at @p renderPositions, all layers if it is empty.
+     *
+     * The widget keeps the layers of each render position in a back buffer.
+     * Use this instead of update() for changes of layers that are not reported
+     * through repaintNeeded() of the layer.
+     */
+    void repaintLayers(const QStringList &renderPositions = QStringList());
+
     RoutingLayer *routingLayer();
 
     PopupLayer *popupLayer();
@@ -10,6 +10,7 @@
 
 // posix
 #include <cmath>
+#include <cstring>
 
 // Qt
 #include <QRunnable>
@@ -26,10 +27,26 @@
 
 using namespace Marble;
 
+// Keeps a longitude within [-M_PI, M_PI]
+static qreal normalizedLon(qreal lon)
+{
+    while (lon < -M_PI)
+        lon += 2 * M_PI;
+    while (lon > M_PI)
+        lon -= 2 * M_PI;
+    return lon;
+}
+
 class MercatorScanlineTextureMapper::RenderJob : public QRunnable
 {
 public:
-    RenderJob(StackedTileLoader *tileLoader, int tileLevel, QImage *canvasImage, const ViewportParams *viewport, MapQuality mapQuality, int yTop, int yBottom);
+    RenderJob(StackedTileLoader *tileLoader,
+              int tileLevel,
+              QImage *canvasImage,
+              const ViewportParams *viewportParams,
+              MapQuality mapQuality,
+              qreal leftLon,
+              ScanlineRowScheduler *rowScheduler);
 
     void run() override;
 
@@ -39,8 +56,8 @@ private:
     QImage *const m_canvasImage;
     const ViewportParams *const m_viewport;
     const MapQuality m_mapQuality;
-    const int m_yPaintedTop;
-    const int m_yPaintedBottom;
+    const qreal m_leftLon;
+    ScanlineRowScheduler *const m_rowScheduler;
 };
 
 MercatorScanlineTextureMapper::RenderJob::RenderJob(StackedTileLoader *tileLoader,
@@ -48,15 +65,15 @@ MercatorScanlineTextureMapper::RenderJob::RenderJob(StackedTileLoader *tileLoade
                                                     QImage *canvasImage,
                                                     const ViewportParams *viewport,
                                                     MapQuality mapQuality,
-                                                    int yTop,
-                                                    int yBottom)
+                                                    qreal leftLon,
+                                                    ScanlineRowScheduler *rowScheduler)
     : m_tileLoader(tileLoader)
     , m_tileLevel(tileLevel)
     , m_canvasImage(canvasImage)
     , m_viewport(viewport)
     , m_mapQuality(mapQuality)
-    , m_yPaintedTop(yTop)
-    , m_yPaintedBottom(yBottom)
+    , m_leftLon(leftLon)
+    , m_rowScheduler(rowScheduler)
 {
 }
 
@@ -64,7 +81,11 @@ MercatorScanlineTextureMapper::MercatorScanlineTextureMapper(StackedTileLoader *
     : TextureMapperInterface()
     , m_tileLoader(tileLoader)
     , m_radius(0)
-    , m_oldYPaintedTop(0)
+    , m_centerChanged(false)
+    , m_tileLevel(-1)
+    , m_mapQuality(NormalQuality)
+    , m_leftLon(0.0)
+    , m_yCenterOffset(0)
 {
 }
 
@@ -89,20 +110,76 @@ void MercatorScanlineTextureMapper::mapTexture(GeoPainter *painter,
         m_repaintNeeded = true;
     }
 
-    if (m_repaintNeeded) {
-        mapTexture(viewport, tileZoomLevel, painter->mapQuality());
+    if (m_repaintNeeded || m_centerChanged) {
+        // The colorizer rewrites the whole canvas anyway, so it is mapped from scratch
+        if (m_repaintNeeded || texColorizer || !scrollTexture(viewport, tileZoomLevel, painter->mapQuality())) {
+            mapTexture(viewport, tileZoomLevel, painter->mapQuality());
+        }
 
         if (texColorizer) {
             texColorizer->colorize(&m_canvasImage, viewport, painter->mapQuality());
+            // A colorized canvas cannot be scrolled
+            m_tileLevel = -1;
         }
 
         m_repaintNeeded = false;
+        m_centerChanged = false;
     }
 
     painter->drawImage(dirtyRect, m_canvasImage, dirtyRect);
 }
 
+void MercatorScanlineTextureMapper::setCenterChanged()
+{
+    m_centerChanged = true;
+}
+
 void MercatorScanlineTextureMapper::mapTexture(const ViewportParams *viewport, int tileZoomLevel, MapQuality mapQuality)
+{
+    const qint64 radius = viewport->radius();
+    const float rad2Pixel = (float)(2 * radius) / M_PI;
+    const qreal pixel2Rad = 1.0 / rad2Pixel;
+
+    m_tileLevel = tileZoomLevel;
+    m_mapQuality = mapQuality;
+    m_leftLon = normalizedLon(viewport->centerLongitude() - (m_canvasImage.width() / 2 * pixel2Rad));
+    m_yCenterOffset = (int)(asinh(tan(viewport->centerLatitude())) * rad2Pixel);
+
+    mapAreas(viewport, QList<QRect>() << m_canvasImage.rect());
+}
+
+bool MercatorScanlineTextureMapper::scrollTexture(const ViewportParams *viewport, int tileZoomLevel, MapQuality mapQuality)
+{
+    if (tileZoomLevel != m_tileLevel || mapQuality != m_mapQuality) {
+        return false;
+    }
+
+    const qint64 radius = viewport->radius();
+    const float rad2Pixel = (float)(2 * radius) / M_PI;
+    const qreal pixel2Rad = 1.0 / rad2Pixel;
+
+    // Rows are mapped relative to a whole pixel offset already, columns get
+    // snapped to the pixel grid of the canvas by keeping its left longitude
+    const int yCenterOffset = (int)(asinh(tan(viewport->centerLatitude())) * rad2Pixel);
+    const qreal leftLon = normalizedLon(viewport->centerLongitude() - (m_canvasImage.width() / 2 * pixel2Rad));
+    const int dx = qRound(normalizedLon(m_leftLon - leftLon) / pixel2Rad);
+    const int dy = yCenterOffset - m_yCenterOffset;
+
+    if (qAbs(dx) >= m_canvasImage.width() || qAbs(dy) >= m_canvasImage.height()) {
+        return false;
+    }
+
+    m_leftLon = normalizedLon(m_leftLon - dx * pixel2Rad);
+    m_yCenterOffset = yCenterOffset;
+
+    if (dx != 0 || dy != 0) {
+        mapAreas(viewport, ScanlineTextureMapperContext::scrollCanvasImage(&m_canvasImage, dx, dy));
+    }
+
+    return true;
+}
+
+void MercatorScanlineTextureMapper::mapAreas(const ViewportParams *viewport, const QList<QRect> &areas)
 {
     // Reset backend
     m_tileLoader->resetTilehash();
@@ -120,37 +197,33 @@ void MercatorScanlineTextureMapper::mapTexture(const ViewportParams *viewport, i
     viewport->screenCoordinates(yNorth, dummyX, realYTop);
     viewport->screenCoordinates(ySouth, dummyX, realYBottom);
 
-    const int yTop = qBound(qreal(0.0), realYTop, qreal(imageHeight));
-    int yPaintedTop = yTop;
-    int yPaintedBottom = qBound(qreal(0.0), realYBottom, qreal(imageHeight));
+    const int yPaintedTop = qBound(qreal(0.0), realYTop, qreal(imageHeight));
+    const int yPaintedBottom = qBound(qreal(0.0), realYBottom, qreal(imageHeight));
 
-    yPaintedTop = qBound(0, yPaintedTop, imageHeight);
-    yPaintedBottom = qBound(0, yPaintedBottom, imageHeight);
+    QList<QRect> paintedAreas;
+    for (const QRect &area : areas) {
+        paintedAreas << area.intersected(QRect(area.left(), yPaintedTop, area.width(), yPaintedBottom - yPaintedTop));
+    }
 
-    const int numThreads = m_threadPool.maxThreadCount();
-    const int yStep = (yPaintedBottom - yPaintedTop) / numThreads;
+    ScanlineRowScheduler rowScheduler(paintedAreas);
+    const int numThreads = qMin(m_threadPool.maxThreadCount(), rowScheduler.blockCount());
     for (int i = 0; i < numThreads; ++i) {
-        const int yStart = yPaintedTop + i * yStep;
-        const int yEnd = (i == numThreads - 1) ? yPaintedBottom : yPaintedTop + (i + 1) * yStep;
-        QRunnable *const job = new RenderJob(m_tileLoader, tileZoomLevel, &m_canvasImage, viewport, mapQuality, yStart, yEnd);
+        QRunnable *const job = new RenderJob(m_tileLoader, m_tileLevel, &m_canvasImage, viewport, m_mapQuality, m_leftLon, &rowScheduler);
         m_threadPool.start(job);
     }
 
     // Remove unused lines
-    const int clearStart = (yPaintedTop - m_oldYPaintedTop <= 0) ? yPaintedBottom : 0;
-    const int clearStop = (yPaintedTop - m_oldYPaintedTop <= 0) ? imageHeight : yTop;
-
-    QRgb *const itClearBegin = (QRgb *)(m_canvasImage.scanLine(clearStart));
-    QRgb *const itClearEnd = (QRgb *)(m_canvasImage.scanLine(clearStop));
-
-    for (QRgb *it = itClearBegin; it < itClearEnd; ++it) {
-        *(it) = 0;
+    const int bytesPerPixel = m_canvasImage.depth() / 8;
+    for (const QRect &area : areas) {
+        for (int y = area.top(); y <= area.bottom(); ++y) {
+            if (y < yPaintedTop || y >= yPaintedBottom) {
+                memset(m_canvasImage.scanLine(y) + area.left() * bytesPerPixel, 0, area.width() * bytesPerPixel);
+            }
+        }
     }
 
     m_threadPool.waitForDone();
 
-    m_oldYPaintedTop = yPaintedTop;
-
     m_tileLoader->cleanupTilehash();
 }
 
@@ -173,73 +246,75 @@ void MercatorScanlineTextureMapper::RenderJob::run()
     const int n = ScanlineTextureMapperContext::interpolationStep(m_viewport, m_mapQuality);
 
     // Calculate translation of center point
-    const qreal centerLon = m_viewport->centerLongitude();
     const qreal centerLat = m_viewport->centerLatitude();
 
     const int yCenterOffset = (int)(asinh(tan(centerLat)) * rad2Pixel);
 
-    qreal leftLon = +centerLon - (imageWidth / 2 * pixel2Rad);
-    while (leftLon < -M_PI)
-        leftLon += 2 * M_PI;
-    while (leftLon > M_PI)
-        leftLon -= 2 * M_PI;
-
-    const int maxInterpolationPointX = n * (int)(imageWidth / n - 1) + 1;
-
     // initialize needed variables that are modified during texture mapping:
 
     ScanlineTextureMapperContext context(m_tileLoader, m_tileLevel);
 
-    // Scanline based algorithm to do texture mapping
-
-    for (int y = m_yPaintedTop; y < m_yPaintedBottom; ++y) {
-        QRgb *scanLine = (QRgb *)(m_canvasImage->scanLine(y));
-
-        qreal lon = leftLon;
-        const qreal lat = gd(((imageHeight / 2 + yCenterOffset) - y) * pixel2Rad);
-
-        for (int x = 0; x < imageWidth; ++x) {
-            // Prepare for interpolation
-            bool interpolate = false;
-            if (x > 0 && x <= maxInterpolationPointX) {
-                x += n - 1;
-                lon += (n - 1) * pixel2Rad;
-                interpolate = !printQuality;
-            } else {
-                interpolate = false;
+    QRect block;
+    while (m_rowScheduler->nextBlock(block)) {
+        // The columns to paint start at the left longitude of the canvas
+        const int xPaintedLeft = block.left();
+        const int xPaintedRight = block.right() + 1;
+        const int paintedWidth = block.width();
+        const qreal leftLon = normalizedLon(m_leftLon + xPaintedLeft * pixel2Rad);
+
+        const int maxInterpolationPointX = xPaintedLeft + n * (int)(paintedWidth / n - 1) + 1;
+
+        for (int y = block.top(); y <= block.bottom(); ++y) {
+            QRgb *scanLine = (QRgb *)(m_canvasImage->scanLine(y)) + xPaintedLeft;
+
+            qreal lon = leftLon;
+            const qreal lat = gd(((imageHeight / 2 + yCenterOffset) - y) * pixel2Rad);
+
+            for (int x = xPaintedLeft; x < xPaintedRight; ++x) {
+                // Prepare for interpolation
+                bool interpolate = false;
+                if (x > xPaintedLeft && x <= maxInterpolationPointX) {
+                    x += n - 1;
+                    lon += (n - 1) * pixel2Rad;
+                    interpolate = !printQuality;
+                } else {
+                    interpolate = false;
+                }
+
+                if (lon < -M_PI)
+                    lon += 2 * M_PI;
+                if (lon > M_PI)
+                    lon -= 2 * M_PI;
+
+                if (interpolate) {
+                    if (highQuality)
+                        context.pixelValueApproxF(lon, lat, scanLine, n);
+                    else
+                        context.pixelValueApprox(lon, lat, scanLine, n);
+
+                    scanLine += (n - 1);
+                }
+
+                if (x < xPaintedRight) {
+                    if (highQuality)
+                        context.pixelValueF(lon, lat, scanLine);
+                    else
+                        context.pixelValue(lon, lat, scanLine);
+                }
+
+                ++scanLine;
+                lon += pixel2Rad;
             }
 
-            if (lon < -M_PI)
-                lon += 2 * M_PI;
-            if (lon > M_PI)
-                lon -= 2 * M_PI;
-
-            if (interpolate) {
-                if (highQuality)
-                    context.pixelValueApproxF(lon, lat, scanLine, n);
-                else
-                    context.pixelValueApprox(lon, lat, scanLine, n);
+            // copy scanline to improve performance
+            if (interlaced && y < block.bottom()) {
+                const int pixelByteSize = m_canvasImage->bytesPerLine() / imageWidth;
 
-                scanLine += (n - 1);
+                memcpy(m_canvasImage->scanLine(y + 1) + xPaintedLeft * pixelByteSize,
+                       m_canvasImage->scanLine(y) + xPaintedLeft * pixelByteSize,
+                       paintedWidth * pixelByteSize);
+                ++y;
             }
-
-            if (x < imageWidth) {
-                if (highQuality)
-                    context.pixelValueF(lon, lat, scanLine);
-                else
-                    context.pixelValue(lon, lat, scanLine);
-            }
-
-            ++scanLine;
-            lon += pixel2Rad;
-        }
-
-        // copy scanline to improve performance
-        if (interlaced && y + 1 < m_yPaintedBottom) {
-            const int pixelByteSize = m_canvasImage->bytesPerLine() / imageWidth;
-
-            memcpy(m_canvasImage->scanLine(y + 1), m_canvasImage->scanLine(y), imageWidth * pixelByteSize);
-            ++y;
         }
     }
 }
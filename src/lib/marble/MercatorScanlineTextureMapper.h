@@ -27,17 +27,33 @@ public:
 
     void mapTexture(GeoPainter *painter, const ViewportParams *viewport, int tileZoomLevel, const QRect &dirtyRect, TextureColorizer *texColorizer) override;
 
+    void setCenterChanged() override;
+
 private:
     void mapTexture(const ViewportParams *viewport, int tileZoomLevel, MapQuality mapQuality);
 
+    /**
+     * Moves the canvas along with the center and maps the uncovered areas
+     * only. Returns false if the canvas cannot be reused.
+     */
+    bool scrollTexture(const ViewportParams *viewport, int tileZoomLevel, MapQuality mapQuality);
+
+    void mapAreas(const ViewportParams *viewport, const QList<QRect> &areas);
+
 private:
     class RenderJob;
 
     StackedTileLoader *const m_tileLoader;
     int m_radius;
     QImage m_canvasImage;
-    int m_oldYPaintedTop;
     QThreadPool m_threadPool;
+
+    // What the canvas currently shows
+    bool m_centerChanged;
+    int m_tileLevel;
+    MapQuality m_mapQuality;
+    qreal m_leftLon;
+    int m_yCenterOffset;
 };
 
 }
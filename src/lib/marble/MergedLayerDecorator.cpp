@@ -95,6 +95,11 @@ void MergedLayerDecorator::setTextureLayers(const QList<const GeoSceneTextureTil
 
     d->m_textureLayers = textureLayers;
 
+    // The tile size is detected on first use, do that now as loadTile() runs on several threads
+    for (const GeoSceneTextureTileDataset *textureLayer : textureLayers) {
+        textureLayer->tileSize();
+    }
+
     d->detectMaxTileLevel();
 }
 
@@ -108,6 +113,16 @@ int MergedLayerDecorator::textureLayersSize() const
     return d->m_textureLayers.size();
 }
 
+bool MergedLayerDecorator::isTextureLayerTile(const TileId &tileId) const
+{
+    for (const GeoSceneTextureTileDataset *textureLayer : std::as_const(d->m_textureLayers)) {
+        if (TileId(textureLayer->sourceDir(), 0, 0, 0).mapThemeIdHash() == tileId.mapThemeIdHash()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 int MergedLayerDecorator::maximumTileLevel() const
 {
     return d->m_maxTileLevel;
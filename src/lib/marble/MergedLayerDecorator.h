@@ -8,6 +8,7 @@
 #include <QList>
 
 #include "MarbleGlobal.h"
+#include "marble_export.h"
 
 class QImage;
 class QString;
@@ -26,7 +27,7 @@ class TileId;
 class TileLoader;
 class RenderState;
 
-class MergedLayerDecorator
+class MARBLE_EXPORT MergedLayerDecorator
 {
 public:
     MergedLayerDecorator(TileLoader *const tileLoader, const SunLocator *sunLocator);
@@ -37,6 +38,11 @@ public:
 
     int textureLayersSize() const;
 
+    /**
+     * Returns whether @p tileId belongs to one of the texture layers, judged by its source dir.
+     */
+    bool isTextureLayerTile(const TileId &tileId) const;
+
     /**
      * Returns the highest level in which some tiles are theoretically
      * available for the current texture layers.
@@ -51,6 +57,13 @@ public:
 
     QSize tileSize() const;
 
+    /**
+     * Loads and merges the texture tiles of @p id.
+     *
+     * This method may be called from several threads at once, it only reads
+     * the settings of the decorator. The settings must not be changed while
+     * tiles are being loaded.
+     */
     StackedTile *loadTile(const TileId &id);
 
     StackedTile *updateTile(const StackedTile &stackedTile, const TileId &tileId, const QImage &tileImage);
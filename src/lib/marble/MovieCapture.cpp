@@ -7,9 +7,10 @@
 #include "MovieCapture.h"
 #include "MarbleDebug.h"
 #include "MarbleWidget.h"
+#include "MovieCaptureWriter.h"
 
-#include <QElapsedTimer>
 #include <QFile>
+#include <QImage>
 #include <QMessageBox>
 #include <QProcess>
 #include <QTimer>
@@ -44,7 +45,7 @@ public:
     MarbleWidget *marbleWidget;
     QString encoderExec;
     QString destinationFile;
-    QProcess process;
+    MovieCaptureWriter writer;
     MovieCapture::SnapshotMethod method;
     int fps;
 };
@@ -54,6 +55,8 @@ MovieCapture::MovieCapture(MarbleWidget *widget, QObject *parent)
     , d_ptr(new MovieCapturePrivate(widget))
 {
     Q_D(MovieCapture);
+    connect(&d->writer, &MovieCaptureWriter::rateCalculated, this, &MovieCapture::rateCalculated);
+    connect(&d->writer, &MovieCaptureWriter::movieWritten, this, &MovieCapture::processWrittenMovie);
     if (d->method == MovieCapture::TimeDriven) {
         d->frameTimer.setInterval(1000 / 30); // fps = 30 (default)
         connect(&d->frameTimer, &QTimer::timeout, this, &MovieCapture::recordFrame);
@@ -71,6 +74,9 @@ MovieCapture::MovieCapture(MarbleWidget *widget, QObject *parent)
 
 MovieCapture::~MovieCapture()
 {
+    // Let the encoder complete the movie
+    d_ptr->writer.finish();
+    d_ptr->writer.wait();
     delete d_ptr;
 }
 
@@ -161,27 +167,19 @@ bool MovieCapture::checkToolsAvailability()
 void MovieCapture::recordFrame()
 {
     Q_D(MovieCapture);
-    QImage const screenshot = d->marbleWidget->mapScreenShot().toImage().convertToFormat(QImage::Format_RGB888);
-    if (d->process.state() == QProcess::NotRunning) {
-        QStringList const arguments = QStringList() << QStringLiteral("-y") << QStringLiteral("-r") << QString::number(fps()) << QStringLiteral("-f")
-                                                    << QStringLiteral("rawvideo") << QStringLiteral("-pix_fmt") << QStringLiteral("rgb24")
-                                                    << QStringLiteral("-s") << QStringLiteral("%1x%2").arg(screenshot.width()).arg(screenshot.height())
-                                                    << QStringLiteral("-i") << QStringLiteral("pipe:") << QStringLiteral("-b") << QStringLiteral("2000k")
-                                                    << d->destinationFile;
-        d->process.start(d->encoderExec, arguments);
-        connect(&d->process, SIGNAL(finished(int)), this, SLOT(processWrittenMovie(int)));
+    addFrame(d->marbleWidget->mapScreenShot().toImage());
+}
+
+void MovieCapture::addFrame(const QImage &frame)
+{
+    Q_D(MovieCapture);
+    if (!d->writer.isRunning()) {
+        d->writer.start(d->encoderExec, d->destinationFile, fps());
     }
-    d->process.write((char *)screenshot.bits(), screenshot.sizeInBytes());
-    for (int i = 0; i < 30 && d->process.bytesToWrite() > 0; ++i) {
-        QElapsedTimer t;
-        int then = d->process.bytesToWrite();
-        t.start();
-        d->process.waitForBytesWritten(100);
-        int span = t.elapsed();
-        int now = d->process.bytesToWrite();
-        int bytesWritten = then - now;
-        double rate = (bytesWritten * 1000.0) / (qMax(1, span) * 1024);
-        Q_EMIT rateCalculated(rate);
+
+    // Frames of data driven recordings are all needed, time driven ones rather get dropped than delay the map
+    if (!d->writer.enqueue(frame, d->method == DataDriven)) {
+        mDebug() << "[*] Dropped a frame, the encoder is too slow";
     }
 }
 
@@ -194,6 +192,7 @@ bool MovieCapture::startRecording()
         return false;
     }
 
+    d->writer.start(d->encoderExec, d->destinationFile, fps());
     if (d->method == MovieCapture::TimeDriven) {
         d->frameTimer.start();
     }
@@ -206,7 +205,7 @@ void MovieCapture::stopRecording()
     Q_D(MovieCapture);
 
     d->frameTimer.stop();
-    d->process.closeWriteChannel();
+    d->writer.finish();
 }
 
 void MovieCapture::cancelRecording()
@@ -214,7 +213,7 @@ void MovieCapture::cancelRecording()
     Q_D(MovieCapture);
 
     d->frameTimer.stop();
-    d->process.close();
+    d->writer.cancel();
     QFile::remove(d->destinationFile);
 }
 
@@ -9,6 +9,8 @@
 #include <QList>
 #include <QObject>
 
+class QImage;
+
 #include "marble_export.h"
 
 namespace Marble
@@ -70,6 +72,11 @@ public Q_SLOTS:
     void setFilename(const QString &path);
     void setSnapshotMethod(MovieCapture::SnapshotMethod method);
     void recordFrame();
+    /**
+     * Records @p frame instead of a screenshot of the widget. Frames are
+     * converted and written to the encoder in the background.
+     */
+    void addFrame(const QImage &frame);
     bool startRecording();
     void stopRecording();
     void cancelRecording();
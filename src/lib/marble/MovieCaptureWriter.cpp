@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "MovieCaptureWriter.h"
+
+#include "MarbleDebug.h"
+
+#include <QElapsedTimer>
+#include <QProcess>
+
+namespace Marble
+{
+
+MovieCaptureWriter::MovieCaptureWriter(QObject *parent)
+    : QThread(parent)
+    , m_fps(30)
+    , m_finishing(false)
+    , m_canceled(false)
+{
+}
+
+MovieCaptureWriter::~MovieCaptureWriter()
+{
+    cancel();
+}
+
+void MovieCaptureWriter::start(const QString &encoderExec, const QString &destinationFile, int fps)
+{
+    // A movie still being finished has to be complete before writing the next one
+    wait();
+
+    m_encoderExec = encoderExec;
+    m_destinationFile = destinationFile;
+    m_fps = fps;
+    m_frames.clear();
+    m_finishing = false;
+    m_canceled = false;
+    QThread::start();
+}
+
+bool MovieCaptureWriter::enqueue(const QImage &frame, bool wait)
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_frames.size() >= queueCapacity && !m_canceled) {
+        if (!wait) {
+            return false;
+        }
+        m_frameTaken.wait(&m_mutex);
+    }
+
+    m_frames.enqueue(frame);
+    m_frameQueued.wakeOne();
+    return true;
+}
+
+void MovieCaptureWriter::finish()
+{
+    QMutexLocker locker(&m_mutex);
+    m_finishing = true;
+    m_frameQueued.wakeOne();
+}
+
+void MovieCaptureWriter::cancel()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_canceled = true;
+        m_frames.clear();
+        m_frameQueued.wakeOne();
+        m_frameTaken.wakeAll();
+    }
+    wait();
+}
+
+void MovieCaptureWriter::run()
+{
+    QProcess process;
+    QSize size;
+    bool failed = false;
+
+    while (true) {
+        QImage frame;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_frames.isEmpty() && !m_finishing && !m_canceled) {
+                m_frameQueued.wait(&m_mutex);
+            }
+            if (m_canceled || m_frames.isEmpty()) {
+                break;
+            }
+            frame = m_frames.dequeue();
+            m_frameTaken.wakeOne();
+        }
+
+        if (!size.isValid()) {
+            // The encoder reads raw frames, their size is fixed by the first one
+            size = frame.size();
+            QStringList const arguments = QStringList() << QStringLiteral("-y") << QStringLiteral("-r") << QString::number(m_fps) << QStringLiteral("-f")
+                                                        << QStringLiteral("rawvideo") << QStringLiteral("-pix_fmt") << QStringLiteral("rgb24")
+                                                        << QStringLiteral("-s") << QStringLiteral("%1x%2").arg(size.width()).arg(size.height())
+                                                        << QStringLiteral("-i") << QStringLiteral("pipe:") << QStringLiteral("-b") << QStringLiteral("2000k")
+                                                        << m_destinationFile;
+            process.start(m_encoderExec, arguments);
+            if (!process.waitForStarted()) {
+                mDebug() << "[*] Cannot start" << m_encoderExec << process.errorString();
+                failed = true;
+                break;
+            }
+        }
+
+        if (!write(process, frame.size() == size ? frame : frame.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation))) {
+            failed = true;
+            break;
+        }
+    }
+
+    if (failed) {
+        process.kill();
+        process.waitForFinished();
+        Q_EMIT movieWritten(-1);
+
+        // Nothing gets written anymore, do not keep the recording waiting
+        QMutexLocker locker(&m_mutex);
+        m_canceled = true;
+        m_frames.clear();
+        m_frameTaken.wakeAll();
+        return;
+    }
+
+    if (process.state() == QProcess::NotRunning) {
+        return;
+    }
+
+    if (isCanceled()) {
+        process.kill();
+        process.waitForFinished();
+        return;
+    }
+
+    process.closeWriteChannel();
+    process.waitForFinished(-1);
+    const int exitCode = process.exitStatus() == QProcess::NormalExit ? process.exitCode() : -1;
+    Q_EMIT movieWritten(exitCode);
+}
+
+bool MovieCaptureWriter::isCanceled()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_canceled;
+}
+
+bool MovieCaptureWriter::write(QProcess &process, const QImage &frame)
+{
+    QImage const image = frame.convertToFormat(QImage::Format_RGB888);
+
+    // Scanlines are padded to four bytes, the encoder expects them packed
+    const qsizetype rowLength = qsizetype(image.width()) * 3;
+    QByteArray data;
+    data.reserve(rowLength * image.height());
+    for (int y = 0; y < image.height(); ++y) {
+        data.append(reinterpret_cast<const char *>(image.constScanLine(y)), rowLength);
+    }
+
+    QElapsedTimer t;
+    t.start();
+    process.write(data);
+    // Canceling must not wait for an encoder that stopped reading
+    while (process.bytesToWrite() > 0 && !isCanceled()) {
+        if (!process.waitForBytesWritten(1000) && process.state() != QProcess::Running) {
+            mDebug() << "[*]" << m_encoderExec << "stopped reading frames";
+            return false;
+        }
+    }
+    double rate = (data.size() * 1000.0) / (qMax<qint64>(1, t.elapsed()) * 1024);
+    Q_EMIT rateCalculated(rate);
+    return true;
+}
+
+}
+
+#include "moc_MovieCaptureWriter.cpp"
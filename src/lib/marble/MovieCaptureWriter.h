@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_MOVIECAPTUREWRITER_H
+#define MARBLE_MOVIECAPTUREWRITER_H
+
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "marble_export.h"
+
+class QProcess;
+
+namespace Marble
+{
+
+/**
+ * Converts the recorded frames and pipes them into the encoder on a thread
+ * of its own, so that recording does not hold up rendering the map.
+ */
+class MARBLE_EXPORT MovieCaptureWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit MovieCaptureWriter(QObject *parent = nullptr);
+    ~MovieCaptureWriter() override;
+
+    /**
+     * Starts writing a movie. The encoder is started with avconv/ffmpeg
+     * arguments once the first frame arrives, it reads the frames as packed
+     * rgb24 rows from its standard input.
+     */
+    void start(const QString &encoderExec, const QString &destinationFile, int fps);
+
+    /**
+     * Queues @p frame for writing. If the queue is full, waits for room if
+     * @p wait is true, or drops the frame and returns false otherwise.
+     */
+    bool enqueue(const QImage &frame, bool wait);
+
+    /// Writes the queued frames, then closes the movie
+    void finish();
+
+    /// Drops the queued frames and stops the encoder
+    void cancel();
+
+    // Frames recorded at most ahead of the encoder
+    static const int queueCapacity = 16;
+
+Q_SIGNALS:
+    /// The rate the encoder reads frames at, in KiB per second
+    void rateCalculated(double rate);
+
+    /// The encoder finished the movie, with -1 if it failed or could not be started
+    void movieWritten(int exitCode);
+
+protected:
+    void run() override;
+
+private:
+    bool isCanceled();
+    bool write(QProcess &process, const QImage &frame);
+
+    QString m_encoderExec;
+    QString m_destinationFile;
+    int m_fps;
+
+    QMutex m_mutex;
+    QWaitCondition m_frameQueued;
+    QWaitCondition m_frameTaken;
+    QQueue<QImage> m_frames;
+    bool m_finishing;
+    bool m_canceled;
+};
+
+}
+
+#endif
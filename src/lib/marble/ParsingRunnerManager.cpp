@@ -12,7 +12,6 @@
 #include "PluginManager.h"
 #include "RunnerTask.h"
 
-#include <QFileInfo>
 #include <QList>
 #include <QMutex>
 #include <QThreadPool>
@@ -79,21 +78,15 @@ ParsingRunnerManager::~ParsingRunnerManager()
 
 void ParsingRunnerManager::parseFile(const QString &fileName, DocumentRole role)
 {
-    QList<const ParseRunnerPlugin *> plugins = d->m_pluginManager->parsingRunnerPlugins();
-    const QFileInfo fileInfo(fileName);
-    const QString suffix = fileInfo.suffix().toLower();
-    const QString completeSuffix = fileInfo.completeSuffix().toLower();
+    const QList<const ParseRunnerPlugin *> plugins = d->m_pluginManager->parsingRunnerPlugins(fileName);
 
     d->m_parsingTasks = 0;
-    for (const ParseRunnerPlugin *plugin : std::as_const(plugins)) {
-        QStringList const extensions = plugin->fileExtensions();
-        if (extensions.isEmpty() || extensions.contains(suffix) || extensions.contains(completeSuffix)) {
-            auto task = new ParsingTask(plugin->newRunner(), this, fileName, role);
-            connect(task, SIGNAL(finished()), this, SLOT(cleanupParsingTask()));
-            mDebug() << "parse task " << plugin->nameId() << " " << (quintptr)task;
-            ++d->m_parsingTasks;
-            QThreadPool::globalInstance()->start(task);
-        }
+    for (const ParseRunnerPlugin *plugin : plugins) {
+        auto task = new ParsingTask(plugin->newRunner(), this, fileName, role);
+        connect(task, SIGNAL(finished()), this, SLOT(cleanupParsingTask()));
+        mDebug() << "parse task " << plugin->nameId() << " " << (quintptr)task;
+        ++d->m_parsingTasks;
+        QThreadPool::globalInstance()->start(task);
     }
 
     if (d->m_parsingTasks == 0) {
@@ -7,7 +7,6 @@
 
 #include "PlacemarkLayout.h"
 
-#include <QAbstractItemModel>
 #include <QFont>
 #include <QFontMetrics>
 #include <QItemSelectionModel>
@@ -30,6 +29,7 @@
 #include "MarblePlacemarkModel.h"
 #include "MathHelper.h"
 #include "PlacemarkLayer.h"
+#include "PlacemarkRegistry.h"
 #include "TileCoordsPyramid.h"
 #include "TileId.h"
 #include "ViewportParams.h"
@@ -72,15 +72,16 @@ QSet<GeoDataPlacemark::GeoDataVisualCategory> acceptedVisualCategories()
     return visualCategories;
 }
 
-PlacemarkLayout::PlacemarkLayout(QAbstractItemModel *placemarkModel,
+PlacemarkLayout::PlacemarkLayout(const PlacemarkRegistry *placemarkRegistry,
                                  QItemSelectionModel *selectionModel,
                                  MarbleClock *clock,
                                  const StyleBuilder *styleBuilder,
                                  QObject *parent)
     : QObject(parent)
-    , m_placemarkModel(placemarkModel)
+    , m_placemarkRegistry(placemarkRegistry)
     , m_selectionModel(selectionModel)
     , m_clock(clock)
+    , m_consideredPlacemarkCount(0)
     , m_acceptedVisualCategories(acceptedVisualCategories())
     , m_showPlaces(false)
     , m_showCities(false)
@@ -94,14 +95,13 @@ PlacemarkLayout::PlacemarkLayout(QAbstractItemModel *placemarkModel,
     , m_styleBuilder(styleBuilder)
     , m_lastPlacemarkAvailable(false)
 {
-    Q_ASSERT(m_placemarkModel);
+    Q_ASSERT(m_placemarkRegistry);
 
     connect(m_selectionModel, SIGNAL(selectionChanged(QItemSelection, QItemSelection)), this, SLOT(requestStyleReset()));
 
-    connect(m_placemarkModel, SIGNAL(dataChanged(QModelIndex, QModelIndex)), this, SLOT(resetCacheData()));
-    connect(m_placemarkModel, SIGNAL(rowsInserted(QModelIndex, int, int)), this, SLOT(addPlacemarks(QModelIndex, int, int)));
-    connect(m_placemarkModel, SIGNAL(rowsAboutToBeRemoved(QModelIndex, int, int)), this, SLOT(removePlacemarks(QModelIndex, int, int)));
-    connect(m_placemarkModel, SIGNAL(modelReset()), this, SLOT(resetCacheData()));
+    connect(m_placemarkRegistry, &PlacemarkRegistry::placemarksAdded, this, &PlacemarkLayout::addPlacemarks);
+    connect(m_placemarkRegistry, &PlacemarkRegistry::placemarksRemoved, this, &PlacemarkLayout::removePlacemarks);
+    connect(m_placemarkRegistry, &PlacemarkRegistry::reset, this, &PlacemarkLayout::resetCacheData);
 }
 
 PlacemarkLayout::~PlacemarkLayout()
@@ -192,47 +192,36 @@ int PlacemarkLayout::maxLabelHeight()
 }
 
 /// feed an internal QMap of placemarks with TileId as key when model changes
-void PlacemarkLayout::addPlacemarks(const QModelIndex &parent, int first, int last)
-{
-    Q_ASSERT(first < m_placemarkModel->rowCount());
-    Q_ASSERT(last < m_placemarkModel->rowCount());
-    for (int i = first; i <= last; ++i) {
-        QModelIndex index = m_placemarkModel->index(i, 0, parent);
-        Q_ASSERT(index.isValid());
-        auto const object = qvariant_cast<GeoDataObject *>(index.data(MarblePlacemarkModel::ObjectPointerRole));
-        if (const GeoDataPlacemark *placemark = geodata_cast<GeoDataPlacemark>(object)) {
-            const GeoDataCoordinates coordinates = placemarkIconCoordinates(placemark);
-            if (!coordinates.isValid()) {
-                continue;
-            }
+void PlacemarkLayout::addPlacemarks(const QList<const GeoDataPlacemark *> &placemarks)
+{
+    for (const GeoDataPlacemark *placemark : placemarks) {
+        const GeoDataCoordinates coordinates = placemarkIconCoordinates(placemark);
+        if (!coordinates.isValid()) {
+            continue;
+        }
 
-            if (placemark->hasOsmData()) {
-                qint64 const osmId = placemark->osmData().id();
-                if (osmId > 0) {
-                    if (m_osmIds.contains(osmId)) {
-                        continue; // placemark is already shown
-                    }
-                    m_osmIds << osmId;
+        if (placemark->hasOsmData()) {
+            qint64 const osmId = placemark->osmData().id();
+            if (osmId > 0) {
+                if (m_osmIds.contains(osmId)) {
+                    continue; // placemark is already shown
                 }
+                m_osmIds << osmId;
             }
-
-            int zoomLevel = placemark->zoomLevel();
-            TileId key = TileId::fromCoordinates(coordinates, zoomLevel);
-            m_placemarkCache[key].append(placemark);
         }
+
+        int zoomLevel = placemark->zoomLevel();
+        TileId key = TileId::fromCoordinates(coordinates, zoomLevel);
+        m_placemarkCache[key].append(placemark);
     }
     Q_EMIT repaintNeeded();
 }
 
-void PlacemarkLayout::removePlacemarks(const QModelIndex &parent, int first, int last)
+void PlacemarkLayout::removePlacemarks(const QList<const GeoDataPlacemark *> &placemarks)
 {
-    Q_ASSERT(first < m_placemarkModel->rowCount());
-    Q_ASSERT(last < m_placemarkModel->rowCount());
-    for (int i = first; i <= last; ++i) {
-        QModelIndex index = m_placemarkModel->index(i, 0, parent);
-        Q_ASSERT(index.isValid());
-        const GeoDataPlacemark *placemark =
-            static_cast<GeoDataPlacemark *>(qvariant_cast<GeoDataObject *>(index.data(MarblePlacemarkModel::ObjectPointerRole)));
+    // Collect the placemarks per tile first, so that every tile is searched only once
+    QMap<TileId, QSet<const GeoDataPlacemark *>> removed;
+    for (const GeoDataPlacemark *placemark : placemarks) {
         const GeoDataCoordinates coordinates = placemarkIconCoordinates(placemark);
         if (!coordinates.isValid()) {
             continue;
@@ -240,9 +229,8 @@ void PlacemarkLayout::removePlacemarks(const QModelIndex &parent, int first, int
 
         int zoomLevel = placemark->zoomLevel();
         TileId key = TileId::fromCoordinates(coordinates, zoomLevel);
-        delete m_visiblePlacemarks[placemark];
-        m_visiblePlacemarks.remove(placemark);
-        m_placemarkCache[key].removeAll(placemark);
+        delete m_visiblePlacemarks.take(placemark);
+        removed[key].insert(placemark);
         if (placemark->hasOsmData()) {
             qint64 const osmId = placemark->osmData().id();
             if (osmId > 0) {
@@ -250,20 +238,26 @@ void PlacemarkLayout::removePlacemarks(const QModelIndex &parent, int first, int
             }
         }
     }
+
+    for (auto it = removed.cbegin(), end = removed.cend(); it != end; ++it) {
+        const auto cached = m_placemarkCache.find(it.key());
+        if (cached != m_placemarkCache.end()) {
+            cached->removeIf([&it](const GeoDataPlacemark *placemark) {
+                return it->contains(placemark);
+            });
+        }
+    }
     Q_EMIT repaintNeeded();
 }
 
 void PlacemarkLayout::resetCacheData()
 {
-    const int rowCount = m_placemarkModel->rowCount();
-
     m_osmIds.clear();
     m_placemarkCache.clear();
     qDeleteAll(m_visiblePlacemarks);
     m_visiblePlacemarks.clear();
     requestStyleReset();
-    addPlacemarks(m_placemarkModel->index(0, 0), 0, rowCount);
-    Q_EMIT repaintNeeded();
+    addPlacemarks(m_placemarkRegistry->placemarks());
 }
 
 QSet<TileId> PlacemarkLayout::visibleTiles(const ViewportParams &viewport, int zoomLevel)
@@ -320,7 +314,8 @@ QSet<TileId> PlacemarkLayout::visibleTiles(const ViewportParams &viewport, int z
 QList<VisiblePlacemark *> PlacemarkLayout::generateLayout(const ViewportParams *viewport, int tileLevel)
 {
     m_runtimeTrace.clear();
-    if (m_placemarkModel->rowCount() <= 0) {
+    m_consideredPlacemarkCount = 0;
+    if (m_placemarkRegistry->placemarkCount() <= 0) {
         clearCache();
         return {};
     }
@@ -476,6 +471,7 @@ QList<VisiblePlacemark *> PlacemarkLayout::generateLayout(const ViewportParams *
         }
     } while (currentMaxLabelHeight != m_maxLabelHeight);
 
+    m_consideredPlacemarkCount = placemarkList.count();
     m_runtimeTrace = QStringLiteral("Placemarks: %1 Drawn: %2").arg(placemarkList.count()).arg(m_paintOrder.size());
     return m_paintOrder;
 }
@@ -485,6 +481,16 @@ QString PlacemarkLayout::runtimeTrace() const
     return m_runtimeTrace;
 }
 
+int PlacemarkLayout::consideredPlacemarkCount() const
+{
+    return m_consideredPlacemarkCount;
+}
+
+int PlacemarkLayout::drawnPlacemarkCount() const
+{
+    return m_paintOrder.size();
+}
+
 QList<VisiblePlacemark *> PlacemarkLayout::visiblePlacemarks() const
 {
     return m_visiblePlacemarks.values();
@@ -544,10 +550,10 @@ bool PlacemarkLayout::layoutPlacemark(const GeoDataPlacemark *placemark, const G
     if (!labelText.isEmpty()) {
         labelRect = roomForLabel(style, x, y, labelText, mark);
     }
-    if (labelRect.isEmpty() && mark->symbolPixmap().isNull()) {
+    if (labelRect.isEmpty() && mark->symbolImage().isNull()) {
         return false;
     }
-    if (!mark->symbolPixmap().isNull() && !hasRoomForPixmap(y, mark)) {
+    if (!mark->symbolImage().isNull() && !hasRoomForPixmap(y, mark)) {
         return false;
     }
 
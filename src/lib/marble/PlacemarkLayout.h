@@ -20,12 +20,11 @@
 #include <QSet>
 
 #include "GeoDataPlacemark.h"
+#include "marble_export.h"
 #include <GeoDataStyle.h>
 
-class QAbstractItemModel;
 class QItemSelectionModel;
 class QPoint;
-class QModelIndex;
 
 namespace Marble
 {
@@ -34,6 +33,7 @@ class GeoDataCoordinates;
 class GeoPainter;
 class MarbleClock;
 class PlacemarkPainter;
+class PlacemarkRegistry;
 class TileId;
 class VisiblePlacemark;
 class ViewportParams;
@@ -43,7 +43,7 @@ class StyleBuilder;
  * Layouts the place marks with a passed QPainter.
  */
 
-class PlacemarkLayout : public QObject
+class MARBLE_EXPORT PlacemarkLayout : public QObject
 {
     Q_OBJECT
 
@@ -51,7 +51,7 @@ public:
     /**
      * Creates a new place mark layout.
      */
-    PlacemarkLayout(QAbstractItemModel *placemarkModel,
+    PlacemarkLayout(const PlacemarkRegistry *placemarkRegistry,
                     QItemSelectionModel *selectionModel,
                     MarbleClock *clock,
                     const StyleBuilder *styleBuilder,
@@ -74,6 +74,13 @@ public:
 
     QString runtimeTrace() const;
 
+    /**
+     * Returns the number of placemarks the last layout considered resp. placed
+     * on the map.
+     */
+    int consideredPlacemarkCount() const;
+    int drawnPlacemarkCount() const;
+
     QList<VisiblePlacemark *> visiblePlacemarks() const;
 
     bool hasPlacemarkAt(const QPoint &pos);
@@ -91,8 +98,8 @@ public Q_SLOTS:
     void setShowMaria(bool show);
 
     void requestStyleReset();
-    void addPlacemarks(const QModelIndex &index, int first, int last);
-    void removePlacemarks(const QModelIndex &index, int first, int last);
+    void addPlacemarks(const QList<const GeoDataPlacemark *> &placemarks);
+    void removePlacemarks(const QList<const GeoDataPlacemark *> &placemarks);
     void resetCacheData();
 
 Q_SIGNALS:
@@ -128,12 +135,13 @@ private:
 
 private:
     Q_DISABLE_COPY(PlacemarkLayout)
-    QAbstractItemModel *m_placemarkModel;
+    const PlacemarkRegistry *const m_placemarkRegistry;
     QItemSelectionModel *const m_selectionModel;
     MarbleClock *const m_clock;
 
     QList<VisiblePlacemark *> m_paintOrder;
     QString m_runtimeTrace;
+    int m_consideredPlacemarkCount;
     int m_labelArea;
     QHash<const GeoDataPlacemark *, VisiblePlacemark *> m_visiblePlacemarks;
     QList<QList<VisiblePlacemark *>> m_rowsection;
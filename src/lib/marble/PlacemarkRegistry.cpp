@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "PlacemarkRegistry.h"
+
+#include "GeoDataContainer.h"
+#include "GeoDataDocument.h"
+#include "GeoDataGeometry.h"
+#include "GeoDataOverlay.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataRelation.h"
+#include "GeoDataTreeModel.h"
+
+#include <QHash>
+#include <QSet>
+
+namespace Marble
+{
+
+class PlacemarkRegistryPrivate
+{
+public:
+    struct Position {
+        int geometryId;
+        int index;
+    };
+
+    /// The features of interest below an object of the tree
+    struct Batch {
+        QList<const GeoDataPlacemark *> placemarks;
+        QList<const GeoDataOverlay *> overlays;
+        QList<GeoDataRelation *> relations;
+    };
+
+    explicit PlacemarkRegistryPrivate(GeoDataTreeModel *treeModel);
+
+    static void collect(GeoDataFeature *feature, Batch &batch);
+
+    static int geometryId(const GeoDataPlacemark *placemark);
+
+    bool insert(const GeoDataPlacemark *placemark);
+    bool remove(const GeoDataPlacemark *placemark);
+
+    void fill();
+
+    GeoDataTreeModel *const m_treeModel;
+
+    /// Placemarks by the type of their geometry
+    QHash<int, QList<const GeoDataPlacemark *>> m_placemarks;
+    QHash<const GeoDataPlacemark *, Position> m_positions;
+    QSet<const GeoDataOverlay *> m_overlays;
+    QSet<GeoDataRelation *> m_relations;
+};
+
+PlacemarkRegistryPrivate::PlacemarkRegistryPrivate(GeoDataTreeModel *treeModel)
+    : m_treeModel(treeModel)
+{
+}
+
+void PlacemarkRegistryPrivate::collect(GeoDataFeature *feature, Batch &batch)
+{
+    if (const auto placemark = geodata_cast<GeoDataPlacemark>(feature)) {
+        batch.placemarks << placemark;
+    } else if (const auto relation = geodata_cast<GeoDataRelation>(feature)) {
+        batch.relations << relation;
+    } else if (const auto overlay = dynamic_cast<const GeoDataOverlay *>(feature)) {
+        batch.overlays << overlay;
+    } else if (const auto container = dynamic_cast<GeoDataContainer *>(feature)) {
+        for (auto it = container->constBegin(), end = container->constEnd(); it != end; ++it) {
+            collect(*it, batch);
+        }
+    }
+}
+
+int PlacemarkRegistryPrivate::geometryId(const GeoDataPlacemark *placemark)
+{
+    const GeoDataGeometry *geometry = placemark->geometry();
+    return geometry ? geometry->geometryId() : InvalidGeometryId;
+}
+
+bool PlacemarkRegistryPrivate::insert(const GeoDataPlacemark *placemark)
+{
+    if (m_positions.contains(placemark)) {
+        return false;
+    }
+
+    // The geometry is remembered as the placemark may get a different one while registered
+    const int id = geometryId(placemark);
+    QList<const GeoDataPlacemark *> &placemarks = m_placemarks[id];
+    m_positions.insert(placemark, Position{id, int(placemarks.size())});
+    placemarks << placemark;
+    return true;
+}
+
+bool PlacemarkRegistryPrivate::remove(const GeoDataPlacemark *placemark)
+{
+    const auto iterator = m_positions.constFind(placemark);
+    if (iterator == m_positions.constEnd()) {
+        return false;
+    }
+    const Position position = iterator.value();
+    m_positions.erase(iterator);
+
+    // Fill the gap with the last placemark of the same type
+    QList<const GeoDataPlacemark *> &placemarks = m_placemarks[position.geometryId];
+    const GeoDataPlacemark *last = placemarks.takeLast();
+    if (last != placemark) {
+        placemarks[position.index] = last;
+        m_positions[last].index = position.index;
+    }
+    return true;
+}
+
+void PlacemarkRegistryPrivate::fill()
+{
+    m_placemarks.clear();
+    m_positions.clear();
+
+    Batch batch;
+    collect(m_treeModel->rootDocument(), batch);
+    m_positions.reserve(batch.placemarks.size());
+    for (const GeoDataPlacemark *placemark : std::as_const(batch.placemarks)) {
+        insert(placemark);
+    }
+    m_overlays = QSet<const GeoDataOverlay *>(batch.overlays.constBegin(), batch.overlays.constEnd());
+    m_relations = QSet<GeoDataRelation *>(batch.relations.constBegin(), batch.relations.constEnd());
+}
+
+PlacemarkRegistry::PlacemarkRegistry(GeoDataTreeModel *treeModel, QObject *parent)
+    : QObject(parent)
+    , d(new PlacemarkRegistryPrivate(treeModel))
+{
+    d->fill();
+
+    connect(treeModel, &GeoDataTreeModel::added, this, &PlacemarkRegistry::addObject);
+    connect(treeModel, &GeoDataTreeModel::removed, this, &PlacemarkRegistry::removeObject);
+    connect(treeModel, &QAbstractItemModel::modelReset, this, &PlacemarkRegistry::resetFromModel);
+}
+
+PlacemarkRegistry::~PlacemarkRegistry()
+{
+    delete d;
+}
+
+int PlacemarkRegistry::placemarkCount() const
+{
+    return d->m_positions.size();
+}
+
+QList<const GeoDataPlacemark *> PlacemarkRegistry::placemarks() const
+{
+    QList<const GeoDataPlacemark *> result;
+    result.reserve(d->m_positions.size());
+    for (const auto &placemarks : std::as_const(d->m_placemarks)) {
+        result += placemarks;
+    }
+    return result;
+}
+
+QList<const GeoDataPlacemark *> PlacemarkRegistry::placemarks(EnumGeometryId geometryId) const
+{
+    return d->m_placemarks.value(geometryId);
+}
+
+QList<const GeoDataOverlay *> PlacemarkRegistry::overlays() const
+{
+    return d->m_overlays.values();
+}
+
+QList<GeoDataRelation *> PlacemarkRegistry::relations() const
+{
+    return d->m_relations.values();
+}
+
+void PlacemarkRegistry::addObject(GeoDataObject *object)
+{
+    const auto feature = dynamic_cast<GeoDataFeature *>(object);
+    if (!feature) {
+        return;
+    }
+
+    PlacemarkRegistryPrivate::Batch batch;
+    PlacemarkRegistryPrivate::collect(feature, batch);
+
+    d->m_positions.reserve(d->m_positions.size() + batch.placemarks.size());
+    batch.placemarks.removeIf([this](const GeoDataPlacemark *placemark) {
+        return !d->insert(placemark);
+    });
+    batch.overlays.removeIf([this](const GeoDataOverlay *overlay) {
+        const qsizetype size = d->m_overlays.size();
+        d->m_overlays.insert(overlay);
+        return d->m_overlays.size() == size; // already known
+    });
+    batch.relations.removeIf([this](GeoDataRelation *relation) {
+        const qsizetype size = d->m_relations.size();
+        d->m_relations.insert(relation);
+        return d->m_relations.size() == size; // already known
+    });
+
+    // Relations first, so that their members know about them when they are added
+    if (!batch.relations.isEmpty()) {
+        Q_EMIT relationsAdded(batch.relations);
+    }
+    if (!batch.placemarks.isEmpty()) {
+        Q_EMIT placemarksAdded(batch.placemarks);
+    }
+    if (!batch.overlays.isEmpty()) {
+        Q_EMIT overlaysAdded(batch.overlays);
+    }
+}
+
+void PlacemarkRegistry::removeObject(GeoDataObject *object)
+{
+    const auto feature = dynamic_cast<GeoDataFeature *>(object);
+    if (!feature) {
+        return;
+    }
+
+    PlacemarkRegistryPrivate::Batch batch;
+    PlacemarkRegistryPrivate::collect(feature, batch);
+
+    batch.placemarks.removeIf([this](const GeoDataPlacemark *placemark) {
+        return !d->remove(placemark);
+    });
+    batch.overlays.removeIf([this](const GeoDataOverlay *overlay) {
+        return !d->m_overlays.remove(overlay);
+    });
+    batch.relations.removeIf([this](GeoDataRelation *relation) {
+        return !d->m_relations.remove(relation);
+    });
+
+    if (!batch.placemarks.isEmpty()) {
+        Q_EMIT placemarksRemoved(batch.placemarks);
+    }
+    if (!batch.overlays.isEmpty()) {
+        Q_EMIT overlaysRemoved(batch.overlays);
+    }
+    if (!batch.relations.isEmpty()) {
+        Q_EMIT relationsRemoved(batch.relations);
+    }
+}
+
+void PlacemarkRegistry::resetFromModel()
+{
+    d->fill();
+    Q_EMIT reset();
+}
+
+}
+
+#include "moc_PlacemarkRegistry.cpp"
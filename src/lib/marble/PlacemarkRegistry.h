@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_PLACEMARKREGISTRY_H
+#define MARBLE_PLACEMARKREGISTRY_H
+
+#include "marble_export.h"
+
+#include "Serializable.h"
+
+#include <QList>
+#include <QObject>
+
+namespace Marble
+{
+
+class GeoDataObject;
+class GeoDataOverlay;
+class GeoDataPlacemark;
+class GeoDataRelation;
+class GeoDataTreeModel;
+class PlacemarkRegistryPrivate;
+
+/**
+ * A flat view of all placemarks, overlays and relations in a GeoDataTreeModel.
+ *
+ * Layers that only care about the leaves of the tree are told about every
+ * document, folder or feature added to or removed from the tree in a single
+ * signal carrying all placemarks of it. Unlike a chain of proxy models this
+ * needs no per-row mapping, so adding and removing features stays cheap no
+ * matter how many of them the tree holds.
+ *
+ * Placemarks are kept per type of their geometry, which lets consumers skip
+ * whole groups they cannot render.
+ */
+class MARBLE_EXPORT PlacemarkRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PlacemarkRegistry(GeoDataTreeModel *treeModel, QObject *parent = nullptr);
+
+    ~PlacemarkRegistry() override;
+
+    /** Returns the number of placemarks in the tree */
+    int placemarkCount() const;
+
+    /** Returns all placemarks in the tree, in no particular order */
+    QList<const GeoDataPlacemark *> placemarks() const;
+
+    /** Returns the placemarks whose geometry is of the given type, in no particular order */
+    QList<const GeoDataPlacemark *> placemarks(EnumGeometryId geometryId) const;
+
+    /** Returns all overlays in the tree, in no particular order */
+    QList<const GeoDataOverlay *> overlays() const;
+
+    /** Returns all relations in the tree, in no particular order */
+    QList<GeoDataRelation *> relations() const;
+
+Q_SIGNALS:
+    void placemarksAdded(const QList<const GeoDataPlacemark *> &placemarks);
+
+    /** The placemarks are removed from the tree, but not deleted yet */
+    void placemarksRemoved(const QList<const GeoDataPlacemark *> &placemarks);
+
+    void overlaysAdded(const QList<const GeoDataOverlay *> &overlays);
+
+    /** The overlays are removed from the tree, but not deleted yet */
+    void overlaysRemoved(const QList<const GeoDataOverlay *> &overlays);
+
+    /** Emitted before the placemarks and overlays that were added along with the relations */
+    void relationsAdded(const QList<GeoDataRelation *> &relations);
+
+    /** The relations are removed from the tree, but not deleted yet */
+    void relationsRemoved(const QList<GeoDataRelation *> &relations);
+
+    /** The tree was replaced, all previously reported features are gone */
+    void reset();
+
+private Q_SLOTS:
+    void addObject(GeoDataObject *object);
+    void removeObject(GeoDataObject *object);
+    void resetFromModel();
+
+private:
+    Q_DISABLE_COPY(PlacemarkRegistry)
+
+    PlacemarkRegistryPrivate *const d;
+};
+
+}
+
+#endif
@@ -9,8 +9,14 @@
 
 // Qt
 #include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QMessageBox>
+#include <QMutex>
 #include <QPluginLoader>
+#include <QThread>
 
 // Local dir
 #include "MarbleDebug.h"
@@ -29,18 +35,52 @@ namespace Marble
 class PluginManagerPrivate
 {
 public:
+    enum PluginType {
+        RenderPluginType,
+        PositionProviderPluginType,
+        SearchRunnerPluginType,
+        ReverseGeocodingRunnerPluginType,
+        RoutingRunnerPluginType,
+        ParseRunnerPluginType,
+        UnknownPluginType
+    };
+
+    /**
+     * A plugin found on disk or linked statically. Its type is known from the
+     * JSON metadata embedded in it, the library is only loaded on first use.
+     */
+    struct PluginEntry {
+        PluginType type = UnknownPluginType;
+        QPluginLoader *loader = nullptr;
+        QtPluginInstanceFunction staticInstance = nullptr;
+        QStringList fileExtensions;
+        bool loaded = false;
+    };
+
     PluginManagerPrivate(PluginManager *parent)
-        : m_pluginsLoaded(false)
+        : m_pluginsScanned(false)
+        , m_loadedTypes(0)
         , m_parent(parent)
     {
     }
 
     ~PluginManagerPrivate();
 
-    void loadPlugins();
+    void scanPlugins();
+    void loadPlugins(PluginType type);
+    void loadParseRunnerPlugins(const QString &suffix, const QString &completeSuffix);
+    void loadPlugin(PluginEntry &entry);
     bool addPlugin(QObject *obj, const QPluginLoader *loader);
+    void moveToManagerThread(QObject *object) const;
+
+    static PluginEntry createEntry(const QJsonObject &metaData);
 
-    bool m_pluginsLoaded;
+    // Parse runners are looked up from worker threads, e.g. when loading vector tiles.
+    // Guards all members below, plugin objects are moved to the thread of the manager.
+    QMutex m_mutex;
+    bool m_pluginsScanned;
+    int m_loadedTypes;
+    QList<PluginEntry> m_plugins;
     QList<const RenderPlugin *> m_renderPluginTemplates;
     QList<const PositionProviderPlugin *> m_positionProviderPluginTemplates;
     QList<const SearchRunnerPlugin *> m_searchRunnerPlugins;
@@ -61,7 +101,9 @@ QStringList PluginManagerPrivate::m_whitelist;
 
 PluginManagerPrivate::~PluginManagerPrivate()
 {
-    // nothing to do
+    for (const PluginEntry &entry : std::as_const(m_plugins)) {
+        delete entry.loader;
+    }
 }
 
 PluginManager::PluginManager(QObject *parent)
@@ -81,79 +123,122 @@ PluginManager::~PluginManager()
 
 QList<const RenderPlugin *> PluginManager::renderPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker(&d->m_mutex);
+    d->loadPlugins(PluginManagerPrivate::RenderPluginType);
     return d->m_renderPluginTemplates;
 }
 
 void PluginManager::addRenderPlugin(const RenderPlugin *plugin)
 {
-    d->loadPlugins();
-    d->m_renderPluginTemplates << plugin;
+    {
+        QMutexLocker locker(&d->m_mutex);
+        d->loadPlugins(PluginManagerPrivate::RenderPluginType);
+        d->m_renderPluginTemplates << plugin;
+    }
     Q_EMIT renderPluginsChanged();
 }
 
 QList<const PositionProviderPlugin *> PluginManager::positionProviderPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker(&d->m_mutex);
+    d->loadPlugins(PluginManagerPrivate::PositionProviderPluginType);
     return d->m_positionProviderPluginTemplates;
 }
 
 void PluginManager::addPositionProviderPlugin(const PositionProviderPlugin *plugin)
 {
-    d->loadPlugins();
-    d->m_positionProviderPluginTemplates << plugin;
+    {
+        QMutexLocker locker(&d->m_mutex);
+        d->loadPlugins(PluginManagerPrivate::PositionProviderPluginType);
+        d->m_positionProviderPluginTemplates << plugin;
+    }
     Q_EMIT positionProviderPluginsChanged();
 }
 
 QList<const SearchRunnerPlugin *> PluginManager::searchRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker(&d->m_mutex);
+    d->loadPlugins(PluginManagerPrivate::SearchRunnerPluginType);
     return d->m_searchRunnerPlugins;
 }
 
 void PluginManager::addSearchRunnerPlugin(const SearchRunnerPlugin *plugin)
 {
-    d->loadPlugins();
-    d->m_searchRunnerPlugins << plugin;
+    {
+        QMutexLocker locker(&d->m_mutex);
+        d->loadPlugins(PluginManagerPrivate::SearchRunnerPluginType);
+        d->m_searchRunnerPlugins << plugin;
+    }
     Q_EMIT searchRunnerPluginsChanged();
 }
 
 QList<const ReverseGeocodingRunnerPlugin *> PluginManager::reverseGeocodingRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker(&d->m_mutex);
+    d->loadPlugins(PluginManagerPrivate::ReverseGeocodingRunnerPluginType);
     return d->m_reverseGeocodingRunnerPlugins;
 }
 
 void PluginManager::addReverseGeocodingRunnerPlugin(const ReverseGeocodingRunnerPlugin *plugin)
 {
-    d->loadPlugins();
-    d->m_reverseGeocodingRunnerPlugins << plugin;
+    {
+        QMutexLocker locker(&d->m_mutex);
+        d->loadPlugins(PluginManagerPrivate::ReverseGeocodingRunnerPluginType);
+        d->m_reverseGeocodingRunnerPlugins << plugin;
+    }
     Q_EMIT reverseGeocodingRunnerPluginsChanged();
 }
 
 QList<RoutingRunnerPlugin *> PluginManager::routingRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker(&d->m_mutex);
+    d->loadPlugins(PluginManagerPrivate::RoutingRunnerPluginType);
     return d->m_routingRunnerPlugins;
 }
 
 void PluginManager::addRoutingRunnerPlugin(RoutingRunnerPlugin *plugin)
 {
-    d->loadPlugins();
-    d->m_routingRunnerPlugins << plugin;
+    {
+        QMutexLocker locker(&d->m_mutex);
+        d->loadPlugins(PluginManagerPrivate::RoutingRunnerPluginType);
+        d->m_routingRunnerPlugins << plugin;
+    }
     Q_EMIT routingRunnerPluginsChanged();
 }
 
 QList<const ParseRunnerPlugin *> PluginManager::parsingRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker(&d->m_mutex);
+    d->loadPlugins(PluginManagerPrivate::ParseRunnerPluginType);
     return d->m_parsingRunnerPlugins;
 }
 
+QList<const ParseRunnerPlugin *> PluginManager::parsingRunnerPlugins(const QString &fileName) const
+{
+    const QFileInfo fileInfo(fileName);
+    const QString suffix = fileInfo.suffix().toLower();
+    const QString completeSuffix = fileInfo.completeSuffix().toLower();
+
+    QMutexLocker locker(&d->m_mutex);
+    d->loadParseRunnerPlugins(suffix, completeSuffix);
+
+    QList<const ParseRunnerPlugin *> plugins;
+    for (const ParseRunnerPlugin *plugin : std::as_const(d->m_parsingRunnerPlugins)) {
+        QStringList const extensions = plugin->fileExtensions();
+        if (extensions.isEmpty() || extensions.contains(suffix) || extensions.contains(completeSuffix)) {
+            plugins << plugin;
+        }
+    }
+    return plugins;
+}
+
 void PluginManager::addParseRunnerPlugin(const ParseRunnerPlugin *plugin)
 {
-    d->loadPlugins();
-    d->m_parsingRunnerPlugins << plugin;
+    {
+        QMutexLocker locker(&d->m_mutex);
+        d->loadPlugins(PluginManagerPrivate::ParseRunnerPluginType);
+        d->m_parsingRunnerPlugins << plugin;
+    }
     Q_EMIT parseRunnerPluginsChanged();
 }
 
@@ -199,28 +284,40 @@ bool PluginManagerPrivate::addPlugin(QObject *obj, const QPluginLoader *loader)
     return isPlugin;
 }
 
-void PluginManagerPrivate::loadPlugins()
+PluginManagerPrivate::PluginEntry PluginManagerPrivate::createEntry(const QJsonObject &metaData)
 {
-    if (m_pluginsLoaded) {
+    static const QHash<QString, PluginType> types = {{QStringLiteral("RenderPlugin"), RenderPluginType},
+                                                     {QStringLiteral("PositionProviderPlugin"), PositionProviderPluginType},
+                                                     {QStringLiteral("SearchRunnerPlugin"), SearchRunnerPluginType},
+                                                     {QStringLiteral("ReverseGeocodingRunnerPlugin"), ReverseGeocodingRunnerPluginType},
+                                                     {QStringLiteral("RoutingRunnerPlugin"), RoutingRunnerPluginType},
+                                                     {QStringLiteral("ParseRunnerPlugin"), ParseRunnerPluginType}};
+
+    // Plugins without metadata are loaded along with the first plugin type requested
+    const QJsonObject pluginData = metaData.value(QLatin1StringView("MetaData")).toObject();
+    PluginEntry entry;
+    entry.type = types.value(pluginData.value(QLatin1StringView("Type")).toString(), UnknownPluginType);
+    const QJsonArray extensions = pluginData.value(QLatin1StringView("FileExtensions")).toArray();
+    for (const QJsonValue &extension : extensions) {
+        entry.fileExtensions << extension.toString();
+    }
+    return entry;
+}
+
+void PluginManagerPrivate::scanPlugins()
+{
+    if (m_pluginsScanned) {
         return;
     }
 
     QElapsedTimer t;
     t.start();
-    mDebug() << "Starting to load Plugins.";
+    mDebug() << "Starting to scan Plugins.";
 
     QStringList pluginFileNameList = MarbleDirs::pluginEntryList(QString(), QDir::Files);
 
     MarbleDirs::debug();
 
-    Q_ASSERT(m_renderPluginTemplates.isEmpty());
-    Q_ASSERT(m_positionProviderPluginTemplates.isEmpty());
-    Q_ASSERT(m_searchRunnerPlugins.isEmpty());
-    Q_ASSERT(m_reverseGeocodingRunnerPlugins.isEmpty());
-    Q_ASSERT(m_routingRunnerPlugins.isEmpty());
-    Q_ASSERT(m_parsingRunnerPlugins.isEmpty());
-
-    bool foundPlugin = false;
     for (const QString &fileName : pluginFileNameList) {
         QString const baseName = QFileInfo(fileName).baseName();
         QString const libBaseName = QString::fromLatin1(MARBLE_SHARED_LIBRARY_PREFIX) + QFileInfo(fileName).baseName();
@@ -243,32 +340,30 @@ void PluginManagerPrivate::loadPlugins()
             continue;
         }
 #endif
-        auto loader = new QPluginLoader(path, m_parent);
-
-        QObject *obj = loader->instance();
-
-        if (obj) {
-            bool isPlugin = addPlugin(obj, loader);
-            if (!isPlugin) {
-                delete loader;
-            } else {
-                foundPlugin = true;
-            }
-        } else {
+        // Reading the metadata does not load the library
+        auto loader = new QPluginLoader(path);
+        moveToManagerThread(loader);
+        const QJsonObject metaData = loader->metaData();
+        if (metaData.isEmpty()) {
             qWarning() << "Ignoring to load the following file since it doesn't look like a valid Marble plugin:" << path << Qt::endl
                        << "Reason:" << loader->errorString();
             delete loader;
+            continue;
         }
+
+        PluginEntry entry = createEntry(metaData);
+        entry.loader = loader;
+        m_plugins << entry;
     }
 
-    const auto staticPlugins = QPluginLoader::staticInstances();
-    for (auto obj : staticPlugins) {
-        if (addPlugin(obj, nullptr)) {
-            foundPlugin = true;
-        }
+    const auto staticPlugins = QPluginLoader::staticPlugins();
+    for (const QStaticPlugin &plugin : staticPlugins) {
+        PluginEntry entry = createEntry(plugin.metaData());
+        entry.staticInstance = plugin.instance;
+        m_plugins << entry;
     }
 
-    if (!foundPlugin) {
+    if (m_plugins.isEmpty()) {
 #ifdef Q_OS_WIN
         QString pluginPaths = "Plugin Path: " + MarbleDirs::marblePluginPath();
         if (MarbleDirs::marblePluginPath().isEmpty())
@@ -286,11 +381,87 @@ void PluginManagerPrivate::loadPlugins()
 #endif
     }
 
-    m_pluginsLoaded = true;
+    m_pluginsScanned = true;
 
     mDebug() << "Time elapsed:" << t.elapsed() << "ms";
 }
 
+void PluginManagerPrivate::loadPlugin(PluginEntry &entry)
+{
+    if (entry.loaded) {
+        return;
+    }
+    entry.loaded = true;
+
+    if (entry.staticInstance) {
+        QObject *obj = entry.staticInstance();
+        moveToManagerThread(obj);
+        addPlugin(obj, nullptr);
+        return;
+    }
+
+    QObject *obj = entry.loader->instance();
+    if (obj) {
+        moveToManagerThread(obj);
+        if (!addPlugin(obj, entry.loader)) {
+            delete entry.loader;
+            entry.loader = nullptr;
+        }
+    } else {
+        qWarning() << "Ignoring to load the following file since it doesn't look like a valid Marble plugin:" << entry.loader->fileName() << Qt::endl
+                   << "Reason:" << entry.loader->errorString();
+        delete entry.loader;
+        entry.loader = nullptr;
+    }
+}
+
+void PluginManagerPrivate::moveToManagerThread(QObject *object) const
+{
+    // Objects created while loading plugins from a worker thread would belong to it otherwise
+    if (object->thread() != m_parent->thread()) {
+        object->moveToThread(m_parent->thread());
+    }
+}
+
+void PluginManagerPrivate::loadPlugins(PluginType type)
+{
+    if (m_loadedTypes & (1 << type)) {
+        return;
+    }
+
+    scanPlugins();
+
+    QElapsedTimer t;
+    t.start();
+
+    for (PluginEntry &entry : m_plugins) {
+        if (entry.type == type || entry.type == UnknownPluginType) {
+            loadPlugin(entry);
+        }
+    }
+
+    m_loadedTypes |= 1 << type;
+
+    mDebug() << "Plugins of type" << type << "loaded in" << t.elapsed() << "ms";
+}
+
+void PluginManagerPrivate::loadParseRunnerPlugins(const QString &suffix, const QString &completeSuffix)
+{
+    if (m_loadedTypes & (1 << ParseRunnerPluginType)) {
+        return;
+    }
+
+    scanPlugins();
+
+    for (PluginEntry &entry : m_plugins) {
+        if (entry.type == UnknownPluginType
+            || (entry.type == ParseRunnerPluginType
+                && (entry.fileExtensions.isEmpty() || entry.fileExtensions.contains(suffix) || entry.fileExtensions.contains(completeSuffix)))) {
+            loadPlugin(entry);
+        }
+    }
+}
+
 #ifdef Q_OS_ANDROID
 void PluginManager::installPluginsFromAssets() const
 {
@@ -25,6 +25,9 @@ class ParseRunnerPlugin;
 /**
  * @short The class that handles Marble's plugins.
  *
+ * Plugins are enumerated from the JSON metadata embedded in them. A plugin
+ * library is only loaded once plugins of its type are requested.
+ *
  * Ownership policy for plugins:
  *
  * On every invocation of createNetworkPlugins and
@@ -121,6 +124,15 @@ public:
      */
     QList<const ParseRunnerPlugin *> parsingRunnerPlugins() const;
 
+    /**
+     * Returns the parse runner plugins that can open the given file, judged by its suffix.
+     * Plugins not restricted to certain file extensions are included. Other parse runner
+     * plugins are not loaded unless needed. This may be called from any thread, the plugins
+     * loaded by it live in the thread of the PluginManager.
+     * @note: The runner plugins are owned by the PluginManager, do not delete them.
+     */
+    QList<const ParseRunnerPlugin *> parsingRunnerPlugins(const QString &fileName) const;
+
     /**
      * @brief Add a ParseRunnerPlugin manually to the list of known plugins. Normally you
      * don't need to call this method since all plugins are loaded automatically.
@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "RenderProfiler.h"
+
+#include "MarbleDebug.h"
+
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
+
+namespace Marble
+{
+
+class RenderProfilerPrivate
+{
+public:
+    enum Type {
+        Duration,
+        Counter
+    };
+
+    /**
+     * A slot of the ring buffer. The sequence is odd while the slot is being
+     * written, and twice the number of the sample plus two once it is complete,
+     * so readers can tell torn and overwritten samples apart.
+     */
+    struct Slot {
+        QAtomicInteger<quint64> sequence;
+        QAtomicInteger<qint64> frame;
+        QAtomicInteger<qint64> start;
+        QAtomicInteger<qint64> value;
+        QAtomicInteger<int> type;
+        QAtomicInteger<int> name;
+        QAtomicInteger<int> category;
+    };
+
+    struct Sample {
+        qint64 frame;
+        qint64 start;
+        qint64 value;
+        Type type;
+        QString name;
+        QString category;
+    };
+
+    explicit RenderProfilerPrivate(int capacity);
+
+    int nameIndex(const QString &name);
+    void add(Type type, const QString &name, const QString &category, qint64 start, qint64 value);
+
+    /// Returns the samples currently held, oldest first
+    QList<Sample> samples() const;
+
+    const int m_capacity;
+    const std::unique_ptr<Slot[]> m_slots;
+    QAtomicInteger<quint64> m_written;
+    QAtomicInteger<quint64> m_cleared;
+    QAtomicInt m_enabled;
+    QElapsedTimer m_clock;
+
+    // Only used by the recording thread
+    qint64 m_frame;
+    qint64 m_frameStart;
+    QHash<QString, int> m_nameIndices;
+
+    // Names are appended while recording and read while exporting
+    mutable QMutex m_namesMutex;
+    QStringList m_names;
+};
+
+RenderProfilerPrivate::RenderProfilerPrivate(int capacity)
+    : m_capacity(qMax(1, capacity))
+    , m_slots(new Slot[m_capacity])
+    , m_written(0)
+    , m_cleared(0)
+    , m_enabled(qEnvironmentVariableIsSet("MARBLE_RENDER_PROFILE"))
+    , m_frame(0)
+    , m_frameStart(0)
+{
+    m_clock.start();
+}
+
+int RenderProfilerPrivate::nameIndex(const QString &name)
+{
+    const auto iterator = m_nameIndices.constFind(name);
+    if (iterator != m_nameIndices.constEnd()) {
+        return iterator.value();
+    }
+
+    QMutexLocker locker(&m_namesMutex);
+    const int index = m_names.size();
+    m_names << name;
+    m_nameIndices.insert(name, index);
+    return index;
+}
+
+void RenderProfilerPrivate::add(Type type, const QString &name, const QString &category, qint64 start, qint64 value)
+{
+    const quint64 number = m_written.loadRelaxed();
+    Slot &slot = m_slots[number % m_capacity];
+
+    slot.sequence.storeRelaxed(2 * number + 1);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.frame.storeRelaxed(m_frame);
+    slot.start.storeRelaxed(start);
+    slot.value.storeRelaxed(value);
+    slot.type.storeRelaxed(type);
+    slot.name.storeRelaxed(nameIndex(name));
+    slot.category.storeRelaxed(nameIndex(category));
+    slot.sequence.storeRelease(2 * number + 2);
+
+    m_written.storeRelease(number + 1);
+}
+
+QList<RenderProfilerPrivate::Sample> RenderProfilerPrivate::samples() const
+{
+    const quint64 written = m_written.loadAcquire();
+    const quint64 first = qMax(m_cleared.loadAcquire(), written > quint64(m_capacity) ? written - m_capacity : 0);
+
+    QStringList names;
+    {
+        QMutexLocker locker(&m_namesMutex);
+        names = m_names;
+    }
+
+    QList<Sample> result;
+    result.reserve(written - first);
+    for (quint64 number = first; number < written; ++number) {
+        const Slot &slot = m_slots[number % m_capacity];
+        const quint64 sequence = slot.sequence.loadAcquire();
+        Sample sample;
+        sample.frame = slot.frame.loadRelaxed();
+        sample.start = slot.start.loadRelaxed();
+        sample.value = slot.value.loadRelaxed();
+        sample.type = Type(slot.type.loadRelaxed());
+        const int name = slot.name.loadRelaxed();
+        const int category = slot.category.loadRelaxed();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence != 2 * number + 2 || slot.sequence.loadRelaxed() != sequence) {
+            // Overwritten by the recording thread meanwhile
+            continue;
+        }
+        sample.name = names.value(name);
+        sample.category = names.value(category);
+        result << sample;
+    }
+
+    return result;
+}
+
+RenderProfiler::RenderProfiler(int capacity)
+    : d(new RenderProfilerPrivate(capacity))
+{
+}
+
+RenderProfiler::~RenderProfiler()
+{
+    delete d;
+}
+
+void RenderProfiler::setEnabled(bool enabled)
+{
+    d->m_enabled.storeRelaxed(enabled);
+}
+
+bool RenderProfiler::isEnabled() const
+{
+    return d->m_enabled.loadRelaxed();
+}
+
+int RenderProfiler::capacity() const
+{
+    return d->m_capacity;
+}
+
+qint64 RenderProfiler::now() const
+{
+    return d->m_clock.nsecsElapsed();
+}
+
+void RenderProfiler::beginFrame()
+{
+    ++d->m_frame;
+    d->m_frameStart = now();
+}
+
+void RenderProfiler::endFrame()
+{
+    if (isEnabled()) {
+        d->add(RenderProfilerPrivate::Duration, QStringLiteral("Frame"), QStringLiteral("Frame"), d->m_frameStart, now() - d->m_frameStart);
+    }
+}
+
+void RenderProfiler::addDuration(const QString &name, const QString &category, qint64 start, qint64 duration)
+{
+    if (isEnabled()) {
+        d->add(RenderProfilerPrivate::Duration, name, category, start, duration);
+    }
+}
+
+void RenderProfiler::addCounter(const QString &name, qint64 value)
+{
+    if (isEnabled()) {
+        d->add(RenderProfilerPrivate::Counter, name, QStringLiteral("Counter"), now(), value);
+    }
+}
+
+void RenderProfiler::clear()
+{
+    d->m_cleared.storeRelease(d->m_written.loadAcquire());
+}
+
+QByteArray RenderProfiler::toChromeTrace() const
+{
+    QJsonArray events;
+    const QList<RenderProfilerPrivate::Sample> samples = d->samples();
+    for (const RenderProfilerPrivate::Sample &sample : samples) {
+        QJsonObject event;
+        event[QStringLiteral("name")] = sample.name;
+        event[QStringLiteral("cat")] = sample.category;
+        event[QStringLiteral("pid")] = 1;
+        event[QStringLiteral("tid")] = 1;
+        // The format expects microseconds
+        event[QStringLiteral("ts")] = sample.start / 1000.0;
+        if (sample.type == RenderProfilerPrivate::Duration) {
+            event[QStringLiteral("ph")] = QStringLiteral("X");
+            event[QStringLiteral("dur")] = sample.value / 1000.0;
+            event[QStringLiteral("args")] = QJsonObject{{QStringLiteral("frame"), sample.frame}};
+        } else {
+            event[QStringLiteral("ph")] = QStringLiteral("C");
+            event[QStringLiteral("args")] = QJsonObject{{QStringLiteral("value"), sample.value}};
+        }
+        events.append(event);
+    }
+
+    QJsonObject trace;
+    trace[QStringLiteral("traceEvents")] = events;
+    trace[QStringLiteral("displayTimeUnit")] = QStringLiteral("ms");
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+QByteArray RenderProfiler::toCsv() const
+{
+    QByteArray result("frame,type,category,name,start_us,duration_us,value\n");
+    const QList<RenderProfilerPrivate::Sample> samples = d->samples();
+    for (const RenderProfilerPrivate::Sample &sample : samples) {
+        const bool duration = sample.type == RenderProfilerPrivate::Duration;
+        QString name = sample.name;
+        name.replace(QLatin1Char('"'), QLatin1StringView("\"\""));
+        const QStringList fields = {QString::number(sample.frame),
+                                    duration ? QStringLiteral("duration") : QStringLiteral("counter"),
+                                    sample.category,
+                                    QLatin1Char('"') + name + QLatin1Char('"'),
+                                    QString::number(sample.start / 1000.0, 'f', 3),
+                                    duration ? QString::number(sample.value / 1000.0, 'f', 3) : QString(),
+                                    duration ? QString() : QString::number(sample.value)};
+        result += fields.join(QLatin1Char(',')).toUtf8() + '\n';
+    }
+    return result;
+}
+
+bool RenderProfiler::save(const QString &fileName, Format format) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        mDebug() << "Cannot write render profile to" << fileName << file.errorString();
+        return false;
+    }
+
+    const QByteArray data = format == ChromeTrace ? toChromeTrace() : toCsv();
+    return file.write(data) == data.size();
+}
+
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_RENDERPROFILER_H
+#define MARBLE_RENDERPROFILER_H
+
+#include "marble_export.h"
+
+#include <QtGlobal>
+
+class QByteArray;
+class QString;
+
+namespace Marble
+{
+
+class RenderProfilerPrivate;
+
+/**
+ * @short Records timings and counters of the rendered frames.
+ *
+ * While enabled, MarbleMap records the time spent in each render position
+ * and in each layer, and per frame the tile cache hit rate, the number of
+ * pending downloads and the number of placemarks laid out. The most recent
+ * samples are kept in a ring buffer of fixed size and can be exported at any
+ * time, either in the Trace Event format understood by chrome://tracing and
+ * Perfetto, or as CSV.
+ *
+ * Samples are recorded from the thread rendering the map without taking
+ * locks; exporting is safe from any thread.
+ *
+ * @see MarbleMap::renderProfiler()
+ */
+class MARBLE_EXPORT RenderProfiler
+{
+public:
+    enum Format {
+        ChromeTrace,
+        Csv
+    };
+
+    explicit RenderProfiler(int capacity = 16384);
+    ~RenderProfiler();
+
+    /**
+     * Switches recording on or off. Recording is off initially, unless the
+     * environment variable MARBLE_RENDER_PROFILE is set.
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /// The number of samples kept at most, older samples get overwritten
+    int capacity() const;
+
+    /// Returns the nanoseconds passed since the profiler was created
+    qint64 now() const;
+
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * Records that @p name took @p duration nanoseconds starting at @p start,
+     * both as returned by now().
+     */
+    void addDuration(const QString &name, const QString &category, qint64 start, qint64 duration);
+
+    /// Records the value of the counter @p name for the current frame
+    void addCounter(const QString &name, qint64 value);
+
+    /// Drops all samples recorded so far
+    void clear();
+
+    QByteArray toChromeTrace() const;
+    QByteArray toCsv() const;
+
+    bool save(const QString &fileName, Format format) const;
+
+private:
+    Q_DISABLE_COPY(RenderProfiler)
+
+    RenderProfilerPrivate *const d;
+};
+
+}
+
+#endif
@@ -14,6 +14,8 @@
 #include "ViewParams.h"
 #include "ViewportParams.h"
 
+#include <cstring>
+
 using namespace Marble;
 
 ScanlineTextureMapperContext::ScanlineTextureMapperContext(StackedTileLoader *const tileLoader, int tileLevel)
@@ -388,6 +390,82 @@ QImage::Format ScanlineTextureMapperContext::optimalCanvasImageFormat(const View
     return imageFormat;
 }
 
+QList<QRect> ScanlineTextureMapperContext::scrollCanvasImage(QImage *canvasImage, int dx, int dy)
+{
+    const int width = canvasImage->width();
+    const int height = canvasImage->height();
+    Q_ASSERT(qAbs(dx) < width && qAbs(dy) < height);
+
+    // Detach first, the rows are moved within the same buffer
+    uchar *const bits = canvasImage->bits();
+    const qsizetype bytesPerLine = canvasImage->bytesPerLine();
+    const int bytesPerPixel = canvasImage->depth() / 8;
+    const qsizetype rowLength = qsizetype(width - qAbs(dx)) * bytesPerPixel;
+    const qsizetype sourceX = qsizetype(qMax(0, -dx)) * bytesPerPixel;
+    const qsizetype targetX = qsizetype(qMax(0, dx)) * bytesPerPixel;
+
+    const int top = qMax(0, dy);
+    const int bottom = height + qMin(0, dy);
+
+    // Moving down, start at the bottom not to overwrite rows still to be moved
+    if (dy > 0) {
+        for (int y = bottom - 1; y >= top; --y) {
+            memmove(bits + y * bytesPerLine + targetX, bits + (y - dy) * bytesPerLine + sourceX, rowLength);
+        }
+    } else {
+        for (int y = top; y < bottom; ++y) {
+            memmove(bits + y * bytesPerLine + targetX, bits + (y - dy) * bytesPerLine + sourceX, rowLength);
+        }
+    }
+
+    QList<QRect> uncovered;
+    if (dy > 0) {
+        uncovered << QRect(0, 0, width, dy);
+    } else if (dy < 0) {
+        uncovered << QRect(0, bottom, width, -dy);
+    }
+    if (dx > 0) {
+        uncovered << QRect(0, top, dx, bottom - top);
+    } else if (dx < 0) {
+        uncovered << QRect(width + dx, top, -dx, bottom - top);
+    }
+
+    return uncovered;
+}
+
+ScanlineRowScheduler::ScanlineRowScheduler(const QList<QRect> &areas, int blockHeight)
+    : m_blockHeight(qMax(2, blockHeight & ~1))
+    , m_blockCount(0)
+    , m_nextBlock(0)
+{
+    for (const QRect &area : areas) {
+        if (area.isEmpty()) {
+            continue;
+        }
+        m_areas << area;
+        m_firstBlocks << m_blockCount;
+        m_blockCount += (area.height() + m_blockHeight - 1) / m_blockHeight;
+    }
+}
+
+bool ScanlineRowScheduler::nextBlock(QRect &block)
+{
+    const int index = m_nextBlock.fetchAndAddRelaxed(1);
+    if (index >= m_blockCount) {
+        return false;
+    }
+
+    int area = m_firstBlocks.size() - 1;
+    while (m_firstBlocks.at(area) > index) {
+        --area;
+    }
+
+    const QRect &rect = m_areas.at(area);
+    const int top = rect.top() + (index - m_firstBlocks.at(area)) * m_blockHeight;
+    block = QRect(rect.left(), top, rect.width(), qMin(m_blockHeight, rect.bottom() + 1 - top));
+    return true;
+}
+
 void ScanlineTextureMapperContext::nextTile(int &posX, int &posY)
 {
     // Move from tile coordinates to global texture coordinates
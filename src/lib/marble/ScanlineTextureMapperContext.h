@@ -7,12 +7,16 @@
 #ifndef MARBLE_SCANLINETEXTUREMAPPERCONTEXT_H
 #define MARBLE_SCANLINETEXTUREMAPPERCONTEXT_H
 
+#include <QAtomicInt>
 #include <QImage>
+#include <QList>
+#include <QRect>
 #include <QSize>
 
 #include "GeoSceneTileDataset.h"
 #include "MarbleMath.h"
 #include "MathHelper.h"
+#include "marble_export.h"
 
 namespace Marble
 {
@@ -21,7 +25,7 @@ class StackedTile;
 class StackedTileLoader;
 class ViewportParams;
 
-class ScanlineTextureMapperContext
+class MARBLE_EXPORT ScanlineTextureMapperContext
 {
 public:
     ScanlineTextureMapperContext(StackedTileLoader *const tileLoader, int tileLevel);
@@ -36,6 +40,13 @@ public:
 
     static QImage::Format optimalCanvasImageFormat(const ViewportParams *viewport);
 
+    /**
+     * Moves the content of @p canvasImage by @p dx pixels to the right and by
+     * @p dy pixels down, and returns the areas uncovered by the move. Their
+     * content is undefined.
+     */
+    static QList<QRect> scrollCanvasImage(QImage *canvasImage, int dx, int dy);
+
     int globalWidth() const;
     int globalHeight() const;
 
@@ -91,6 +102,43 @@ private:
     qreal m_prevPixelY;
 };
 
+/**
+ * @short Hands out the rows to map to the render jobs of a texture mapper.
+ *
+ * The areas to map are cut into blocks of a few rows, which the render jobs
+ * fetch one after the other until none is left. A job that got cheap rows,
+ * e.g. rows mostly outside of the globe or covered by a single tile, takes
+ * over more blocks instead of idling until the other jobs are done.
+ *
+ * Blocks start at an even row offset within their area, so interlaced
+ * mapping can keep copying each mapped row into the row below.
+ */
+class MARBLE_EXPORT ScanlineRowScheduler
+{
+public:
+    explicit ScanlineRowScheduler(const QList<QRect> &areas, int blockHeight = 16);
+
+    /// Fetches the next block of rows, returns false once all are taken
+    bool nextBlock(QRect &block);
+
+    int blockCount() const;
+
+private:
+    Q_DISABLE_COPY(ScanlineRowScheduler)
+
+    QList<QRect> m_areas;
+    // The index of the first block of each area
+    QList<int> m_firstBlocks;
+    const int m_blockHeight;
+    int m_blockCount;
+    QAtomicInt m_nextBlock;
+};
+
+inline int ScanlineRowScheduler::blockCount() const
+{
+    return m_blockCount;
+}
+
 inline int ScanlineTextureMapperContext::globalWidth() const
 {
     return m_globalWidth;
@@ -16,10 +16,14 @@
 #include "TileLoader.h"
 #include "TileLoaderHelper.h"
 
+#include <QAtomicInteger>
 #include <QCache>
+#include <QFuture>
 #include <QHash>
 #include <QImage>
+#include <QPromise>
 #include <QReadWriteLock>
+#include <QScopeGuard>
 
 namespace Marble
 {
@@ -29,6 +33,9 @@ class StackedTileLoaderPrivate
 public:
     explicit StackedTileLoaderPrivate(MergedLayerDecorator *mergedLayerDecorator)
         : m_layerDecorator(mergedLayerDecorator)
+        , m_loadCount(0)
+        , m_hitCount(0)
+        , m_missCount(0)
     {
         m_tileCache.setMaxCost(20000 * 1024); // Cache size measured in bytes
     }
@@ -36,7 +43,26 @@ public:
     MergedLayerDecorator *const m_layerDecorator;
     QHash<TileId, StackedTile *> m_tilesOnDisplay;
     QCache<TileId, StackedTile> m_tileCache;
+    struct PendingTile {
+        QFuture<StackedTile *> future;
+        quint64 load;
+    };
+
+    /**
+     * Tiles being loaded by one of the threads, the others wait for the result.
+     * clear() and updateTile() drop the entries, so that the results of the
+     * loads still running are not put into the hash.
+     */
+    QHash<TileId, PendingTile> m_pendingTiles;
+    /// Numbers the loads to tell whether the entry in m_pendingTiles is still the own one
+    quint64 m_loadCount;
+    /// Dropped results, kept until the threads waiting for them are done with the frame
+    QList<StackedTile *> m_staleTiles;
+    // Guards the hash, the cache, the pending and the stale tiles
     QReadWriteLock m_cacheLock;
+    // Tiles are requested by several threads of the texture mapper
+    QAtomicInteger<quint64> m_hitCount;
+    QAtomicInteger<quint64> m_missCount;
 };
 
 StackedTileLoader::StackedTileLoader(MergedLayerDecorator *mergedLayerDecorator, QObject *parent)
@@ -48,6 +74,7 @@ StackedTileLoader::StackedTileLoader(MergedLayerDecorator *mergedLayerDecorator,
 StackedTileLoader::~StackedTileLoader()
 {
     qDeleteAll(d->m_tilesOnDisplay);
+    qDeleteAll(d->m_staleTiles);
     delete d;
 }
 
@@ -73,6 +100,7 @@ QSize StackedTileLoader::tileSize() const
 
 void StackedTileLoader::resetTilehash()
 {
+    QWriteLocker locker(&d->m_cacheLock);
     QHash<TileId, StackedTile *>::const_iterator it = d->m_tilesOnDisplay.constBegin();
     QHash<TileId, StackedTile *>::const_iterator const end = d->m_tilesOnDisplay.constEnd();
     for (; it != end; ++it) {
@@ -86,6 +114,12 @@ void StackedTileLoader::cleanupTilehash()
     // Make sure that tiles which haven't been used during the last
     // rendering of the map at all get removed from the tile hash.
 
+    QWriteLocker locker(&d->m_cacheLock);
+
+    // No thread uses the tiles of the last frame anymore
+    qDeleteAll(d->m_staleTiles);
+    d->m_staleTiles.clear();
+
     QHashIterator<TileId, StackedTile *> it(d->m_tilesOnDisplay);
     while (it.hasNext()) {
         it.next();
@@ -104,11 +138,13 @@ const StackedTile *StackedTileLoader::loadTile(TileId const &stackedTileId)
     // check if the tile is in the hash
     d->m_cacheLock.lockForRead();
     StackedTile *stackedTile = d->m_tilesOnDisplay.value(stackedTileId, nullptr);
-    d->m_cacheLock.unlock();
     if (stackedTile) {
         stackedTile->setUsed(true);
+        d->m_cacheLock.unlock();
+        d->m_hitCount.fetchAndAddRelaxed(1);
         return stackedTile;
     }
+    d->m_cacheLock.unlock();
     // here ends the performance critical section of this method
 
     d->m_cacheLock.lockForWrite();
@@ -118,6 +154,7 @@ const StackedTile *StackedTileLoader::loadTile(TileId const &stackedTileId)
     if (stackedTile) {
         Q_ASSERT(stackedTile->used() && "other thread should have marked tile as used");
         d->m_cacheLock.unlock();
+        d->m_hitCount.fetchAndAddRelaxed(1);
         return stackedTile;
     }
 
@@ -128,44 +165,110 @@ const StackedTile *StackedTileLoader::loadTile(TileId const &stackedTileId)
         stackedTile->setUsed(true);
         d->m_tilesOnDisplay[stackedTileId] = stackedTile;
         d->m_cacheLock.unlock();
+        d->m_hitCount.fetchAndAddRelaxed(1);
         return stackedTile;
     }
 
+    // is another thread loading our tile already?
+    const auto pending = d->m_pendingTiles.constFind(stackedTileId);
+    if (pending != d->m_pendingTiles.constEnd()) {
+        QFuture<StackedTile *> future = pending->future;
+        d->m_cacheLock.unlock();
+        future.waitForFinished();
+        if (future.resultCount() > 0) {
+            return future.result();
+        }
+        // loading failed in the other thread, try on our own
+        return loadTile(stackedTileId);
+    }
+
     // tile (valid) has not been found in hash or cache, so load it from disk
-    // and place it in the hash from where it will get transferred to the cache
+    // and place it in the hash from where it will get transferred to the cache.
+    // Loading happens without holding the lock, so that other threads can
+    // meanwhile use the tiles already loaded or load other tiles.
+
+    QPromise<StackedTile *> promise;
+    promise.start();
+    const quint64 load = ++d->m_loadCount;
+    d->m_pendingTiles.insert(stackedTileId, {promise.future(), load});
+    d->m_cacheLock.unlock();
+
+    // If loading fails, the waiting threads get no result and load the tile themselves
+    auto failure = qScopeGuard([this, &stackedTileId, &promise, load]() {
+        d->m_cacheLock.lockForWrite();
+        const auto pending = d->m_pendingTiles.constFind(stackedTileId);
+        if (pending != d->m_pendingTiles.constEnd() && pending->load == load) {
+            d->m_pendingTiles.erase(pending);
+        }
+        d->m_cacheLock.unlock();
+        promise.finish();
+    });
 
     mDebug() << "load tile from disk:" << stackedTileId;
+    d->m_missCount.fetchAndAddRelaxed(1);
 
     stackedTile = d->m_layerDecorator->loadTile(stackedTileId);
-    Q_ASSERT(stackedTile);
+    if (!stackedTile) {
+        mDebug() << "failed to load tile" << stackedTileId;
+        return nullptr;
+    }
+    failure.dismiss();
     stackedTile->setUsed(true);
 
-    d->m_tilesOnDisplay[stackedTileId] = stackedTile;
+    d->m_cacheLock.lockForWrite();
+    const auto own = d->m_pendingTiles.constFind(stackedTileId);
+    const bool current = own != d->m_pendingTiles.constEnd() && own->load == load;
+    if (current) {
+        d->m_pendingTiles.erase(own);
+        d->m_tilesOnDisplay[stackedTileId] = stackedTile;
+    } else {
+        // The tiles were cleared or updated meanwhile, the result is only good for the current frame
+        d->m_staleTiles << stackedTile;
+    }
     d->m_cacheLock.unlock();
 
-    Q_EMIT tileLoaded(stackedTileId);
+    promise.addResult(stackedTile);
+    promise.finish();
+
+    if (current) {
+        Q_EMIT tileLoaded(stackedTileId);
+    }
 
     return stackedTile;
 }
 
 quint64 StackedTileLoader::volatileCacheLimit() const
 {
+    QReadLocker locker(&d->m_cacheLock);
     return d->m_tileCache.maxCost() / 1024;
 }
 
 QList<TileId> StackedTileLoader::visibleTiles() const
 {
+    QReadLocker locker(&d->m_cacheLock);
     return d->m_tilesOnDisplay.keys();
 }
 
 int StackedTileLoader::tileCount() const
 {
+    QReadLocker locker(&d->m_cacheLock);
     return d->m_tileCache.count() + d->m_tilesOnDisplay.count();
 }
 
+quint64 StackedTileLoader::tileHitCount() const
+{
+    return d->m_hitCount.loadRelaxed();
+}
+
+quint64 StackedTileLoader::tileMissCount() const
+{
+    return d->m_missCount.loadRelaxed();
+}
+
 void StackedTileLoader::setVolatileCacheLimit(quint64 kiloBytes)
 {
     mDebug() << QStringLiteral("Setting tile cache to %1 kilobytes.").arg(kiloBytes);
+    QWriteLocker locker(&d->m_cacheLock);
     d->m_tileCache.setMaxCost(kiloBytes * 1024);
 }
 
@@ -173,6 +276,11 @@ void StackedTileLoader::updateTile(TileId const &tileId, QImage const &tileImage
 {
     const TileId stackedTileId(0, tileId.zoomLevel(), tileId.x(), tileId.y());
 
+    d->m_cacheLock.lockForWrite();
+
+    // A load still running may have read the outdated image
+    d->m_pendingTiles.remove(stackedTileId);
+
     StackedTile *displayedTile = d->m_tilesOnDisplay.take(stackedTileId);
     if (displayedTile) {
         Q_ASSERT(!d->m_tileCache.contains(stackedTileId));
@@ -184,15 +292,35 @@ void StackedTileLoader::updateTile(TileId const &tileId, QImage const &tileImage
         delete displayedTile;
         displayedTile = nullptr;
 
+        d->m_cacheLock.unlock();
+
         Q_EMIT tileLoaded(stackedTileId);
     } else {
         d->m_tileCache.remove(stackedTileId);
+        d->m_cacheLock.unlock();
     }
 }
 
+void StackedTileLoader::discardTile(TileId const &tileId)
+{
+    // Tiles of other datasets, e.g. elevation data, are cancelled through the same download manager
+    if (!d->m_layerDecorator->isTextureLayerTile(tileId)) {
+        return;
+    }
+
+    const TileId stackedTileId(0, tileId.zoomLevel(), tileId.x(), tileId.y());
+
+    d->m_cacheLock.lockForWrite();
+    d->m_pendingTiles.remove(stackedTileId);
+    delete d->m_tilesOnDisplay.take(stackedTileId);
+    d->m_tileCache.remove(stackedTileId);
+    d->m_cacheLock.unlock();
+}
+
 RenderState StackedTileLoader::renderState() const
 {
     RenderState renderState(QString::fromLatin1("Stacked Tiles"));
+    QReadLocker locker(&d->m_cacheLock);
     QHash<TileId, StackedTile *>::const_iterator it = d->m_tilesOnDisplay.constBegin();
     QHash<TileId, StackedTile *>::const_iterator const end = d->m_tilesOnDisplay.constEnd();
     for (; it != end; ++it) {
@@ -203,9 +331,12 @@ RenderState StackedTileLoader::renderState() const
 
 void StackedTileLoader::clear()
 {
+    d->m_cacheLock.lockForWrite();
     qDeleteAll(d->m_tilesOnDisplay);
     d->m_tilesOnDisplay.clear();
     d->m_tileCache.clear(); // clear the tile cache in physical memory
+    d->m_pendingTiles.clear(); // loads still running must not put their tiles back
+    d->m_cacheLock.unlock();
 
     Q_EMIT cleared();
 }
@@ -13,6 +13,7 @@
 #include <QObject>
 
 #include "RenderState.h"
+#include "marble_export.h"
 
 class QImage;
 class QString;
@@ -41,7 +42,7 @@ class StackedTileLoaderPrivate;
  * @author Torsten Rahn <rahn@kde.org>
  **/
 
-class StackedTileLoader : public QObject
+class MARBLE_EXPORT StackedTileLoader : public QObject
 {
     Q_OBJECT
 
@@ -67,6 +68,15 @@ public:
     /**
      * Loads a tile and returns it.
      *
+     * This method may be called from several threads at once. Tiles missing
+     * from memory are loaded concurrently, a thread requesting a tile that is
+     * being loaded by another thread waits for that tile only.
+     *
+     * Tiles still being loaded when clear() or updateTile() is called are
+     * returned to the threads that requested them, but are not kept. The
+     * returned tiles stay valid until cleanupTilehash(), clear() or
+     * updateTile() is called.
+     *
      * @param stackedTileId The Id of the requested tile, containing the x and y coordinate
      *                      and the zoom level.
      */
@@ -80,7 +90,8 @@ public:
     /**
      * Cleans up the internal tile hash.
      *
-     * Removes all superfluous tiles from the hash.
+     * Removes all superfluous tiles from the hash. This must not be called
+     * while tiles are used by loadTile() callers, i.e. while a frame is rendered.
      */
     void cleanupTilehash();
 
@@ -101,6 +112,16 @@ public:
      */
     int tileCount() const;
 
+    /**
+     * @brief Return the number of tiles found in memory by loadTile() so far.
+     */
+    quint64 tileHitCount() const;
+
+    /**
+     * @brief Return the number of tiles loadTile() had to load from disk so far.
+     */
+    quint64 tileMissCount() const;
+
     /**
      * @brief Set the limit of the volatile (in RAM) cache.
      * @param kiloBytes The limit in kilobytes.
@@ -117,6 +138,15 @@ public:
      */
     void updateTile(TileId const &tileId, QImage const &tileImage);
 
+    /**
+     * Drops the stacked tile containing @p tileId, so that it gets loaded again
+     * the next time it is needed.
+     *
+     * This is used when the download of a tile got cancelled, as the stacked tile
+     * would otherwise keep showing the replacement for good.
+     */
+    void discardTile(TileId const &tileId);
+
     RenderState renderState() const;
 
 Q_SIGNALS:
@@ -13,4 +13,22 @@ StoragePolicy::StoragePolicy(QObject *parent)
 {
 }
 
+CacheValidators StoragePolicy::validators(const QString &fileName) const
+{
+    Q_UNUSED(fileName);
+    return {};
+}
+
+void StoragePolicy::setValidators(const QString &fileName, const CacheValidators &validators)
+{
+    Q_UNUSED(fileName);
+    Q_UNUSED(validators);
+}
+
+bool StoragePolicy::refreshFile(const QString &fileName)
+{
+    Q_UNUSED(fileName);
+    return false;
+}
+
 #include "moc_StoragePolicy.cpp"
@@ -7,14 +7,28 @@
 #ifndef MARBLE_STORAGEPOLICY_H
 #define MARBLE_STORAGEPOLICY_H
 
+#include <QByteArray>
 #include <QObject>
 
-class QByteArray;
 class QString;
 
 namespace Marble
 {
 
+/**
+ * The validators a server sent along with a file. They allow asking the server
+ * later on whether the file changed, instead of downloading it again.
+ */
+struct CacheValidators {
+    QByteArray eTag;
+    QByteArray lastModified;
+
+    bool isEmpty() const
+    {
+        return eTag.isEmpty() && lastModified.isEmpty();
+    }
+};
+
 class StoragePolicy : public QObject
 {
     Q_OBJECT
@@ -31,6 +45,23 @@ public:
      */
     virtual bool updateFile(const QString &fileName, const QByteArray &data) = 0;
 
+    /**
+     * Returns the validators stored along with @p fileName, or none if the
+     * file does not exist or the policy does not keep validators.
+     */
+    virtual CacheValidators validators(const QString &fileName) const;
+
+    /**
+     * Stores the @p validators along with @p fileName, replacing any previous ones.
+     */
+    virtual void setValidators(const QString &fileName, const CacheValidators &validators);
+
+    /**
+     * Marks @p fileName as up to date without changing its content.
+     * Return true if the file was refreshed.
+     */
+    virtual bool refreshFile(const QString &fileName);
+
     virtual void clearCache() = 0;
 
     virtual QString lastErrorMessage() const = 0;
@@ -30,6 +30,8 @@
 #include <QScreen>
 #include <QSet>
 
+#include <mutex>
+
 namespace Marble
 {
 
@@ -109,7 +111,9 @@ public:
     static QString createPaintLayerItem(const QString &itemType, GeoDataPlacemark::GeoDataVisualCategory visualCategory, const QString &subType = QString());
 
     static void initializeOsmVisualCategories();
+    static void fillOsmVisualCategories();
     static void initializeMinimumZoomLevels();
+    static void fillMinimumZoomLevels();
 
     int m_maximumZoomLevel;
     QColor m_defaultLabelColor;
@@ -1666,11 +1670,13 @@ QString StyleBuilder::Private::createPaintLayerItem(const QString &itemType, Geo
 
 void StyleBuilder::Private::initializeOsmVisualCategories()
 {
-    // Only initialize the map once
-    if (!s_visualCategories.isEmpty()) {
-        return;
-    }
+    // Only initialize the map once, style builders are used from several threads
+    static std::once_flag initialized;
+    std::call_once(initialized, fillOsmVisualCategories);
+}
 
+void StyleBuilder::Private::fillOsmVisualCategories()
+{
     s_visualCategories[OsmTag("admin_level", "1")] = GeoDataPlacemark::AdminLevel1;
     s_visualCategories[OsmTag("admin_level", "2")] = GeoDataPlacemark::AdminLevel2;
     s_visualCategories[OsmTag("admin_level", "3")] = GeoDataPlacemark::AdminLevel3;
@@ -2046,11 +2052,16 @@ void StyleBuilder::Private::initializeOsmVisualCategories()
 
 void StyleBuilder::Private::initializeMinimumZoomLevels()
 {
-    if (s_defaultMinZoomLevelsInitialized) {
-        return;
-    }
+    // Other threads must not see the levels before they are all set
+    static std::once_flag initialized;
+    std::call_once(initialized, []() {
+        fillMinimumZoomLevels();
+        s_defaultMinZoomLevelsInitialized = true;
+    });
+}
 
-    s_defaultMinZoomLevelsInitialized = true;
+void StyleBuilder::Private::fillMinimumZoomLevels()
+{
     for (int i = 0; i < GeoDataPlacemark::LastIndex; i++) {
         s_defaultMinZoomLevels[i] = -1;
     }
@@ -2430,9 +2441,9 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::presetStyle(GeoDataPlacemark::GeoD
 
 QStringList StyleBuilder::renderOrder() const
 {
-    static QStringList paintLayerOrder;
-
-    if (paintLayerOrder.isEmpty()) {
+    // Style builders are used from several threads, e.g. by the batch renderer
+    static const QStringList paintLayerOrder = []() {
+        QStringList paintLayerOrder;
         paintLayerOrder << Private::createPaintLayerItem("Polygon", GeoDataPlacemark::Landmass);
         paintLayerOrder << Private::createPaintLayerItem("Polygon", GeoDataPlacemark::UrbanArea);
         paintLayerOrder << Private::createPaintLayerItem("Polygon", GeoDataPlacemark::LanduseResidential);
@@ -2564,7 +2575,8 @@ QStringList StyleBuilder::renderOrder() const
 
         // This assert checks that all the values in paintLayerOrder are unique.
         Q_ASSERT(QSet<QString>(paintLayerOrder.constBegin(), paintLayerOrder.constEnd()).size() == paintLayerOrder.size());
-    }
+        return paintLayerOrder;
+    }();
 
     return paintLayerOrder;
 }
@@ -2590,7 +2602,8 @@ qint64 StyleBuilder::popularity(const GeoDataPlacemark *placemark)
 {
     qint64 const defaultValue = 100;
     int const offset = 10;
-    if (StyleBuilder::Private::s_popularities.isEmpty()) {
+    static std::once_flag popularitiesInitialized;
+    std::call_once(popularitiesInitialized, [=]() {
         QList<GeoDataPlacemark::GeoDataVisualCategory> popularities;
         popularities << GeoDataPlacemark::PlaceCityNationalCapital;
         popularities << GeoDataPlacemark::PlaceTownNationalCapital;
@@ -2794,7 +2807,7 @@ qint64 StyleBuilder::popularity(const GeoDataPlacemark *placemark)
             StyleBuilder::Private::s_popularities[popularity] = value;
             value -= offset;
         }
-    }
+    });
 
     bool const isPrivate = placemark->osmData().containsTag(QStringLiteral("access"), QStringLiteral("private"));
     int const base = defaultValue + (isPrivate ? 0 : offset * StyleBuilder::Private::s_popularities.size());
@@ -2808,9 +2821,8 @@ int StyleBuilder::maximumZoomLevel() const
 
 QString StyleBuilder::visualCategoryName(GeoDataPlacemark::GeoDataVisualCategory category)
 {
-    static QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> visualCategoryNames;
-
-    if (visualCategoryNames.isEmpty()) {
+    static const QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> visualCategoryNames = []() {
+        QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> visualCategoryNames;
         visualCategoryNames[GeoDataPlacemark::None] = "None";
         visualCategoryNames[GeoDataPlacemark::Default] = "Default";
         visualCategoryNames[GeoDataPlacemark::Unknown] = "Unknown";
@@ -3168,10 +3180,11 @@ QString StyleBuilder::visualCategoryName(GeoDataPlacemark::GeoDataVisualCategory
         visualCategoryNames[GeoDataPlacemark::IndoorWall] = "IndoorWall";
         visualCategoryNames[GeoDataPlacemark::IndoorRoom] = "IndoorRoom";
         visualCategoryNames[GeoDataPlacemark::LastIndex] = "LastIndex";
-    }
+        return visualCategoryNames;
+    }();
 
     Q_ASSERT(visualCategoryNames.contains(category));
-    return visualCategoryNames[category];
+    return visualCategoryNames.value(category);
 }
 
 QColor StyleBuilder::effectColor(const QColor &color)
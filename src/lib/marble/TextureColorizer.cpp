@@ -13,8 +13,11 @@
 #include <QList>
 #include <QPainter>
 #include <QSharedPointer>
+#include <QtConcurrentMap>
 #include <qmath.h>
 
+#include <cstring>
+
 #include "AbstractProjection.h"
 #include "GeoDataFeature.h"
 #include "GeoDataLinearRing.h"
@@ -29,35 +32,15 @@
 namespace Marble
 {
 
-// 4 uchar long queue
-class EmbossFifo
-{
-public:
-    EmbossFifo()
-        : data(0)
-    {
-    }
-
-    inline uchar head() const
-    {
-        // return least significant byte as head of queue
-        return data & 0x000000FF;
-    }
-
-    inline void enqueue(uchar value)
-    {
-        // drop current head by shifting by one byte
-        // and append new value as most significant byte to queue
-        data = ((data >> 8) & 0x00FFFFFF) | (value << 24);
-    }
-
-private:
-    // 4 byte long queue
-    quint32 data;
-};
+// Rows colorized by one task, fewer rows per task make the overhead dominate
+static const int rowsPerTask = 16;
 
 TextureColorizer::TextureColorizer(const QString &seafile, const QString &landfile)
-    : m_showRelief(false)
+    : m_coastImageValid(false)
+    , m_coastProjection(Spherical)
+    , m_coastRadius(0)
+    , m_coastMapQuality(NormalQuality)
+    , m_showRelief(false)
     , m_landColor(qRgb(255, 0, 0))
     , m_seaColor(qRgb(0, 255, 0))
 {
@@ -134,11 +117,13 @@ TextureColorizer::TextureColorizer(const QString &seafile, const QString &landfi
 void TextureColorizer::addSeaDocument(const GeoDataDocument *seaDocument)
 {
     m_seaDocuments.append(seaDocument);
+    m_coastImageValid = false;
 }
 
 void TextureColorizer::addLandDocument(const GeoDataDocument *landDocument)
 {
     m_landDocuments.append(landDocument);
+    m_coastImageValid = false;
 }
 
 void TextureColorizer::setShowRelief(bool show)
@@ -203,8 +188,19 @@ void TextureColorizer::drawTextureMap(GeoPainter *painter)
     }
 }
 
-void TextureColorizer::colorize(QImage *origimg, const ViewportParams *viewport, MapQuality mapQuality)
+void TextureColorizer::updateCoastImage(const ViewportParams *viewport, MapQuality mapQuality)
 {
+    QList<bool> seaVisibility;
+    seaVisibility.reserve(m_seaDocuments.size());
+    for (const GeoDataDocument *doc : std::as_const(m_seaDocuments)) {
+        seaVisibility << doc->isVisible();
+    }
+
+    if (m_coastImageValid && m_coastImage.size() == viewport->size() && m_coastProjection == viewport->projection() && m_coastRadius == viewport->radius()
+        && m_coastPlanetAxis == viewport->planetAxis() && m_coastMapQuality == mapQuality && m_coastSeaVisibility == seaVisibility) {
+        return;
+    }
+
     if (m_coastImage.size() != viewport->size())
         m_coastImage = QImage(viewport->size(), QImage::Format_RGB32);
 
@@ -218,6 +214,18 @@ void TextureColorizer::colorize(QImage *origimg, const ViewportParams *viewport,
 
     drawTextureMap(&painter);
 
+    m_coastImageValid = true;
+    m_coastProjection = viewport->projection();
+    m_coastRadius = viewport->radius();
+    m_coastPlanetAxis = viewport->planetAxis();
+    m_coastMapQuality = mapQuality;
+    m_coastSeaVisibility = seaVisibility;
+}
+
+void TextureColorizer::colorize(QImage *origimg, const ViewportParams *viewport, MapQuality mapQuality)
+{
+    updateCoastImage(viewport, mapQuality);
+
     const qint64 radius = viewport->radius() * viewport->currentProjection()->clippingRadius();
 
     const int imgheight = origimg->height();
@@ -227,11 +235,15 @@ void TextureColorizer::colorize(QImage *origimg, const ViewportParams *viewport,
     // This variable is not used anywhere..
     const int imgradius = imgrx * imgrx + imgry * imgry;
 
-    int bump = 8;
+    int yTop;
+    int yBottom;
+    // The globe is colorized within its circle only, and with a subtler relief
+    bool clippedToCircle;
 
     if (radius * radius > imgradius || !viewport->currentProjection()->isClippedToSphere()) {
-        int yTop = 0;
-        int yBottom = imgheight;
+        yTop = 0;
+        yBottom = imgheight;
+        clippedToCircle = false;
 
         if (!viewport->currentProjection()->isClippedToSphere() && !viewport->currentProjection()->traversablePoles()) {
             qreal realYTop, realYBottom, dummyX;
@@ -242,93 +254,100 @@ void TextureColorizer::colorize(QImage *origimg, const ViewportParams *viewport,
             yTop = qBound(qreal(0.0), realYTop, qreal(imgheight));
             yBottom = qBound(qreal(0.0), realYBottom, qreal(imgheight));
         }
+    } else {
+        yTop = (imgry - radius < 0) ? 0 : imgry - radius;
+        yBottom = (yTop == 0) ? imgheight : imgry + radius;
+        clippedToCircle = true;
+    }
 
-        const int itEnd = yBottom;
-
-        for (int y = yTop; y < itEnd; ++y) {
-            QRgb *writeData = (QRgb *)(origimg->scanLine(y));
-            const QRgb *coastData = (QRgb *)(m_coastImage.scanLine(y));
-
-            uchar *readDataStart = origimg->scanLine(y);
-            const uchar *readDataEnd = readDataStart + imgwidth * 4;
-
-            EmbossFifo emboss;
-
-            for (uchar *readData = readDataStart; readData < readDataEnd; readData += 4, ++writeData, ++coastData) {
-                // Cheap Emboss / Bumpmapping
-                uchar &grey = *readData; // qBlue(*data);
+    const int bumpOffset = clippedToCircle ? 16 : 8;
+    const int bumpShift = clippedToCircle ? 1 : 0;
 
-                if (m_showRelief) {
-                    emboss.enqueue(grey);
-                    bump = (emboss.head() + 8 - grey);
-                    if (bump < 0) {
-                        bump = 0;
-                    } else if (bump > 15) {
-                        bump = 15;
-                    }
-                }
-                setPixel(coastData, writeData, bump, grey);
-            }
-        }
-    } else {
-        int yTop = (imgry - radius < 0) ? 0 : imgry - radius;
-        const int yBottom = (yTop == 0) ? imgheight : imgry + radius;
+    QList<int> taskRows;
+    for (int y = yTop; y < yBottom; y += rowsPerTask) {
+        taskRows << y;
+    }
 
-        EmbossFifo emboss;
+    // Detach before the rows get written concurrently
+    uchar *const bits = origimg->bits();
+    const qsizetype bytesPerLine = origimg->bytesPerLine();
 
-        for (int y = yTop; y < yBottom; ++y) {
-            const int dy = imgry - y;
-            int rx = (int)sqrt((qreal)(radius * radius - dy * dy));
+    // Rows are independent of each other, spread them over the global thread pool
+    QtConcurrent::blockingMap(taskRows, [this, bits, bytesPerLine, imgwidth, imgrx, imgry, radius, clippedToCircle, yBottom, bumpOffset, bumpShift](int firstRow) {
+        const int lastRow = qMin(firstRow + rowsPerTask, yBottom);
+        for (int y = firstRow; y < lastRow; ++y) {
             int xLeft = 0;
             int xRight = imgwidth;
 
-            if (imgrx - rx > 0) {
-                xLeft = imgrx - rx;
-                xRight = imgrx + rx;
-            }
-
-            QRgb *writeData = (QRgb *)(origimg->scanLine(y)) + xLeft;
-            const QRgb *coastData = (QRgb *)(m_coastImage.scanLine(y)) + xLeft;
-
-            uchar *readDataStart = origimg->scanLine(y) + xLeft * 4;
-            const uchar *readDataEnd = origimg->scanLine(y) + xRight * 4;
-
-            for (uchar *readData = readDataStart; readData < readDataEnd; readData += 4, ++writeData, ++coastData) {
-                // Cheap Emboss / Bumpmapping
-
-                uchar &grey = *readData; // qBlue(*data);
-
-                if (m_showRelief) {
-                    emboss.enqueue(grey);
-                    bump = (emboss.head() + 16 - grey) >> 1;
-                    if (bump < 0) {
-                        bump = 0;
-                    } else if (bump > 15) {
-                        bump = 15;
-                    }
+            if (clippedToCircle) {
+                const int dy = imgry - y;
+                const int rx = (int)sqrt((qreal)(radius * radius - dy * dy));
+                if (imgrx - rx > 0) {
+                    xLeft = imgrx - rx;
+                    xRight = imgrx + rx;
                 }
-                setPixel(coastData, writeData, bump, grey);
             }
+
+            QRgb *const row = (QRgb *)(bits + y * bytesPerLine) + xLeft;
+            const QRgb *const coastRow = (const QRgb *)(m_coastImage.constScanLine(y)) + xLeft;
+            colorizeRow(row, coastRow, xRight - xLeft, bumpOffset, bumpShift);
         }
-    }
+    });
 }
 
-void TextureColorizer::setPixel(const QRgb *coastData, QRgb *writeData, int bump, uchar grey)
+void TextureColorizer::colorizeRow(QRgb *row, const QRgb *coastRow, int length, int bumpOffset, int bumpShift) const
 {
-    int alpha = qRed(*coastData);
-    if (alpha == 255)
-        *writeData = texturepalette[bump][grey + 0x100];
-    else if (alpha == 0) {
-        *writeData = texturepalette[bump][grey];
-    } else {
-        qreal c = 1.0 / 255.0;
+    // Process the row in chunks that fit on the stack, with one simple loop
+    // per step, so that the compiler can vectorize the steps without gathers
+    static const int chunkLength = 256;
+    uchar grey[chunkLength + 3];
+    uchar bump[chunkLength];
+    uchar coast[chunkLength];
+
+    // Cheap Emboss / Bumpmapping compares to the pixel three pixels to the left
+    grey[0] = grey[1] = grey[2] = 0;
+
+    for (int start = 0; start < length; start += chunkLength) {
+        const int count = qMin(chunkLength, length - start);
+        QRgb *const data = row + start;
+        const QRgb *const coastData = coastRow + start;
+
+        for (int i = 0; i < count; ++i) {
+            grey[i + 3] = qBlue(data[i]);
+            coast[i] = qRed(coastData[i]);
+        }
 
-        QRgb landcolor = (QRgb)(texturepalette[bump][grey + 0x100]);
-        QRgb watercolor = (QRgb)(texturepalette[bump][grey]);
+        if (m_showRelief) {
+            for (int i = 0; i < count; ++i) {
+                bump[i] = qBound(0, (grey[i] + bumpOffset - grey[i + 3]) >> bumpShift, 15);
+            }
+        } else {
+            memset(bump, 8, count);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const uint *const palette = texturepalette[bump[i]];
+            const uchar alpha = coast[i];
+            const uchar value = grey[i + 3];
+            if (alpha == 255) {
+                data[i] = palette[value + 0x100];
+            } else if (alpha == 0) {
+                data[i] = palette[value];
+            } else {
+                // Blend land and sea along the antialiased coast lines
+                const QRgb landcolor = palette[value + 0x100];
+                const QRgb watercolor = palette[value];
+                const int beta = 255 - alpha;
+                data[i] = qRgb((alpha * qRed(landcolor) + beta * qRed(watercolor)) / 255,
+                               (alpha * qGreen(landcolor) + beta * qGreen(watercolor)) / 255,
+                               (alpha * qBlue(landcolor) + beta * qBlue(watercolor)) / 255);
+            }
+        }
 
-        *writeData = qRgb((int)(c * (alpha * qRed(landcolor) + (255 - alpha) * qRed(watercolor))),
-                          (int)(c * (alpha * qGreen(landcolor) + (255 - alpha) * qGreen(watercolor))),
-                          (int)(c * (alpha * qBlue(landcolor) + (255 - alpha) * qBlue(watercolor))));
+        // Carry the last greys over to the next chunk
+        grey[0] = grey[count];
+        grey[1] = grey[count + 1];
+        grey[2] = grey[count + 2];
     }
 }
 }
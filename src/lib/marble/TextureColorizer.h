@@ -13,6 +13,7 @@
 
 #include "GeoDataDocument.h"
 #include "MarbleGlobal.h"
+#include "Quaternion.h"
 
 #include <QColor>
 #include <QImage>
@@ -43,14 +44,32 @@ public:
 
     void colorize(QImage *origimg, const ViewportParams *viewport, MapQuality mapQuality);
 
-    void setPixel(const QRgb *coastData, QRgb *writeData, int bump, uchar grey);
-
 private:
+    /**
+     * Redraws the coast image unless it was drawn for the same view and
+     * documents already.
+     */
+    void updateCoastImage(const ViewportParams *viewport, MapQuality mapQuality);
+
+    /**
+     * Colorizes @p length pixels of @p row, selecting the land or sea palette
+     * by @p coastRow. The relief is embossed with
+     * ( grey three pixels left + @p bumpOffset - grey ) >> @p bumpShift.
+     */
+    void colorizeRow(QRgb *row, const QRgb *coastRow, int length, int bumpOffset, int bumpShift) const;
+
     QString m_seafile;
     QString m_landfile;
     QList<const GeoDataDocument *> m_seaDocuments;
     QList<const GeoDataDocument *> m_landDocuments;
     QImage m_coastImage;
+    // The view the coast image was drawn for
+    bool m_coastImageValid;
+    Projection m_coastProjection;
+    int m_coastRadius;
+    Quaternion m_coastPlanetAxis;
+    MapQuality m_coastMapQuality;
+    QList<bool> m_coastSeaVisibility;
     uint texturepalette[16][512];
     bool m_showRelief;
     QRgb m_landColor;
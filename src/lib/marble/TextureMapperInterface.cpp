@@ -19,3 +19,8 @@ void TextureMapperInterface::setRepaintNeeded()
 {
     m_repaintNeeded = true;
 }
+
+void TextureMapperInterface::setCenterChanged()
+{
+    setRepaintNeeded();
+}
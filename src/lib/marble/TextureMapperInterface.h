@@ -26,6 +26,13 @@ public:
 
     void setRepaintNeeded();
 
+    /**
+     * Tells the mapper that the center of the viewport moved. Mappers which
+     * can reuse the previous canvas for such a move reimplement this, the
+     * default repaints the whole canvas.
+     */
+    virtual void setCenterChanged();
+
 protected:
     bool m_repaintNeeded;
 };
@@ -10,11 +10,15 @@
 
 #include <QApplication>
 #include <QDir>
+#include <QFileInfo>
 #include <QImage>
+#include <QImageReader>
 #include <QList>
 #include <QPainter>
 #include <QRect>
+#include <QSemaphore>
 #include <QSize>
+#include <QThreadPool>
 
 #include "MarbleDebug.h"
 #include "MarbleDirs.h"
@@ -35,19 +39,38 @@ public:
         , m_resume(false)
         , m_verify(false)
         , m_source(source)
+        , m_saveSlots(4 * m_threadPool.maxThreadCount())
     {
         if (m_dem == QLatin1StringView("true")) {
             m_tileQuality = 70;
         } else {
             m_tileQuality = 85;
         }
+
+        for (int cnt = 0; cnt <= 255; ++cnt) {
+            m_grayScalePalette.insert(cnt, qRgb(cnt, cnt, cnt));
+        }
     }
 
     ~TileCreatorPrivate()
     {
+        m_threadPool.waitForDone();
         delete m_source;
     }
 
+    QString tileFileName(int tileLevel, int n, int m) const;
+
+    /**
+     * Saves the tile in the background and merges it into its parent tile
+     * on the next lower level. Parent tiles are passed on the same way once
+     * all four of their children arrived.
+     */
+    void addTile(int tileLevel, int n, int m, const QImage &tile);
+
+    void saveTile(const QString &tileName, const QImage &tile) const;
+
+    static void downsample(const QImage &source, QImage &target, int quadrantX, int quadrantY);
+
 public:
     QString m_dem;
     QString m_targetDir;
@@ -58,24 +81,154 @@ public:
     bool m_verify;
 
     TileCreatorSource *m_source;
+
+    QList<QRgb> m_grayScalePalette;
+
+    QThreadPool m_threadPool;
+    // Limits the number of tiles waiting to be saved
+    QSemaphore m_saveSlots;
+    // Per tile level, the row of tiles being assembled from the level above
+    QList<QList<QImage>> m_pendingTiles;
 };
 
+QString TileCreatorPrivate::tileFileName(int tileLevel, int n, int m) const
+{
+    return m_targetDir
+        + QStringLiteral("%1/%2/%2_%3.%4")
+              .arg(tileLevel)
+              .arg(n, tileDigits, 10, QLatin1Char('0'))
+              .arg(m, tileDigits, 10, QLatin1Char('0'))
+              .arg(m_tileFormat);
+}
+
+void TileCreatorPrivate::addTile(int tileLevel, int n, int m, const QImage &tile)
+{
+    const QString tileName = tileFileName(tileLevel, n, m);
+
+    if (m == 0) {
+        const QString dirName = QFileInfo(tileName).path();
+        if (!QDir(dirName).exists())
+            (QDir::root()).mkpath(dirName);
+    }
+
+    if (QFile::exists(tileName) && m_resume) {
+        // mDebug() << tileName << "exists already";
+    } else {
+        m_saveSlots.acquire();
+        m_threadPool.start([this, tileName, tile]() {
+            saveTile(tileName, tile);
+            m_saveSlots.release();
+        });
+    }
+
+    if (tileLevel == 0) {
+        return;
+    }
+
+    // Rows and columns always come in pairs, so the bottom right child completes the parent
+    QImage &parent = m_pendingTiles[tileLevel - 1][m / 2];
+    if (parent.isNull()) {
+        parent = QImage(tile.size(), tile.format());
+    }
+    downsample(tile, parent, m % 2, n % 2);
+
+    if (n % 2 == 1 && m % 2 == 1) {
+        const QImage completed = parent;
+        parent = QImage();
+        addTile(tileLevel - 1, n / 2, m / 2, completed);
+    }
+}
+
+void TileCreatorPrivate::saveTile(const QString &tileName, const QImage &tile) const
+{
+    QImage image = tile;
+    if (m_dem == QLatin1StringView("true")) {
+        image = tile.convertToFormat(QImage::Format_Indexed8, m_grayScalePalette, Qt::ThresholdDither);
+    }
+
+    bool ok = image.save(tileName, m_tileFormat.toLatin1().data(), m_tileQuality);
+    if (!ok)
+        mDebug() << "Error while writing Tile: " << tileName;
+
+    mDebug() << tileName << "size" << QFile(tileName).size();
+
+    if (m_verify) {
+        QImage writtenTile(tileName);
+        Q_ASSERT(writtenTile.size() == image.size());
+        for (int i = 0; i < writtenTile.size().width(); ++i) {
+            for (int j = 0; j < writtenTile.size().height(); ++j) {
+                if (writtenTile.pixel(i, j) != image.pixel(i, j)) {
+                    unsigned int pixel = image.pixel(i, j);
+                    unsigned int writtenPixel = writtenTile.pixel(i, j);
+                    qWarning() << "***** pixel" << i << j << "is off by" << (pixel - writtenPixel) << "pixel" << pixel << "writtenPixel" << writtenPixel;
+                    QByteArray baPixel((char *)&pixel, sizeof(unsigned int));
+                    qWarning() << "pixel" << baPixel.size() << "0x" << baPixel.toHex();
+                    QByteArray baWrittenPixel((char *)&writtenPixel, sizeof(unsigned int));
+                    qWarning() << "writtenPixel" << baWrittenPixel.size() << "0x" << baWrittenPixel.toHex();
+                    Q_ASSERT(false);
+                }
+            }
+        }
+    }
+}
+
+void TileCreatorPrivate::downsample(const QImage &source, QImage &target, int quadrantX, int quadrantY)
+{
+    // Both images are 32 bit, the tile size is odd so the right and bottom quadrants are a pixel larger
+    const int size = source.width();
+    const int half = size / 2;
+    const int offsetX = quadrantX ? half : 0;
+    const int offsetY = quadrantY ? half : 0;
+    const int width = quadrantX ? size - half : half;
+    const int height = quadrantY ? size - half : half;
+
+    for (int y = 0; y < height; ++y) {
+        const auto upperLine = reinterpret_cast<const QRgb *>(source.constScanLine(2 * y));
+        const auto lowerLine = reinterpret_cast<const QRgb *>(source.constScanLine(qMin(2 * y + 1, size - 1)));
+        auto destLine = reinterpret_cast<QRgb *>(target.scanLine(offsetY + y)) + offsetX;
+        for (int x = 0; x < width; ++x) {
+            const int left = 2 * x;
+            const int right = qMin(left + 1, size - 1);
+            const QRgb a = upperLine[left];
+            const QRgb b = upperLine[right];
+            const QRgb c = lowerLine[left];
+            const QRgb d = lowerLine[right];
+            destLine[x] = qRgba((qRed(a) + qRed(b) + qRed(c) + qRed(d) + 2) / 4,
+                                (qGreen(a) + qGreen(b) + qGreen(c) + qGreen(d) + 2) / 4,
+                                (qBlue(a) + qBlue(b) + qBlue(c) + qBlue(d) + 2) / 4,
+                                (qAlpha(a) + qAlpha(b) + qAlpha(c) + qAlpha(d) + 2) / 4);
+        }
+    }
+}
+
 class TileCreatorSourceImage : public TileCreatorSource
 {
 public:
     explicit TileCreatorSourceImage(const QString &sourcePath)
-        : m_sourceImage(QImage(sourcePath))
+        : m_sourcePath(sourcePath)
+        , m_banded(false)
         , m_cachedRowNum(-1)
     {
+        // Images whose format allows reading parts of them are read in bands of
+        // rows, others have to be decoded completely
+        QImageReader reader(sourcePath);
+        m_imageSize = reader.size();
+        m_banded = m_imageSize.isValid() && reader.supportsOption(QImageIOHandler::ClipRect);
+        if (!m_banded && !isTooLarge(m_imageSize)) {
+            // The size is checked above, the decoded image may exceed the default limit
+            reader.setAllocationLimit(0);
+            m_sourceImage = reader.read();
+            m_imageSize = m_sourceImage.size();
+        }
     }
 
     QSize fullImageSize() const override
     {
-        if (m_sourceImage.size().width() > 21600 || m_sourceImage.height() > 10800) {
+        if (!m_banded && isTooLarge(m_imageSize)) {
             qDebug("Install map too large!");
             return {};
         }
-        return m_sourceImage.size();
+        return m_imageSize;
     }
 
     QImage tile(int n, int m, int maxTileLevel) override
@@ -83,8 +236,8 @@ public:
         int mmax = TileLoaderHelper::levelToColumn(defaultLevelZeroColumns, maxTileLevel);
         int nmax = TileLoaderHelper::levelToRow(defaultLevelZeroRows, maxTileLevel);
 
-        int imageHeight = m_sourceImage.height();
-        int imageWidth = m_sourceImage.width();
+        int imageHeight = m_imageSize.height();
+        int imageWidth = m_imageSize.width();
 
         // If the image size of the image source does not match the expected
         // geometry we need to smooth-scale the image in advance to match
@@ -110,9 +263,16 @@ public:
             row = m_rowCache;
 
         } else {
-            QRect sourceRowRect(0, (int)((qreal)(n * imageHeight) / (qreal)(nmax)), imageWidth, (int)((qreal)(imageHeight) / (qreal)(nmax)));
+            const QRect sourceRowRect = rowRect(n, nmax);
 
-            row = m_sourceImage.copy(sourceRowRect);
+            if (m_banded) {
+                if (!m_bandRect.contains(sourceRowRect)) {
+                    readBand(n, nmax);
+                }
+                row = m_band.copy(sourceRowRect.translated(0, -m_bandRect.top()));
+            } else {
+                row = m_sourceImage.copy(sourceRowRect);
+            }
 
             if (needsScaling) {
                 // Pick the current row and smooth scale it
@@ -136,8 +296,53 @@ public:
     }
 
 private:
+    static bool isTooLarge(const QSize &size)
+    {
+        return size.width() > 21600 || size.height() > 10800;
+    }
+
+    QRect rowRect(int n, int nmax) const
+    {
+        const int imageHeight = m_imageSize.height();
+        return {0, (int)((qreal)(n * imageHeight) / (qreal)(nmax)), m_imageSize.width(), (int)((qreal)(imageHeight) / (qreal)(nmax))};
+    }
+
+    /**
+     * Reads the rows starting at row @p n into the band. Formats like JPEG
+     * decode from the top of the image up to the end of each clip rect, so
+     * each band holds as many rows as the memory budget allows.
+     */
+    void readBand(int n, int nmax)
+    {
+        const QRect firstRow = rowRect(n, nmax);
+        const qint64 rowBytes = qint64(firstRow.width()) * qMax(1, firstRow.height()) * 4;
+        const int rows = qBound<qint64>(1, bandBytes / rowBytes, nmax - n);
+
+        m_bandRect = firstRow | rowRect(n + rows - 1, nmax);
+        QImageReader reader(m_sourcePath);
+        reader.setClipRect(m_bandRect);
+        // The band is bounded by bandBytes, which may exceed the default limit
+        reader.setAllocationLimit(0);
+        m_band = reader.read();
+        if (m_band.isNull()) {
+            mDebug() << "Cannot read" << m_bandRect << "of" << m_sourcePath << reader.errorString();
+            m_bandRect = QRect();
+        }
+    }
+
+    // The memory a band of decoded rows may take
+    static const qint64 bandBytes = qint64(1024) * 1024 * 1024;
+
+    const QString m_sourcePath;
+    QSize m_imageSize;
+    bool m_banded;
+
+    // The whole image, if its format does not allow reading parts of it
     QImage m_sourceImage;
 
+    QImage m_band;
+    QRect m_bandRect;
+
     QImage m_rowCache;
     int m_cachedRowNum;
 };
@@ -200,11 +405,6 @@ void TileCreator::run()
 
     mDebug() << "Installing tiles to: " << d->m_targetDir;
 
-    QList<QRgb> grayScalePalette;
-    for (int cnt = 0; cnt <= 255; ++cnt) {
-        grayScalePalette.insert(cnt, qRgb(cnt, cnt, cnt));
-    }
-
     QSize fullImageSize = d->m_source->fullImageSize();
     int imageWidth = fullImageSize.width();
     int imageHeight = fullImageSize.height();
@@ -239,8 +439,13 @@ void TileCreator::run()
     int tileLevel = 0;
     int totalTileCount = 0;
 
+    d->m_pendingTiles.clear();
     while (tileLevel <= maxTileLevel) {
-        totalTileCount += (TileLoaderHelper::levelToRow(defaultLevelZeroRows, tileLevel) * TileLoaderHelper::levelToColumn(defaultLevelZeroColumns, tileLevel));
+        const int columns = TileLoaderHelper::levelToColumn(defaultLevelZeroColumns, tileLevel);
+        totalTileCount += (TileLoaderHelper::levelToRow(defaultLevelZeroRows, tileLevel) * columns);
+        if (tileLevel < maxTileLevel) {
+            d->m_pendingTiles.append(QList<QImage>(columns));
+        }
         tileLevel++;
     }
 
@@ -249,288 +454,49 @@ void TileCreator::run()
     int mmax = TileLoaderHelper::levelToColumn(defaultLevelZeroColumns, maxTileLevel);
     int nmax = TileLoaderHelper::levelToRow(defaultLevelZeroRows, maxTileLevel);
 
-    // Loading each row at highest spatial resolution and cropping tiles
+    // Loading each row at highest spatial resolution and cropping tiles.
+    // The lower levels are built along the way, one row of tiles per level
+    // is kept in memory while the tiles get saved in the background.
     int percentCompleted = 0;
     int createdTilesCount = 0;
-    QString tileName;
-
-    // Creating directory structure for the highest level
-    QString dirName(d->m_targetDir + QStringLiteral("%1").arg(maxTileLevel));
-    if (!QDir(dirName).exists())
-        (QDir::root()).mkpath(dirName);
-
-    for (int n = 0; n < nmax; ++n) {
-        QString dirName(d->m_targetDir + QStringLiteral("%1/%2").arg(maxTileLevel).arg(n, tileDigits, 10, QLatin1Char('0')));
-        if (!QDir(dirName).exists())
-            (QDir::root()).mkpath(dirName);
-    }
+    QSize const expectedSize(c_defaultTileSize, c_defaultTileSize);
 
     for (int n = 0; n < nmax; ++n) {
         for (int m = 0; m < mmax; ++m) {
             mDebug() << "** tile" << m << "x" << n;
 
-            if (d->m_cancelled)
+            if (d->m_cancelled) {
+                d->m_threadPool.waitForDone();
                 return;
+            }
 
-            tileName = d->m_targetDir
-                + QStringLiteral("%1/%2/%2_%3.%4")
-                      .arg(maxTileLevel)
-                      .arg(n, tileDigits, 10, QLatin1Char('0'))
-                      .arg(m, tileDigits, 10, QLatin1Char('0'))
-                      .arg(d->m_tileFormat);
-
-            if (QFile::exists(tileName) && d->m_resume) {
-                // mDebug() << tileName << "exists already";
-
-            } else {
-                QImage tile = d->m_source->tile(n, m, maxTileLevel);
+            const QString tileName = d->tileFileName(maxTileLevel, n, m);
 
-                if (tile.isNull()) {
-                    mDebug() << "Read-Error! Null QImage!";
-                    return;
-                }
+            // Existing tiles are still needed for the lower levels
+            QImage tile = QFile::exists(tileName) && d->m_resume ? QImage(tileName) : d->m_source->tile(n, m, maxTileLevel);
 
-                if (d->m_dem == QLatin1StringView("true")) {
-                    tile = tile.convertToFormat(QImage::Format_Indexed8, grayScalePalette, Qt::ThresholdDither);
-                }
-
-                bool ok = tile.save(tileName, d->m_tileFormat.toLatin1().data(), d->m_tileFormat == QLatin1StringView("jpg") ? 100 : d->m_tileQuality);
-                if (!ok)
-                    mDebug() << "Error while writing Tile: " << tileName;
-
-                mDebug() << tileName << "size" << QFile(tileName).size();
-
-                if (d->m_verify) {
-                    QImage writtenTile(tileName);
-                    Q_ASSERT(writtenTile.size() == tile.size());
-                    for (int i = 0; i < writtenTile.size().width(); ++i) {
-                        for (int j = 0; j < writtenTile.size().height(); ++j) {
-                            if (writtenTile.pixel(i, j) != tile.pixel(i, j)) {
-                                unsigned int pixel = tile.pixel(i, j);
-                                unsigned int writtenPixel = writtenTile.pixel(i, j);
-                                qWarning() << "***** pixel" << i << j << "is off by" << (pixel - writtenPixel) << "pixel" << pixel << "writtenPixel"
-                                           << writtenPixel;
-                                QByteArray baPixel((char *)&pixel, sizeof(unsigned int));
-                                qWarning() << "pixel" << baPixel.size() << "0x" << baPixel.toHex();
-                                QByteArray baWrittenPixel((char *)&writtenPixel, sizeof(unsigned int));
-                                qWarning() << "writtenPixel" << baWrittenPixel.size() << "0x" << baWrittenPixel.toHex();
-                                Q_ASSERT(false);
-                            }
-                        }
-                    }
-                }
+            if (tile.size() != expectedSize) {
+                mDebug() << "Read-Error! Null QImage!";
+                d->m_threadPool.waitForDone();
+                return;
             }
 
-            percentCompleted = (int)(90 * (qreal)(createdTilesCount) / (qreal)(totalTileCount));
+            d->addTile(maxTileLevel, n, m, tile.convertToFormat(tile.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32));
+
+            // Lower level tiles are completed along with the top level ones
             createdTilesCount++;
 
+            // Don't exceed 99% as this would cancel the thread unexpectedly
+            percentCompleted = (int)(99 * (qreal)(createdTilesCount) / (qreal)(nmax * mmax));
+
             mDebug() << "percentCompleted" << percentCompleted;
             Q_EMIT progress(percentCompleted);
         }
     }
 
-    mDebug() << "tileLevel: " << maxTileLevel << " successfully created.";
-
-    tileLevel = maxTileLevel;
-
-    // Now that we have the tiles at the highest resolution lets build
-    // them together four by four.
-
-    while (tileLevel > 0) {
-        tileLevel--;
-
-        int nmaxit = TileLoaderHelper::levelToRow(defaultLevelZeroRows, tileLevel);
-
-        for (int n = 0; n < nmaxit; ++n) {
-            QString dirName(d->m_targetDir + QStringLiteral("%1/%2").arg(tileLevel).arg(n, tileDigits, 10, QLatin1Char('0')));
-
-            // mDebug() << "dirName: " << dirName;
-            if (!QDir(dirName).exists())
-                (QDir::root()).mkpath(dirName);
-
-            int mmaxit = TileLoaderHelper::levelToColumn(defaultLevelZeroColumns, tileLevel);
-            for (int m = 0; m < mmaxit; ++m) {
-                if (d->m_cancelled)
-                    return;
-
-                QString newTileName = d->m_targetDir
-                    + QStringLiteral("%1/%2/%2_%3.%4")
-                          .arg(tileLevel)
-                          .arg(n, tileDigits, 10, QLatin1Char('0'))
-                          .arg(m, tileDigits, 10, QLatin1Char('0'))
-                          .arg(d->m_tileFormat);
-
-                if (QFile::exists(newTileName) && d->m_resume) {
-                    // mDebug() << newTileName << "exists already";
-                } else {
-                    tileName = d->m_targetDir
-                        + QStringLiteral("%1/%2/%2_%3.%4")
-                              .arg(tileLevel + 1)
-                              .arg(2 * n, tileDigits, 10, QLatin1Char('0'))
-                              .arg(2 * m, tileDigits, 10, QLatin1Char('0'))
-                              .arg(d->m_tileFormat);
-                    QImage img_topleft(tileName);
-
-                    tileName = d->m_targetDir
-                        + QStringLiteral("%1/%2/%2_%3.%4")
-                              .arg(tileLevel + 1)
-                              .arg(2 * n, tileDigits, 10, QLatin1Char('0'))
-                              .arg(2 * m + 1, tileDigits, 10, QLatin1Char('0'))
-                              .arg(d->m_tileFormat);
-                    QImage img_topright(tileName);
-
-                    tileName = d->m_targetDir
-                        + QStringLiteral("%1/%2/%2_%3.%4")
-                              .arg(tileLevel + 1)
-                              .arg(2 * n + 1, tileDigits, 10, QLatin1Char('0'))
-                              .arg(2 * m, tileDigits, 10, QLatin1Char('0'))
-                              .arg(d->m_tileFormat);
-                    QImage img_bottomleft(tileName);
-
-                    tileName = d->m_targetDir
-                        + QStringLiteral("%1/%2/%2_%3.%4")
-                              .arg(tileLevel + 1)
-                              .arg(2 * n + 1, tileDigits, 10, QLatin1Char('0'))
-                              .arg(2 * m + 1, tileDigits, 10, QLatin1Char('0'))
-                              .arg(d->m_tileFormat);
-                    QImage img_bottomright(tileName);
-
-                    QSize const expectedSize(c_defaultTileSize, c_defaultTileSize);
-                    if (img_topleft.size() != expectedSize || img_topright.size() != expectedSize || img_bottomleft.size() != expectedSize
-                        || img_bottomright.size() != expectedSize) {
-                        mDebug() << "Tile write failure. Missing write permissions?";
-                        Q_EMIT progress(100);
-                        return;
-                    }
-                    QImage tile = img_topleft;
-
-                    if (d->m_dem == QLatin1StringView("true")) {
-                        tile.setColorTable(grayScalePalette);
-                        uchar *destLine;
-
-                        for (uint y = 0; y < c_defaultTileSize / 2; ++y) {
-                            destLine = tile.scanLine(y);
-                            const uchar *srcLine = img_topleft.scanLine(2 * y);
-                            for (uint x = 0; x < c_defaultTileSize / 2; ++x)
-                                destLine[x] = srcLine[2 * x];
-                        }
-                        for (uint y = 0; y < c_defaultTileSize / 2; ++y) {
-                            destLine = tile.scanLine(y);
-                            const uchar *srcLine = img_topright.scanLine(2 * y);
-                            for (uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x)
-                                destLine[x] = srcLine[2 * (x - c_defaultTileSize / 2)];
-                        }
-                        for (uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y) {
-                            destLine = tile.scanLine(y);
-                            const uchar *srcLine = img_bottomleft.scanLine(2 * (y - c_defaultTileSize / 2));
-                            for (uint x = 0; x < c_defaultTileSize / 2; ++x)
-                                destLine[x] = srcLine[2 * x];
-                        }
-                        for (uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y) {
-                            destLine = tile.scanLine(y);
-                            const uchar *srcLine = img_bottomright.scanLine(2 * (y - c_defaultTileSize / 2));
-                            for (uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x)
-                                destLine[x] = srcLine[2 * (x - c_defaultTileSize / 2)];
-                        }
-                    } else {
-                        // tile.depth() != 8
-
-                        img_topleft = img_topleft.convertToFormat(QImage::Format_ARGB32);
-                        img_topright = img_topright.convertToFormat(QImage::Format_ARGB32);
-                        img_bottomleft = img_bottomleft.convertToFormat(QImage::Format_ARGB32);
-                        img_bottomright = img_bottomright.convertToFormat(QImage::Format_ARGB32);
-                        tile = img_topleft;
-
-                        QRgb *destLine;
-
-                        for (uint y = 0; y < c_defaultTileSize / 2; ++y) {
-                            destLine = (QRgb *)tile.scanLine(y);
-                            const QRgb *srcLine = (QRgb *)img_topleft.scanLine(2 * y);
-                            for (uint x = 0; x < c_defaultTileSize / 2; ++x)
-                                destLine[x] = srcLine[2 * x];
-                        }
-                        for (uint y = 0; y < c_defaultTileSize / 2; ++y) {
-                            destLine = (QRgb *)tile.scanLine(y);
-                            const QRgb *srcLine = (QRgb *)img_topright.scanLine(2 * y);
-                            for (uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x)
-                                destLine[x] = srcLine[2 * (x - c_defaultTileSize / 2)];
-                        }
-                        for (uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y) {
-                            destLine = (QRgb *)tile.scanLine(y);
-                            const QRgb *srcLine = (QRgb *)img_bottomleft.scanLine(2 * (y - c_defaultTileSize / 2));
-                            for (uint x = 0; x < c_defaultTileSize / 2; ++x)
-                                destLine[x] = srcLine[2 * x];
-                        }
-                        for (uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y) {
-                            destLine = (QRgb *)tile.scanLine(y);
-                            const QRgb *srcLine = (QRgb *)img_bottomright.scanLine(2 * (y - c_defaultTileSize / 2));
-                            for (uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x)
-                                destLine[x] = srcLine[2 * (x - c_defaultTileSize / 2)];
-                        }
-                    }
-
-                    mDebug() << newTileName;
-
-                    // Saving at 100% JPEG quality to have a high-quality
-                    // version to create the remaining needed tiles from.
-                    bool ok = tile.save(newTileName, d->m_tileFormat.toLatin1().data(), d->m_tileFormat == QLatin1StringView("jpg") ? 100 : d->m_tileQuality);
-                    if (!ok)
-                        mDebug() << "Error while writing Tile: " << newTileName;
-                }
-
-                percentCompleted = (int)(90 * (qreal)(createdTilesCount) / (qreal)(totalTileCount));
-                createdTilesCount++;
-
-                Q_EMIT progress(percentCompleted);
-                mDebug() << "percentCompleted" << percentCompleted;
-            }
-        }
-        mDebug() << "tileLevel: " << tileLevel << " successfully created.";
-    }
+    d->m_threadPool.waitForDone();
     mDebug() << "Tile creation completed.";
 
-    if (d->m_tileFormat == QLatin1StringView("jpg") && d->m_tileQuality != 100) {
-        // Applying correct lower JPEG compression now that we created all tiles
-        int savedTilesCount = 0;
-
-        tileLevel = 0;
-        while (tileLevel <= maxTileLevel) {
-            int nmaxit = TileLoaderHelper::levelToRow(defaultLevelZeroRows, tileLevel);
-            for (int n = 0; n < nmaxit; ++n) {
-                int mmaxit = TileLoaderHelper::levelToColumn(defaultLevelZeroColumns, tileLevel);
-                for (int m = 0; m < mmaxit; ++m) {
-                    if (d->m_cancelled)
-                        return;
-
-                    savedTilesCount++;
-
-                    tileName = d->m_targetDir
-                        + QStringLiteral("%1/%2/%2_%3.%4")
-                              .arg(tileLevel)
-                              .arg(n, tileDigits, 10, QLatin1Char('0'))
-                              .arg(m, tileDigits, 10, QLatin1Char('0'))
-                              .arg(d->m_tileFormat);
-                    QImage tile(tileName);
-
-                    bool ok;
-
-                    ok = tile.save(tileName, d->m_tileFormat.toLatin1().data(), d->m_tileQuality);
-
-                    if (!ok)
-                        mDebug() << "Error while writing Tile: " << tileName;
-                    // Don't exceed 99% as this would cancel the thread unexpectedly
-                    percentCompleted = 90 + (int)(9 * (qreal)(savedTilesCount) / (qreal)(totalTileCount));
-                    Q_EMIT progress(percentCompleted);
-                    mDebug() << "percentCompleted" << percentCompleted;
-                    // mDebug() << "Saving Tile #" << savedTilesCount
-                    //          << " of " << totalTileCount
-                    //          << " Percent: " << percentCompleted;
-                }
-            }
-            tileLevel++;
-        }
-    }
-
     percentCompleted = 100;
     Q_EMIT progress(percentCompleted);
 
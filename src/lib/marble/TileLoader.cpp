@@ -14,6 +14,8 @@
 #include <QUrl>
 
 #include "GeoDataDocument.h"
+#include "GeoDataLatLonBox.h"
+#include "GeoSceneAbstractTileProjection.h"
 #include "GeoSceneTextureTileDataset.h"
 #include "GeoSceneTileDataset.h"
 #include "GeoSceneTypes.h"
@@ -34,7 +36,8 @@ TileLoader::TileLoader(HttpDownloadManager *const downloadManager, const PluginM
     : m_pluginManager(pluginManager)
 {
     qRegisterMetaType<DownloadUsage>("DownloadUsage");
-    connect(this, &TileLoader::tileRequested, downloadManager, &HttpDownloadManager::addJob);
+    connect(this, &TileLoader::tileRequested, downloadManager, &HttpDownloadManager::addTileJob);
+    connect(downloadManager, &HttpDownloadManager::downloadCancelled, this, &TileLoader::cancelTile);
     connect(downloadManager, SIGNAL(downloadComplete(QString, QString)), SLOT(updateTile(QString, QString)));
     connect(downloadManager, SIGNAL(downloadComplete(QByteArray, QString)), SLOT(updateTile(QByteArray, QString)));
 }
@@ -192,18 +195,24 @@ TileLoader::TileStatus TileLoader::tileStatus(GeoSceneTileDataset const *tileDat
     return isExpired ? Expired : Available;
 }
 
-void TileLoader::updateTile(QByteArray const &data, QString const &idStr)
+TileId TileLoader::parseTileId(QString const &idStr, QString &origin)
 {
     QStringList const components = idStr.split(QLatin1Char(':'), Qt::SkipEmptyParts);
     Q_ASSERT(components.size() == 5);
 
-    QString const origin = components[0];
+    origin = components[0];
     QString const sourceDir = components[1];
     int const zoomLevel = components[2].toInt();
     int const tileX = components[3].toInt();
     int const tileY = components[4].toInt();
 
-    TileId const id = TileId(sourceDir, zoomLevel, tileX, tileY);
+    return TileId(sourceDir, zoomLevel, tileX, tileY);
+}
+
+void TileLoader::updateTile(QByteArray const &data, QString const &idStr)
+{
+    QString origin;
+    TileId const id = parseTileId(idStr, origin);
 
     if (origin == QString::fromLatin1(GeoSceneTypes::GeoSceneTextureTileType)) {
         QImage const tileImage = QImage::fromData(data);
@@ -216,16 +225,8 @@ void TileLoader::updateTile(QByteArray const &data, QString const &idStr)
 
 void TileLoader::updateTile(const QString &fileName, const QString &idStr)
 {
-    QStringList const components = idStr.split(QLatin1Char(':'), Qt::SkipEmptyParts);
-    Q_ASSERT(components.size() == 5);
-
-    QString const origin = components[0];
-    QString const sourceDir = components[1];
-    int const zoomLevel = components[2].toInt();
-    int const tileX = components[3].toInt();
-    int const tileY = components[4].toInt();
-
-    TileId const id = TileId(sourceDir, zoomLevel, tileX, tileY);
+    QString origin;
+    TileId const id = parseTileId(idStr, origin);
     if (origin == QString::fromLatin1(GeoSceneTypes::GeoSceneVectorTileType)) {
         GeoDataDocument *document = openVectorFile(MarbleDirs::path(fileName));
         if (document) {
@@ -234,6 +235,15 @@ void TileLoader::updateTile(const QString &fileName, const QString &idStr)
     }
 }
 
+void TileLoader::cancelTile(const QString &idStr)
+{
+    QString origin;
+    TileId const id = parseTileId(idStr, origin);
+    if (origin == QString::fromLatin1(GeoSceneTypes::GeoSceneTextureTileType)) {
+        Q_EMIT tileCancelled(id);
+    }
+}
+
 QString TileLoader::tileFileName(GeoSceneTileDataset const *tileData, TileId const &tileId)
 {
     QString const fileName = tileData->relativeTileFileName(tileId);
@@ -255,7 +265,7 @@ void TileLoader::triggerDownload(GeoSceneTileDataset const *tileData, TileId con
     QString const destFileName = tileData->relativeTileFileName(id);
     QString const idStr =
         QStringLiteral("%1:%2:%3:%4:%5").arg(QString::fromLatin1(tileData->nodeType()), tileData->sourceDir()).arg(id.zoomLevel()).arg(id.x()).arg(id.y());
-    Q_EMIT tileRequested(sourceUrl, destFileName, idStr, usage);
+    Q_EMIT tileRequested(sourceUrl, destFileName, idStr, usage, tileData->tileProjection()->geoCoordinates(id), id.zoomLevel());
 }
 
 QImage TileLoader::scaledLowerLevelTile(const GeoSceneTextureTileDataset *textureData, TileId const &id)
@@ -304,12 +314,12 @@ QImage TileLoader::scaledLowerLevelTile(const GeoSceneTextureTileDataset *textur
 
 GeoDataDocument *TileLoader::openVectorFile(const QString &fileName) const
 {
-    QList<const ParseRunnerPlugin *> plugins = m_pluginManager->parsingRunnerPlugins();
+    const QList<const ParseRunnerPlugin *> plugins = m_pluginManager->parsingRunnerPlugins(fileName);
     const QFileInfo fileInfo(fileName);
     const QString suffix = fileInfo.suffix().toLower();
     const QString completeSuffix = fileInfo.completeSuffix().toLower();
 
-    for (const ParseRunnerPlugin *plugin : std::as_const(plugins)) {
+    for (const ParseRunnerPlugin *plugin : plugins) {
         QStringList const extensions = plugin->fileExtensions();
         if (extensions.contains(suffix) || extensions.contains(completeSuffix)) {
             ParsingRunner *runner = plugin->newRunner();
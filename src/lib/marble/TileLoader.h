@@ -10,6 +10,7 @@
 
 #include "MarbleGlobal.h"
 #include "PluginManager.h"
+#include "marble_export.h"
 
 class QByteArray;
 class QImage;
@@ -21,11 +22,12 @@ namespace Marble
 class TileId;
 class HttpDownloadManager;
 class GeoDataDocument;
+class GeoDataLatLonBox;
 class GeoSceneTileDataset;
 class GeoSceneTextureTileDataset;
 class GeoSceneVectorTileDataset;
 
-class TileLoader : public QObject
+class MARBLE_EXPORT TileLoader : public QObject
 {
     Q_OBJECT
 
@@ -39,6 +41,12 @@ public:
     explicit TileLoader(HttpDownloadManager *const, const PluginManager *);
     ~TileLoader() override;
 
+    /**
+     * Returns the image of the tile, or a scaled part of a lower level tile
+     * if it is not available yet. Missing and expired tiles get downloaded.
+     *
+     * This method may be called from several threads at once.
+     */
     QImage loadTileImage(GeoSceneTextureTileDataset const *textureData, TileId const &tileId, DownloadUsage const);
     GeoDataDocument *loadTileVectorData(GeoSceneVectorTileDataset const *vectorData, TileId const &tileId, DownloadUsage const usage);
     void downloadTile(GeoSceneTileDataset const *tileData, TileId const &, DownloadUsage const);
@@ -62,16 +70,32 @@ public:
 private Q_SLOTS:
     void updateTile(QByteArray const &imageData, QString const &tileId);
     void updateTile(QString const &fileName, QString const &idStr);
+    void cancelTile(QString const &idStr);
 
 Q_SIGNALS:
-    void tileRequested(QUrl const &sourceUrl, QString const &destinationFileName, QString const &id, DownloadUsage);
+    void tileRequested(QUrl const &sourceUrl,
+                       QString const &destinationFileName,
+                       QString const &id,
+                       DownloadUsage,
+                       GeoDataLatLonBox const &tileBox,
+                       int tileLevel);
 
     void tileCompleted(TileId const &tileId, QImage const &tileImage);
 
     void tileCompleted(TileId const &tileId, GeoDataDocument *document);
 
+    /**
+     * The download of the tile was cancelled as it went out of view. Any
+     * replacement shown for it should be dropped, so that it gets requested
+     * again once needed. Like tileCompleted(), this is emitted for the tiles of
+     * all datasets downloaded through the same download manager, the source dir
+     * hash of @p tileId tells them apart.
+     */
+    void tileCancelled(TileId const &tileId);
+
 private:
     static QString tileFileName(GeoSceneTileDataset const *tileData, TileId const &);
+    static TileId parseTileId(QString const &idStr, QString &origin);
     void triggerDownload(GeoSceneTileDataset const *tileData, TileId const &, DownloadUsage const);
     static QImage scaledLowerLevelTile(GeoSceneTextureTileDataset const *textureData, TileId const &);
     GeoDataDocument *openVectorFile(const QString &filename) const;
@@ -17,13 +17,20 @@
 namespace Marble
 {
 
+// How long a frame waits for missing tiles and data at most
+static const int maximumFrameWait = 5000;
+// How often the render status is checked while waiting
+static const int frameRetryInterval = 50;
+
 TourCaptureDialog::TourCaptureDialog(MarbleWidget *widget, QWidget *parent)
     : QDialog(parent)
     , ui(new Ui::TourCaptureDialog)
+    , m_marbleWidget(widget)
     , m_recorder(new MovieCapture(widget, parent))
     , m_playback(nullptr)
     , m_writingPossible(true)
     , m_current_position(0.0)
+    , m_framePainted(false)
 {
     ui->setupUi(this);
     m_recorder->setSnapshotMethod(MovieCapture::DataDriven);
@@ -44,6 +51,11 @@ TourCaptureDialog::TourCaptureDialog(MarbleWidget *widget, QWidget *parent)
     connect(m_recorder, &MovieCapture::rateCalculated, this, &TourCaptureDialog::setRate);
 
     connect(m_recorder, &MovieCapture::errorOccured, this, &TourCaptureDialog::handleError);
+
+    // Every paint of the widget updates its render status
+    connect(m_marbleWidget, &MarbleWidget::renderStateChanged, this, [this]() {
+        m_framePainted = true;
+    });
 }
 
 TourCaptureDialog::~TourCaptureDialog()
@@ -131,7 +143,6 @@ void TourCaptureDialog::updateProgress(double position)
 
 void TourCaptureDialog::recordNextFrame()
 {
-    double const shift = 1.0 / (ui->fpsSlider->value());
     double const duration = m_playback->duration();
 
     if (!m_writingPossible) {
@@ -145,10 +156,11 @@ void TourCaptureDialog::recordNextFrame()
 
     if (m_current_position <= duration) {
         m_playback->seek(m_current_position);
-        m_recorder->recordFrame();
-        updateProgress(m_current_position * 100);
-        m_current_position += shift;
-        QTimer::singleShot(1, this, SLOT(recordNextFrame()));
+        // The render status belongs to the previous frame until the widget painted this one
+        m_framePainted = false;
+        m_marbleWidget->repaintLayers();
+        m_frameTimer.start();
+        QTimer::singleShot(0, this, &TourCaptureDialog::captureFrame);
     } else {
         m_recorder->stopRecording();
         ui->progressBar->setValue(duration * 100);
@@ -158,6 +170,30 @@ void TourCaptureDialog::recordNextFrame()
     }
 }
 
+void TourCaptureDialog::captureFrame()
+{
+    if (ui->startButton->text() == QLatin1StringView("Start")) {
+        return;
+    }
+
+    // The tour advances by the frame rate, not by wall-clock time, so frames
+    // may wait for the map to be complete without making the movie jerky.
+    // The widget repaints itself as data arrives, the frame is only grabbed
+    // once it is going to be recorded.
+    const RenderStatus status = m_marbleWidget->renderStatus();
+    const bool ready = m_framePainted && (status == Complete || status == Incomplete);
+    if (!ready && m_frameTimer.elapsed() < maximumFrameWait) {
+        QTimer::singleShot(frameRetryInterval, this, &TourCaptureDialog::captureFrame);
+        return;
+    }
+
+    const QImage frame = m_marbleWidget->mapScreenShot().toImage();
+    m_recorder->addFrame(frame);
+    updateProgress(m_current_position * 100);
+    m_current_position += 1.0 / (ui->fpsSlider->value());
+    QTimer::singleShot(0, this, &TourCaptureDialog::recordNextFrame);
+}
+
 void TourCaptureDialog::setRate(double rate)
 {
     ui->rate->setText(QStringLiteral("%1 KBytes/sec").arg(rate));
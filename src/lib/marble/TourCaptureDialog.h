@@ -7,6 +7,7 @@
 #define TOURCAPTUREDIALOG_H
 
 #include <QDialog>
+#include <QElapsedTimer>
 
 #include "marble_export.h"
 
@@ -42,13 +43,19 @@ private Q_SLOTS:
     void loadDestinationFile();
     void updateProgress(double position);
     void recordNextFrame();
+    void captureFrame();
 
 private:
     Ui::TourCaptureDialog *const ui;
+    MarbleWidget *const m_marbleWidget;
     MovieCapture *const m_recorder;
     TourPlayback *m_playback = nullptr;
     bool m_writingPossible;
     double m_current_position;
+    // Measures how long the current frame waits for the map to be complete
+    QElapsedTimer m_frameTimer;
+    // Whether the widget painted since the tour moved to the current frame
+    bool m_framePainted;
     QString m_defaultFileName;
 };
 
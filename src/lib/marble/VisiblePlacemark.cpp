@@ -15,10 +15,6 @@
 #include "GeoDataStyle.h"
 #include "PlacemarkLayer.h"
 
-#include <QApplication>
-#include <QPainter>
-#include <QPainterPath>
-#include <QPalette>
 #include <QPixmapCache>
 
 using namespace Marble;
@@ -43,15 +39,22 @@ const GeoDataPlacemark *VisiblePlacemark::placemark() const
 
 const QPixmap &VisiblePlacemark::symbolPixmap() const
 {
-    if (!m_symbolId.isEmpty() && m_symbolPixmap.isNull()) {
-        if (!QPixmapCache::find(m_symbolId, &m_symbolPixmap)) {
-            m_symbolPixmap = QPixmap::fromImage(m_style->iconStyle().scaledIcon());
+    if (m_symbolPixmap.isNull() && m_style) {
+        if (m_symbolId.isEmpty()) {
+            m_symbolPixmap = QPixmap::fromImage(symbolImage());
+        } else if (!QPixmapCache::find(m_symbolId, &m_symbolPixmap)) {
+            m_symbolPixmap = QPixmap::fromImage(symbolImage());
             QPixmapCache::insert(m_symbolId, m_symbolPixmap);
         }
     }
     return m_symbolPixmap;
 }
 
+QImage VisiblePlacemark::symbolImage() const
+{
+    return m_style ? m_style->iconStyle().scaledIcon() : QImage();
+}
+
 const QString &VisiblePlacemark::symbolId() const
 {
     return m_symbolId;
@@ -115,13 +118,13 @@ void VisiblePlacemark::setSymbolPosition(const QPointF &position)
     m_symbolPosition = position;
 }
 
-const QPixmap &VisiblePlacemark::labelPixmap()
+const LabelAtlas::Key &VisiblePlacemark::labelKey()
 {
     if (m_labelDirty) {
-        drawLabelPixmap();
+        updateLabelKey();
     }
 
-    return m_labelPixmap;
+    return m_labelKey;
 }
 
 void VisiblePlacemark::setSymbolPixmap()
@@ -130,8 +133,9 @@ void VisiblePlacemark::setSymbolPixmap()
         m_symbolId = m_style->iconStyle().iconPath() + QString::number(m_style->iconStyle().scale());
         if (m_style->iconStyle().iconPath().isEmpty()) {
             m_symbolId.clear();
-            m_symbolPixmap = QPixmap::fromImage(m_style->iconStyle().scaledIcon());
         }
+        // Created on demand by symbolPixmap(), which only works on the GUI thread
+        m_symbolPixmap = QPixmap();
         Q_EMIT updateNeeded();
     } else {
         mDebug() << "Style pointer is Null";
@@ -162,7 +166,7 @@ GeoDataStyle::ConstPtr VisiblePlacemark::style() const
 
 QRectF VisiblePlacemark::symbolRect() const
 {
-    return QRectF(m_symbolPosition, m_symbolPixmap.size());
+    return QRectF(m_symbolPosition, symbolImage().size());
 }
 
 QRectF VisiblePlacemark::boundingBox() const
@@ -175,85 +179,24 @@ const GeoDataCoordinates &VisiblePlacemark::coordinates() const
     return m_coordinates;
 }
 
-void VisiblePlacemark::drawLabelPixmap()
+void VisiblePlacemark::updateLabelKey()
 {
     m_labelDirty = false;
+    m_labelKey = LabelAtlas::Key();
     QString labelName = m_placemark->displayName();
     if (labelName.isEmpty() || m_style->labelStyle().color() == QColor(Qt::transparent)) {
-        m_labelPixmap = QPixmap();
         return;
     }
 
-    QFont labelFont = m_style->labelStyle().scaledFont();
-    QColor labelColor = m_style->labelStyle().color();
+    m_labelKey.text = labelName;
+    m_labelKey.font = m_style->labelStyle().scaledFont();
+    m_labelKey.color = m_style->labelStyle().color();
+    m_labelKey.glow = m_style->labelStyle().glow();
 
-    LabelStyle labelStyle = Normal;
     if (m_selected) {
-        labelStyle = Selected;
-    } else if (m_style->labelStyle().glow()) {
-        labelStyle = Glow;
-    }
-
-    int textHeight = QFontMetrics(labelFont).height();
-
-    int textWidth;
-    if (m_style->labelStyle().glow()) {
-        labelFont.setWeight(QFont::Bold); // Needed to calculate the correct pixmap size;
-        textWidth = (QFontMetrics(labelFont).horizontalAdvance(labelName) + qRound(2 * s_labelOutlineWidth));
-    } else {
-        textWidth = (QFontMetrics(labelFont).horizontalAdvance(labelName));
-    }
-
-    m_labelPixmap = QPixmap(QSize(textWidth, textHeight));
-    m_labelPixmap.fill(Qt::transparent);
-
-    QPainter labelPainter(&m_labelPixmap);
-
-    drawLabelText(labelPainter, labelName, labelFont, labelStyle, labelColor);
-}
-
-void VisiblePlacemark::drawLabelText(QPainter &labelPainter, const QString &text, const QFont &labelFont, LabelStyle labelStyle, const QColor &color)
-{
-    QFont font = labelFont;
-    QFontMetrics metrics = QFontMetrics(font);
-    int fontAscent = metrics.ascent();
-
-    switch (labelStyle) {
-    case Selected: {
-        labelPainter.setPen(color);
-        labelPainter.setFont(font);
-        QRect textRect(0, 0, metrics.horizontalAdvance(text), metrics.height());
-        labelPainter.fillRect(textRect, QApplication::palette().highlight());
-        labelPainter.setPen(QPen(QApplication::palette().highlightedText(), 1));
-        labelPainter.drawText(0, fontAscent, text);
-        break;
-    }
-    case Glow: {
-        font.setWeight(QFont::Bold);
-        fontAscent = QFontMetrics(font).ascent();
-
-        QPen outlinepen((color.red() + color.green() + color.blue()) / 3 < 160 ? Qt::white : Qt::black);
-        outlinepen.setWidthF(s_labelOutlineWidth);
-        QBrush outlinebrush(color);
-
-        QPainterPath outlinepath;
-
-        const QPointF baseline(s_labelOutlineWidth / 2.0, fontAscent);
-        outlinepath.addText(baseline, font, text);
-        labelPainter.setRenderHint(QPainter::Antialiasing, true);
-        labelPainter.setPen(outlinepen);
-        labelPainter.setBrush(outlinebrush);
-        labelPainter.drawPath(outlinepath);
-        labelPainter.setPen(Qt::NoPen);
-        labelPainter.drawPath(outlinepath);
-        labelPainter.setRenderHint(QPainter::Antialiasing, false);
-        break;
-    }
-    default: {
-        labelPainter.setPen(color);
-        labelPainter.setFont(font);
-        labelPainter.drawText(0, fontAscent, text);
-    }
+        m_labelKey.style = LabelAtlas::Selected;
+    } else if (m_labelKey.glow) {
+        m_labelKey.style = LabelAtlas::Glow;
     }
 }
 
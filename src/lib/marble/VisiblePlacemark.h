@@ -12,6 +12,7 @@
 #define MARBLE_VISIBLEPLACEMARK_H
 
 #include <QObject>
+#include <QImage>
 #include <QPixmap>
 #include <QPoint>
 #include <QRectF>
@@ -19,6 +20,8 @@
 #include <GeoDataCoordinates.h>
 #include <GeoDataStyle.h>
 
+#include "LabelAtlas.h"
+
 namespace Marble
 {
 
@@ -47,9 +50,15 @@ public:
 
     /**
      * Returns the pixmap of the place mark symbol.
+     * Pixmaps must only be used on the GUI thread, use symbolImage() elsewhere.
      */
     const QPixmap &symbolPixmap() const;
 
+    /**
+     * Returns the image of the place mark symbol.
+     */
+    QImage symbolImage() const;
+
     /**
      * Returns the id for the place mark symbol.
      */
@@ -81,9 +90,10 @@ public:
     void setSymbolPosition(const QPointF &position);
 
     /**
-     * Returns the pixmap of the place mark name label.
+     * Returns the description of the place mark name label, for looking it up
+     * in the label atlas. The text is empty if there is no label to show.
      */
-    const QPixmap &labelPixmap();
+    const LabelAtlas::Key &labelKey();
 
     /**
      * Returns the area covered by the place mark name label on the map.
@@ -95,12 +105,6 @@ public:
      */
     void setLabelRect(const QRectF &area);
 
-    enum LabelStyle {
-        Normal = 0,
-        Glow,
-        Selected
-    };
-
     void setStyle(const GeoDataStyle::ConstPtr &style);
 
     GeoDataStyle::ConstPtr style() const;
@@ -118,15 +122,14 @@ private Q_SLOTS:
     void setSymbolPixmap();
 
 private:
-    static void drawLabelText(QPainter &labelPainter, const QString &text, const QFont &labelFont, LabelStyle labelStyle, const QColor &color);
-    void drawLabelPixmap();
+    void updateLabelKey();
 
     const GeoDataPlacemark *m_placemark;
 
     // View stuff
     QPointF m_symbolPosition; // position of the placemark's symbol
     bool m_selected; // state of the placemark
-    QPixmap m_labelPixmap; // the text label (most often name)
+    LabelAtlas::Key m_labelKey; // the text label (most often name)
     bool m_labelDirty;
     QRectF m_labelRect; // bounding box of label
 
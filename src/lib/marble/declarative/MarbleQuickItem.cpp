@@ -4,12 +4,11 @@
 //
 
 #include <MarbleQuickItem.h>
-#include <QPaintDevice>
-#include <QPainter>
+#include <QImage>
 #include <QQmlContext>
 #include <QQmlEngine>
 #include <QQuickWindow>
-#include <QScreen>
+#include <QSGImageNode>
 #include <QSettings>
 #include <QtMath>
 
@@ -191,7 +190,14 @@ public:
         , m_heading(0.0)
         , m_hoverEnabled(false)
         , m_invertColorEnabled(false)
+        , m_devicePixelRatio(1.0)
+        , m_painting(false)
     {
+        for (int group = 0; group < LayerGroupCount; ++group) {
+            m_imageDirty[group] = true;
+            m_textureDirty[group] = false;
+        }
+
         m_currentPosition.setName(QObject::tr("Current Location"));
         m_relationTypeConverter[QStringLiteral("road")] = GeoDataRelation::RouteRoad;
         m_relationTypeConverter[QStringLiteral("detour")] = GeoDataRelation::RouteDetour;
@@ -217,6 +223,24 @@ public:
     void changeBlending(bool enabled, const QString &blendingName);
     void changeStyleBuilder(bool invert);
 
+    /**
+     * The groups of render positions that are painted into separate images,
+     * in the order they are composed in.
+     */
+    enum LayerGroup {
+        SurfaceGroup,
+        OverlayGroup,
+        FloatItemGroup,
+        LayerGroupCount
+    };
+
+    static LayerGroup layerGroup(const QString &renderPosition);
+
+    void setDirty(const QStringList &renderPositions);
+
+    /// Paints the images of the groups that contain dirty layers
+    void updateLayerImages(qreal devicePixelRatio);
+
 private:
     friend class MarbleQuickItem;
     MarbleModel m_model;
@@ -240,14 +264,79 @@ private:
     qreal m_heading;
     bool m_hoverEnabled;
     bool m_invertColorEnabled;
+
+    // Painted on the GUI thread while polishing, uploaded while synchronizing with the render thread
+    QImage m_layerImages[LayerGroupCount];
+    bool m_imageDirty[LayerGroupCount];
+    bool m_textureDirty[LayerGroupCount];
+    qreal m_devicePixelRatio;
+    bool m_painting;
 };
 
+MarbleQuickItemPrivate::LayerGroup MarbleQuickItemPrivate::layerGroup(const QString &renderPosition)
+{
+    if (renderPosition == QLatin1StringView("STARS") || renderPosition == QLatin1StringView("BEHIND_TARGET")
+        || renderPosition == QLatin1StringView("SURFACE")) {
+        return SurfaceGroup;
+    }
+    if (renderPosition == QLatin1StringView("FLOAT_ITEM") || renderPosition == QLatin1StringView("USER_TOOLS")) {
+        return FloatItemGroup;
+    }
+    return OverlayGroup;
+}
+
+void MarbleQuickItemPrivate::setDirty(const QStringList &renderPositions)
+{
+    for (const QString &renderPosition : renderPositions) {
+        m_imageDirty[layerGroup(renderPosition)] = true;
+    }
+}
+
+void MarbleQuickItemPrivate::updateLayerImages(qreal devicePixelRatio)
+{
+    setDirty(m_map.dirtyRenderPositions());
+
+    const QSize size = (QSizeF(m_map.size()) * devicePixelRatio).toSize();
+    const QStringList renderPositions = m_map.renderPositions();
+    for (int group = 0; group < LayerGroupCount; ++group) {
+        QImage &image = m_layerImages[group];
+        if (image.size() != size || devicePixelRatio != m_devicePixelRatio) {
+            // The globe surface covers the whole image, there is nothing to blend it with
+            image = QImage(size, group == SurfaceGroup ? QImage::Format_RGB32 : QImage::Format_ARGB32_Premultiplied);
+            m_imageDirty[group] = true;
+        }
+        if (!m_imageDirty[group]) {
+            continue;
+        }
+
+        QStringList groupPositions;
+        for (const QString &renderPosition : renderPositions) {
+            if (layerGroup(renderPosition) == group) {
+                groupPositions << renderPosition;
+            }
+        }
+
+        // Layers may request another repaint while being painted
+        m_imageDirty[group] = false;
+        m_textureDirty[group] = true;
+
+        image.fill(group == SurfaceGroup ? Qt::black : Qt::transparent);
+        {
+            GeoPainter painter(&image, m_map.viewport(), m_map.mapQuality());
+            if (devicePixelRatio != 1.0) {
+                painter.scale(devicePixelRatio, devicePixelRatio);
+            }
+            m_map.paintLayers(painter, groupPositions);
+        }
+    }
+    m_devicePixelRatio = devicePixelRatio;
+}
+
 MarbleQuickItem::MarbleQuickItem(QQuickItem *parent)
-    : QQuickPaintedItem(parent)
+    : QQuickItem(parent)
     , d(new MarbleQuickItemPrivate(this))
 {
-    setOpaquePainting(true);
-    setFillColor(Qt::black);
+    setFlag(ItemHasContents, true);
     qRegisterMetaType<Placemark *>("Placemark*");
     d->m_map.setMapQualityForViewContext(NormalQuality, Animation);
 
@@ -262,7 +351,7 @@ MarbleQuickItem::MarbleQuickItem(QQuickItem *parent)
     d->m_model.positionTracking()->setTrackVisible(false);
     d->m_mapTheme.setMap(this);
 
-    connect(&d->m_map, SIGNAL(repaintNeeded(QRegion)), this, SLOT(update()));
+    connect(&d->m_map, &MarbleMap::repaintNeeded, this, &MarbleQuickItem::scheduleRepaint);
     connect(this, &MarbleQuickItem::widthChanged, this, &MarbleQuickItem::resizeMap);
     connect(this, &MarbleQuickItem::heightChanged, this, &MarbleQuickItem::resizeMap);
     connect(&d->m_map, &MarbleMap::visibleLatLonAltBoxChanged, this, &MarbleQuickItem::updatePositionVisibility);
@@ -279,10 +368,34 @@ MarbleQuickItem::MarbleQuickItem(QQuickItem *parent)
     installEventFilter(&d->m_inputHandler);
 }
 
+void MarbleQuickItem::scheduleRepaint()
+{
+    // MarbleMap marks the layers that changed before requesting the repaint
+    d->setDirty(d->m_map.dirtyRenderPositions());
+    if (d->m_map.showFrameRate()) {
+        d->m_imageDirty[MarbleQuickItemPrivate::FloatItemGroup] = true;
+    }
+
+    if (d->m_painting) {
+        // Polishing again while polishing would loop
+        QMetaObject::invokeMethod(
+            this,
+            [this]() {
+                polish();
+                update();
+            },
+            Qt::QueuedConnection);
+        return;
+    }
+
+    polish();
+    update();
+}
+
 void MarbleQuickItem::resizeMap()
 {
     d->m_map.setSize(qMax(100, int(width())), qMax(100, int(height())));
-    update();
+    scheduleRepaint();
     updatePositionVisibility();
 }
 
@@ -370,29 +483,53 @@ void MarbleQuickItem::handleVisibleLatLonAltBoxChanged(const GeoDataLatLonAltBox
     Q_EMIT geoItemUpdateRequested();
 }
 
-void MarbleQuickItem::paint(QPainter *painter)
+void MarbleQuickItem::updatePolish()
 { // TODO - much to be done here still, i.e paint !enabled version
-    QPaintDevice *paintDevice = painter->device();
-    QRect rect = contentsBoundingRect().toRect();
+    QQuickWindow *const window = this->window();
+    d->m_painting = true;
+    // For HighDPI displays take QT_SCALE_FACTOR into account
+    d->updateLayerImages(window ? window->effectiveDevicePixelRatio() : 1.0);
+    d->m_painting = false;
+}
 
-    painter->end();
-    {
-        GeoPainter geoPainter(paintDevice, d->m_map.viewport(), d->m_map.mapQuality());
-
-        double scale = 1.0;
-        // For HighDPI displays take QT_SCALE_FACTOR into account:
-        QQuickWindow *window = this->window();
-        if (window) {
-            QScreen *screen = window->screen();
-            scale = screen != nullptr ? screen->devicePixelRatio() : 1.0;
-            if (scale != 1) {
-                geoPainter.scale(scale, scale);
+QSGNode *MarbleQuickItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    QQuickWindow *const window = this->window();
+    if (!oldNode) {
+        for (const QImage &image : std::as_const(d->m_layerImages)) {
+            if (image.isNull()) {
+                // Not polished yet
+                return nullptr;
             }
         }
 
-        d->m_map.paint(geoPainter, rect);
+        oldNode = new QSGNode;
+        for (int group = 0; group < MarbleQuickItemPrivate::LayerGroupCount; ++group) {
+            QSGImageNode *const node = window->createImageNode();
+            node->setOwnsTexture(true);
+            oldNode->appendChildNode(node);
+            d->m_textureDirty[group] = true;
+        }
     }
-    painter->begin(paintDevice);
+
+    const QRectF rect(QPointF(0.0, 0.0), QSizeF(d->m_map.size()));
+    int group = 0;
+    for (QSGNode *child = oldNode->firstChild(); child; child = child->nextSibling(), ++group) {
+        auto const node = static_cast<QSGImageNode *>(child);
+        if (d->m_textureDirty[group]) {
+            const QImage &image = d->m_layerImages[group];
+            QQuickWindow::CreateTextureOptions options;
+            if (group != MarbleQuickItemPrivate::SurfaceGroup) {
+                options |= QQuickWindow::TextureHasAlphaChannel;
+            }
+            node->setTexture(window->createTextureFromImage(image, options));
+            node->setSourceRect(QRectF(QPointF(0.0, 0.0), QSizeF(image.size())));
+            d->m_textureDirty[group] = false;
+        }
+        node->setRect(rect);
+    }
+
+    return oldNode;
 }
 
 void MarbleQuickItem::classBegin()
@@ -401,6 +538,7 @@ void MarbleQuickItem::classBegin()
 
 void MarbleQuickItem::componentComplete()
 {
+    scheduleRepaint();
 }
 
 void Marble::MarbleQuickItem::MarbleQuickItem::hoverMoveEvent(QHoverEvent *event)
@@ -1163,25 +1301,25 @@ bool MarbleQuickItem::workOffline()
 void MarbleQuickItem::setShowRuntimeTrace(bool showRuntimeTrace)
 {
     d->m_map.setShowRuntimeTrace(showRuntimeTrace);
-    update();
+    scheduleRepaint();
 }
 
 void MarbleQuickItem::setShowDebugPolygons(bool showDebugPolygons)
 {
     d->m_map.setShowDebugPolygons(showDebugPolygons);
-    update();
+    scheduleRepaint();
 }
 
 void MarbleQuickItem::setShowDebugPlacemarks(bool showDebugPlacemarks)
 {
     d->m_map.setShowDebugPlacemarks(showDebugPlacemarks);
-    update();
+    scheduleRepaint();
 }
 
 void MarbleQuickItem::setShowDebugBatches(bool showDebugBatches)
 {
     d->m_map.setShowDebugBatchRender(showDebugBatches);
-    update();
+    scheduleRepaint();
 }
 
 void MarbleQuickItem::setPlacemarkDelegate(QQmlComponent *placemarkDelegate)
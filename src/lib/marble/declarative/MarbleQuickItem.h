@@ -17,7 +17,7 @@
 #include "PositionProviderPluginInterface.h"
 
 #include <QPolygonF>
-#include <QQuickPaintedItem>
+#include <QQuickItem>
 #include <QSharedPointer>
 #include <qqmlregistration.h>
 
@@ -30,7 +30,13 @@ class MarbleInputHandler;
 class MarbleQuickItemPrivate;
 
 // Class is still being developed
-class MarbleQuickItem : public QQuickPaintedItem
+/**
+ * The layers of the map are painted into three cached images, one for the
+ * globe surface, one for the layers above it and one for the float items.
+ * They are composed in the scene graph, and only the images containing
+ * layers that changed get painted and uploaded again.
+ */
+class MarbleQuickItem : public QQuickItem
 {
     Q_OBJECT
     QML_NAMED_ELEMENT(MarbleItem)
@@ -167,8 +173,9 @@ public Q_SLOTS:
     qreal centerLongitude() const;
     qreal centerLatitude() const;
 
-public:
-    void paint(QPainter *painter) override;
+protected:
+    void updatePolish() override;
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
 
     // QQmlParserStatus interface
 public:
@@ -296,6 +303,7 @@ protected:
     void pinch(const QPointF &center, qreal scale, Qt::GestureState state);
 
 private Q_SLOTS:
+    void scheduleRepaint();
     void resizeMap();
     void positionDataStatusChanged(PositionProviderStatus status);
     void positionChanged(const GeoDataCoordinates &, GeoDataAccuracy);
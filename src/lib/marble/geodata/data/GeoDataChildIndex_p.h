@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_GEODATACHILDINDEX_P_H
+#define MARBLE_GEODATACHILDINDEX_P_H
+
+#include <QHash>
+#include <QList>
+
+namespace Marble
+{
+
+/**
+ * Maps the children of a container to their position in it.
+ *
+ * The mapping is built on the first lookup and kept up to date while children
+ * are appended or removed from the end, which covers documents being loaded.
+ * Any other modification invalidates it. Small containers are scanned
+ * linearly instead, they are the vast majority and not worth the memory.
+ */
+template<typename T>
+class GeoDataChildIndex
+{
+public:
+    int position(const QList<T *> &children, const T *child) const
+    {
+        if (children.size() < MinimumSize) {
+            return children.indexOf(child);
+        }
+
+        if (!m_valid) {
+            m_positions.clear();
+            m_positions.reserve(children.size());
+            // Walk backwards so that duplicates resolve to their first position, like indexOf()
+            for (int i = children.size() - 1; i >= 0; --i) {
+                m_positions.insert(children.at(i), i);
+            }
+            m_valid = true;
+        }
+        return m_positions.value(child, -1);
+    }
+
+    /** To be called after a child was appended to @p children */
+    void appended(const QList<T *> &children)
+    {
+        if (m_valid && !m_positions.contains(children.last())) {
+            m_positions.insert(children.last(), children.size() - 1);
+        }
+    }
+
+    /** To be called after @p child was removed from the end of @p children */
+    void removedLast(const QList<T *> &children, const T *child)
+    {
+        if (m_valid) {
+            const auto iterator = m_positions.constFind(child);
+            if (iterator != m_positions.constEnd() && iterator.value() == children.size()) {
+                m_positions.erase(iterator);
+            }
+        }
+    }
+
+    void invalidate()
+    {
+        if (m_valid) {
+            m_positions.clear();
+            m_valid = false;
+        }
+    }
+
+private:
+    static constexpr int MinimumSize = 32;
+
+    mutable QHash<const T *, int> m_positions;
+    mutable bool m_valid = false;
+};
+
+}
+
+#endif
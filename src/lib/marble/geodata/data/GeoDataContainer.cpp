@@ -175,12 +175,7 @@ const GeoDataFeature *GeoDataContainer::child(int i) const
 int GeoDataContainer::childPosition(const GeoDataFeature *object) const
 {
     Q_D(const GeoDataContainer);
-    for (int i = 0; i < d->m_vector.size(); ++i) {
-        if (d->m_vector.at(i) == object) {
-            return i;
-        }
-    }
-    return -1;
+    return d->m_childIndex.position(d->m_vector, object);
 }
 
 void GeoDataContainer::insert(GeoDataFeature *other, int index)
@@ -193,6 +188,11 @@ void GeoDataContainer::insert(int index, GeoDataFeature *feature)
     Q_D(GeoDataContainer);
     feature->setParent(this);
     d->m_vector.insert(index, feature);
+    if (index == d->m_vector.size() - 1) {
+        d->m_childIndex.appended(d->m_vector);
+    } else {
+        d->m_childIndex.invalidate();
+    }
 }
 
 void GeoDataContainer::append(GeoDataFeature *other)
@@ -200,23 +200,27 @@ void GeoDataContainer::append(GeoDataFeature *other)
     Q_D(GeoDataContainer);
     other->setParent(this);
     d->m_vector.append(other);
+    d->m_childIndex.appended(d->m_vector);
 }
 
 void GeoDataContainer::remove(int index)
 {
     Q_D(GeoDataContainer);
     d->m_vector.remove(index);
+    d->m_childIndex.invalidate();
 }
 
 void GeoDataContainer::remove(int index, int count)
 {
     Q_D(GeoDataContainer);
     d->m_vector.remove(index, count);
+    d->m_childIndex.invalidate();
 }
 
 int GeoDataContainer::removeAll(GeoDataFeature *feature)
 {
     Q_D(GeoDataContainer);
+    d->m_childIndex.invalidate();
     return d->m_vector.removeAll(feature);
 }
 
@@ -224,23 +228,27 @@ void GeoDataContainer::removeAt(int index)
 {
     Q_D(GeoDataContainer);
     d->m_vector.removeAt(index);
+    d->m_childIndex.invalidate();
 }
 
 void GeoDataContainer::removeFirst()
 {
     Q_D(GeoDataContainer);
     d->m_vector.removeFirst();
+    d->m_childIndex.invalidate();
 }
 
 void GeoDataContainer::removeLast()
 {
     Q_D(GeoDataContainer);
-    d->m_vector.removeLast();
+    const GeoDataFeature *feature = d->m_vector.takeLast();
+    d->m_childIndex.removedLast(d->m_vector, feature);
 }
 
 bool GeoDataContainer::removeOne(GeoDataFeature *feature)
 {
     Q_D(GeoDataContainer);
+    d->m_childIndex.invalidate();
     return d->m_vector.removeOne(feature);
 }
 
@@ -296,17 +304,21 @@ void GeoDataContainer::clear()
     Q_D(GeoDataContainer);
     qDeleteAll(d->m_vector);
     d->m_vector.clear();
+    d->m_childIndex.invalidate();
 }
 
 QList<GeoDataFeature *>::Iterator GeoDataContainer::begin()
 {
     Q_D(GeoDataContainer);
+    // Children may be replaced through the iterator
+    d->m_childIndex.invalidate();
     return d->m_vector.begin();
 }
 
 QList<GeoDataFeature *>::Iterator GeoDataContainer::end()
 {
     Q_D(GeoDataContainer);
+    d->m_childIndex.invalidate();
     return d->m_vector.end();
 }
 
@@ -370,6 +382,7 @@ void GeoDataContainer::unpack(QDataStream &stream)
             break;
         };
     }
+    d->m_childIndex.invalidate();
 }
 
 }
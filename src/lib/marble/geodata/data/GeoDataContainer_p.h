@@ -6,6 +6,7 @@
 #ifndef MARBLE_GEODATACONTAINERPRIVATE_H
 #define MARBLE_GEODATACONTAINERPRIVATE_H
 
+#include "GeoDataChildIndex_p.h"
 #include "GeoDataFeature_p.h"
 
 #include "GeoDataTypes.h"
@@ -37,6 +38,7 @@ public:
         GeoDataFeaturePrivate::operator=(other);
         qDeleteAll(m_vector);
         m_vector.clear();
+        m_childIndex.invalidate();
         m_vector.reserve(other.m_vector.size());
         for (GeoDataFeature *feature : other.m_vector) {
             m_vector.append(feature->clone());
@@ -57,6 +59,7 @@ public:
     }
 
     QList<GeoDataFeature *> m_vector;
+    GeoDataChildIndex<GeoDataFeature> m_childIndex;
 };
 
 } // namespace Marble
@@ -159,6 +159,8 @@ QList<GeoDataGeometry *>::Iterator GeoDataMultiGeometry::begin()
     detach();
 
     Q_D(GeoDataMultiGeometry);
+    // Children may be replaced through the iterator
+    d->m_childIndex.invalidate();
     return d->m_vector.begin();
 }
 
@@ -167,6 +169,7 @@ QList<GeoDataGeometry *>::Iterator GeoDataMultiGeometry::end()
     detach();
 
     Q_D(GeoDataMultiGeometry);
+    d->m_childIndex.invalidate();
     return d->m_vector.end();
 }
 
@@ -205,12 +208,7 @@ const GeoDataGeometry *GeoDataMultiGeometry::child(int i) const
 int GeoDataMultiGeometry::childPosition(const GeoDataGeometry *object) const
 {
     Q_D(const GeoDataMultiGeometry);
-    for (int i = 0; i < d->m_vector.size(); ++i) {
-        if (d->m_vector.at(i) == object) {
-            return i;
-        }
-    }
-    return -1;
+    return d->m_childIndex.position(d->m_vector, object);
 }
 
 /**
@@ -223,6 +221,7 @@ void GeoDataMultiGeometry::append(GeoDataGeometry *other)
     Q_D(GeoDataMultiGeometry);
     other->setParent(this);
     d->m_vector.append(other);
+    d->m_childIndex.appended(d->m_vector);
 }
 
 GeoDataMultiGeometry &GeoDataMultiGeometry::operator<<(const GeoDataGeometry &value)
@@ -233,6 +232,7 @@ GeoDataMultiGeometry &GeoDataMultiGeometry::operator<<(const GeoDataGeometry &va
     GeoDataGeometry *g = value.copy();
     g->setParent(this);
     d->m_vector.append(g);
+    d->m_childIndex.appended(d->m_vector);
     return *this;
 }
 
@@ -243,6 +243,7 @@ void GeoDataMultiGeometry::clear()
     Q_D(GeoDataMultiGeometry);
     qDeleteAll(d->m_vector);
     d->m_vector.clear();
+    d->m_childIndex.invalidate();
 }
 
 void GeoDataMultiGeometry::pack(QDataStream &stream) const
@@ -308,6 +309,7 @@ void GeoDataMultiGeometry::unpack(QDataStream &stream)
             break;
         };
     }
+    d->m_childIndex.invalidate();
 }
 
 }
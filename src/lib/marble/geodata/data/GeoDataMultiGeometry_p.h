@@ -6,6 +6,7 @@
 #ifndef MARBLE_GEODATAMULTIGEOMETRYPRIVATE_H
 #define MARBLE_GEODATAMULTIGEOMETRYPRIVATE_H
 
+#include "GeoDataChildIndex_p.h"
 #include "GeoDataGeometry_p.h"
 
 #include "GeoDataLineString.h"
@@ -35,6 +36,7 @@ public:
 
         qDeleteAll(m_vector);
         m_vector.clear();
+        m_childIndex.invalidate();
 
         m_vector.reserve(other.m_vector.size());
 
@@ -52,6 +54,7 @@ public:
     }
 
     QList<GeoDataGeometry *> m_vector;
+    GeoDataChildIndex<GeoDataGeometry> m_childIndex;
 };
 
 } // namespace Marble
@@ -14,7 +14,12 @@
 #include "GeoDataLineString.h"
 
 #include <QDateTime>
-#include <QMap>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 
 namespace Marble
 {
@@ -22,9 +27,29 @@ namespace Marble
 class GeoDataTrackPrivate : public GeoDataGeometryPrivate
 {
 public:
+    // Time value of points without time information
+    static constexpr qint64 InvalidTime = std::numeric_limits<qint64>::min();
+
+    // Number of resolutions decimated line strings are kept for, e.g. for several views
+    static constexpr int DecimationCacheSize = 4;
+
+    // The decimation of the first size points of the track for one tolerance
+    struct Decimation {
+        GeoDataLineString lineString;
+        qreal tolerance = 0.0;
+        int size = 0;
+        // Whether the last point of lineString is only kept because it ends the track
+        bool tail = false;
+        quint64 lastUsed = 0;
+    };
+
     GeoDataTrackPrivate()
-        : m_lineStringNeedsUpdate(false)
+        : m_lineStringSize(0)
+        , m_decimationUses(0)
+        , m_timeOrderNeedsUpdate(false)
         , m_interpolate(false)
+        , m_timeOrdered(true)
+        , m_hasTimeZone(false)
     {
     }
 
@@ -33,26 +58,274 @@ public:
         return new GeoDataTrackPrivate(*this);
     }
 
+    int pointCount() const
+    {
+        return m_coordinates.size() / 3;
+    }
+
+    // Number of points that have both coordinates and a time value
+    int timedPointCount() const
+    {
+        return qMin<int>(m_when.size(), pointCount());
+    }
+
+    GeoDataCoordinates coordinates(int index) const
+    {
+        const qreal *point = m_coordinates.constData() + 3 * index;
+        return GeoDataCoordinates(point[0], point[1], point[2]);
+    }
+
+    void insertCoordinates(int index, const GeoDataCoordinates &coord)
+    {
+        const qreal point[3] = {coord.longitude(), coord.latitude(), coord.altitude()};
+        m_coordinates.insert(3 * index, 3, 0.0);
+        std::copy(point, point + 3, m_coordinates.begin() + 3 * index);
+        changed(index);
+    }
+
+    // Time values are compared in UTC
+    static qint64 toTime(const QDateTime &when)
+    {
+        return when.isValid() ? when.toMSecsSinceEpoch() : InvalidTime;
+    }
+
+    // Hands out the time value at index in the time zone it was added with
+    QDateTime toDateTime(int index) const
+    {
+        const qint64 time = m_when[index];
+        if (time == InvalidTime) {
+            return {};
+        }
+        return QDateTime::fromMSecsSinceEpoch(time, m_timeZones.isEmpty() ? m_timeZone : m_timeZones[index]);
+    }
+
+    void insertWhen(int index, const QDateTime &when)
+    {
+        QTimeZone timeZone = m_timeZone;
+        if (!when.isValid()) {
+            m_timeOrdered = false;
+        } else if (!m_hasTimeZone) {
+            m_timeZone = when.timeRepresentation();
+            timeZone = m_timeZone;
+            m_hasTimeZone = true;
+        } else {
+            timeZone = when.timeRepresentation();
+            if (m_timeZones.isEmpty() && timeZone != m_timeZone) {
+                // Usually all values share a time zone, only mixed ones are stored per value
+                m_timeZones = QList<QTimeZone>(m_when.size(), m_timeZone);
+            }
+        }
+
+        m_when.insert(index, toTime(when));
+        if (!m_timeZones.isEmpty()) {
+            m_timeZones.insert(index, timeZone);
+        }
+    }
+
+    void removeWhen(int index, int count)
+    {
+        m_when.remove(index, count);
+        if (!m_timeZones.isEmpty()) {
+            m_timeZones.remove(index, count);
+        }
+    }
+
     void equalizeWhenSize()
     {
-        m_when.reserve(m_coordinates.size());
-        while (m_when.size() < m_coordinates.size()) {
+        m_when.reserve(pointCount());
+        while (m_when.size() < pointCount()) {
             // fill coordinates without time information with null QDateTime
-            m_when.append(QDateTime());
+            insertWhen(m_when.size(), QDateTime());
         }
     }
 
+    // Invalidates all derived data from the point at index on
+    void changed(int index)
+    {
+        m_lineStringSize = qMin(m_lineStringSize, index);
+        for (Decimation &decimation : m_decimations) {
+            if (index < decimation.size) {
+                decimation.size = 0;
+            }
+        }
+        m_timeOrderNeedsUpdate = true;
+    }
+
+    const QList<int> &timeOrder() const;
+
+    int orderedCount() const
+    {
+        return m_timeOrdered ? timedPointCount() : timeOrder().size();
+    }
+
+    int orderedIndex(int position) const
+    {
+        return m_timeOrdered ? position : m_timeOrder[position];
+    }
+
+    // Position in time order of the first point whose time value is not less than time
+    int lowerBound(qint64 time) const;
+
+    // Position in time order of the first point whose time value is greater than time
+    int upperBound(qint64 time) const;
+
+    void updateLineString() const;
+
+    const GeoDataLineString *decimatedLineString(qreal resolution) const;
+
+    // Holds the first m_lineStringSize points of the track
     mutable GeoDataLineString m_lineString;
-    mutable bool m_lineStringNeedsUpdate;
+    mutable int m_lineStringSize;
+
+    // Least recently used decimations are replaced. Slots do not move, so handed out
+    // line strings stay valid until their slot is reused.
+    mutable std::array<Decimation, DecimationCacheSize> m_decimations;
+    mutable quint64 m_decimationUses;
+
+    // Indices of the points with valid time values, sorted by time. Only used if not m_timeOrdered.
+    mutable QList<int> m_timeOrder;
+    mutable bool m_timeOrderNeedsUpdate;
 
     bool m_interpolate;
 
-    QList<QDateTime> m_when;
-    QList<GeoDataCoordinates> m_coordinates;
+    // Milliseconds since epoch, InvalidTime for points without time information
+    QList<qint64> m_when;
+    // Longitude and latitude in radians and altitude in meters, three values per point
+    QList<qreal> m_coordinates;
+    // Whether all time values are valid and in chronological order
+    bool m_timeOrdered;
+
+    // The time zone of the first time value
+    QTimeZone m_timeZone;
+    bool m_hasTimeZone;
+    // One time zone per time value, only used once values of different time zones were added
+    QList<QTimeZone> m_timeZones;
 
     GeoDataExtendedData m_extendedData;
 };
 
+const QList<int> &GeoDataTrackPrivate::timeOrder() const
+{
+    if (m_timeOrderNeedsUpdate) {
+        m_timeOrder.clear();
+        const int count = timedPointCount();
+        for (int i = 0; i < count; ++i) {
+            if (m_when[i] != InvalidTime) {
+                m_timeOrder << i;
+            }
+        }
+        std::stable_sort(m_timeOrder.begin(), m_timeOrder.end(), [this](int a, int b) {
+            return m_when[a] < m_when[b];
+        });
+        m_timeOrderNeedsUpdate = false;
+    }
+    return m_timeOrder;
+}
+
+int GeoDataTrackPrivate::lowerBound(qint64 time) const
+{
+    if (m_timeOrdered) {
+        const auto end = m_when.cbegin() + timedPointCount();
+        return std::lower_bound(m_when.cbegin(), end, time) - m_when.cbegin();
+    }
+    const QList<int> &order = timeOrder();
+    return std::lower_bound(order.cbegin(),
+                            order.cend(),
+                            time,
+                            [this](int index, qint64 value) {
+                                return m_when[index] < value;
+                            })
+        - order.cbegin();
+}
+
+int GeoDataTrackPrivate::upperBound(qint64 time) const
+{
+    if (m_timeOrdered) {
+        const auto end = m_when.cbegin() + timedPointCount();
+        return std::upper_bound(m_when.cbegin(), end, time) - m_when.cbegin();
+    }
+    const QList<int> &order = timeOrder();
+    return std::upper_bound(order.cbegin(),
+                            order.cend(),
+                            time,
+                            [this](qint64 value, int index) {
+                                return value < m_when[index];
+                            })
+        - order.cbegin();
+}
+
+void GeoDataTrackPrivate::updateLineString() const
+{
+    const int size = pointCount();
+    if (m_lineString.size() > m_lineStringSize) {
+        if (m_lineStringSize == 0) {
+            m_lineString.clear();
+        }
+        while (m_lineString.size() > m_lineStringSize) {
+            m_lineString.remove(m_lineString.size() - 1);
+        }
+    }
+    if (m_lineStringSize == size) {
+        return;
+    }
+
+    // Points appended since the last update only extend the line string
+    m_lineString.reserve(size);
+    for (int i = m_lineStringSize; i < size; ++i) {
+        m_lineString.append(coordinates(i));
+    }
+    m_lineStringSize = size;
+}
+
+const GeoDataLineString *GeoDataTrackPrivate::decimatedLineString(qreal resolution) const
+{
+    // Round down to a power of two so that zooming does not redo the decimation on every step
+    const qreal tolerance = std::exp2(std::floor(std::log2(resolution)));
+
+    Decimation *decimation = &m_decimations[0];
+    for (Decimation &candidate : m_decimations) {
+        if (candidate.tolerance == tolerance) {
+            decimation = &candidate;
+            break;
+        }
+        if (candidate.lastUsed < decimation->lastUsed) {
+            decimation = &candidate;
+        }
+    }
+    if (decimation->tolerance != tolerance) {
+        decimation->tolerance = tolerance;
+        decimation->size = 0;
+    }
+    decimation->lastUsed = ++m_decimationUses;
+
+    GeoDataLineString &lineString = decimation->lineString;
+    if (decimation->size == 0 && !lineString.isEmpty()) {
+        lineString.clear();
+        decimation->tail = false;
+    }
+
+    const int size = pointCount();
+    if (decimation->size == size) {
+        return &lineString;
+    }
+
+    if (decimation->tail) {
+        lineString.remove(lineString.size() - 1);
+        decimation->tail = false;
+    }
+    for (int i = decimation->size; i < size; ++i) {
+        const GeoDataCoordinates point = coordinates(i);
+        if (lineString.isEmpty() || std::as_const(lineString).last().sphericalDistanceTo(point) >= tolerance) {
+            lineString.append(point);
+        } else if (i == size - 1) {
+            lineString.append(point);
+            decimation->tail = true;
+        }
+    }
+    decimation->size = size;
+    return &lineString;
+}
+
 GeoDataTrack::GeoDataTrack()
     : GeoDataGeometry(new GeoDataTrackPrivate())
 {
@@ -96,7 +369,7 @@ bool GeoDataTrack::operator!=(const GeoDataTrack &other) const
 int GeoDataTrack::size() const
 {
     Q_D(const GeoDataTrack);
-    return d->m_coordinates.size();
+    return d->pointCount();
 }
 
 bool GeoDataTrack::interpolate() const
@@ -121,7 +394,7 @@ QDateTime GeoDataTrack::firstWhen() const
         return {};
     }
 
-    return d->m_when.first();
+    return d->toDateTime(0);
 }
 
 QDateTime GeoDataTrack::lastWhen() const
@@ -132,19 +405,31 @@ QDateTime GeoDataTrack::lastWhen() const
         return {};
     }
 
-    return d->m_when.last();
+    return d->toDateTime(d->m_when.size() - 1);
 }
 
 QList<GeoDataCoordinates> GeoDataTrack::coordinatesList() const
 {
     Q_D(const GeoDataTrack);
-    return d->m_coordinates;
+
+    QList<GeoDataCoordinates> result;
+    result.reserve(d->pointCount());
+    for (int i = 0; i < d->pointCount(); ++i) {
+        result << d->coordinates(i);
+    }
+    return result;
 }
 
 QList<QDateTime> GeoDataTrack::whenList() const
 {
     Q_D(const GeoDataTrack);
-    return d->m_when;
+
+    QList<QDateTime> result;
+    result.reserve(d->m_when.size());
+    for (int i = 0; i < d->m_when.size(); ++i) {
+        result << d->toDateTime(i);
+    }
+    return result;
 }
 
 GeoDataCoordinates GeoDataTrack::coordinatesAt(const QDateTime &when) const
@@ -155,48 +440,46 @@ GeoDataCoordinates GeoDataTrack::coordinatesAt(const QDateTime &when) const
         return {};
     }
 
-    if (d->m_when.contains(when)) {
-        // exact match found
-        const int index = d->m_when.indexOf(when);
-        if (index < d->m_coordinates.size()) {
-            return d->m_coordinates.at(index);
+    if (!when.isValid()) {
+        // only points without time information match
+        const int index = d->m_when.indexOf(GeoDataTrackPrivate::InvalidTime);
+        if (index >= 0 && index < d->pointCount()) {
+            return d->coordinates(index);
         }
+        return {};
     }
 
-    if (!interpolate()) {
-        return {};
+    const qint64 time = when.toMSecsSinceEpoch();
+    const int lower = d->lowerBound(time);
+    if (lower < d->orderedCount() && d->m_when[d->orderedIndex(lower)] == time) {
+        // exact match found
+        return d->coordinates(d->orderedIndex(lower));
     }
 
-    typedef QMap<QDateTime, GeoDataCoordinates> PointMap;
-    PointMap pointMap;
-    for (int i = 0; i < qMin(d->m_when.size(), d->m_coordinates.size()); ++i) {
-        if (d->m_when.at(i).isValid()) {
-            pointMap[d->m_when.at(i)] = d->m_coordinates.at(i);
-        }
+    if (!interpolate()) {
+        return {};
     }
 
-    QMap<QDateTime, GeoDataCoordinates>::const_iterator nextEntry = const_cast<const PointMap &>(pointMap).upperBound(when);
+    const int next = d->upperBound(time);
 
     // No tracked point happened before "when"
-    if (nextEntry == pointMap.constBegin()) {
+    if (next == 0) {
         mDebug() << "No tracked point before " << when;
         return {};
     }
 
-    if (nextEntry == pointMap.constEnd()) {
+    if (next == d->orderedCount()) {
         mDebug() << "No track point after" << when;
         return {};
     }
 
-    QMap<QDateTime, GeoDataCoordinates>::const_iterator previousEntry = nextEntry - 1;
-    GeoDataCoordinates previousCoord = previousEntry.value();
+    const int previousIndex = d->orderedIndex(next - 1);
+    const int nextIndex = d->orderedIndex(next);
+    const GeoDataCoordinates previousCoord = d->coordinates(previousIndex);
+    const GeoDataCoordinates nextCoord = d->coordinates(nextIndex);
 
-    QDateTime previousWhen = previousEntry.key();
-    QDateTime nextWhen = nextEntry.key();
-    GeoDataCoordinates nextCoord = nextEntry.value();
-
-    int interval = previousWhen.msecsTo(nextWhen);
-    int position = previousWhen.msecsTo(when);
+    const qint64 interval = d->m_when[nextIndex] - d->m_when[previousIndex];
+    const qint64 position = time - d->m_when[previousIndex];
     qreal t = (qreal)position / (qreal)interval;
 
     return previousCoord.interpolate(nextCoord, t);
@@ -205,7 +488,8 @@ GeoDataCoordinates GeoDataTrack::coordinatesAt(const QDateTime &when) const
 GeoDataCoordinates GeoDataTrack::coordinatesAt(int index) const
 {
     Q_D(const GeoDataTrack);
-    return d->m_coordinates.at(index);
+    Q_ASSERT(index >= 0 && index < d->pointCount());
+    return d->coordinates(index);
 }
 
 void GeoDataTrack::addPoint(const QDateTime &when, const GeoDataCoordinates &coord)
@@ -214,16 +498,20 @@ void GeoDataTrack::addPoint(const QDateTime &when, const GeoDataCoordinates &coo
 
     Q_D(GeoDataTrack);
     d->equalizeWhenSize();
-    d->m_lineStringNeedsUpdate = true;
+    const qint64 time = GeoDataTrackPrivate::toTime(when);
     int i = 0;
-    while (i < d->m_when.size()) {
-        if (d->m_when.at(i) > when) {
-            break;
+    if (d->m_timeOrdered) {
+        i = std::upper_bound(d->m_when.cbegin(), d->m_when.cend(), time) - d->m_when.cbegin();
+    } else {
+        while (i < d->m_when.size()) {
+            if (d->m_when.at(i) > time) {
+                break;
+            }
+            ++i;
         }
-        ++i;
     }
-    d->m_when.insert(i, when);
-    d->m_coordinates.insert(i, coord);
+    d->insertWhen(i, when);
+    d->insertCoordinates(i, coord);
 }
 
 void GeoDataTrack::appendCoordinates(const GeoDataCoordinates &coord)
@@ -232,8 +520,7 @@ void GeoDataTrack::appendCoordinates(const GeoDataCoordinates &coord)
 
     Q_D(GeoDataTrack);
     d->equalizeWhenSize();
-    d->m_lineStringNeedsUpdate = true;
-    d->m_coordinates.append(coord);
+    d->insertCoordinates(d->pointCount(), coord);
 }
 
 void GeoDataTrack::appendAltitude(qreal altitude)
@@ -241,14 +528,12 @@ void GeoDataTrack::appendAltitude(qreal altitude)
     detach();
 
     Q_D(GeoDataTrack);
-    d->m_lineStringNeedsUpdate = true;
     Q_ASSERT(!d->m_coordinates.isEmpty());
     if (d->m_coordinates.isEmpty()) {
         return;
     }
-    GeoDataCoordinates coordinates = d->m_coordinates.takeLast();
-    coordinates.setAltitude(altitude);
-    d->m_coordinates.append(coordinates);
+    d->m_coordinates.last() = altitude;
+    d->changed(d->pointCount() - 1);
 }
 
 void GeoDataTrack::appendWhen(const QDateTime &when)
@@ -256,7 +541,12 @@ void GeoDataTrack::appendWhen(const QDateTime &when)
     detach();
 
     Q_D(GeoDataTrack);
-    d->m_when.append(when);
+    const qint64 time = GeoDataTrackPrivate::toTime(when);
+    if (!d->m_when.isEmpty() && d->m_when.last() > time) {
+        d->m_timeOrdered = false;
+    }
+    d->insertWhen(d->m_when.size(), when);
+    d->m_timeOrderNeedsUpdate = true;
 }
 
 void GeoDataTrack::clear()
@@ -265,8 +555,11 @@ void GeoDataTrack::clear()
 
     Q_D(GeoDataTrack);
     d->m_when.clear();
+    d->m_timeZones.clear();
     d->m_coordinates.clear();
-    d->m_lineStringNeedsUpdate = true;
+    d->m_timeOrdered = true;
+    d->m_hasTimeZone = false;
+    d->changed(0);
 }
 
 void GeoDataTrack::removeBefore(const QDateTime &when)
@@ -274,16 +567,20 @@ void GeoDataTrack::removeBefore(const QDateTime &when)
     detach();
 
     Q_D(GeoDataTrack);
-    Q_ASSERT(d->m_coordinates.size() == d->m_when.size());
+    Q_ASSERT(d->pointCount() == d->m_when.size());
     if (d->m_when.isEmpty()) {
         return;
     }
     d->equalizeWhenSize();
 
-    while (!d->m_when.isEmpty() && d->m_when.first() < when) {
-        d->m_when.takeFirst();
-        d->m_coordinates.takeFirst();
+    const qint64 time = GeoDataTrackPrivate::toTime(when);
+    int count = 0;
+    while (count < d->m_when.size() && d->m_when.at(count) < time) {
+        ++count;
     }
+    d->removeWhen(0, count);
+    d->m_coordinates.remove(0, qMin<int>(3 * count, d->m_coordinates.size()));
+    d->changed(0);
 }
 
 void GeoDataTrack::removeAfter(const QDateTime &when)
@@ -291,28 +588,41 @@ void GeoDataTrack::removeAfter(const QDateTime &when)
     detach();
 
     Q_D(GeoDataTrack);
-    Q_ASSERT(d->m_coordinates.size() == d->m_when.size());
+    Q_ASSERT(d->pointCount() == d->m_when.size());
     if (d->m_when.isEmpty()) {
         return;
     }
     d->equalizeWhenSize();
-    while (!d->m_when.isEmpty() && d->m_when.last() > when) {
-        d->m_when.takeLast();
-        d->m_coordinates.takeLast();
+
+    const qint64 time = GeoDataTrackPrivate::toTime(when);
+    int size = d->m_when.size();
+    while (size > 0 && d->m_when.at(size - 1) > time) {
+        --size;
+    }
+    d->removeWhen(size, d->m_when.size() - size);
+    if (d->pointCount() > size) {
+        d->m_coordinates.resize(3 * size);
     }
+    d->changed(size);
 }
 
 const GeoDataLineString *GeoDataTrack::lineString() const
 {
     Q_D(const GeoDataTrack);
-    if (d->m_lineStringNeedsUpdate) {
-        d->m_lineString = GeoDataLineString();
-        d->m_lineString.append(coordinatesList());
-        d->m_lineStringNeedsUpdate = false;
-    }
+    d->updateLineString();
     return &d->m_lineString;
 }
 
+const GeoDataLineString *GeoDataTrack::decimatedLineString(qreal resolution) const
+{
+    if (resolution <= 0.0) {
+        return lineString();
+    }
+
+    Q_D(const GeoDataTrack);
+    return d->decimatedLineString(resolution);
+}
+
 GeoDataExtendedData &GeoDataTrack::extendedData()
 {
     detach();
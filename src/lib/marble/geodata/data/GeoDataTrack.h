@@ -173,6 +173,19 @@ public:
      */
     const GeoDataLineString *lineString() const;
 
+    /**
+     * Return a GeoDataLineString of the current track that is thinned out for
+     * display: points closer than @p resolution (in radians) to the previously
+     * kept point are skipped, the first and last point are always kept. The
+     * result is cached for the last few resolutions, so several views at
+     * different zoom levels can share a track, and extended as new points are
+     * appended, so it is cheap to call on every repaint. A non-positive
+     * resolution returns lineString().
+     *
+     * @see ViewportParams::angularResolution()
+     */
+    const GeoDataLineString *decimatedLineString(qreal resolution) const;
+
     /**
      * Return the ExtendedData assigned to the feature.
      */
@@ -19,8 +19,9 @@
 #include "OsmPlacemarkData.h"
 #include "ViewportParams.h"
 
-#include <QImageReader>
+#include <QCoreApplication>
 #include <QPixmapCache>
+#include <QThread>
 #include <QtMath>
 
 namespace Marble
@@ -188,25 +189,32 @@ int AbstractGeoPolygonGraphicsItem::extractElevation(const GeoDataPlacemark &pla
     return elevation;
 }
 
-QPixmap AbstractGeoPolygonGraphicsItem::texture(const QString &texturePath, const QColor &color) const
+QBrush AbstractGeoPolygonGraphicsItem::texture(const QString &texturePath, const QColor &color) const
 {
+    // Pixmaps and QPixmapCache only work on the GUI thread, other threads use the image
+    const bool guiThread = QThread::currentThread() == QCoreApplication::instance()->thread();
     QString const key = QString::number(color.rgba()) + QLatin1Char('/') + texturePath;
     QPixmap texture;
-    if (!QPixmapCache::find(key, &texture)) {
-        QImageReader imageReader(style()->polyStyle().resolvePath(texturePath));
-        texture = QPixmap::fromImageReader(&imageReader);
-
-        if (texture.hasAlphaChannel()) {
-            QPixmap pixmap(texture.size());
-            pixmap.fill(color);
-            QPainter imagePainter(&pixmap);
-            imagePainter.drawPixmap(0, 0, texture);
-            imagePainter.end();
-            texture = pixmap;
-        }
-        QPixmapCache::insert(key, texture);
+    if (guiThread && QPixmapCache::find(key, &texture)) {
+        return QBrush(texture);
+    }
+
+    QImage image(style()->polyStyle().resolvePath(texturePath));
+    if (image.hasAlphaChannel()) {
+        QImage background(image.size(), QImage::Format_ARGB32_Premultiplied);
+        background.fill(color);
+        QPainter imagePainter(&background);
+        imagePainter.drawImage(0, 0, image);
+        imagePainter.end();
+        image = background;
+    }
+
+    if (!guiThread) {
+        return QBrush(image);
     }
-    return texture;
+    texture = QPixmap::fromImage(image);
+    QPixmapCache::insert(key, texture);
+    return QBrush(texture);
 }
 
 void AbstractGeoPolygonGraphicsItem::setLinearRing(GeoDataLinearRing *ring)
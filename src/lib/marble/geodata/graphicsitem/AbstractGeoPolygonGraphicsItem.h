@@ -9,6 +9,7 @@
 #include "GeoGraphicsItem.h"
 #include "marble_export.h"
 
+#include <QBrush>
 #include <QColor>
 #include <QImage>
 
@@ -56,7 +57,7 @@ protected:
     static int extractElevation(const GeoDataPlacemark &placemark);
 
 private:
-    QPixmap texture(const QString &path, const QColor &color) const;
+    QBrush texture(const QString &path, const QColor &color) const;
 
     const GeoDataPolygon *m_polygon;
     const GeoDataLinearRing *m_ring;
@@ -8,6 +8,7 @@
 #include "GeoDataPlacemark.h"
 #include "GeoDataTrack.h"
 #include "StyleBuilder.h"
+#include "ViewportParams.h"
 
 using namespace Marble;
 
@@ -31,7 +32,8 @@ void GeoTrackGraphicsItem::paint(GeoPainter *painter, const ViewportParams *view
 {
     Q_UNUSED(layer);
     Q_UNUSED(tileZoomLevel);
-    update();
+    // Points closer than a pixel do not change the rendering
+    setLineString(m_track->decimatedLineString(viewport->angularResolution()));
     GeoLineStringGraphicsItem::paint(painter, viewport, layer, tileZoomLevel);
 }
 
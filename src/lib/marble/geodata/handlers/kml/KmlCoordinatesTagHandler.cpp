@@ -6,9 +6,6 @@
 
 #include "KmlCoordinatesTagHandler.h"
 
-#include <QRegularExpression>
-#include <QStringList>
-
 #include "GeoDataLatLonQuad.h"
 #include "GeoDataLineString.h"
 #include "GeoDataLinearRing.h"
@@ -36,6 +33,131 @@ static GeoTagHandlerRegistrar s_handlercoordkmlTag_nameSpaceGx22(GeoParser::Qual
                                                                                           QLatin1StringView(kmlTag_nameSpaceGx22)),
                                                                  new KmlcoordinatesTagHandler());
 
+namespace
+{
+// Powers of ten that are exactly representable as double
+const double s_powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * Converts a number to double like QStringView::toDouble(). Plain decimal
+ * numbers with up to 15 significant digits are converted directly: both the
+ * digits and the power of ten are exact doubles then, so a single division
+ * yields the correctly rounded result. Everything else falls back to Qt.
+ */
+double toDouble(QStringView text)
+{
+    const QChar *it = text.cbegin();
+    const QChar *const end = text.cend();
+
+    bool negative = false;
+    if (it != end && (*it == QLatin1Char('-') || *it == QLatin1Char('+'))) {
+        negative = *it == QLatin1Char('-');
+        ++it;
+    }
+
+    quint64 mantissa = 0;
+    int significantDigits = 0;
+    int decimals = 0;
+    bool hasDigits = false;
+    bool fraction = false;
+    for (; it != end; ++it) {
+        const char16_t c = it->unicode();
+        if (c == u'.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        if (c < u'0' || c > u'9') {
+            break;
+        }
+        hasDigits = true;
+        mantissa = mantissa * 10 + (c - u'0');
+        if (mantissa > 0) {
+            ++significantDigits;
+        }
+        if (fraction) {
+            ++decimals;
+        }
+        if (significantDigits > 15 || decimals > 22) {
+            break;
+        }
+    }
+
+    if (it != end || !hasDigits) {
+        // Exponents, too many digits or garbage
+        return text.toDouble();
+    }
+
+    const double value = double(mantissa) / s_powersOfTen[decimals];
+    return negative ? -value : value;
+}
+
+/**
+ * Splits the content of a coordinates element into tuples of comma
+ * separated fields without copying any text. Tuples are separated by
+ * whitespace. Unless kmlStrictSpecs is set, whitespace around commas
+ * is ignored.
+ */
+class CoordinatesTokenizer
+{
+public:
+    explicit CoordinatesTokenizer(QStringView text)
+        : m_text(text.trimmed())
+        , m_position(0)
+        , m_atEnd(false)
+    {
+    }
+
+    /**
+     * Reads the next tuple. At most the first three fields are stored in
+     * @p fields, @p count is set to the number of fields of the tuple.
+     */
+    bool next(QStringView *fields, int &count)
+    {
+        if (m_atEnd) {
+            return false;
+        }
+
+        count = 0;
+        while (true) {
+            const qsizetype start = m_position;
+            while (m_position < m_text.size() && !m_text[m_position].isSpace() && m_text[m_position] != QLatin1Char(',')) {
+                ++m_position;
+            }
+            if (count < 3) {
+                fields[count] = m_text.sliced(start, m_position - start);
+            }
+            ++count;
+
+            const qsizetype fieldEnd = m_position;
+            skipSpaces();
+            if (m_position < m_text.size() && m_text[m_position] == QLatin1Char(',') && (!kmlStrictSpecs || m_position == fieldEnd)) {
+                ++m_position;
+                if (!kmlStrictSpecs) {
+                    skipSpaces();
+                }
+                continue;
+            }
+            break;
+        }
+
+        m_atEnd = m_position >= m_text.size();
+        return true;
+    }
+
+private:
+    void skipSpaces()
+    {
+        while (m_position < m_text.size() && m_text[m_position].isSpace()) {
+            ++m_position;
+        }
+    }
+
+    const QStringView m_text;
+    qsizetype m_position;
+    bool m_atEnd;
+};
+}
+
 GeoNode *KmlcoordinatesTagHandler::parse(GeoParser &parser) const
 {
     Q_ASSERT(parser.isStartElement()
@@ -45,63 +167,48 @@ GeoNode *KmlcoordinatesTagHandler::parse(GeoParser &parser) const
 
     if (parentItem.represents(kmlTag_Point) || parentItem.represents(kmlTag_LineString) || parentItem.represents(kmlTag_MultiGeometry)
         || parentItem.represents(kmlTag_LinearRing) || parentItem.represents(kmlTag_LatLonQuad)) {
-        QStringList coordinatesLines; // = parser.readElementText().trimmed().split( QRegExp("\\s"), Qt::SkipEmptyParts );
-        // Splitting using the "\\s" regexp is slow, split manually instead.
-        QString text = parser.readElementText().trimmed();
-
-        if (!kmlStrictSpecs) {
-            // Removing spaces before and after commas
-            for (int i = 1; i < text.size() - 1; ++i) {
-                if (text[i] == QLatin1Char(',')) {
-                    // Before
-                    int l = i - 1;
-                    while (l > 0 && text[l].isSpace()) {
-                        --l;
-                    }
+        const QString text = parser.readElementText();
 
-                    // After
-                    int r = i + 1;
-                    while (r < text.size() && text[r].isSpace()) {
-                        ++r;
-                    }
-
-                    text.remove(l + 1, r - l - 1).insert(l + 1, QLatin1Char(','));
+        if (parentItem.represents(kmlTag_LineString) || parentItem.represents(kmlTag_LinearRing)) {
+            // Line strings of large documents have thousands of points, avoid growing their storage step by step.
+            // Tuples are separated by whitespace that does not touch a comma, count these gaps in a single pass.
+            int separators = 0;
+            bool inSpace = false;
+            QChar previous = QLatin1Char(',');
+            for (const QChar c : text) {
+                if (c.isSpace()) {
+                    inSpace = true;
+                    continue;
                 }
-            }
-        }
-
-        int index = 0;
-        bool inside = true;
-        int const size = text.size();
-        for (int i = 0; i < size; ++i) {
-            if (text[i].isSpace()) {
-                if (inside) {
-                    coordinatesLines.append(text.mid(index, i - index));
-                    inside = false;
+                if (inSpace && previous != QLatin1Char(',') && c != QLatin1Char(',')) {
+                    ++separators;
                 }
-                index = i + 1;
-            } else {
-                inside = true;
+                inSpace = false;
+                previous = c;
             }
+            auto lineString = parentItem.nodeAs<GeoDataLineString>();
+            lineString->reserve(lineString->size() + separators + 1);
         }
-        coordinatesLines.append(text.mid(index));
+
+        CoordinatesTokenizer tokenizer(text);
+        QStringView coordinates[3];
+        int coordinatesSize = 0;
         int coordinatesIndex = 0;
-        for (const QString &line : coordinatesLines) {
-            const QStringList coordinates = line.trimmed().split(QLatin1Char(','));
+        while (tokenizer.next(coordinates, coordinatesSize)) {
             if (parentItem.represents(kmlTag_Point) && parentItem.is<GeoDataFeature>()) {
                 GeoDataCoordinates coord;
-                if (coordinates.size() == 2) {
-                    coord.set(coordinates.at(0).toDouble(), coordinates.at(1).toDouble(), 0.0, GeoDataCoordinates::Degree);
-                } else if (coordinates.size() == 3) {
-                    coord.set(coordinates.at(0).toDouble(), coordinates.at(1).toDouble(), coordinates.at(2).toDouble(), GeoDataCoordinates::Degree);
+                if (coordinatesSize == 2) {
+                    coord.set(toDouble(coordinates[0]), toDouble(coordinates[1]), 0.0, GeoDataCoordinates::Degree);
+                } else if (coordinatesSize == 3) {
+                    coord.set(toDouble(coordinates[0]), toDouble(coordinates[1]), toDouble(coordinates[2]), GeoDataCoordinates::Degree);
                 }
                 parentItem.nodeAs<GeoDataPlacemark>()->setCoordinate(coord);
             } else {
                 GeoDataCoordinates coord;
-                if (coordinates.size() == 2) {
-                    coord.set(DEG2RAD * coordinates.at(0).toDouble(), DEG2RAD * coordinates.at(1).toDouble());
-                } else if (coordinates.size() == 3) {
-                    coord.set(DEG2RAD * coordinates.at(0).toDouble(), DEG2RAD * coordinates.at(1).toDouble(), coordinates.at(2).toDouble());
+                if (coordinatesSize == 2) {
+                    coord.set(DEG2RAD * toDouble(coordinates[0]), DEG2RAD * toDouble(coordinates[1]));
+                } else if (coordinatesSize == 3) {
+                    coord.set(DEG2RAD * toDouble(coordinates[0]), DEG2RAD * toDouble(coordinates[1]), toDouble(coordinates[2]));
                 }
 
                 if (parentItem.represents(kmlTag_LineString)) {
@@ -147,17 +254,38 @@ GeoNode *KmlcoordinatesTagHandler::parse(GeoParser &parser) const
     }
 
     if (parentItem.represents(kmlTag_Track)) {
-        QString input = parser.readElementText().trimmed();
-        if (!kmlStrictSpecs) {
-            input.replace(QRegularExpression(QStringLiteral("\\s*,\\s*")), QStringLiteral(","));
+        const QString input = parser.readElementText();
+        const QStringView trimmed = QStringView(input).trimmed();
+
+        // Fields are separated by whitespace, commas are tolerated unless kmlStrictSpecs is set
+        QStringView coordinates[3];
+        int coordinatesSize = 0;
+        qsizetype position = 0;
+        while (position < trimmed.size()) {
+            const qsizetype start = position;
+            while (position < trimmed.size() && !trimmed[position].isSpace() && (kmlStrictSpecs || trimmed[position] != QLatin1Char(','))) {
+                ++position;
+            }
+            if (coordinatesSize < 3) {
+                coordinates[coordinatesSize] = trimmed.sliced(start, position - start);
+            }
+            ++coordinatesSize;
+            while (position < trimmed.size() && trimmed[position].isSpace()) {
+                ++position;
+            }
+            if (!kmlStrictSpecs && position < trimmed.size() && trimmed[position] == QLatin1Char(',')) {
+                ++position;
+                while (position < trimmed.size() && trimmed[position].isSpace()) {
+                    ++position;
+                }
+            }
         }
-        const QStringList coordinates = input.split(QLatin1Char(' '));
 
         GeoDataCoordinates coord;
-        if (coordinates.size() == 2) {
-            coord.set(DEG2RAD * coordinates.at(0).toDouble(), DEG2RAD * coordinates.at(1).toDouble());
-        } else if (coordinates.size() == 3) {
-            coord.set(DEG2RAD * coordinates.at(0).toDouble(), DEG2RAD * coordinates.at(1).toDouble(), coordinates.at(2).toDouble());
+        if (coordinatesSize == 2) {
+            coord.set(DEG2RAD * toDouble(coordinates[0]), DEG2RAD * toDouble(coordinates[1]));
+        } else if (coordinatesSize == 3) {
+            coord.set(DEG2RAD * toDouble(coordinates[0]), DEG2RAD * toDouble(coordinates[1]), toDouble(coordinates[2]));
         }
         parentItem.nodeAs<GeoDataTrack>()->appendCoordinates(coord);
     }
@@ -126,14 +126,19 @@ void GeoParser::parseDocument()
     }
 
     bool processChildren = true;
-    QualifiedName qName(name().toString(), namespaceUri().toString());
+    // Known elements reuse the strings of the handler registry, only unknown ones need copies
+    QualifiedName qName;
+    const GeoTagHandler *handler = GeoTagHandler::recognizes(name(), namespaceUri(), qName);
+    if (!handler) {
+        qName = QualifiedName(name().toString(), namespaceUri().toString());
+    }
 
     if (tokenType() == QXmlStreamReader::Invalid)
         raiseWarning(QStringLiteral("%1: %2").arg(error()).arg(errorString()));
 
     GeoStackItem stackItem(qName, nullptr);
 
-    if (const GeoTagHandler *handler = GeoTagHandler::recognizes(qName)) {
+    if (handler) {
         stackItem.assignNode(handler->parse(*this));
         processChildren = !isEndElement();
     }
@@ -17,6 +17,7 @@ namespace Marble
 #define DUMP_TAG_HANDLER_REGISTRATION 0
 
 GeoTagHandler::TagHash *GeoTagHandler::s_tagHandlerHash = nullptr;
+GeoTagHandler::TagIndex *GeoTagHandler::s_tagIndex = nullptr;
 
 GeoTagHandler::GeoTagHandler() = default;
 
@@ -31,6 +32,20 @@ GeoTagHandler::TagHash *GeoTagHandler::tagHandlerHash()
     return s_tagHandlerHash;
 }
 
+GeoTagHandler::TagIndex *GeoTagHandler::tagIndex()
+{
+    if (!s_tagIndex)
+        s_tagIndex = new TagIndex();
+
+    Q_ASSERT(s_tagIndex);
+    return s_tagIndex;
+}
+
+size_t GeoTagHandler::tagKey(QStringView name, QStringView nameSpace)
+{
+    return qHashMulti(0, name, nameSpace);
+}
+
 void GeoTagHandler::registerHandler(const GeoParser::QualifiedName &qName, const GeoTagHandler *handler)
 {
     TagHash *hash = tagHandlerHash();
@@ -39,6 +54,19 @@ void GeoTagHandler::registerHandler(const GeoParser::QualifiedName &qName, const
     hash->insert(qName, handler);
     Q_ASSERT(hash->contains(qName));
 
+    // Keep a single index entry per tag, even if a release build registers a tag twice
+    TagIndex *index = tagIndex();
+    const size_t key = tagKey(qName.first, qName.second);
+    auto it = index->find(key);
+    while (it != index->end() && it.key() == key && it->qualifiedName != qName) {
+        ++it;
+    }
+    if (it != index->end() && it.key() == key) {
+        it->handler = handler;
+    } else {
+        index->insert(key, TagIndexEntry{qName, handler});
+    }
+
 #if DUMP_TAG_HANDLER_REGISTRATION > 0
     mDebug() << "[GeoTagHandler] -> Recognizing" << qName.first << "tag with namespace" << qName.second;
 #endif
@@ -49,6 +77,17 @@ void GeoTagHandler::unregisterHandler(const GeoParser::QualifiedName &qName)
     TagHash *hash = tagHandlerHash();
 
     Q_ASSERT(hash->contains(qName));
+
+    TagIndex *index = tagIndex();
+    const size_t key = tagKey(qName.first, qName.second);
+    for (auto it = index->find(key); it != index->end() && it.key() == key;) {
+        if (it->qualifiedName == qName) {
+            it = index->erase(it);
+        } else {
+            ++it;
+        }
+    }
+
     delete hash->value(qName);
     hash->remove(qName);
     Q_ASSERT(!hash->contains(qName));
@@ -64,4 +103,19 @@ const GeoTagHandler *GeoTagHandler::recognizes(const GeoParser::QualifiedName &q
     return (*hash)[qName];
 }
 
+const GeoTagHandler *GeoTagHandler::recognizes(QStringView name, QStringView nameSpace, GeoParser::QualifiedName &qualifiedName)
+{
+    const TagIndex *index = tagIndex();
+    const size_t key = tagKey(name, nameSpace);
+
+    for (auto it = index->constFind(key); it != index->constEnd() && it.key() == key; ++it) {
+        if (it->qualifiedName.first == name && it->qualifiedName.second == nameSpace) {
+            qualifiedName = it->qualifiedName;
+            return it->handler;
+        }
+    }
+
+    return nullptr;
+}
+
 }
@@ -10,6 +10,7 @@
 #include "GeoParser.h"
 #include "marble_export.h"
 #include <QHash>
+#include <QMultiHash>
 
 namespace Marble
 {
@@ -47,11 +48,30 @@ private: // Only our parser is allowed to access tag handlers.
     friend class GeoParser;
     static const GeoTagHandler *recognizes(const GeoParser::QualifiedName &);
 
+    /**
+     * Looks up the handler of an element without allocating strings. On
+     * success, @p qualifiedName is set to the registered name, which shares
+     * its string data with the registry.
+     */
+    static const GeoTagHandler *recognizes(QStringView name, QStringView nameSpace, GeoParser::QualifiedName &qualifiedName);
+
 private:
     using TagHash = QHash<GeoParser::QualifiedName, const GeoTagHandler *>;
 
+    struct TagIndexEntry {
+        GeoParser::QualifiedName qualifiedName;
+        const GeoTagHandler *handler;
+    };
+    // Registered names by their hash, for lookups of QStringView pairs
+    using TagIndex = QMultiHash<size_t, TagIndexEntry>;
+
+    static size_t tagKey(QStringView name, QStringView nameSpace);
+
     static TagHash *tagHandlerHash();
     static TagHash *s_tagHandlerHash;
+
+    static TagIndex *tagIndex();
+    static TagIndex *s_tagIndex;
 };
 
 // Helper structure
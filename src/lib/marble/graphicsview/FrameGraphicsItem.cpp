@@ -11,15 +11,37 @@
 #include "MarbleDebug.h"
 
 // Qt
+#include <QCoreApplication>
+#include <QImage>
 #include <QMargins>
 #include <QPainter>
 #include <QPainterPath>
 #include <QPixmapCache>
 #include <QSizeF>
+#include <QThread>
 #include <qdrawutil.h>
 
 using namespace Marble;
 
+// Like qDrawBorderPixmap(), which only works on the GUI thread
+static void drawBorderImage(QPainter *painter, const QRect &targetRect, const QMargins &margins, const QImage &image)
+{
+    const int sourceX[4] = {0, margins.left(), image.width() - margins.right(), image.width()};
+    const int sourceY[4] = {0, margins.top(), image.height() - margins.bottom(), image.height()};
+    const int targetX[4] = {targetRect.left(), targetRect.left() + margins.left(), targetRect.right() + 1 - margins.right(), targetRect.right() + 1};
+    const int targetY[4] = {targetRect.top(), targetRect.top() + margins.top(), targetRect.bottom() + 1 - margins.bottom(), targetRect.bottom() + 1};
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            const QRect source(sourceX[column], sourceY[row], sourceX[column + 1] - sourceX[column], sourceY[row + 1] - sourceY[row]);
+            const QRect target(targetX[column], targetY[row], targetX[column + 1] - targetX[column], targetY[row + 1] - targetY[row]);
+            if (source.isValid() && target.isValid()) {
+                painter->drawImage(target, image, source);
+            }
+        }
+    }
+}
+
 FrameGraphicsItem::FrameGraphicsItem(MarbleGraphicsItem *parent)
     : ScreenGraphicsItem(new FrameGraphicsItemPrivate(this, parent))
 {
@@ -257,12 +279,20 @@ void FrameGraphicsItem::paint(QPainter *painter)
 
     // Needs to be done here cause we don't want the margin translation
     if (frame() == ShadowFrame) {
-        QPixmap shadow;
-        if (!QPixmapCache::find(QStringLiteral("marble/frames/shadowframe.png"), &shadow)) {
-            shadow = QPixmap(QStringLiteral(":/marble/frames/shadowframe.png"));
-            QPixmapCache::insert(QStringLiteral("marble/frames/shadowframe.png"), shadow);
+        const QRect shadowRect(QPoint(0, 0), size().toSize());
+        const QMargins shadowMargins(10, 10, 10, 10);
+        if (QThread::currentThread() == QCoreApplication::instance()->thread()) {
+            QPixmap shadow;
+            if (!QPixmapCache::find(QStringLiteral("marble/frames/shadowframe.png"), &shadow)) {
+                shadow = QPixmap(QStringLiteral(":/marble/frames/shadowframe.png"));
+                QPixmapCache::insert(QStringLiteral("marble/frames/shadowframe.png"), shadow);
+            }
+            qDrawBorderPixmap(painter, shadowRect, shadowMargins, shadow);
+        } else {
+            // Pixmaps and QPixmapCache only work on the GUI thread
+            static const QImage shadow(QStringLiteral(":/marble/frames/shadowframe.png"));
+            drawBorderImage(painter, shadowRect, shadowMargins, shadow);
         }
-        qDrawBorderPixmap(painter, QRect(QPoint(0, 0), size().toSize()), QMargins(10, 10, 10, 10), shadow);
     }
 
     painter->translate(paintedRect().topLeft());
@@ -12,10 +12,12 @@
 #include "ViewportParams.h"
 
 // Qt
+#include <QCoreApplication>
 #include <QList>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPixmap>
+#include <QThread>
 
 using namespace Marble;
 
@@ -51,7 +53,8 @@ bool MarbleGraphicsItem::paintEvent(QPainter *painter, const ViewportParams *vie
 
     // At the moment, as GraphicsItems can't be zoomed or rotated ItemCoordinateCache
     // and DeviceCoordianteCache is exactly the same
-    if (ItemCoordinateCache == cacheMode() || DeviceCoordinateCache == cacheMode()) {
+    const bool guiThread = QThread::currentThread() == QCoreApplication::instance()->thread();
+    if ((ItemCoordinateCache == cacheMode() || DeviceCoordinateCache == cacheMode()) && guiThread) {
         const qreal scale = painter->device()->devicePixelRatio();
 
         const QSize neededPixmapSize = scale * size().toSize() + QSize(1, 1); // adding a pixel for rounding errors
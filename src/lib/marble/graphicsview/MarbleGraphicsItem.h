@@ -38,7 +38,8 @@ public:
 
     /**
      * Paints the item on the screen in view coordinates.
-     * It is not safe to call this function from a thread other than the gui thread.
+     * Outside of the gui thread, the item is painted without using the cache,
+     * as pixmaps only work on the gui thread.
      */
     bool paintEvent(QPainter *painter, const ViewportParams *viewport);
 
@@ -12,6 +12,17 @@
 namespace Marble
 {
 
+namespace
+{
+
+QRect floatItemRect(const AbstractFloatItem *floatItem)
+{
+    // Leave room for antialiased frames
+    return QRectF(floatItem->positivePosition() - QPointF(1, 1), floatItem->size() + QSizeF(2, 2)).toAlignedRect();
+}
+
+}
+
 FloatItemsLayer::FloatItemsLayer(QObject *parent)
     : QObject(parent)
     , m_floatItems()
@@ -40,6 +51,17 @@ bool FloatItemsLayer::render(GeoPainter *painter, ViewportParams *viewport, cons
 
         if (item->visible()) {
             item->paintEvent(painter, viewport);
+
+            // Painting lays the item out, it may have moved or grown beyond the region being repainted
+            const QRect rect = floatItemRect(item);
+            const QRect previousRect = m_paintedRects.value(item, rect);
+            m_paintedRects.insert(item, rect);
+            if (painter->hasClipping()) {
+                const QRegion missed = (QRegion(rect) | previousRect) - painter->clipRegion();
+                if (!missed.isEmpty()) {
+                    Q_EMIT repaintNeeded(missed);
+                }
+            }
         }
     }
 
@@ -51,9 +73,24 @@ void FloatItemsLayer::addFloatItem(AbstractFloatItem *floatItem)
     Q_ASSERT(floatItem && "must not add a null float item to FloatItemsLayer");
 
     connect(floatItem, SIGNAL(settingsChanged(QString)), this, SIGNAL(pluginSettingsChanged()));
-    connect(floatItem, SIGNAL(repaintNeeded(QRegion)), this, SIGNAL(repaintNeeded(QRegion)));
+    connect(floatItem, &AbstractFloatItem::repaintNeeded, this, [this, floatItem](const QRegion &dirtyRegion) {
+        if (!dirtyRegion.isEmpty()) {
+            Q_EMIT repaintNeeded(dirtyRegion);
+            return;
+        }
+        // A float item only changes within its own rect, also where it was painted before
+        Q_EMIT repaintNeeded(QRegion(floatItemRect(floatItem)) | m_paintedRects.value(floatItem));
+    });
     connect(floatItem, SIGNAL(visibilityChanged(bool, QString)), this, SLOT(updateVisibility(bool, QString)));
 
+    // Showing, hiding or reconfiguring a float item may change its size, the whole render position is repainted
+    const auto itemChanged = [this]() {
+        Q_EMIT repaintNeeded();
+    };
+    connect(floatItem, &AbstractFloatItem::visibilityChanged, this, itemChanged);
+    connect(floatItem, &AbstractFloatItem::enabledChanged, this, itemChanged);
+    connect(floatItem, &AbstractFloatItem::settingsChanged, this, itemChanged);
+
     m_floatItems.append(floatItem);
 }
 
@@ -9,7 +9,9 @@
 #include "LayerInterface.h"
 #include <QObject>
 
+#include <QHash>
 #include <QList>
+#include <QRect>
 #include <QRegion>
 
 namespace Marble
@@ -64,6 +66,8 @@ private Q_SLOTS:
 
 private:
     QList<AbstractFloatItem *> m_floatItems;
+    // Where the float items were painted last
+    QHash<const AbstractFloatItem *, QRect> m_paintedRects;
 };
 
 }
@@ -21,6 +21,7 @@
 #include "GeoDataMultiTrack.h"
 #include "GeoDataObject.h"
 #include "GeoDataPhotoOverlay.h"
+#include "GeoDataPoint.h"
 #include "GeoDataPlacemark.h"
 #include "GeoDataPolyStyle.h"
 #include "GeoDataPolygon.h"
@@ -39,6 +40,7 @@
 #include "MarbleDebug.h"
 #include "MarbleGraphicsItem.h"
 #include "MarblePlacemarkModel.h"
+#include "PlacemarkRegistry.h"
 #include "RenderState.h"
 #include "ScreenOverlayGraphicsItem.h"
 #include "StyleBuilder.h"
@@ -48,7 +50,6 @@
 
 // Qt
 #include <QAbstractItemModel>
-#include <QModelIndex>
 #include <qmath.h>
 
 namespace Marble
@@ -70,10 +71,11 @@ public:
         QList<GeoGraphicsItem *> positive; // buildings
     };
 
-    explicit GeometryLayerPrivate(const QAbstractItemModel *model, const StyleBuilder *styleBuilder);
+    explicit GeometryLayerPrivate(const QAbstractItemModel *model, const PlacemarkRegistry *placemarkRegistry, const StyleBuilder *styleBuilder);
 
-    void createGraphicsItems(const GeoDataObject *object);
-    void createGraphicsItems(const GeoDataObject *object, FeatureRelationHash &relations);
+    void createGraphicsItems();
+    void createGraphicsItems(const GeoDataPlacemark *placemark);
+    void addRelations(const QList<GeoDataRelation *> &relations);
     void createGraphicsItemFromGeometry(const GeoDataGeometry *object, const GeoDataPlacemark *placemark, const Relations &relations);
     void createGraphicsItemFromOverlay(const GeoDataOverlay *overlay);
     void removeGraphicsItems(const GeoDataFeature *feature);
@@ -84,10 +86,12 @@ public:
     void updateRelationVisibility();
 
     const QAbstractItemModel *const m_model;
+    const PlacemarkRegistry *const m_placemarkRegistry;
     const StyleBuilder *const m_styleBuilder;
     GeoGraphicsScene m_scene;
     QString m_runtimeTrace;
     QList<ScreenOverlayGraphicsItem *> m_screenOverlays;
+    FeatureRelationHash m_relations;
 
     QHash<qint64, OsmLineStringItems> m_osmLineStringItems;
     int m_tileLevel;
@@ -106,8 +110,9 @@ public:
     int m_debugLevelTag;
 };
 
-GeometryLayerPrivate::GeometryLayerPrivate(const QAbstractItemModel *model, const StyleBuilder *styleBuilder)
+GeometryLayerPrivate::GeometryLayerPrivate(const QAbstractItemModel *model, const PlacemarkRegistry *placemarkRegistry, const StyleBuilder *styleBuilder)
     : m_model(model)
+    , m_placemarkRegistry(placemarkRegistry)
     , m_styleBuilder(styleBuilder)
     , m_tileLevel(0)
     , m_lastFeatureAt(nullptr)
@@ -119,24 +124,19 @@ GeometryLayerPrivate::GeometryLayerPrivate(const QAbstractItemModel *model, cons
 {
 }
 
-void GeometryLayerPrivate::createGraphicsItems(const GeoDataObject *object)
+GeometryLayer::GeometryLayer(const QAbstractItemModel *model, const PlacemarkRegistry *placemarkRegistry, const StyleBuilder *styleBuilder)
+    : d(std::make_unique<GeometryLayerPrivate>(model, placemarkRegistry, styleBuilder))
 {
-    FeatureRelationHash noRelations;
-    createGraphicsItems(object, noRelations);
-}
-
-GeometryLayer::GeometryLayer(const QAbstractItemModel *model, const StyleBuilder *styleBuilder)
-    : d(std::make_unique<GeometryLayerPrivate>(model, styleBuilder))
-{
-    const GeoDataObject *object = static_cast<GeoDataObject *>(d->m_model->index(0, 0, QModelIndex()).internalPointer());
-    if (object && object->parent()) {
-        d->createGraphicsItems(object->parent());
-    }
+    d->createGraphicsItems();
 
     connect(model, &QAbstractItemModel::dataChanged, this, &GeometryLayer::resetCacheData);
-    connect(model, &QAbstractItemModel::rowsInserted, this, &GeometryLayer::addPlacemarks);
-    connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &GeometryLayer::removePlacemarks);
-    connect(model, &QAbstractItemModel::modelReset, this, &GeometryLayer::resetCacheData);
+    connect(placemarkRegistry, &PlacemarkRegistry::relationsAdded, this, &GeometryLayer::addRelations);
+    connect(placemarkRegistry, &PlacemarkRegistry::relationsRemoved, this, &GeometryLayer::removeRelations);
+    connect(placemarkRegistry, &PlacemarkRegistry::placemarksAdded, this, &GeometryLayer::addPlacemarks);
+    connect(placemarkRegistry, &PlacemarkRegistry::placemarksRemoved, this, &GeometryLayer::removePlacemarks);
+    connect(placemarkRegistry, &PlacemarkRegistry::overlaysAdded, this, &GeometryLayer::addOverlays);
+    connect(placemarkRegistry, &PlacemarkRegistry::overlaysRemoved, this, &GeometryLayer::removeOverlays);
+    connect(placemarkRegistry, &PlacemarkRegistry::reset, this, &GeometryLayer::resetCacheData);
     connect(this, &GeometryLayer::highlightedPlacemarksChanged, &d->m_scene, &GeoGraphicsScene::applyHighlight);
     connect(&d->m_scene, &GeoGraphicsScene::repaintNeeded, this, &GeometryLayer::repaintNeeded);
 }
@@ -296,32 +296,45 @@ bool GeometryLayer::hasFeatureAt(const QPoint &curpos, const ViewportParams *vie
     return false;
 }
 
-void GeometryLayerPrivate::createGraphicsItems(const GeoDataObject *object, FeatureRelationHash &relations)
+void GeometryLayerPrivate::createGraphicsItems()
 {
     clearCache();
-    if (auto document = geodata_cast<GeoDataDocument>(object)) {
-        const auto features = document->featureList();
-        for (auto feature : features) {
-            if (auto relation = geodata_cast<GeoDataRelation>(feature)) {
-                relation->setVisible(showRelation(relation));
-                const auto members = relation->members();
-                for (const auto &member : members) {
-                    relations[member] << relation;
-                }
-            }
+    m_relations.clear();
+    addRelations(m_placemarkRegistry->relations());
+
+    // Placemarks with other geometries, like points, are left to the placemark layer
+    const EnumGeometryId geometryIds[] = {GeoDataLineStringId,
+                                          GeoDataLinearRingId,
+                                          GeoDataPolygonId,
+                                          GeoDataBuildingId,
+                                          GeoDataMultiGeometryId,
+                                          GeoDataMultiTrackId,
+                                          GeoDataTrackId};
+    for (EnumGeometryId geometryId : geometryIds) {
+        const auto placemarks = m_placemarkRegistry->placemarks(geometryId);
+        for (const GeoDataPlacemark *placemark : placemarks) {
+            createGraphicsItems(placemark);
         }
     }
-    if (auto placemark = geodata_cast<GeoDataPlacemark>(object)) {
-        createGraphicsItemFromGeometry(placemark->geometry(), placemark, relations.value(placemark));
-    } else if (const auto overlay = dynamic_cast<const GeoDataOverlay *>(object)) {
+
+    const auto overlays = m_placemarkRegistry->overlays();
+    for (const GeoDataOverlay *overlay : overlays) {
         createGraphicsItemFromOverlay(overlay);
     }
+}
 
-    // parse all child objects of the container
-    if (const auto container = dynamic_cast<const GeoDataContainer *>(object)) {
-        int rowCount = container->size();
-        for (int row = 0; row < rowCount; ++row) {
-            createGraphicsItems(container->child(row), relations);
+void GeometryLayerPrivate::createGraphicsItems(const GeoDataPlacemark *placemark)
+{
+    createGraphicsItemFromGeometry(placemark->geometry(), placemark, m_relations.value(placemark));
+}
+
+void GeometryLayerPrivate::addRelations(const QList<GeoDataRelation *> &relations)
+{
+    for (GeoDataRelation *relation : relations) {
+        relation->setVisible(showRelation(relation));
+        const auto members = relation->members();
+        for (const auto &member : members) {
+            m_relations[member] << relation;
         }
     }
 }
@@ -381,17 +394,9 @@ inline bool GeometryLayerPrivate::showRelation(const GeoDataRelation *relation)
 
 void GeometryLayerPrivate::updateRelationVisibility()
 {
-    for (int i = 0; i < m_model->rowCount(); ++i) {
-        QVariant const data = m_model->data(m_model->index(i, 0), MarblePlacemarkModel::ObjectPointerRole);
-        auto object = qvariant_cast<GeoDataObject *>(data);
-        if (auto doc = geodata_cast<GeoDataDocument>(object)) {
-            const auto features = doc->featureList();
-            for (auto feature : features) {
-                if (auto relation = geodata_cast<GeoDataRelation>(feature)) {
-                    relation->setVisible(showRelation(relation));
-                }
-            }
-        }
+    const auto relations = m_placemarkRegistry->relations();
+    for (GeoDataRelation *relation : relations) {
+        relation->setVisible(showRelation(relation));
     }
     m_scene.resetStyle();
 }
@@ -481,50 +486,73 @@ void GeometryLayerPrivate::removeGraphicsItems(const GeoDataFeature *feature)
             updateTiledLineStrings(items);
         }
         m_scene.removeItem(feature);
-    } else if (const auto container = dynamic_cast<const GeoDataContainer *>(feature)) {
-        const auto features = container->featureList();
-        for (const GeoDataFeature *child : features) {
-            removeGraphicsItems(child);
-        }
+    } else if (geodata_cast<GeoDataPhotoOverlay>(feature)) {
+        m_scene.removeItem(feature);
     } else if (geodata_cast<GeoDataScreenOverlay>(feature)) {
-        for (ScreenOverlayGraphicsItem *item : std::as_const(m_screenOverlays)) {
+        m_screenOverlays.removeIf([feature](ScreenOverlayGraphicsItem *item) {
             if (item->screenOverlay() == feature) {
-                m_screenOverlays.removeAll(item);
+                delete item;
+                return true;
             }
+            return false;
+        });
+    }
+}
+
+void GeometryLayer::addPlacemarks(const QList<const GeoDataPlacemark *> &placemarks)
+{
+    d->clearCache();
+    for (const GeoDataPlacemark *placemark : placemarks) {
+        if (!geodata_cast<GeoDataPoint>(placemark->geometry())) {
+            d->createGraphicsItems(placemark);
         }
     }
+    Q_EMIT repaintNeeded();
 }
 
-void GeometryLayer::addPlacemarks(const QModelIndex &parent, int first, int last)
+void GeometryLayer::removePlacemarks(const QList<const GeoDataPlacemark *> &placemarks)
 {
-    Q_ASSERT(first < d->m_model->rowCount(parent));
-    Q_ASSERT(last < d->m_model->rowCount(parent));
-    for (int i = first; i <= last; ++i) {
-        QModelIndex index = d->m_model->index(i, 0, parent);
-        Q_ASSERT(index.isValid());
-        const GeoDataObject *object = qvariant_cast<GeoDataObject *>(index.data(MarblePlacemarkModel::ObjectPointerRole));
-        Q_ASSERT(object);
-        d->createGraphicsItems(object);
+    for (const GeoDataPlacemark *placemark : placemarks) {
+        d->removeGraphicsItems(placemark);
     }
     Q_EMIT repaintNeeded();
 }
 
-void GeometryLayer::removePlacemarks(const QModelIndex &parent, int first, int last)
+void GeometryLayer::addOverlays(const QList<const GeoDataOverlay *> &overlays)
 {
-    Q_ASSERT(last < d->m_model->rowCount(parent));
-    bool isRepaintNeeded = false;
-    for (int i = first; i <= last; ++i) {
-        QModelIndex index = d->m_model->index(i, 0, parent);
-        Q_ASSERT(index.isValid());
-        const GeoDataObject *object = qvariant_cast<GeoDataObject *>(index.data(MarblePlacemarkModel::ObjectPointerRole));
-        const auto feature = dynamic_cast<const GeoDataFeature *>(object);
-        if (feature != nullptr) {
-            d->removeGraphicsItems(feature);
-            isRepaintNeeded = true;
-        }
+    d->clearCache();
+    for (const GeoDataOverlay *overlay : overlays) {
+        d->createGraphicsItemFromOverlay(overlay);
     }
-    if (isRepaintNeeded) {
-        Q_EMIT repaintNeeded();
+    Q_EMIT repaintNeeded();
+}
+
+void GeometryLayer::removeOverlays(const QList<const GeoDataOverlay *> &overlays)
+{
+    for (const GeoDataOverlay *overlay : overlays) {
+        d->removeGraphicsItems(overlay);
+    }
+    Q_EMIT repaintNeeded();
+}
+
+void GeometryLayer::addRelations(const QList<GeoDataRelation *> &relations)
+{
+    d->addRelations(relations);
+}
+
+void GeometryLayer::removeRelations(const QList<GeoDataRelation *> &relations)
+{
+    for (const GeoDataRelation *relation : relations) {
+        const auto members = relation->members();
+        for (const auto &member : members) {
+            const auto iterator = d->m_relations.find(member);
+            if (iterator != d->m_relations.end()) {
+                iterator->remove(relation);
+                if (iterator->isEmpty()) {
+                    d->m_relations.erase(iterator);
+                }
+            }
+        }
     }
 }
 
@@ -535,11 +563,7 @@ void GeometryLayer::resetCacheData()
     qDeleteAll(d->m_screenOverlays);
     d->m_screenOverlays.clear();
     d->m_osmLineStringItems.clear();
-
-    const GeoDataObject *object = static_cast<GeoDataObject *>(d->m_model->index(0, 0, QModelIndex()).internalPointer());
-    if (object && object->parent()) {
-        d->createGraphicsItems(object->parent());
-    }
+    d->createGraphicsItems();
     Q_EMIT repaintNeeded();
 }
 
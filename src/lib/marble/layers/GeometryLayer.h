@@ -14,15 +14,16 @@
 #include <QObject>
 
 class QAbstractItemModel;
-class QModelIndex;
 class QPoint;
 
 namespace Marble
 {
 class GeoPainter;
 class GeoDataFeature;
+class GeoDataOverlay;
 class GeoDataPlacemark;
 class GeoDataRelation;
+class PlacemarkRegistry;
 class StyleBuilder;
 class ViewportParams;
 
@@ -32,7 +33,7 @@ class GeometryLayer : public QObject, public LayerInterface
 {
     Q_OBJECT
 public:
-    explicit GeometryLayer(const QAbstractItemModel *model, const StyleBuilder *styleBuilder);
+    GeometryLayer(const QAbstractItemModel *model, const PlacemarkRegistry *placemarkRegistry, const StyleBuilder *styleBuilder);
     ~GeometryLayer() override;
 
     QStringList renderPosition() const override;
@@ -60,8 +61,12 @@ public:
     int debugLevelTag() const;
 
 public Q_SLOTS:
-    void addPlacemarks(const QModelIndex &index, int first, int last);
-    void removePlacemarks(const QModelIndex &index, int first, int last);
+    void addPlacemarks(const QList<const GeoDataPlacemark *> &placemarks);
+    void removePlacemarks(const QList<const GeoDataPlacemark *> &placemarks);
+    void addOverlays(const QList<const GeoDataOverlay *> &overlays);
+    void removeOverlays(const QList<const GeoDataOverlay *> &overlays);
+    void addRelations(const QList<GeoDataRelation *> &relations);
+    void removeRelations(const QList<GeoDataRelation *> &relations);
     void resetCacheData();
     void setTileLevel(int tileLevel);
 
@@ -7,7 +7,9 @@
 
 #include "PlacemarkLayer.h"
 
+#include <QCoreApplication>
 #include <QPoint>
+#include <QThread>
 
 #include "AbstractProjection.h"
 #include "GeoDataLatLonAltBox.h"
@@ -23,13 +25,13 @@
 
 using namespace Marble;
 
-PlacemarkLayer::PlacemarkLayer(QAbstractItemModel *placemarkModel,
+PlacemarkLayer::PlacemarkLayer(const PlacemarkRegistry *placemarkRegistry,
                                QItemSelectionModel *selectionModel,
                                MarbleClock *clock,
                                const StyleBuilder *styleBuilder,
                                QObject *parent)
     : QObject(parent)
-    , m_layout(placemarkModel, selectionModel, clock, styleBuilder)
+    , m_layout(placemarkRegistry, selectionModel, clock, styleBuilder)
     , m_debugModeEnabled(false)
     , m_levelTagDebugModeEnabled(false)
     , m_tileLevel(0)
@@ -62,12 +64,17 @@ bool PlacemarkLayer::render(GeoPainter *geoPainter, ViewportParams *viewport, co
 
     QPainter *const painter = geoPainter;
 
+    // Pixmaps only work on the GUI thread, other threads (e.g. of BatchRenderer) draw images
+    const bool guiThread = QThread::currentThread() == QCoreApplication::instance()->thread();
+
     bool const repeatableX = viewport->currentProjection()->repeatableX();
     int const radius4 = 4 * viewport->radius();
 
 #ifdef BATCH_RENDERING
     QHash<QString, Fragment> hash;
 #endif
+    QList<LabelAtlas::Key> labelKeys;
+    QList<QRect> labelTargets;
 
     while (visit != itEnd) {
         --visit;
@@ -99,15 +106,19 @@ bool PlacemarkLayer::render(GeoPainter *geoPainter, ViewportParams *viewport, co
                 labelRect.moveLeft(i - symbolX + textX);
                 symbolPos.setX(i);
 
-                if (!mark->symbolPixmap().isNull()) {
+                if (!mark->symbolImage().isNull()) {
 #ifdef BATCH_RENDERING
-                    QRect symbolRect = mark->symbolPixmap().rect();
+                    QRect symbolRect = mark->symbolImage().rect();
                     QPainter::PixmapFragment pixmapFragment = QPainter::PixmapFragment::create(QPointF(symbolPos + symbolRect.center()), QRectF(symbolRect));
 
                     auto iter = hash.find(mark->symbolId());
                     if (iter == hash.end()) {
                         Fragment fragment;
-                        fragment.pixmap = mark->symbolPixmap();
+                        if (guiThread) {
+                            fragment.pixmap = mark->symbolPixmap();
+                        } else {
+                            fragment.image = mark->symbolImage();
+                        }
                         fragment.fragments << pixmapFragment;
                         hash.insert(mark->symbolId(), fragment);
                     } else {
@@ -115,24 +126,33 @@ bool PlacemarkLayer::render(GeoPainter *geoPainter, ViewportParams *viewport, co
                         fragment.fragments << pixmapFragment;
                     }
 #else
-                    painter->drawPixmap(symbolPos, mark->symbolPixmap());
+                    if (guiThread) {
+                        painter->drawPixmap(symbolPos, mark->symbolPixmap());
+                    } else {
+                        painter->drawImage(symbolPos, mark->symbolImage());
+                    }
 #endif
                 }
-                if (!mark->labelPixmap().isNull()) {
-                    painter->drawPixmap(labelRect, mark->labelPixmap());
+                if (!mark->labelKey().text.isEmpty() && !labelRect.isEmpty()) {
+                    labelKeys << mark->labelKey();
+                    labelTargets << labelRect;
                 }
             }
         } else { // simple case, one draw per placemark
 
-            if (!mark->symbolPixmap().isNull()) {
+            if (!mark->symbolImage().isNull()) {
 #ifdef BATCH_RENDERING
-                QRect symbolRect = mark->symbolPixmap().rect();
+                QRect symbolRect = mark->symbolImage().rect();
                 QPainter::PixmapFragment pixmapFragment = QPainter::PixmapFragment::create(QPointF(symbolPos + symbolRect.center()), QRectF(symbolRect));
 
                 auto iter = hash.find(mark->symbolId());
                 if (iter == hash.end()) {
                     Fragment fragment;
-                    fragment.pixmap = mark->symbolPixmap();
+                    if (guiThread) {
+                        fragment.pixmap = mark->symbolPixmap();
+                    } else {
+                        fragment.image = mark->symbolImage();
+                    }
                     fragment.fragments << pixmapFragment;
                     hash.insert(mark->symbolId(), fragment);
                 } else {
@@ -140,20 +160,24 @@ bool PlacemarkLayer::render(GeoPainter *geoPainter, ViewportParams *viewport, co
                     fragment.fragments << pixmapFragment;
                 }
 #else
-                painter->drawPixmap(symbolPos, mark->symbolPixmap());
+                if (guiThread) {
+                    painter->drawPixmap(symbolPos, mark->symbolPixmap());
+                } else {
+                    painter->drawImage(symbolPos, mark->symbolImage());
+                }
 #endif
             }
-            if (!mark->labelPixmap().isNull()) {
-                painter->drawPixmap(labelRect, mark->labelPixmap());
+            if (!mark->labelKey().text.isEmpty() && !labelRect.isEmpty()) {
+                labelKeys << mark->labelKey();
+                labelTargets << labelRect;
             }
         }
     }
 
 #ifdef BATCH_RENDERING
     for (auto iter = hash.begin(), end = hash.end(); iter != end; ++iter) {
-        auto const &fragment = iter.value();
+        auto &fragment = iter.value();
         if (m_debugModeEnabled) {
-            QPixmap debugPixmap(fragment.pixmap.size());
             QColor backgroundColor;
             QString idStr = iter.key().section(QLatin1Char('/'), -1);
             if (idStr.length() > 2) {
@@ -163,17 +187,57 @@ bool PlacemarkLayer::render(GeoPainter *geoPainter, ViewportParams *viewport, co
             } else {
                 backgroundColor = QColor((quint64)(&iter.key()));
             }
-            debugPixmap.fill(backgroundColor);
             QPainter pixpainter;
-            pixpainter.begin(&debugPixmap);
-            pixpainter.drawPixmap(0, 0, fragment.pixmap);
-            pixpainter.end();
-            iter.value().pixmap = debugPixmap;
+            if (guiThread) {
+                QPixmap debugPixmap(fragment.pixmap.size());
+                debugPixmap.fill(backgroundColor);
+                pixpainter.begin(&debugPixmap);
+                pixpainter.drawPixmap(0, 0, fragment.pixmap);
+                pixpainter.end();
+                fragment.pixmap = debugPixmap;
+            } else {
+                QImage debugImage(fragment.image.size(), QImage::Format_ARGB32_Premultiplied);
+                debugImage.fill(backgroundColor);
+                pixpainter.begin(&debugImage);
+                pixpainter.drawImage(0, 0, fragment.image);
+                pixpainter.end();
+                fragment.image = debugImage;
+            }
+        }
+        if (guiThread) {
+            painter->drawPixmapFragments(fragment.fragments.data(), fragment.fragments.size(), fragment.pixmap);
+        } else {
+            for (const QPainter::PixmapFragment &pixmapFragment : std::as_const(fragment.fragments)) {
+                painter->drawImage(QPointF(pixmapFragment.x - pixmapFragment.width / 2, pixmapFragment.y - pixmapFragment.height / 2), fragment.image);
+            }
         }
-        painter->drawPixmapFragments(fragment.fragments.data(), fragment.fragments.size(), fragment.pixmap);
     }
 #endif
 
+    // Labels go above the symbols, draw all labels of an atlas page at once
+    const QList<LabelAtlas::Entry> labelEntries = m_labelAtlas.prepare(labelKeys);
+    QList<QList<QPainter::PixmapFragment>> labelFragments(m_labelAtlas.pageCount());
+    for (int i = 0; i < labelEntries.size(); ++i) {
+        const LabelAtlas::Entry &entry = labelEntries.at(i);
+        if (entry.page < 0) {
+            continue;
+        }
+        const QRect &target = labelTargets.at(i);
+        if (!guiThread) {
+            painter->drawImage(QRectF(target), m_labelAtlas.page(entry.page), QRectF(entry.rect));
+            continue;
+        }
+        labelFragments[entry.page] << QPainter::PixmapFragment::create(QRectF(target).center(),
+                                                                       QRectF(entry.rect),
+                                                                       target.width() / qreal(entry.rect.width()),
+                                                                       target.height() / qreal(entry.rect.height()));
+    }
+    for (int page = 0; page < labelFragments.size(); ++page) {
+        if (!labelFragments.at(page).isEmpty()) {
+            painter->drawPixmapFragments(labelFragments.at(page).constData(), labelFragments.at(page).size(), m_labelAtlas.pagePixmap(page));
+        }
+    }
+
     if (m_debugModeEnabled) {
         renderDebug(geoPainter, viewport, visiblePlacemarks);
     }
@@ -191,6 +255,16 @@ QString PlacemarkLayer::runtimeTrace() const
     return m_layout.runtimeTrace();
 }
 
+int PlacemarkLayer::consideredPlacemarkCount() const
+{
+    return m_layout.consideredPlacemarkCount();
+}
+
+int PlacemarkLayer::drawnPlacemarkCount() const
+{
+    return m_layout.drawnPlacemarkCount();
+}
+
 QList<const GeoDataFeature *> PlacemarkLayer::whichPlacemarkAt(const QPoint &pos)
 {
     return m_layout.whichPlacemarkAt(pos);
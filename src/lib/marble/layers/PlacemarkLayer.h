@@ -18,9 +18,9 @@
 #include <QList>
 #include <QPainter>
 
+#include "LabelAtlas.h"
 #include "PlacemarkLayout.h"
 
-class QAbstractItemModel;
 class QItemSelectionModel;
 class QString;
 
@@ -30,12 +30,15 @@ namespace Marble
 class GeoPainter;
 class GeoSceneLayer;
 class MarbleClock;
+class PlacemarkRegistry;
 class ViewportParams;
 class StyleBuilder;
 
 struct Fragment {
     QVarLengthArray<QPainter::PixmapFragment, 16> fragments;
     QPixmap pixmap;
+    // Drawn instead of the pixmap outside of the GUI thread
+    QImage image;
 };
 
 class PlacemarkLayer : public QObject, public LayerInterface
@@ -43,7 +46,7 @@ class PlacemarkLayer : public QObject, public LayerInterface
     Q_OBJECT
 
 public:
-    PlacemarkLayer(QAbstractItemModel *placemarkModel,
+    PlacemarkLayer(const PlacemarkRegistry *placemarkRegistry,
                    QItemSelectionModel *selectionModel,
                    MarbleClock *clock,
                    const StyleBuilder *styleBuilder,
@@ -69,6 +72,10 @@ public:
 
     QString runtimeTrace() const override;
 
+    /// The number of placemarks considered resp. drawn by the last render()
+    int consideredPlacemarkCount() const;
+    int drawnPlacemarkCount() const;
+
     /**
      * Returns a list of model indexes that are at position @p pos.
      */
@@ -105,6 +112,7 @@ private:
     void renderDebug(GeoPainter *painter, ViewportParams *viewport, const QList<VisiblePlacemark *> &placemarks) const;
 
     PlacemarkLayout m_layout;
+    LabelAtlas m_labelAtlas;
     bool m_debugModeEnabled;
     bool m_levelTagDebugModeEnabled;
     int m_tileLevel;
@@ -239,6 +239,7 @@ TextureLayer::TextureLayer(HttpDownloadManager *downloadManager,
     , d(new Private(downloadManager, pluginManager, sunLocator, groundOverlayModel, this))
 {
     connect(&d->m_loader, SIGNAL(tileCompleted(TileId, QImage)), this, SLOT(updateTile(TileId, QImage)));
+    connect(&d->m_loader, &TileLoader::tileCancelled, &d->m_tileLoader, &StackedTileLoader::discardTile);
 
     // Repaint timer
     d->m_repaintTimer.setSingleShot(true);
@@ -312,7 +313,7 @@ bool TextureLayer::render(GeoPainter *painter, ViewportParams *viewport, const Q
     if (d->m_centerCoordinates.longitude() != viewport->centerLongitude() || d->m_centerCoordinates.latitude() != viewport->centerLatitude()) {
         d->m_centerCoordinates.setLongitude(viewport->centerLongitude());
         d->m_centerCoordinates.setLatitude(viewport->centerLatitude());
-        d->m_texmapper->setRepaintNeeded();
+        d->m_texmapper->setCenterChanged();
     }
 
     // choose the smaller dimension for selecting the tile level, leading to higher-resolution results
@@ -505,6 +506,16 @@ quint64 TextureLayer::volatileCacheLimit() const
     return d->m_tileLoader.volatileCacheLimit();
 }
 
+quint64 TextureLayer::tileHitCount() const
+{
+    return d->m_tileLoader.tileHitCount();
+}
+
+quint64 TextureLayer::tileMissCount() const
+{
+    return d->m_tileLoader.tileMissCount();
+}
+
 int TextureLayer::preferredRadiusCeil(int radius) const
 {
     if (!d->m_layerDecorator.hasTextureLayer()) {
@@ -76,6 +76,10 @@ public:
 
     quint64 volatileCacheLimit() const;
 
+    /// The number of tiles found in memory resp. loaded from disk so far
+    quint64 tileHitCount() const;
+    quint64 tileMissCount() const;
+
     int preferredRadiusCeil(int radius) const;
     int preferredRadiusFloor(int radius) const;
 
@@ -13,15 +13,26 @@
 #include "GeoDataPlacemark.h"
 
 #include <QElapsedTimer>
-#include <QPainter>
+#include <QLineF>
 #include <QTimer>
 
+#include <algorithm>
+#include <array>
+
 namespace Marble
 {
 
 class Q_DECL_HIDDEN AlternativeRoutesModel::Private
 {
 public:
+    /** Number of points routes are resampled to when comparing them */
+    static const int SampleCount = 128;
+
+    struct Samples {
+        std::array<QPointF, SampleCount> points;
+        qreal spacing;
+    };
+
     Private();
 
     /**
@@ -39,32 +50,16 @@ public:
     static qreal similarity(const GeoDataDocument *routeA, const GeoDataDocument *routeB);
 
     /**
-     * Returns the distance between the given polygon and the given point
-     */
-    static qreal distance(const GeoDataLineString &wayPoints, const GeoDataCoordinates &position);
-
-    /**
-     * Returns the bearing of the great circle path defined by the coordinates one and two
-     * Based on https://www.movable-type.co.uk/scripts/latlong.html
-     */
-    static qreal bearing(const GeoDataCoordinates &one, const GeoDataCoordinates &two);
-
-    /**
-     * Returns the distance between the given point and the line segment (not line) defined
-     * by the two coordinates lineA and lineB
+     * Returns the similarity between routeA and routeB. This method is not symmetric, i.e. in
+     * general unidirectionalSimilarity(a,b) != unidirectionalSimilarity(b,a)
      */
-    static qreal distance(const GeoDataCoordinates &satellite, const GeoDataCoordinates &lineA, const GeoDataCoordinates &lineB);
+    static qreal unidirectionalSimilarity(const Samples &routeA, const Samples &routeB);
 
     /**
-     * Returns the point reached when traveling the given distance from start with the given direction
+     * Resamples the line string to points equally spaced along it, in coordinates normalized
+     * to the given bounding box. Returns false for an empty line string.
      */
-    static GeoDataCoordinates coordinates(const GeoDataCoordinates &start, qreal distance, qreal bearing);
-
-    /**
-     * Returns the similarity between routeA and routeB. This method is not symmetric, i.e. in
-     * general unidirectionalSimilarity(a,b) != unidirectionalSimilarity(b,a)
-     */
-    static qreal unidirectionalSimilarity(const GeoDataDocument *routeA, const GeoDataDocument *routeB);
+    static bool resample(const GeoDataLineString &lineString, const GeoDataLatLonBox &box, Samples &samples);
 
     /**
      * (Primitive) scoring for routes
@@ -78,10 +73,6 @@ public:
 
     static const GeoDataLineString *waypoints(const GeoDataDocument *document);
 
-    static int nonZero(const QImage &image);
-
-    static QPolygonF polygon(const GeoDataLineString &lineString, qreal x, qreal y, qreal sx, qreal sy);
-
     /** The currently shown alternative routes (model data) */
     QList<GeoDataDocument *> m_routes;
 
@@ -100,28 +91,6 @@ AlternativeRoutesModel::Private::Private()
     // nothing to do
 }
 
-int AlternativeRoutesModel::Private::nonZero(const QImage &image)
-{
-    QRgb const black = qRgb(0, 0, 0);
-    int count = 0;
-    for (int y = 0; y < image.height(); ++y) {
-        QRgb *destLine = (QRgb *)image.scanLine(y);
-        for (int x = 0; x < image.width(); ++x) {
-            count += destLine[x] == black ? 0 : 1;
-        }
-    }
-    return count;
-}
-
-QPolygonF AlternativeRoutesModel::Private::polygon(const GeoDataLineString &lineString, qreal x, qreal y, qreal sx, qreal sy)
-{
-    QPolygonF poly;
-    for (int i = 0; i < lineString.size(); ++i) {
-        poly << QPointF(qAbs((lineString)[i].longitude() - x) * sx, qAbs((lineString)[i].latitude() - y) * sy);
-    }
-    return poly;
-}
-
 bool AlternativeRoutesModel::Private::filter(const GeoDataDocument *document) const
 {
     for (int i = 0; i < m_routes.size(); ++i) {
@@ -135,61 +104,6 @@ bool AlternativeRoutesModel::Private::filter(const GeoDataDocument *document) co
 }
 
 qreal AlternativeRoutesModel::Private::similarity(const GeoDataDocument *routeA, const GeoDataDocument *routeB)
-{
-    return qMax<qreal>(unidirectionalSimilarity(routeA, routeB), unidirectionalSimilarity(routeB, routeA));
-}
-
-qreal AlternativeRoutesModel::Private::distance(const GeoDataLineString &wayPoints, const GeoDataCoordinates &position)
-{
-    Q_ASSERT(!wayPoints.isEmpty());
-    qreal minDistance = 0;
-    for (int i = 1; i < wayPoints.size(); ++i) {
-        qreal dist = distance(position, wayPoints.at(i - 1), wayPoints.at(i));
-        if (minDistance <= 0 || dist < minDistance) {
-            minDistance = dist;
-        }
-    }
-
-    return minDistance;
-}
-
-qreal AlternativeRoutesModel::Private::bearing(const GeoDataCoordinates &one, const GeoDataCoordinates &two)
-{
-    qreal delta = two.longitude() - one.longitude();
-    qreal lat1 = one.latitude();
-    qreal lat2 = two.latitude();
-    return fmod(atan2(sin(delta) * cos(lat2), cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(delta)), 2 * M_PI);
-}
-
-GeoDataCoordinates AlternativeRoutesModel::Private::coordinates(const GeoDataCoordinates &start, qreal distance, qreal bearing)
-{
-    qreal lat1 = start.latitude();
-    qreal lon1 = start.longitude();
-    qreal lat2 = asin(sin(lat1) * cos(distance) + cos(lat1) * sin(distance) * cos(bearing));
-    qreal lon2 = lon1 + atan2(sin(bearing) * sin(distance) * cos(lat1), cos(distance) - sin(lat1) * sin(lat2));
-    return {lon2, lat2};
-}
-
-qreal AlternativeRoutesModel::Private::distance(const GeoDataCoordinates &satellite, const GeoDataCoordinates &lineA, const GeoDataCoordinates &lineB)
-{
-    const qreal dist = lineA.sphericalDistanceTo(satellite);
-    qreal bearA = bearing(lineA, satellite);
-    qreal bearB = bearing(lineA, lineB);
-    qreal result = asin(sin(dist) * sin(bearB - bearA));
-    Q_ASSERT(qMax<qreal>(satellite.sphericalDistanceTo(lineA), satellite.sphericalDistanceTo(lineB)) >= qAbs<qreal>(result));
-
-    result = acos(cos(dist) / cos(result));
-    /** @todo: This is a naive approach. Look into the maths. */
-    const qreal final = qMin<qreal>(satellite.sphericalDistanceTo(lineA), satellite.sphericalDistanceTo(lineB));
-    if (result >= 0 && result <= lineA.sphericalDistanceTo(lineB)) {
-        GeoDataCoordinates nearest = coordinates(lineA, result, bearB);
-        return qMin<qreal>(final, satellite.sphericalDistanceTo(nearest));
-    } else {
-        return final;
-    }
-}
-
-qreal AlternativeRoutesModel::Private::unidirectionalSimilarity(const GeoDataDocument *routeA, const GeoDataDocument *routeB)
 {
     const GeoDataLineString *waypointsA = waypoints(routeA);
     const GeoDataLineString *waypointsB = waypoints(routeB);
@@ -197,27 +111,102 @@ qreal AlternativeRoutesModel::Private::unidirectionalSimilarity(const GeoDataDoc
         return 0.0;
     }
 
-    QImage image(64, 64, QImage::Format_ARGB32_Premultiplied);
-    image.fill(qRgb(0, 0, 0));
     GeoDataLatLonBox box = GeoDataLatLonBox::fromLineString(*waypointsA);
     box = box.united(GeoDataLatLonBox::fromLineString(*waypointsB));
     if (!box.width() || !box.height()) {
         return 0.0;
     }
 
-    qreal const sw = image.width() / box.width();
-    qreal const sh = image.height() / box.height();
+    Samples samplesA;
+    Samples samplesB;
+    if (!resample(*waypointsA, box, samplesA) || !resample(*waypointsB, box, samplesB)) {
+        return 0.0;
+    }
 
-    QPainter painter(&image);
-    painter.setPen(QColor(Qt::white));
+    return qMax<qreal>(unidirectionalSimilarity(samplesA, samplesB), unidirectionalSimilarity(samplesB, samplesA));
+}
 
-    painter.drawPoints(Private::polygon(*waypointsA, box.west(), box.north(), sw, sh));
-    int const countA = Private::nonZero(image);
+bool AlternativeRoutesModel::Private::resample(const GeoDataLineString &lineString, const GeoDataLatLonBox &box, Samples &samples)
+{
+    if (lineString.isEmpty()) {
+        return false;
+    }
 
-    painter.drawPoints(Private::polygon(*waypointsB, box.west(), box.north(), sw, sh));
-    int const countB = Private::nonZero(image);
-    Q_ASSERT(countA <= countB);
-    return countB ? 1.0 - qreal(countB - countA) / countB : 0;
+    auto normalized = [&box](const GeoDataCoordinates &coordinates) {
+        qreal x = coordinates.longitude() - box.west();
+        if (x < 0.0) {
+            x += 2 * M_PI;
+        }
+        return QPointF(x / box.width(), (box.north() - coordinates.latitude()) / box.height());
+    };
+
+    qreal length = 0.0;
+    for (int i = 1; i < lineString.size(); ++i) {
+        length += QLineF(normalized(lineString[i - 1]), normalized(lineString[i])).length();
+    }
+    samples.spacing = length / (SampleCount - 1);
+
+    int index = 1;
+    qreal travelled = 0.0;
+    QPointF from = normalized(lineString[0]);
+    QPointF to = lineString.size() > 1 ? normalized(lineString[1]) : from;
+    qreal segmentLength = QLineF(from, to).length();
+    for (int i = 0; i < SampleCount; ++i) {
+        const qreal position = i * samples.spacing;
+        while (index < lineString.size() - 1 && travelled + segmentLength < position) {
+            travelled += segmentLength;
+            ++index;
+            from = to;
+            to = normalized(lineString[index]);
+            segmentLength = QLineF(from, to).length();
+        }
+        const qreal t = segmentLength > 0.0 ? qBound<qreal>(0.0, (position - travelled) / segmentLength, 1.0) : 0.0;
+        samples.points[i] = from + (to - from) * t;
+    }
+
+    return true;
+}
+
+qreal AlternativeRoutesModel::Private::unidirectionalSimilarity(const Samples &routeA, const Samples &routeB)
+{
+    // The fraction of routeB lying close to routeA. Close means within 1/64 of the
+    // common bounding box, or half the sample spacing of routeA if that is larger.
+    // Samples of routeA are bucketed into a grid with cells of that size, so only
+    // the neighboring cells need to be checked for each sample of routeB.
+    const qreal tolerance = qMax<qreal>(1.0 / 64, routeA.spacing / 2);
+    auto cell = [tolerance](const QPointF &point) {
+        return std::make_pair(qMax(0, int(point.x() / tolerance)), qMax(0, int(point.y() / tolerance)));
+    };
+    auto key = [](int x, int y) {
+        return (quint32(x) << 16) | quint32(y);
+    };
+
+    std::array<std::pair<quint32, int>, SampleCount> grid;
+    for (int i = 0; i < SampleCount; ++i) {
+        const auto position = cell(routeA.points[i]);
+        grid[i] = std::make_pair(key(position.first, position.second), i);
+    }
+    std::sort(grid.begin(), grid.end());
+
+    int covered = 0;
+    for (const QPointF &point : routeB.points) {
+        const auto position = cell(point);
+        bool isCovered = false;
+        for (int x = position.first - 1; !isCovered && x <= position.first + 1; ++x) {
+            for (int y = position.second - 1; !isCovered && y <= position.second + 1; ++y) {
+                if (x < 0 || y < 0) {
+                    continue;
+                }
+                auto it = std::lower_bound(grid.cbegin(), grid.cend(), std::make_pair(key(x, y), 0));
+                for (; !isCovered && it != grid.cend() && it->first == key(x, y); ++it) {
+                    isCovered = QLineF(routeA.points[it->second], point).length() <= tolerance;
+                }
+            }
+        }
+        covered += isCovered ? 1 : 0;
+    }
+
+    return qreal(covered) / SampleCount;
 }
 
 bool AlternativeRoutesModel::Private::higherScore(const GeoDataDocument *one, const GeoDataDocument *two)
@@ -402,6 +391,11 @@ const GeoDataLineString *AlternativeRoutesModel::waypoints(const GeoDataDocument
     return Private::waypoints(document);
 }
 
+qreal AlternativeRoutesModel::similarity(const GeoDataDocument *routeA, const GeoDataDocument *routeB)
+{
+    return Private::similarity(routeA, routeB);
+}
+
 void AlternativeRoutesModel::setCurrentRoute(int index)
 {
     if (index >= 0 && index < rowCount() && d->m_currentIndex != index) {
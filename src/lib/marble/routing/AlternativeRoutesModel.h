@@ -77,6 +77,12 @@ public:
     /** Returns the waypoints contained in the route as a linestring */
     static const GeoDataLineString *waypoints(const GeoDataDocument *document);
 
+    /**
+     * Returns how much the two routes overlap, from 0 (not at all) to 1 (equal).
+     * Routes more similar than 0.8 are treated as the same alternative.
+     */
+    static qreal similarity(const GeoDataDocument *routeA, const GeoDataDocument *routeB);
+
 public Q_SLOTS:
     void setCurrentRoute(int index);
 
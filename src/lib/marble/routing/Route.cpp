@@ -5,6 +5,8 @@
 
 #include "Route.h"
 
+#include "RouteSegmentIndex.h"
+
 namespace Marble
 {
 
@@ -13,6 +15,7 @@ Route::Route()
     , m_travelTime(0)
     , m_positionDirty(true)
     , m_closestSegmentIndex(-1)
+    , m_closestEdgeIndex(-1)
 {
     // nothing to do
 }
@@ -30,6 +33,7 @@ void Route::addRouteSegment(const RouteSegment &segment)
             m_waypoints << segment.maneuver().waypoint();
         }
         m_segments.push_back(segment);
+        m_segmentIndex.reset();
         m_positionDirty = true;
 
         for (int i = 1; i < m_segments.size(); ++i) {
@@ -94,37 +98,34 @@ GeoDataCoordinates Route::position() const
     return m_position;
 }
 
+const RouteSegmentIndex &Route::segmentIndex() const
+{
+    if (!m_segmentIndex) {
+        m_segmentIndex.reset(new RouteSegmentIndex(m_segments));
+    }
+    return *m_segmentIndex;
+}
+
 void Route::updatePosition() const
 {
     if (!m_segments.isEmpty()) {
-        if (m_closestSegmentIndex < 0 || m_closestSegmentIndex >= m_segments.size()) {
-            m_closestSegmentIndex = 0;
-        }
-
-        qreal distance = m_segments[m_closestSegmentIndex].distanceTo(m_position, m_currentWaypoint, m_positionOnRoute);
-        QList<int> candidates;
-
-        for (int i = 0; i < m_segments.size(); ++i) {
-            if (i != m_closestSegmentIndex && m_segments[i].minimalDistanceTo(m_position) <= distance) {
-                candidates << i;
-            }
-        }
-
-        GeoDataCoordinates closest, interpolated;
-        for (int i : std::as_const(candidates)) {
-            qreal const dist = m_segments[i].distanceTo(m_position, closest, interpolated);
-            if (distance < 0.0 || dist < distance) {
-                distance = dist;
-                m_closestSegmentIndex = i;
-                m_positionOnRoute = interpolated;
-                m_currentWaypoint = closest;
-            }
+        RouteSegmentIndex::Match const match = segmentIndex().closestEdge(m_position, m_closestEdgeIndex);
+        if (match.segment >= 0) {
+            m_closestEdgeIndex = match.edge;
+            m_closestSegmentIndex = match.segment;
+            m_positionOnRoute = match.interpolated;
+            m_currentWaypoint = m_segments[match.segment].path().at(match.point);
         }
     }
 
     m_positionDirty = false;
 }
 
+int Route::closestPathIndex(const GeoDataCoordinates &position) const
+{
+    return m_segments.isEmpty() ? -1 : segmentIndex().closestPathPoint(position);
+}
+
 const RouteSegment &Route::currentSegment() const
 {
     if (m_positionDirty) {
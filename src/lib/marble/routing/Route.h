@@ -9,9 +9,13 @@
 #include "GeoDataLatLonBox.h"
 #include "RouteSegment.h"
 
+#include <QSharedPointer>
+
 namespace Marble
 {
 
+class RouteSegmentIndex;
+
 class MARBLE_EXPORT Route
 {
 public:
@@ -47,9 +51,17 @@ public:
 
     GeoDataCoordinates positionOnRoute() const;
 
+    /**
+     * Returns the index of the point in path() closest to the given position,
+     * or -1 if the route is empty.
+     */
+    int closestPathIndex(const GeoDataCoordinates &position) const;
+
 private:
     void updatePosition() const;
 
+    const RouteSegmentIndex &segmentIndex() const;
+
     GeoDataLatLonBox m_bounds;
 
     qreal m_distance;
@@ -68,6 +80,10 @@ private:
 
     mutable int m_closestSegmentIndex;
 
+    mutable int m_closestEdgeIndex;
+
+    mutable QSharedPointer<const RouteSegmentIndex> m_segmentIndex;
+
     mutable GeoDataCoordinates m_positionOnRoute;
 
     mutable GeoDataCoordinates m_currentWaypoint;
@@ -53,6 +53,8 @@ public:
     bool operator!=(const RouteSegment &other) const;
 
 private:
+    friend class RouteSegmentIndex;
+
     static qreal distancePointToLine(const GeoDataCoordinates &p, const GeoDataCoordinates &a, const GeoDataCoordinates &b);
 
     static GeoDataCoordinates projected(const GeoDataCoordinates &p, const GeoDataCoordinates &a, const GeoDataCoordinates &b);
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "RouteSegmentIndex.h"
+
+#include "MarbleGlobal.h"
+#include "RouteSegment.h"
+
+#include <QtMath>
+
+#include <queue>
+#include <vector>
+
+namespace Marble
+{
+
+namespace
+{
+// Number of children per node of the hierarchy
+const int GroupSize = 8;
+
+// Number of edges before and after the previous match that are checked first
+const int WindowSize = 16;
+}
+
+void RouteSegmentIndex::Box::unite(const Box &other)
+{
+    west = qMin(west, other.west);
+    east = qMax(east, other.east);
+    south = qMin(south, other.south);
+    north = qMax(north, other.north);
+}
+
+RouteSegmentIndex::RouteSegmentIndex(const QList<RouteSegment> &segments)
+{
+    int pathOffset = 0;
+    for (int segment = 0; segment < segments.size(); ++segment) {
+        const GeoDataLineString &path = segments[segment].path();
+        m_paths << path;
+        if (path.size() == 1) {
+            m_edges << Edge{segment, 0, pathOffset};
+        }
+        for (int i = 1; i < path.size(); ++i) {
+            m_edges << Edge{segment, i, pathOffset + i};
+        }
+        pathOffset += path.size();
+    }
+
+    m_edgeBoxes.reserve(m_edges.size());
+    for (const Edge &edge : std::as_const(m_edges)) {
+        const GeoDataCoordinates &a = coordinates(edge, -1);
+        const GeoDataCoordinates &b = coordinates(edge);
+        m_edgeBoxes << Box{qMin(a.longitude(), b.longitude()),
+                           qMax(a.longitude(), b.longitude()),
+                           qMin(a.latitude(), b.latitude()),
+                           qMax(a.latitude(), b.latitude())};
+    }
+
+    const QList<Box> *children = &m_edgeBoxes;
+    while (!children->isEmpty()) {
+        QList<Box> level;
+        level.reserve(children->size() / GroupSize + 1);
+        for (int i = 0; i < children->size(); i += GroupSize) {
+            Box box = children->at(i);
+            for (int j = i + 1; j < qMin(i + GroupSize, int(children->size())); ++j) {
+                box.unite(children->at(j));
+            }
+            level << box;
+        }
+        m_levels << level;
+        if (level.size() == 1) {
+            break;
+        }
+        children = &m_levels.last();
+    }
+}
+
+RouteSegmentIndex::Match RouteSegmentIndex::closestEdge(const GeoDataCoordinates &position, int hintEdge) const
+{
+    Match match;
+    if (hintEdge >= 0 && hintEdge < m_edges.size()) {
+        const int last = qMin(hintEdge + WindowSize, int(m_edges.size()) - 1);
+        for (int i = qMax(0, hintEdge - WindowSize); i <= last; ++i) {
+            checkEdge(position, i, match);
+        }
+    }
+
+    visitNearest(position, match.distance, [&](int edge) {
+        checkEdge(position, edge, match);
+    });
+    return match;
+}
+
+int RouteSegmentIndex::closestPathPoint(const GeoDataCoordinates &position) const
+{
+    int result = -1;
+    qreal best = -1.0;
+    visitNearest(position, best, [&](int edgeIndex) {
+        // Both end points lie within the box of the edge, so its bound is valid for them as well
+        const Edge &edge = m_edges[edgeIndex];
+        for (int offset = edge.point == 0 ? 0 : -1; offset <= 0; ++offset) {
+            const qreal distance = EARTH_RADIUS * position.sphericalDistanceTo(coordinates(edge, offset));
+            if (best < 0.0 || distance < best) {
+                best = distance;
+                result = edge.pathIndex + offset;
+            }
+        }
+    });
+    return result;
+}
+
+template<typename Visitor>
+void RouteSegmentIndex::visitNearest(const GeoDataCoordinates &position, qreal &best, Visitor visitor) const
+{
+    if (m_levels.isEmpty()) {
+        return;
+    }
+
+    struct Entry {
+        qreal bound;
+        int level;
+        int index;
+
+        bool operator>(const Entry &other) const
+        {
+            return bound > other.bound;
+        }
+    };
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    const int top = m_levels.size() - 1;
+    for (int i = 0; i < m_levels[top].size(); ++i) {
+        queue.push({minimalDistance(position, m_levels[top][i]), top, i});
+    }
+
+    while (!queue.empty()) {
+        const Entry entry = queue.top();
+        queue.pop();
+        if (best >= 0.0 && entry.bound >= best) {
+            break;
+        }
+
+        const QList<Box> &children = entry.level == 0 ? m_edgeBoxes : m_levels[entry.level - 1];
+        const int first = entry.index * GroupSize;
+        const int last = qMin(first + GroupSize, int(children.size()));
+        for (int i = first; i < last; ++i) {
+            const qreal bound = minimalDistance(position, children[i]);
+            if (best >= 0.0 && bound >= best) {
+                continue;
+            }
+            if (entry.level == 0) {
+                visitor(i);
+            } else {
+                queue.push({bound, entry.level - 1, i});
+            }
+        }
+    }
+}
+
+qreal RouteSegmentIndex::minimalDistance(const GeoDataCoordinates &position, const Box &box)
+{
+    // A lower bound of the great circle distance to any point in the box: the
+    // haversine formula with the latitude and longitude differences minimized
+    // independently and the smallest cosine of all latitudes involved.
+    const qreal latitude = position.latitude();
+    const qreal longitude = position.longitude();
+    const qreal deltaLatitude = qMax<qreal>(0.0, qMax(box.south - latitude, latitude - box.north));
+
+    qreal deltaLongitude = 0.0;
+    if (longitude < box.west || longitude > box.east) {
+        const qreal toWest = qAbs(box.west - longitude);
+        const qreal toEast = qAbs(longitude - box.east);
+        deltaLongitude = qMin(qMin(toWest, 2 * M_PI - toWest), qMin(toEast, 2 * M_PI - toEast));
+    }
+
+    const qreal maximumLatitude = qMax(qAbs(latitude), qMax(qAbs(box.south), qAbs(box.north)));
+    const qreal cosine = qCos(qMin<qreal>(maximumLatitude, M_PI / 2));
+    const qreal sinLatitude = qSin(deltaLatitude / 2);
+    const qreal sinLongitude = qSin(deltaLongitude / 2);
+    const qreal haversine = sinLatitude * sinLatitude + cosine * cosine * sinLongitude * sinLongitude;
+    return 2 * EARTH_RADIUS * qAsin(qMin<qreal>(1.0, qSqrt(haversine)));
+}
+
+const GeoDataCoordinates &RouteSegmentIndex::coordinates(const Edge &edge, int offset) const
+{
+    return m_paths[edge.segment].at(qMax(0, edge.point + offset));
+}
+
+void RouteSegmentIndex::checkEdge(const GeoDataCoordinates &position, int edgeIndex, Match &match) const
+{
+    const Edge &edge = m_edges[edgeIndex];
+    const GeoDataCoordinates interpolated = edge.point == 0 ? coordinates(edge) : RouteSegment::projected(position, coordinates(edge, -1), coordinates(edge));
+    const qreal distance = EARTH_RADIUS * position.sphericalDistanceTo(interpolated);
+    if (match.distance < 0.0 || distance < match.distance) {
+        match.edge = edgeIndex;
+        match.segment = edge.segment;
+        match.point = edge.point;
+        match.pathIndex = edge.pathIndex;
+        match.distance = distance;
+        match.interpolated = interpolated;
+    }
+}
+
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_ROUTESEGMENTINDEX_H
+#define MARBLE_ROUTESEGMENTINDEX_H
+
+#include "GeoDataCoordinates.h"
+#include "GeoDataLineString.h"
+
+#include <QList>
+
+namespace Marble
+{
+
+class RouteSegment;
+
+/**
+ * A bounding volume hierarchy over the edges of all route segment paths.
+ *
+ * Consecutive edges of a route polyline are spatially close, so the hierarchy
+ * simply groups them in path order. Nearest neighbor queries descend it best
+ * first and skip any box whose lower distance bound exceeds the best match so
+ * far. Seeding the search with the previously matched edge keeps most
+ * position updates during navigation down to a handful of distance checks.
+ */
+class RouteSegmentIndex
+{
+public:
+    struct Match {
+        int edge = -1; ///< index of the closest edge, to be passed as hint to the next query
+        int segment = -1; ///< index of the closest route segment
+        int point = -1; ///< index of the end point of the closest edge in the segment path
+        int pathIndex = -1; ///< index of that point in the route path
+        qreal distance = -1.0; ///< distance to the closest edge in meters
+        GeoDataCoordinates interpolated; ///< closest location on the closest edge
+    };
+
+    explicit RouteSegmentIndex(const QList<RouteSegment> &segments);
+
+    /**
+     * Returns the route edge closest to the given position. Edges around
+     * hintEdge are checked first, which prunes most of the hierarchy when
+     * the position did not move far since the last query.
+     */
+    Match closestEdge(const GeoDataCoordinates &position, int hintEdge = -1) const;
+
+    /** Returns the index of the route path point closest to the given position */
+    int closestPathPoint(const GeoDataCoordinates &position) const;
+
+private:
+    struct Box {
+        qreal west;
+        qreal east;
+        qreal south;
+        qreal north;
+
+        void unite(const Box &other);
+    };
+
+    struct Edge {
+        int segment;
+        int point;
+        int pathIndex;
+    };
+
+    template<typename Visitor>
+    void visitNearest(const GeoDataCoordinates &position, qreal &best, Visitor visitor) const;
+
+    static qreal minimalDistance(const GeoDataCoordinates &position, const Box &box);
+
+    const GeoDataCoordinates &coordinates(const Edge &edge, int offset = 0) const;
+
+    void checkEdge(const GeoDataCoordinates &position, int edgeIndex, Match &match) const;
+
+    QList<GeoDataLineString> m_paths;
+    QList<Edge> m_edges;
+    QList<Box> m_edgeBoxes;
+    /// Level 0 groups edges, every further level groups the boxes of the level below
+    QList<QList<Box>> m_levels;
+};
+
+}
+
+#endif
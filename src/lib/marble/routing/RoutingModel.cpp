@@ -36,8 +36,12 @@ public:
     RouteRequest *const m_request;
     QHash<int, QByteArray> m_roleNames;
     RouteDeviation m_deviation;
+    QList<GeoDataCoordinates> m_mappedViaPoints;
+    QList<int> m_viaPointMapping;
 
     void updateViaPoints(const GeoDataCoordinates &position);
+
+    const QList<int> &viaPointMapping(const RouteRequest *route);
 };
 
 RoutingModelPrivate::RoutingModelPrivate(PositionTracking *positionTracking, RouteRequest *request)
@@ -61,6 +65,47 @@ void RoutingModelPrivate::updateViaPoints(const GeoDataCoordinates &position)
     }
 }
 
+const QList<int> &RoutingModelPrivate::viaPointMapping(const RouteRequest *route)
+{
+    // The mapping only changes with the route or the via points, not with the position
+    bool upToDate = m_mappedViaPoints.size() == route->size();
+    for (int i = 0; upToDate && i < route->size(); ++i) {
+        upToDate = m_mappedViaPoints[i] == route->at(i);
+    }
+    if (upToDate) {
+        return m_viaPointMapping;
+    }
+
+    const GeoDataLineString &points = m_route.path();
+    m_mappedViaPoints.clear();
+    m_viaPointMapping.clear();
+    for (int i = 0; i < route->size(); ++i) {
+        m_mappedViaPoints << route->at(i);
+    }
+
+    // Force first mapping point to match the route start
+    m_viaPointMapping << 0;
+
+    // Calculate the mapping between waypoints and via points
+    // Need two for loops to avoid getting stuck in local minima
+    for (int j = 1; j < route->size() - 1; ++j) {
+        qreal minDistance = -1.0;
+        int mapped = m_viaPointMapping.last();
+        for (int i = m_viaPointMapping.last(); i < points.size(); ++i) {
+            const qreal distance = points[i].sphericalDistanceTo(route->at(j));
+            if (minDistance < 0.0 || distance < minDistance) {
+                mapped = i;
+                minDistance = distance;
+            }
+        }
+        m_viaPointMapping << mapped;
+    }
+
+    // Force last mapping point to match the route destination
+    m_viaPointMapping << points.size() - 1;
+    return m_viaPointMapping;
+}
+
 RoutingModel::RoutingModel(RouteRequest *request, PositionTracking *positionTracking, QObject *parent)
     : QAbstractListModel(parent)
     , d(new RoutingModelPrivate(positionTracking, request))
@@ -146,6 +191,7 @@ void RoutingModel::setRoute(const Route &route)
 {
     d->m_route = route;
     d->m_deviation = RoutingModelPrivate::Unknown;
+    d->m_mappedViaPoints.clear();
 
     beginResetModel();
     endResetModel();
@@ -207,6 +253,7 @@ void RoutingModel::exportGpx(QIODevice *device) const
 void RoutingModel::clear()
 {
     d->m_route = Route();
+    d->m_mappedViaPoints.clear();
     beginResetModel();
     endResetModel();
     Q_EMIT currentRouteChanged();
@@ -221,45 +268,18 @@ int RoutingModel::rightNeighbor(const GeoDataCoordinates &position, RouteRequest
         return route->size() - 1;
     }
 
-    // Generate an ordered list of all waypoints
-    GeoDataLineString points = d->m_route.path();
-    QMap<int, int> mapping;
-
-    // Force first mapping point to match the route start
-    mapping[0] = 0;
-
-    // Calculate the mapping between waypoints and via points
-    // Need two for loops to avoid getting stuck in local minima
-    for (int j = 1; j < route->size() - 1; ++j) {
-        qreal minDistance = -1.0;
-        for (int i = mapping[j - 1]; i < points.size(); ++i) {
-            const qreal distance = points[i].sphericalDistanceTo(route->at(j));
-            if (minDistance < 0.0 || distance < minDistance) {
-                mapping[j] = i;
-                minDistance = distance;
-            }
-        }
+    if (d->m_route.path().isEmpty()) {
+        return route->size() - 1;
     }
 
-    // Determine waypoint with minimum distance to the provided position
-    qreal minWaypointDistance = -1.0;
-    int waypoint = 0;
-    for (int i = 0; i < points.size(); ++i) {
-        const qreal waypointDistance = points[i].sphericalDistanceTo(position);
-        if (minWaypointDistance < 0.0 || waypointDistance < minWaypointDistance) {
-            minWaypointDistance = waypointDistance;
-            waypoint = i;
-        }
-    }
+    const QList<int> &mapping = d->viaPointMapping(route);
 
-    // Force last mapping point to match the route destination
-    mapping[route->size() - 1] = points.size() - 1;
+    // Determine waypoint with minimum distance to the provided position
+    const int waypoint = d->m_route.closestPathIndex(position);
 
     // Determine neighbor based on the mapping
-    QMap<int, int>::const_iterator iter = mapping.constBegin();
-    for (; iter != mapping.constEnd(); ++iter) {
-        if (iter.value() > waypoint) {
-            int index = iter.key();
+    for (int index = 0; index < mapping.size(); ++index) {
+        if (mapping[index] > waypoint) {
             Q_ASSERT(index >= 0 && index <= route->size());
             return index;
         }
@@ -580,7 +580,7 @@ void RoutingWidget::retrieveSelectedPoint(const GeoDataCoordinates &coordinates)
 {
     if (d->m_inputRequest && d->m_inputWidgets.contains(d->m_inputRequest)) {
         d->m_inputRequest->setTargetPosition(coordinates);
-        d->m_widget->update();
+        d->m_widget->repaintLayers();
     }
 
     d->m_inputRequest = nullptr;
@@ -19,7 +19,7 @@ namespace Marble
 class FlightGearPositionProviderPlugin : public PositionProviderPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.FlightGearPositionProviderPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.FlightGearPositionProviderPlugin" FILE "FlightGearPositionProviderPlugin.json")
     Q_INTERFACES(Marble::PositionProviderPluginInterface)
 
 public:
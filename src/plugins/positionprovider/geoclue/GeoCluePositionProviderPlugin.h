@@ -22,7 +22,7 @@ namespace Marble
 class GeoCluePositionProviderPlugin : public PositionProviderPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.GeoCluePositionProviderPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.GeoCluePositionProviderPlugin" FILE "GeoCluePositionProviderPlugin.json")
     Q_INTERFACES(Marble::PositionProviderPluginInterface)
 
 public:
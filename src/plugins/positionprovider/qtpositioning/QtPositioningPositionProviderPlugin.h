@@ -19,7 +19,7 @@ class QtPositioningPositionProviderPluginPrivate;
 class QtPositioningPositionProviderPlugin : public PositionProviderPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.QtPositioningPositionProviderPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.QtPositioningPositionProviderPlugin" FILE "QtPositioningPositionProviderPlugin.json")
     Q_INTERFACES(Marble::PositionProviderPluginInterface)
 
 public:
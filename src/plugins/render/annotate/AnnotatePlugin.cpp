@@ -1291,7 +1291,7 @@ void AnnotatePlugin::addPolygon()
     polygon->setState(SceneGraphicsItem::DrawingPolygon);
     polygon->setFocus(true);
     m_graphicsItems.append(polygon);
-    m_marbleWidget->update();
+    Q_EMIT repaintNeeded();
 
     QPointer<EditPolygonDialog> dialog = new EditPolygonDialog(m_polygonPlacemark, &m_osmRelations, m_marbleWidget);
 
@@ -1542,7 +1542,7 @@ void AnnotatePlugin::addPolyline()
     polyline->setState(SceneGraphicsItem::DrawingPolyline);
     polyline->setFocus(true);
     m_graphicsItems.append(polyline);
-    m_marbleWidget->update();
+    Q_EMIT repaintNeeded();
 
     QPointer<EditPolylineDialog> dialog = new EditPolylineDialog(m_polylinePlacemark, &m_osmRelations, m_marbleWidget);
 
@@ -34,7 +34,7 @@ class OsmPlacemarkData;
 class AnnotatePlugin : public RenderPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.AnnotatePlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.AnnotatePlugin" FILE "AnnotatePlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(AnnotatePlugin)
 
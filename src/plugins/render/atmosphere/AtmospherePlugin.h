@@ -17,7 +17,7 @@ namespace Marble
 class AtmospherePlugin : public RenderPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.AtmospherePlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.AtmospherePlugin" FILE "AtmospherePlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(AtmospherePlugin)
 
@@ -34,7 +34,7 @@ namespace Marble
 class CrosshairsPlugin : public RenderPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.CrosshairsPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.CrosshairsPlugin" FILE "CrosshairsPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(CrosshairsPlugin)
@@ -22,7 +22,7 @@ namespace Marble
 class EarthquakePlugin : public AbstractDataPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.EarthquakePlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.EarthquakePlugin" FILE "EarthquakePlugin.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
@@ -37,7 +37,7 @@ class EclipsesBrowserDialog;
 class EclipsesPlugin : public RenderPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.EclipsesPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.EclipsesPlugin" FILE "EclipsesPlugin.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
@@ -40,7 +40,7 @@ class MarbleWidget;
 class ElevationProfileFloatItem : public AbstractFloatItem, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.ElevationProfileFloatItem")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.ElevationProfileFloatItem" FILE "ElevationProfileFloatItem.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
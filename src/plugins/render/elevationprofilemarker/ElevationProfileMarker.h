@@ -21,7 +21,7 @@ class GeoDataPlacemark;
 class ElevationProfileMarker : public RenderPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.ElevationProfileMarker")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.ElevationProfileMarker" FILE "ElevationProfileMarker.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
 
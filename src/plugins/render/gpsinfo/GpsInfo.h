@@ -31,7 +31,7 @@ class MarbleLocale;
 class GpsInfo : public AbstractFloatItem
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.GpsInfo")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.GpsInfo" FILE "GpsInfo.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(GpsInfo)
 
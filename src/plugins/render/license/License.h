@@ -24,7 +24,7 @@ class WidgetGraphicsItem;
 class License : public AbstractFloatItem
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.License")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.License" FILE "License.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(License)
 public:
@@ -30,7 +30,7 @@ class MeasureConfigDialog;
 class MeasureToolPlugin : public RenderPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.MeasureToolPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.MeasureToolPlugin" FILE "MeasureToolPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(MeasureToolPlugin)
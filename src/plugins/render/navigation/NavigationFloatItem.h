@@ -31,7 +31,7 @@ class WidgetGraphicsItem;
 class NavigationFloatItem : public AbstractFloatItem
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.NavigationFloatItem")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.NavigationFloatItem" FILE "NavigationFloatItem.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
 
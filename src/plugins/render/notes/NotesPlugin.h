@@ -14,7 +14,7 @@ namespace Marble
 class NotesPlugin : public AbstractDataPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.NotesPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.NotesPlugin" FILE "NotesPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(NotesPlugin)
 
@@ -22,7 +22,7 @@ const int defaultItemsOnScreen = 15;
 class OpenDesktopPlugin : public AbstractDataPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.OpenDesktopPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.OpenDesktopPlugin" FILE "OpenDesktopPlugin.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
@@ -32,7 +32,7 @@ namespace Marble
 class OverviewMap : public AbstractFloatItem, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.OverviewMap")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.OverviewMap" FILE "OverviewMap.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(OverviewMap)
@@ -22,7 +22,7 @@ namespace Marble
 class PhotoPlugin : public AbstractDataPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.PhotoPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.PhotoPlugin" FILE "PhotoPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(PhotoPlugin)
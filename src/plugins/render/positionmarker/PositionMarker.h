@@ -30,7 +30,7 @@ namespace Marble
 class PositionMarker : public RenderPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.PositionMarker")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.PositionMarker" FILE "PositionMarker.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(PositionMarker)
@@ -14,7 +14,7 @@ namespace Marble
 class PostalCodePlugin : public AbstractDataPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.PostalCodePlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.PostalCodePlugin" FILE "PostalCodePlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(PostalCodePlugin)
 
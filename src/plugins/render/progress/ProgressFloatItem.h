@@ -22,7 +22,7 @@ namespace Marble
 class ProgressFloatItem : public AbstractFloatItem
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.ProgressFloatItem")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.ProgressFloatItem" FILE "ProgressFloatItem.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
 
@@ -18,7 +18,7 @@ class PositionProviderPlugin;
 class RoutingPlugin : public AbstractFloatItem, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.RoutingPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.RoutingPlugin" FILE "RoutingPlugin.json")
 
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
@@ -21,6 +21,8 @@
 #include <planetarySats.h>
 #include <sgp4io.h>
 
+#include <QtConcurrentMap>
+
 #include <clocale>
 
 namespace Marble
@@ -30,9 +32,19 @@ SatellitesModel::SatellitesModel(GeoDataTreeModel *treeModel, const MarbleClock
     : TrackerPluginModel(treeModel)
     , m_clock(clock)
     , m_currentColorIndex(0)
+    , m_updatePending(false)
 {
     setupColors();
-    connect(m_clock, SIGNAL(timeChanged()), this, SLOT(update()));
+    connect(m_clock, SIGNAL(timeChanged()), this, SLOT(updateItems()));
+    connect(&m_propagationWatcher, SIGNAL(resultsReadyAt(int, int)), this, SLOT(addPropagationResults(int, int)));
+    connect(&m_propagationWatcher, SIGNAL(finished()), this, SLOT(finishPropagation()));
+    // Items may be deleted while they are updated
+    connect(this, SIGNAL(itemUpdateStarted()), this, SLOT(cancelPropagation()));
+}
+
+SatellitesModel::~SatellitesModel()
+{
+    cancelPropagation();
 }
 
 void SatellitesModel::setupColors()
@@ -104,14 +116,79 @@ void SatellitesModel::updateVisibility()
             // TLE satellites are always earth satellites
             bool enabled = (m_lcPlanet == QLatin1StringView("earth"));
             eItem->setEnabled(enabled);
-
-            if (enabled) {
-                eItem->update();
-            }
         }
     }
 
     endUpdateItems();
+
+    updateItems();
+}
+
+void SatellitesModel::updateItems()
+{
+    if (m_propagationWatcher.isRunning()) {
+        // Catch up with the clock once the running propagation is finished
+        m_updatePending = true;
+        return;
+    }
+    m_updatePending = false;
+
+    QList<SatellitesTLEItem::Propagation> propagations;
+    for (TrackerPluginItem *obj : items()) {
+        auto eItem = dynamic_cast<SatellitesTLEItem *>(obj);
+        if (eItem == nullptr) {
+            obj->update();
+            continue;
+        }
+
+        SatellitesTLEItem::Propagation propagation = eItem->prepareUpdate();
+        if (!propagation.times.isEmpty()) {
+            propagations << propagation;
+        }
+    }
+
+    if (propagations.isEmpty()) {
+        return;
+    }
+
+    m_propagationWatcher.setFuture(QtConcurrent::mapped(propagations, [](const SatellitesTLEItem::Propagation &propagation) {
+        SatellitesTLEItem::Propagation result = propagation;
+        SatellitesTLEItem::propagate(result);
+        return result;
+    }));
+}
+
+void SatellitesModel::addPropagationResults(int begin, int end)
+{
+    for (int i = begin; i < end; ++i) {
+        const SatellitesTLEItem::Propagation propagation = m_propagationWatcher.resultAt(i);
+        propagation.item->addPoints(propagation);
+    }
+
+    Q_EMIT tracksUpdated();
+}
+
+void SatellitesModel::finishPropagation()
+{
+    if (m_updatePending) {
+        updateItems();
+    }
+}
+
+void SatellitesModel::cancelPropagation()
+{
+    if (!m_propagationWatcher.isRunning()) {
+        return;
+    }
+
+    // Results that were not delivered yet refer to items that may be gone
+    m_propagationWatcher.disconnect(this);
+    m_propagationWatcher.cancel();
+    m_propagationWatcher.waitForFinished();
+    m_propagationWatcher.setFuture(QFuture<SatellitesTLEItem::Propagation>());
+    connect(&m_propagationWatcher, SIGNAL(resultsReadyAt(int, int)), this, SLOT(addPropagationResults(int, int)));
+    connect(&m_propagationWatcher, SIGNAL(finished()), this, SLOT(finishPropagation()));
+    m_updatePending = false;
 }
 
 void SatellitesModel::parseFile(const QString &id, const QByteArray &data)
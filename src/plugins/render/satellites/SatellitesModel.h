@@ -6,9 +6,11 @@
 #ifndef MARBLE_SATELLITESMODEL_H
 #define MARBLE_SATELLITESMODEL_H
 
+#include <QFutureWatcher>
 #include <QList>
 #include <QStringList>
 
+#include "SatellitesTLEItem.h"
 #include "TrackerPluginModel.h"
 
 class QVariant;
@@ -26,6 +28,7 @@ class SatellitesModel : public TrackerPluginModel
     Q_OBJECT
 public:
     SatellitesModel(GeoDataTreeModel *treeModel, const MarbleClock *clock);
+    ~SatellitesModel() override;
 
     void loadSettings(const QHash<QString, QVariant> &settings);
     void setPlanet(const QString &lcPlanet);
@@ -33,6 +36,12 @@ public:
 
     void parseFile(const QString &id, const QByteArray &file) override;
 
+Q_SIGNALS:
+    /**
+     * Emitted when new points were added to the satellite tracks
+     */
+    void tracksUpdated();
+
 protected:
     /**
      * Parse the Marble Satellite Catalog @p id with content @p data.
@@ -45,6 +54,18 @@ protected:
      */
     void parseTLE(const QString &id, const QByteArray &data);
 
+private Q_SLOTS:
+    /**
+     * Updates all items for the current time. The orbits of TLE satellites
+     * are propagated in the global thread pool and added to their tracks as
+     * the results come in.
+     */
+    void updateItems();
+
+    void addPropagationResults(int begin, int end);
+    void finishPropagation();
+    void cancelPropagation();
+
 private:
     void setupColors();
     QColor nextColor();
@@ -55,6 +76,9 @@ private:
     QString m_lcPlanet;
     QList<QColor> m_colorList;
     int m_currentColorIndex;
+    QFutureWatcher<SatellitesTLEItem::Propagation> m_propagationWatcher;
+    // Whether the clock changed while a propagation was running
+    bool m_updatePending;
 };
 
 } // namespace Marble
@@ -146,6 +146,7 @@ void SatellitesPlugin::initialize()
 
     connect(m_satModel, SIGNAL(fileParsed(QString)), SLOT(dataSourceParsed(QString)));
     connect(m_satModel, SIGNAL(fileParsed(QString)), SLOT(updateDataSourceConfig(QString)));
+    connect(m_satModel, SIGNAL(tracksUpdated()), SIGNAL(repaintNeeded()));
     connect(m_configDialog, SIGNAL(dataSourcesReloadRequested()), SLOT(updateSettings()));
     connect(m_configDialog, SIGNAL(accepted()), SLOT(writeSettings()));
     connect(m_configDialog, SIGNAL(rejected()), SLOT(readSettings()));
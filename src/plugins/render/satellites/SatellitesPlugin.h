@@ -26,7 +26,7 @@ class SatellitesConfigModel;
 class SatellitesPlugin : public RenderPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.SatellitesPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.SatellitesPlugin" FILE "SatellitesPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(SatellitesPlugin)
@@ -33,6 +33,7 @@ SatellitesTLEItem::SatellitesTLEItem(const QString &name, elsetrec satrec, const
     double radiusearthkm;
     getgravconst(wgs84, tumin, mu, radiusearthkm, xke, j2, j3, j4, j3oj2);
     m_earthSemiMajorAxis = radiusearthkm;
+    m_epoch = timeAtEpoch().toSecsSinceEpoch();
 
     setDescription();
 
@@ -65,8 +66,16 @@ void SatellitesTLEItem::setDescription()
 
 void SatellitesTLEItem::update()
 {
+    Propagation propagation = prepareUpdate();
+    propagate(propagation);
+    addPoints(propagation);
+}
+
+SatellitesTLEItem::Propagation SatellitesTLEItem::prepareUpdate()
+{
+    Propagation propagation;
     if (!isEnabled()) {
-        return;
+        return propagation;
     }
 
     QDateTime startTime = m_clock->dateTime();
@@ -79,35 +88,67 @@ void SatellitesTLEItem::update()
     m_track->removeBefore(startTime);
     m_track->removeAfter(endTime);
 
-    addPointAt(m_clock->dateTime());
+    propagation.item = this;
+    propagation.satrec = m_satrec;
+    propagation.earthSemiMajorAxis = m_earthSemiMajorAxis;
+    propagation.epoch = m_epoch;
+
+    const qint64 now = m_clock->dateTime().toSecsSinceEpoch();
+    propagation.times << now;
+
+    // Time span covered by the track once the points computed so far are added
+    qint64 first = m_track->size() == 0 ? now : qMin(m_track->firstWhen().toSecsSinceEpoch(), now);
+    qint64 last = m_track->size() == 0 ? now : qMax(m_track->lastWhen().toSecsSinceEpoch(), now);
 
     // time interval between each point in the track, in seconds
     double step = period() / 100.0;
 
     for (double i = startTime.toSecsSinceEpoch(); i < endTime.toSecsSinceEpoch(); i += step) {
         // No need to add points in this interval
-        if (i >= m_track->firstWhen().toSecsSinceEpoch()) {
-            i = m_track->lastWhen().toSecsSinceEpoch() + step;
+        if (i >= first) {
+            i = last + step;
         }
 
-        addPointAt(QDateTime::fromSecsSinceEpoch(i));
+        const qint64 time = i;
+        propagation.times << time;
+        first = qMin(first, time);
+        last = qMax(last, time);
     }
+
+    return propagation;
 }
 
-void SatellitesTLEItem::addPointAt(const QDateTime &dateTime)
+void SatellitesTLEItem::propagate(Propagation &propagation)
 {
-    // in minutes
-    double timeSinceEpoch = (double)(dateTime.toSecsSinceEpoch() - timeAtEpoch().toSecsSinceEpoch()) / 60.0;
+    propagation.points.reserve(propagation.times.size());
+    for (const qint64 time : std::as_const(propagation.times)) {
+        // in minutes
+        double timeSinceEpoch = (double)(time - propagation.epoch) / 60.0;
+
+        double r[3], v[3];
+        sgp4(wgs84, propagation.satrec, timeSinceEpoch, r, v);
+        if (propagation.satrec.error != 0) {
+            continue;
+        }
 
-    double r[3], v[3];
-    sgp4(wgs84, m_satrec, timeSinceEpoch, r, v);
+        const GeoDataCoordinates coordinates =
+            fromTEME(propagation.satrec, propagation.earthSemiMajorAxis, r[0], r[1], r[2], gmst(propagation.satrec, timeSinceEpoch));
+        propagation.points << Propagation::Point{time, coordinates};
+    }
+}
 
-    GeoDataCoordinates coordinates = fromTEME(r[0], r[1], r[2], gmst(timeSinceEpoch));
-    if (m_satrec.error != 0) {
+void SatellitesTLEItem::addPoints(const Propagation &propagation)
+{
+    if (propagation.item != this) {
         return;
     }
 
-    m_track->addPoint(dateTime, coordinates);
+    // Keep the state of the deep space integrator for the next propagation
+    m_satrec = propagation.satrec;
+
+    for (const Propagation::Point &point : propagation.points) {
+        m_track->addPoint(QDateTime::fromSecsSinceEpoch(point.time), point.coordinates);
+    }
 }
 
 QDateTime SatellitesTLEItem::timeAtEpoch() const
@@ -149,7 +190,7 @@ double SatellitesTLEItem::inclination() const
     return m_satrec.inclo / M_PI * 180;
 }
 
-GeoDataCoordinates SatellitesTLEItem::fromTEME(double x, double y, double z, double gmst) const
+GeoDataCoordinates SatellitesTLEItem::fromTEME(const elsetrec &satrec, double earthSemiMajorAxis, double x, double y, double z, double gmst)
 {
     double lon = atan2(y, x);
     // Rotate the angle by gmst (the origin goes from the vernal equinox
@@ -161,13 +202,13 @@ GeoDataCoordinates SatellitesTLEItem::fromTEME(double x, double y, double z, dou
     // TODO: determine if this is worth the extra precision
     //  Algorithm from https://celestrak.com/columns/v02n03/
     // TODO: demonstrate it.
-    double a = m_earthSemiMajorAxis;
+    double a = earthSemiMajorAxis;
     double planetRadius = sqrt(x * x + y * y);
     double latp = lat;
     double C;
     for (int i = 0; i < 3; i++) {
-        C = 1 / sqrt(1 - square(m_satrec.ecco * sin(latp)));
-        lat = atan2(z + a * C * square(m_satrec.ecco) * sin(latp), planetRadius);
+        C = 1 / sqrt(1 - square(satrec.ecco * sin(latp)));
+        lat = atan2(z + a * C * square(satrec.ecco) * sin(latp), planetRadius);
     }
 
     double alt = planetRadius / cos(lat) - a * C;
@@ -177,11 +218,11 @@ GeoDataCoordinates SatellitesTLEItem::fromTEME(double x, double y, double z, dou
     return {lon, lat, alt * 1000};
 }
 
-double SatellitesTLEItem::gmst(double minutesP) const
+double SatellitesTLEItem::gmst(const elsetrec &satrec, double minutesP)
 {
     // Earth rotation rate in rad/min, from sgp4io.cpp
     double rptim = 4.37526908801129966e-3;
-    return fmod(m_satrec.gsto + rptim * minutesP, 2 * M_PI);
+    return fmod(satrec.gsto + rptim * minutesP, 2 * M_PI);
 }
 
 double SatellitesTLEItem::square(double x)
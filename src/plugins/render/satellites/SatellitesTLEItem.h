@@ -6,8 +6,11 @@
 #ifndef MARBLE_SATELLITESTLEITEM_H
 #define MARBLE_SATELLITESTLEITEM_H
 
+#include "GeoDataCoordinates.h"
 #include "TrackerPluginItem.h"
 
+#include <QList>
+
 #include <sgp4unit.h>
 
 class QColor;
@@ -16,7 +19,6 @@ class QDateTime;
 namespace Marble
 {
 
-class GeoDataCoordinates;
 class GeoDataTrack;
 class MarbleClock;
 
@@ -27,13 +29,50 @@ class MarbleClock;
 class SatellitesTLEItem : public TrackerPluginItem
 {
 public:
+    /**
+     * The track points of a satellite that still need to be computed. It
+     * holds a copy of the orbital elements, so propagate() does not access
+     * the item and can run in a worker thread.
+     */
+    struct Propagation {
+        struct Point {
+            qint64 time; // in seconds since 1970-01-01T00:00:00 UTC
+            GeoDataCoordinates coordinates;
+        };
+
+        SatellitesTLEItem *item = nullptr;
+        elsetrec satrec = {};
+        double earthSemiMajorAxis = 0.0; // in km
+        qint64 epoch = 0; // in seconds since 1970-01-01T00:00:00 UTC
+        QList<qint64> times; // in seconds since 1970-01-01T00:00:00 UTC
+        QList<Point> points; // the results of propagate()
+    };
+
     SatellitesTLEItem(const QString &name, elsetrec satrec, const MarbleClock *clock);
 
     void update() override;
 
+    /**
+     * Removes the track points outside of the current orbit window and
+     * returns the missing ones. The result is empty if the item is disabled.
+     */
+    Propagation prepareUpdate();
+
+    /**
+     * Computes the coordinates of the satellite at all times of @p propagation.
+     * This is thread-safe.
+     */
+    static void propagate(Propagation &propagation);
+
+    /**
+     * Adds the points computed by propagate() to the track.
+     */
+    void addPoints(const Propagation &propagation);
+
 private:
     double m_earthSemiMajorAxis; // in km
     elsetrec m_satrec;
+    qint64 m_epoch; // in seconds since 1970-01-01T00:00:00 UTC
 
     GeoDataTrack *m_track = nullptr;
 
@@ -41,19 +80,13 @@ private:
 
     void setDescription();
 
-    /**
-     * Add a point in the GeoDataTrack geometry of the placemark with time
-     * dateTime and coordinates of the satellite determined from m_satrec.
-     */
-    void addPointAt(const QDateTime &dateTime);
-
     /**
      * Create a GeoDataCoordinates object from the cartesian coordinates
      * @p x, @p y and @p z in km in the Earth-centered inertial frame known
      * as TEME (True equator, Mean equinox) with Greenwich Mean Sidereal Time
      * @p gmst in radians at time of observation.
      */
-    GeoDataCoordinates fromTEME(double x, double y, double z, double gmst) const;
+    static GeoDataCoordinates fromTEME(const elsetrec &satrec, double earthSemiMajorAxis, double x, double y, double z, double gmst);
 
     /**
      * @return The time at the satellite epoch determined from m_satrec
@@ -85,9 +118,9 @@ private:
 
     /**
      * Returns the Greenwich Mean Sideral Time in radians, @p minutes
-     * after the epoch.
+     * after the epoch of @p satrec.
      */
-    double gmst(double minutes) const;
+    static double gmst(const elsetrec &satrec, double minutes);
 
     /**
      * @return The square of @p x
@@ -29,7 +29,7 @@ class MarbleLocale;
 class Speedometer : public AbstractFloatItem
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.Speedometer")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.Speedometer" FILE "Speedometer.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(Speedometer)
 
@@ -124,7 +124,7 @@ class Constellation;
 class StarsPlugin : public RenderPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.StarsPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.StarsPlugin" FILE "StarsPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(StarsPlugin)
@@ -22,7 +22,7 @@ namespace Marble
 class SunPlugin : public RenderPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.SunPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.SunPlugin" FILE "SunPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(SunPlugin)
 public:
@@ -24,7 +24,7 @@ namespace Marble
 class WeatherPlugin : public AbstractDataPlugin, public DialogConfigurationInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.WeatherPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.WeatherPlugin" FILE "WeatherPlugin.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     Q_INTERFACES(Marble::DialogConfigurationInterface)
     MARBLE_PLUGIN(WeatherPlugin)
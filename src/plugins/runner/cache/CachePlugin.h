@@ -13,7 +13,7 @@ namespace Marble
 class CachePlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.CachePlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.CachePlugin" FILE "CachePlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
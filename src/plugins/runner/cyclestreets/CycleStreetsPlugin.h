@@ -14,7 +14,7 @@ namespace Marble
 class CycleStreetsPlugin : public RoutingRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.CycleStreetsPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.CycleStreetsPlugin" FILE "CycleStreetsPlugin.json")
     Q_INTERFACES(Marble::RoutingRunnerPlugin)
 
 public:
@@ -14,7 +14,7 @@ namespace Marble
 class GeoUriPlugin : public SearchRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.GeoUriPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.GeoUriPlugin" FILE "GeoUriPlugin.json")
     Q_INTERFACES(Marble::SearchRunnerPlugin)
 
 public:
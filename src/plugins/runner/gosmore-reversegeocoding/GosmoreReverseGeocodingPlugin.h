@@ -15,7 +15,7 @@ namespace Marble
 class GosmorePlugin : public ReverseGeocodingRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.GosmoreReverseGeocodingPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.GosmoreReverseGeocodingPlugin" FILE "GosmoreReverseGeocodingPlugin.json")
     Q_INTERFACES(Marble::ReverseGeocodingRunnerPlugin)
 
 public:
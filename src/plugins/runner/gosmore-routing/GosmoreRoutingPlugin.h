@@ -14,7 +14,7 @@ namespace Marble
 class GosmorePlugin : public RoutingRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.GosmoreRoutingPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.GosmoreRoutingPlugin" FILE "GosmoreRoutingPlugin.json")
     Q_INTERFACES(Marble::RoutingRunnerPlugin)
 
 public:
@@ -13,7 +13,7 @@ namespace Marble
 class GpsbabelPlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.GpsbabelPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.GpsbabelPlugin" FILE "GpsbabelPlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
@@ -14,7 +14,7 @@ namespace Marble
 class HostipPlugin : public SearchRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.HostipPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.HostipPlugin" FILE "HostipPlugin.json")
     Q_INTERFACES(Marble::SearchRunnerPlugin)
 
 public:
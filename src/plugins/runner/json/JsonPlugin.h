@@ -16,7 +16,7 @@ namespace Marble
 class JsonPlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.JsonPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.JsonPlugin" FILE "JsonPlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
@@ -13,7 +13,7 @@ namespace Marble
 class KmlPlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.KmlPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.KmlPlugin" FILE "KmlPlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
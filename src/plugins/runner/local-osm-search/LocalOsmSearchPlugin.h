@@ -18,7 +18,7 @@ namespace Marble
 class LocalOsmSearchPlugin : public SearchRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.LocalOsmSearchPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.LocalOsmSearchPlugin" FILE "LocalOsmSearchPlugin.json")
     Q_INTERFACES(Marble::SearchRunnerPlugin)
 
 public:
@@ -14,7 +14,7 @@ namespace Marble
 class LocalDatabasePlugin : public SearchRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.LocalDatabasePlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.LocalDatabasePlugin" FILE "LocalDatabasePlugin.json")
     Q_INTERFACES(Marble::SearchRunnerPlugin)
 
 public:
@@ -13,7 +13,7 @@ namespace Marble
 class LogfilePlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.LogPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.LogPlugin" FILE "LogPlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
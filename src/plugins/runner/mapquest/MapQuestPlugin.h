@@ -14,7 +14,7 @@ namespace Marble
 class MapQuestPlugin : public RoutingRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.MapQuestPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.MapQuestPlugin" FILE "MapQuestPlugin.json")
     Q_INTERFACES(Marble::RoutingRunnerPlugin)
 
 public:
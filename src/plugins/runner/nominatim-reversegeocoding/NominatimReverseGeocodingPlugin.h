@@ -15,7 +15,7 @@ namespace Marble
 class NominatimPlugin : public ReverseGeocodingRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.NominatimReverseGeocodingPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.NominatimReverseGeocodingPlugin" FILE "NominatimReverseGeocodingPlugin.json")
     Q_INTERFACES(Marble::ReverseGeocodingRunnerPlugin)
 
 public:
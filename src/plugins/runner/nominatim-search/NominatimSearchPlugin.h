@@ -15,7 +15,7 @@ namespace Marble
 class NominatimPlugin : public SearchRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.NominatimSearchPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.NominatimSearchPlugin" FILE "NominatimSearchPlugin.json")
     Q_INTERFACES(Marble::SearchRunnerPlugin)
 
 public:
@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "ContractionHierarchy.h"
+
+#include "GeoDataCoordinates.h"
+#include "GeoDataLatLonBox.h"
+#include "MarbleDebug.h"
+#include "MarbleGlobal.h"
+
+#include <QHash>
+#include <QtMath>
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace Marble
+{
+
+namespace
+{
+const int GridRows = 18000;
+const int GridColumns = 36000;
+const qint64 CellUnits = 100000; // CellSize in 1e-7 degree
+const int MaximumRing = 100;
+}
+
+ContractionHierarchy::ContractionHierarchy()
+    : m_header(nullptr)
+    , m_firstEdge(nullptr)
+    , m_edges(nullptr)
+    , m_coordinates(nullptr)
+    , m_cells(nullptr)
+    , m_ways(nullptr)
+    , m_degrees(nullptr)
+    , m_strings(nullptr)
+{
+    // nothing to do
+}
+
+ContractionHierarchy::~ContractionHierarchy() = default;
+
+bool ContractionHierarchy::load(const QString &fileName)
+{
+    m_header = nullptr;
+    m_file.close();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly) || m_file.size() < qint64(sizeof(Header))) {
+        return false;
+    }
+
+    const uchar *data = m_file.map(0, m_file.size());
+    if (!data) {
+        mDebug() << "Cannot map" << fileName << m_file.errorString();
+        return false;
+    }
+
+    const auto header = reinterpret_cast<const Header *>(data);
+    if (header->magic != Magic || header->version != Version) {
+        mDebug() << fileName << "is not a compatible routing graph";
+        return false;
+    }
+
+    const qint64 nodes = header->nodeCount;
+    const qint64 expectedSize = sizeof(Header) + (nodes + 1) * sizeof(quint32) + qint64(header->edgeCount) * sizeof(Edge) + 2 * nodes * sizeof(qint32)
+        + nodes * sizeof(quint32) + qint64(header->wayCount) * sizeof(Way) + nodes * sizeof(quint8) + header->stringSize;
+    if (m_file.size() != expectedSize || (header->stringSize > 0 && data[expectedSize - 1] != '\0')) {
+        mDebug() << fileName << "has an unexpected size";
+        return false;
+    }
+
+    data += sizeof(Header);
+    m_firstEdge = reinterpret_cast<const quint32 *>(data);
+    data += (nodes + 1) * sizeof(quint32);
+    m_edges = reinterpret_cast<const Edge *>(data);
+    data += qint64(header->edgeCount) * sizeof(Edge);
+    m_coordinates = reinterpret_cast<const qint32 *>(data);
+    data += 2 * nodes * sizeof(qint32);
+    m_cells = reinterpret_cast<const quint32 *>(data);
+    data += nodes * sizeof(quint32);
+    m_ways = reinterpret_cast<const Way *>(data);
+    data += qint64(header->wayCount) * sizeof(Way);
+    m_degrees = data;
+    data += nodes * sizeof(quint8);
+    m_strings = reinterpret_cast<const char *>(data);
+    m_header = header;
+    return true;
+}
+
+bool ContractionHierarchy::isValid() const
+{
+    return m_header != nullptr;
+}
+
+const ContractionHierarchy::Header &ContractionHierarchy::header() const
+{
+    Q_ASSERT(isValid());
+    return *m_header;
+}
+
+quint32 ContractionHierarchy::nodeCount() const
+{
+    return m_header ? m_header->nodeCount : 0;
+}
+
+GeoDataCoordinates ContractionHierarchy::coordinates(quint32 node) const
+{
+    Q_ASSERT(node < nodeCount());
+    return GeoDataCoordinates(m_coordinates[2 * node + 1] * 1.0e-7, m_coordinates[2 * node] * 1.0e-7, 0.0, GeoDataCoordinates::Degree);
+}
+
+GeoDataLatLonBox ContractionHierarchy::boundingBox() const
+{
+    if (!isValid() || nodeCount() == 0) {
+        return GeoDataLatLonBox();
+    }
+    return GeoDataLatLonBox(m_header->north * 1.0e-7, m_header->south * 1.0e-7, m_header->east * 1.0e-7, m_header->west * 1.0e-7, GeoDataCoordinates::Degree);
+}
+
+bool ContractionHierarchy::isJunction(quint32 node) const
+{
+    Q_ASSERT(node < nodeCount());
+    return m_degrees[node] > 2;
+}
+
+QString ContractionHierarchy::wayName(quint32 way) const
+{
+    return isValid() && way < m_header->wayCount ? string(m_ways[way].name) : QString();
+}
+
+QString ContractionHierarchy::wayType(quint32 way) const
+{
+    if (!isValid() || way >= m_header->wayCount) {
+        return {};
+    }
+    return m_ways[way].flags & Roundabout ? QStringLiteral("roundabout") : string(m_ways[way].type);
+}
+
+QString ContractionHierarchy::string(quint32 offset) const
+{
+    return offset < m_header->stringSize ? QString::fromUtf8(m_strings + offset) : QString();
+}
+
+quint32 ContractionHierarchy::cellIndex(qint32 latitude, qint32 longitude)
+{
+    const int row = qBound<qint64>(0, (qint64(latitude) + 900000000) / CellUnits, GridRows - 1);
+    const int column = qBound<qint64>(0, (qint64(longitude) + 1800000000) / CellUnits, GridColumns - 1);
+    return quint32(row) * GridColumns + quint32(column);
+}
+
+quint32 ContractionHierarchy::nearestNode(const GeoDataCoordinates &position, qreal *distance) const
+{
+    if (!isValid() || nodeCount() == 0) {
+        return InvalidNode;
+    }
+
+    const qint32 latitude = qRound(position.latitude(GeoDataCoordinates::Degree) * 1.0e7);
+    const qint32 longitude = qRound(position.longitude(GeoDataCoordinates::Degree) * 1.0e7);
+    const quint32 center = cellIndex(latitude, longitude);
+    const int row = center / GridColumns;
+    const int column = center % GridColumns;
+
+    // Distances are compared in an equirectangular approximation, which is good
+    // enough within the few kilometers the search covers.
+    const qreal cosLatitude = qMax<qreal>(qCos(position.latitude()), 0.01);
+    const qreal cellExtent = CellSize * DEG2RAD * EARTH_RADIUS * cosLatitude;
+    const qreal unitToMeters = 1.0e-7 * DEG2RAD * EARTH_RADIUS;
+
+    quint32 result = InvalidNode;
+    qreal best = std::numeric_limits<qreal>::max();
+    const quint32 *const cellsEnd = m_cells + nodeCount();
+    for (int ring = 0; ring <= MaximumRing; ++ring) {
+        // Nodes in this ring are at least (ring - 1) cells away from the position
+        if (result != InvalidNode && (ring - 1) * cellExtent > best) {
+            break;
+        }
+
+        for (int r = row - ring; r <= row + ring; ++r) {
+            if (r < 0 || r >= GridRows) {
+                continue;
+            }
+            const bool isOuterRow = qAbs(r - row) == ring;
+            const int step = isOuterRow || ring == 0 ? 1 : 2 * ring;
+            for (int c = column - ring; c <= column + ring; c += step) {
+                const quint32 cell = quint32(r) * GridColumns + quint32((c + GridColumns) % GridColumns);
+                for (const quint32 *it = std::lower_bound(m_cells, cellsEnd, cell); it != cellsEnd && *it == cell; ++it) {
+                    const quint32 node = it - m_cells;
+                    qint64 deltaLongitude = qint64(m_coordinates[2 * node + 1]) - longitude;
+                    if (deltaLongitude > 1800000000) {
+                        deltaLongitude -= 3600000000LL;
+                    } else if (deltaLongitude < -1800000000) {
+                        deltaLongitude += 3600000000LL;
+                    }
+                    const qreal x = deltaLongitude * unitToMeters * cosLatitude;
+                    const qreal y = (qint64(m_coordinates[2 * node]) - latitude) * unitToMeters;
+                    const qreal candidate = qSqrt(x * x + y * y);
+                    if (candidate < best) {
+                        best = candidate;
+                        result = node;
+                    }
+                }
+            }
+        }
+    }
+
+    if (distance && result != InvalidNode) {
+        *distance = position.sphericalDistanceTo(coordinates(result)) * EARTH_RADIUS;
+    }
+    return result;
+}
+
+QList<quint32> ContractionHierarchy::shortestPath(quint32 source, quint32 target, quint32 *duration, QList<quint32> *ways) const
+{
+    QList<quint32> path;
+    if (ways) {
+        ways->clear();
+    }
+    if (!isValid() || source >= nodeCount() || target >= nodeCount()) {
+        return path;
+    }
+
+    struct Label {
+        quint32 distance = 0;
+        quint32 parent = InvalidNode;
+        quint32 edge = InvalidNode;
+    };
+    using QueueEntry = std::pair<quint32, quint32>;
+    using Queue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+    QHash<quint32, Label> forwardLabels;
+    QHash<quint32, Label> backwardLabels;
+    Queue forwardQueue;
+    Queue backwardQueue;
+    forwardLabels.insert(source, Label());
+    forwardQueue.emplace(0, source);
+    backwardLabels.insert(target, Label());
+    backwardQueue.emplace(0, target);
+
+    const quint32 infinity = std::numeric_limits<quint32>::max();
+    quint32 best = infinity;
+    quint32 meetingNode = InvalidNode;
+
+    while (!forwardQueue.empty() || !backwardQueue.empty()) {
+        const quint32 forwardMinimum = forwardQueue.empty() ? infinity : forwardQueue.top().first;
+        const quint32 backwardMinimum = backwardQueue.empty() ? infinity : backwardQueue.top().first;
+        if (qMin(forwardMinimum, backwardMinimum) >= best) {
+            break;
+        }
+
+        const bool isForward = forwardMinimum <= backwardMinimum;
+        Queue &queue = isForward ? forwardQueue : backwardQueue;
+        QHash<quint32, Label> &labels = isForward ? forwardLabels : backwardLabels;
+        const QHash<quint32, Label> &otherLabels = isForward ? backwardLabels : forwardLabels;
+        const EdgeDirection direction = isForward ? Forward : Backward;
+
+        const quint32 distance = queue.top().first;
+        const quint32 node = queue.top().second;
+        queue.pop();
+        if (distance > labels.value(node).distance) {
+            continue;
+        }
+
+        const auto other = otherLabels.constFind(node);
+        if (other != otherLabels.constEnd() && distance + other->distance < best) {
+            best = distance + other->distance;
+            meetingNode = node;
+        }
+
+        for (quint32 i = m_firstEdge[node]; i < m_firstEdge[node + 1]; ++i) {
+            const Edge &edge = m_edges[i];
+            if (!(edge.direction & direction)) {
+                continue;
+            }
+            const quint32 candidate = distance + edge.weight;
+            auto label = labels.find(edge.target);
+            if (label == labels.end() || candidate < label->distance) {
+                Label &updated = label == labels.end() ? labels[edge.target] : *label;
+                updated.distance = candidate;
+                updated.parent = node;
+                updated.edge = i;
+                queue.emplace(candidate, edge.target);
+            }
+        }
+    }
+
+    if (meetingNode == InvalidNode) {
+        return path;
+    }
+
+    quint32 totalDuration = 0;
+    QList<quint32> upwards;
+    for (quint32 node = meetingNode; node != source; node = forwardLabels.value(node).parent) {
+        upwards << node;
+    }
+    path << source;
+    quint32 from = source;
+    for (auto it = upwards.crbegin(); it != upwards.crend(); ++it) {
+        const Edge &edge = m_edges[forwardLabels.value(*it).edge];
+        totalDuration += edge.duration;
+        unpackEdge(from, *it, edge, path, ways);
+        from = *it;
+    }
+    for (quint32 node = meetingNode; node != target;) {
+        const Label label = backwardLabels.value(node);
+        const Edge &edge = m_edges[label.edge];
+        totalDuration += edge.duration;
+        unpackEdge(node, label.parent, edge, path, ways);
+        node = label.parent;
+    }
+
+    if (duration) {
+        *duration = totalDuration;
+    }
+    return path;
+}
+
+const ContractionHierarchy::Edge *ContractionHierarchy::findEdge(quint32 node, quint32 target, EdgeDirection direction) const
+{
+    const Edge *result = nullptr;
+    for (quint32 i = m_firstEdge[node]; i < m_firstEdge[node + 1]; ++i) {
+        const Edge &edge = m_edges[i];
+        if (edge.target == target && (edge.direction & direction) && (!result || edge.weight < result->weight)) {
+            result = &edge;
+        }
+    }
+    return result;
+}
+
+void ContractionHierarchy::unpackEdge(quint32 from, quint32 to, const Edge &edge, QList<quint32> &path, QList<quint32> *ways) const
+{
+    struct Arc {
+        quint32 from;
+        quint32 to;
+        const Edge *edge;
+    };
+
+    // Shortcuts of a long motorway can be nested deeply, avoid recursion
+    std::vector<Arc> stack;
+    stack.push_back({from, to, &edge});
+    while (!stack.empty()) {
+        const Arc arc = stack.back();
+        stack.pop_back();
+        const quint32 middle = arc.edge->middle;
+        if (middle == InvalidNode) {
+            path << arc.to;
+            if (ways) {
+                *ways << arc.edge->way;
+            }
+            continue;
+        }
+
+        // Both halves of a shortcut are stored at the bypassed node, which has the lowest rank
+        const Edge *first = findEdge(middle, arc.from, Backward);
+        const Edge *second = findEdge(middle, arc.to, Forward);
+        if (!first || !second) {
+            mDebug() << "Inconsistent shortcut" << arc.from << middle << arc.to;
+            path << arc.to;
+            if (ways) {
+                *ways << InvalidWay;
+            }
+            continue;
+        }
+        stack.push_back({middle, arc.to, second});
+        stack.push_back({arc.from, middle, first});
+    }
+}
+
+}
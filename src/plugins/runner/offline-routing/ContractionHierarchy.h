@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_CONTRACTIONHIERARCHY_H
+#define MARBLE_CONTRACTIONHIERARCHY_H
+
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+namespace Marble
+{
+
+class GeoDataCoordinates;
+class GeoDataLatLonBox;
+
+/**
+ * A read-only, memory-mapped contraction hierarchy graph.
+ *
+ * Every node only stores the edges leading to nodes of a higher rank. Shortest
+ * paths are found with a bidirectional Dijkstra search that only goes upwards,
+ * which settles a few hundred nodes even on continental graphs. Shortcut edges
+ * remember the node they bypass so that paths can be unpacked into the
+ * original road network.
+ *
+ * The file is created by ContractionHierarchyBuilder. Nodes are stored sorted
+ * by a regular lat/lon grid cell, which allows a binary search to find the
+ * node closest to a given position. Original edges refer to the way they were
+ * created from, which provides the road names and types for turn instructions.
+ */
+class ContractionHierarchy
+{
+public:
+    enum EdgeDirection {
+        Forward = 0x1, ///< The edge leads from the node it is stored at to its target
+        Backward = 0x2 ///< The edge leads from its target to the node it is stored at
+    };
+
+    struct Edge {
+        quint32 target;
+        quint32 weight;
+        quint32 duration; ///< in tenths of a second
+        quint32 middle; ///< the bypassed node of a shortcut, InvalidNode otherwise
+        quint32 direction;
+        quint32 way; ///< the way of an original edge, InvalidWay for shortcuts
+    };
+
+    enum WayFlag {
+        Roundabout = 0x1
+    };
+
+    struct Way {
+        quint32 name; ///< offset of the name in the string table
+        quint32 type; ///< offset of the highway type in the string table
+        quint32 flags;
+    };
+
+    struct Header {
+        quint32 magic;
+        quint32 version;
+        quint32 nodeCount;
+        quint32 edgeCount;
+        quint32 wayCount;
+        quint32 stringSize;
+        /// Bounding box of all nodes in 1e-7 degree
+        qint32 south;
+        qint32 west;
+        qint32 north;
+        qint32 east;
+        qint64 sourceSize;
+        qint64 sourceModified;
+    };
+
+    static constexpr quint32 Magic = 0x4d434831; // "MCH1"
+    static constexpr quint32 Version = 2;
+    static constexpr quint32 InvalidNode = 0xffffffff;
+    static constexpr quint32 InvalidWay = 0xffffffff;
+
+    /** Size of a grid cell of the spatial node index in degree */
+    static constexpr double CellSize = 0.01;
+
+    ContractionHierarchy();
+
+    ~ContractionHierarchy();
+
+    /**
+     * Maps the given graph file into memory. Returns false if the file cannot be
+     * read or was not created by a compatible ContractionHierarchyBuilder.
+     */
+    bool load(const QString &fileName);
+
+    bool isValid() const;
+
+    const Header &header() const;
+
+    quint32 nodeCount() const;
+
+    GeoDataCoordinates coordinates(quint32 node) const;
+
+    /** The area covered by the graph */
+    GeoDataLatLonBox boundingBox() const;
+
+    /** Whether more than two road segments meet at the given node */
+    bool isJunction(quint32 node) const;
+
+    QString wayName(quint32 way) const;
+
+    /** The OSM highway type of the given way, or "roundabout" for roundabouts */
+    QString wayType(quint32 way) const;
+
+    /**
+     * Returns the node closest to the given position, or InvalidNode if there
+     * is none within the search radius. If distance is given, it is set to the
+     * distance between both in meters.
+     */
+    quint32 nearestNode(const GeoDataCoordinates &position, qreal *distance = nullptr) const;
+
+    /**
+     * Returns the nodes of the shortest path from source to target, including
+     * both. The list is empty if target cannot be reached. The summed up edge
+     * durations are written to duration if given. If ways is given, it is set
+     * to the way of each path segment, i.e. it has one entry less than the path.
+     */
+    QList<quint32> shortestPath(quint32 source, quint32 target, quint32 *duration = nullptr, QList<quint32> *ways = nullptr) const;
+
+    static quint32 cellIndex(qint32 latitude, qint32 longitude);
+
+private:
+    Q_DISABLE_COPY(ContractionHierarchy)
+
+    const Edge *findEdge(quint32 node, quint32 target, EdgeDirection direction) const;
+
+    void unpackEdge(quint32 from, quint32 to, const Edge &edge, QList<quint32> &path, QList<quint32> *ways) const;
+
+    QString string(quint32 offset) const;
+
+    QFile m_file;
+    const Header *m_header;
+    const quint32 *m_firstEdge;
+    const Edge *m_edges;
+    const qint32 *m_coordinates;
+    const quint32 *m_cells;
+    const Way *m_ways;
+    const quint8 *m_degrees;
+    const char *m_strings;
+};
+
+}
+
+#endif
@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "ContractionHierarchyBuilder.h"
+
+#include "GeoDataCoordinates.h"
+#include "MarbleDebug.h"
+
+#include <QAtomicInt>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace Marble
+{
+
+namespace
+{
+const quint32 Infinity = std::numeric_limits<quint32>::max();
+
+// Settled node limits of the witness searches. Lower limits speed up the
+// preprocessing at the cost of a few superfluous shortcuts.
+const int SimulationSettledLimit = 50;
+const int ContractionSettledLimit = 500;
+
+template<typename T>
+bool writeArray(QSaveFile &file, const std::vector<T> &array)
+{
+    const qint64 size = qint64(array.size() * sizeof(T));
+    return file.write(reinterpret_cast<const char *>(array.data()), size) == size;
+}
+}
+
+ContractionHierarchyBuilder::ContractionHierarchyBuilder()
+    : m_isContracted(false)
+{
+    // nothing to do
+}
+
+quint32 ContractionHierarchyBuilder::addNode(qint32 latitude, qint32 longitude)
+{
+    Q_ASSERT(!m_isContracted);
+    m_coordinates.push_back(latitude);
+    m_coordinates.push_back(longitude);
+    m_outArcs.emplace_back();
+    m_inArcs.emplace_back();
+    return quint32(m_outArcs.size() - 1);
+}
+
+quint32 ContractionHierarchyBuilder::addWay(const QString &name, const QString &type, bool isRoundabout)
+{
+    Q_ASSERT(!m_isContracted);
+    m_ways.push_back({addString(name), addString(type), isRoundabout ? quint32(ContractionHierarchy::Roundabout) : 0u});
+    return quint32(m_ways.size() - 1);
+}
+
+quint32 ContractionHierarchyBuilder::addString(const QString &string)
+{
+    const auto it = m_stringOffsets.constFind(string);
+    if (it != m_stringOffsets.constEnd()) {
+        return *it;
+    }
+    const quint32 offset = quint32(m_strings.size());
+    m_strings += string.toUtf8();
+    m_strings += '\0';
+    m_stringOffsets.insert(string, offset);
+    return offset;
+}
+
+void ContractionHierarchyBuilder::addArc(quint32 from, quint32 to, quint32 weight, quint32 duration, quint32 way)
+{
+    Q_ASSERT(!m_isContracted);
+    Q_ASSERT(from < nodeCount() && to < nodeCount());
+    Q_ASSERT(way == ContractionHierarchy::InvalidWay || way < m_ways.size());
+    if (from == to) {
+        return;
+    }
+
+    weight = qMax<quint32>(1, weight);
+    insertArc(m_outArcs[from], {to, weight, duration, ContractionHierarchy::InvalidNode, way});
+    insertArc(m_inArcs[to], {from, weight, duration, ContractionHierarchy::InvalidNode, way});
+}
+
+quint32 ContractionHierarchyBuilder::nodeCount() const
+{
+    return quint32(m_coordinates.size() / 2);
+}
+
+GeoDataCoordinates ContractionHierarchyBuilder::coordinates(quint32 node) const
+{
+    Q_ASSERT(node < nodeCount());
+    return GeoDataCoordinates(m_coordinates[2 * node + 1] * 1.0e-7, m_coordinates[2 * node] * 1.0e-7, 0.0, GeoDataCoordinates::Degree);
+}
+
+bool ContractionHierarchyBuilder::insertArc(std::vector<Arc> &arcs, const Arc &arc)
+{
+    for (Arc &existing : arcs) {
+        if (existing.node == arc.node) {
+            if (existing.weight <= arc.weight) {
+                return false;
+            }
+            existing = arc;
+            return true;
+        }
+    }
+    arcs.push_back(arc);
+    return true;
+}
+
+void ContractionHierarchyBuilder::removeArc(std::vector<Arc> &arcs, quint32 node)
+{
+    arcs.erase(std::remove_if(arcs.begin(),
+                              arcs.end(),
+                              [node](const Arc &arc) {
+                                  return arc.node == node;
+                              }),
+               arcs.end());
+}
+
+bool ContractionHierarchyBuilder::contract(const QAtomicInt *canceled)
+{
+    Q_ASSERT(!m_isContracted);
+    const quint32 count = nodeCount();
+
+    // The number of distinct neighbors in the original road network tells junctions apart
+    m_degrees.assign(count, 0);
+    for (quint32 node = 0; node < count; ++node) {
+        int degree = int(m_outArcs[node].size());
+        for (const Arc &in : m_inArcs[node]) {
+            const bool isOutNeighbor = std::any_of(m_outArcs[node].cbegin(), m_outArcs[node].cend(), [&in](const Arc &out) {
+                return out.node == in.node;
+            });
+            if (!isOutNeighbor) {
+                ++degree;
+            }
+        }
+        m_degrees[node] = quint8(qMin(degree, 255));
+    }
+
+    m_upwardEdges.resize(count);
+    m_contractedNeighbors.assign(count, 0);
+    m_contracted.assign(count, false);
+    m_witnessDistance.assign(count, Infinity);
+
+    using QueueEntry = std::pair<int, quint32>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for (quint32 node = 0; node < count; ++node) {
+        queue.emplace(priority(node), node);
+    }
+
+    quint32 contracted = 0;
+    while (!queue.empty()) {
+        const quint32 node = queue.top().second;
+        queue.pop();
+        if (m_contracted[node]) {
+            continue;
+        }
+
+        // Lazy update: priorities only grow while neighbors get contracted
+        const int current = priority(node);
+        if (!queue.empty() && current > queue.top().first) {
+            queue.emplace(current, node);
+            continue;
+        }
+
+        contractNode(node);
+        ++contracted;
+        if (contracted % 1000 == 0 && canceled && canceled->loadRelaxed()) {
+            return false;
+        }
+        if (contracted % 100000 == 0) {
+            mDebug() << "Contracted" << contracted << "of" << count << "nodes";
+        }
+    }
+
+    m_outArcs.clear();
+    m_inArcs.clear();
+    m_witnessDistance.clear();
+    m_touched.clear();
+    m_isContracted = true;
+    return true;
+}
+
+int ContractionHierarchyBuilder::priority(quint32 node)
+{
+    const int degree = int(m_outArcs[node].size() + m_inArcs[node].size());
+    return processShortcuts(node, false) - degree + int(m_contractedNeighbors[node]);
+}
+
+int ContractionHierarchyBuilder::processShortcuts(quint32 node, bool apply)
+{
+    int shortcuts = 0;
+    const std::vector<Arc> &outArcs = m_outArcs[node];
+    for (const Arc &in : m_inArcs[node]) {
+        quint32 limit = 0;
+        for (const Arc &out : outArcs) {
+            if (out.node != in.node) {
+                limit = qMax(limit, in.weight + out.weight);
+            }
+        }
+        if (limit == 0) {
+            continue;
+        }
+
+        witnessSearch(in.node, node, limit, apply ? ContractionSettledLimit : SimulationSettledLimit);
+        for (const Arc &out : outArcs) {
+            const quint32 weight = in.weight + out.weight;
+            if (out.node == in.node || m_witnessDistance[out.node] <= weight) {
+                continue;
+            }
+            ++shortcuts;
+            if (apply) {
+                const Arc shortcut = {out.node, weight, in.duration + out.duration, node, ContractionHierarchy::InvalidWay};
+                if (insertArc(m_outArcs[in.node], shortcut)) {
+                    insertArc(m_inArcs[out.node], {in.node, weight, shortcut.duration, node, ContractionHierarchy::InvalidWay});
+                }
+            }
+        }
+    }
+    return shortcuts;
+}
+
+void ContractionHierarchyBuilder::contractNode(quint32 node)
+{
+    processShortcuts(node, true);
+
+    // All remaining neighbors get contracted later, i.e. have a higher rank
+    std::vector<ContractionHierarchy::Edge> &edges = m_upwardEdges[node];
+    edges.reserve(m_outArcs[node].size() + m_inArcs[node].size());
+    for (const Arc &out : m_outArcs[node]) {
+        edges.push_back({out.node, out.weight, out.duration, out.middle, ContractionHierarchy::Forward, out.way});
+        removeArc(m_inArcs[out.node], node);
+        ++m_contractedNeighbors[out.node];
+    }
+    for (const Arc &in : m_inArcs[node]) {
+        edges.push_back({in.node, in.weight, in.duration, in.middle, ContractionHierarchy::Backward, in.way});
+        removeArc(m_outArcs[in.node], node);
+        ++m_contractedNeighbors[in.node];
+    }
+
+    std::vector<Arc>().swap(m_outArcs[node]);
+    std::vector<Arc>().swap(m_inArcs[node]);
+    m_contracted[node] = true;
+}
+
+void ContractionHierarchyBuilder::witnessSearch(quint32 source, quint32 ignored, quint32 limit, int maximumSettled)
+{
+    for (quint32 node : m_touched) {
+        m_witnessDistance[node] = Infinity;
+    }
+    m_touched.clear();
+
+    using QueueEntry = std::pair<quint32, quint32>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    m_witnessDistance[source] = 0;
+    m_touched.push_back(source);
+    queue.emplace(0, source);
+
+    int settled = 0;
+    while (!queue.empty() && settled < maximumSettled) {
+        const quint32 distance = queue.top().first;
+        const quint32 node = queue.top().second;
+        queue.pop();
+        if (distance > m_witnessDistance[node]) {
+            continue;
+        }
+        if (distance > limit) {
+            break;
+        }
+        ++settled;
+
+        for (const Arc &arc : m_outArcs[node]) {
+            if (arc.node == ignored) {
+                continue;
+            }
+            const quint32 candidate = distance + arc.weight;
+            if (candidate < m_witnessDistance[arc.node]) {
+                if (m_witnessDistance[arc.node] == Infinity) {
+                    m_touched.push_back(arc.node);
+                }
+                m_witnessDistance[arc.node] = candidate;
+                queue.emplace(candidate, arc.node);
+            }
+        }
+    }
+}
+
+bool ContractionHierarchyBuilder::write(const QString &fileName, qint64 sourceSize, qint64 sourceModified) const
+{
+    Q_ASSERT(m_isContracted);
+    const quint32 count = quint32(m_upwardEdges.size());
+
+    // Sort the nodes by grid cell, which provides the spatial index and keeps
+    // nearby nodes close in memory as well
+    std::vector<quint32> cells(count);
+    for (quint32 node = 0; node < count; ++node) {
+        cells[node] = ContractionHierarchy::cellIndex(m_coordinates[2 * node], m_coordinates[2 * node + 1]);
+    }
+    std::vector<quint32> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&cells](quint32 a, quint32 b) {
+        return cells[a] < cells[b];
+    });
+    std::vector<quint32> newIndex(count);
+    for (quint32 i = 0; i < count; ++i) {
+        newIndex[order[i]] = i;
+    }
+
+    std::vector<quint32> firstEdge;
+    firstEdge.reserve(count + 1);
+    std::vector<ContractionHierarchy::Edge> edges;
+    std::vector<qint32> coordinates;
+    coordinates.reserve(2 * count);
+    std::vector<quint32> sortedCells;
+    sortedCells.reserve(count);
+    std::vector<quint8> degrees;
+    degrees.reserve(count);
+    for (quint32 node : order) {
+        firstEdge.push_back(quint32(edges.size()));
+        for (ContractionHierarchy::Edge edge : m_upwardEdges[node]) {
+            edge.target = newIndex[edge.target];
+            if (edge.middle != ContractionHierarchy::InvalidNode) {
+                edge.middle = newIndex[edge.middle];
+            }
+            edges.push_back(edge);
+        }
+        coordinates.push_back(m_coordinates[2 * node]);
+        coordinates.push_back(m_coordinates[2 * node + 1]);
+        sortedCells.push_back(cells[node]);
+        degrees.push_back(m_degrees[node]);
+    }
+    firstEdge.push_back(quint32(edges.size()));
+
+    ContractionHierarchy::Header header;
+    header.magic = ContractionHierarchy::Magic;
+    header.version = ContractionHierarchy::Version;
+    header.nodeCount = count;
+    header.edgeCount = quint32(edges.size());
+    header.wayCount = quint32(m_ways.size());
+    header.stringSize = quint32(m_strings.size());
+    header.south = header.west = std::numeric_limits<qint32>::max();
+    header.north = header.east = std::numeric_limits<qint32>::min();
+    for (quint32 node = 0; node < count; ++node) {
+        header.south = qMin(header.south, m_coordinates[2 * node]);
+        header.north = qMax(header.north, m_coordinates[2 * node]);
+        header.west = qMin(header.west, m_coordinates[2 * node + 1]);
+        header.east = qMax(header.east, m_coordinates[2 * node + 1]);
+    }
+    header.sourceSize = sourceSize;
+    header.sourceModified = sourceModified;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        mDebug() << "Cannot write routing graph" << fileName << file.errorString();
+        return false;
+    }
+    const bool written = file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header)) && writeArray(file, firstEdge)
+        && writeArray(file, edges) && writeArray(file, coordinates) && writeArray(file, sortedCells) && writeArray(file, m_ways) && writeArray(file, degrees)
+        && file.write(m_strings) == m_strings.size();
+    if (!written) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+}
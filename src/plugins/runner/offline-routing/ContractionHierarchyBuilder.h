@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_CONTRACTIONHIERARCHYBUILDER_H
+#define MARBLE_CONTRACTIONHIERARCHYBUILDER_H
+
+#include "ContractionHierarchy.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include <vector>
+
+class QAtomicInt;
+
+namespace Marble
+{
+
+/**
+ * Contracts a directed road graph into a ContractionHierarchy and writes it to disk.
+ *
+ * Nodes are contracted in the order of their edge difference plus the number of
+ * already contracted neighbors, which is updated lazily. Local witness searches
+ * decide whether a shortcut is needed when a node is removed.
+ */
+class ContractionHierarchyBuilder
+{
+public:
+    ContractionHierarchyBuilder();
+
+    /** Adds a node at the given position in 1e-7 degree and returns its index */
+    quint32 addNode(qint32 latitude, qint32 longitude);
+
+    /** Adds a way that arcs can refer to and returns its index */
+    quint32 addWay(const QString &name, const QString &type, bool isRoundabout);
+
+    /**
+     * Adds a directed arc. Parallel arcs are merged, keeping the one with the
+     * lowest weight. Weights are clamped to be positive.
+     */
+    void addArc(quint32 from, quint32 to, quint32 weight, quint32 duration, quint32 way = ContractionHierarchy::InvalidWay);
+
+    quint32 nodeCount() const;
+
+    GeoDataCoordinates coordinates(quint32 node) const;
+
+    /**
+     * Contracts the graph. Afterwards no more nodes or arcs can be added.
+     * Returns false if it was canceled by setting canceled to a non-zero value.
+     */
+    bool contract(const QAtomicInt *canceled = nullptr);
+
+    /**
+     * Writes the contracted graph. The source file properties are stored to detect
+     * outdated graphs later on.
+     */
+    bool write(const QString &fileName, qint64 sourceSize, qint64 sourceModified) const;
+
+private:
+    struct Arc {
+        quint32 node;
+        quint32 weight;
+        quint32 duration;
+        quint32 middle;
+        quint32 way;
+    };
+
+    quint32 addString(const QString &string);
+
+    static bool insertArc(std::vector<Arc> &arcs, const Arc &arc);
+
+    static void removeArc(std::vector<Arc> &arcs, quint32 node);
+
+    int priority(quint32 node);
+
+    int processShortcuts(quint32 node, bool apply);
+
+    void contractNode(quint32 node);
+
+    void witnessSearch(quint32 source, quint32 ignored, quint32 limit, int maximumSettled);
+
+    std::vector<qint32> m_coordinates;
+    std::vector<ContractionHierarchy::Way> m_ways;
+    QByteArray m_strings;
+    QHash<QString, quint32> m_stringOffsets;
+    std::vector<quint8> m_degrees;
+    std::vector<std::vector<Arc>> m_outArcs;
+    std::vector<std::vector<Arc>> m_inArcs;
+    std::vector<std::vector<ContractionHierarchy::Edge>> m_upwardEdges;
+    std::vector<quint32> m_contractedNeighbors;
+    std::vector<bool> m_contracted;
+
+    std::vector<quint32> m_witnessDistance;
+    std::vector<quint32> m_touched;
+    bool m_isContracted;
+};
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "OfflineRoutingGraphCache.h"
+
+#include "ContractionHierarchy.h"
+#include "ContractionHierarchyBuilder.h"
+#include "OfflineRoutingProfile.h"
+#include "PbfRoadNetworkReader.h"
+
+#include "MarbleDebug.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+
+namespace Marble
+{
+
+OfflineRoutingGraphCache::OfflineRoutingGraphCache()
+    : m_canceled(false)
+{
+    m_threadPool.setMaxThreadCount(1);
+}
+
+OfflineRoutingGraphCache::~OfflineRoutingGraphCache()
+{
+    m_canceled.storeRelaxed(true);
+    m_threadPool.clear();
+    m_threadPool.waitForDone();
+}
+
+OfflineRoutingGraphCache &OfflineRoutingGraphCache::instance()
+{
+    static OfflineRoutingGraphCache cache;
+    return cache;
+}
+
+QString OfflineRoutingGraphCache::graphFileName(const QFileInfo &source, const OfflineRoutingProfile &profile)
+{
+    return source.absoluteFilePath() + QLatin1Char('.') + profile.id() + QLatin1StringView(".ch");
+}
+
+std::shared_ptr<const ContractionHierarchy> OfflineRoutingGraphCache::graph(const QFileInfo &source, const OfflineRoutingProfile &profile)
+{
+    const QString fileName = graphFileName(source, profile);
+
+    // Mapping a graph is cheap, building it happens elsewhere
+    QMutexLocker locker(&m_mutex);
+    std::shared_ptr<const ContractionHierarchy> result = m_graphs.value(fileName);
+    if (result && isUpToDate(*result, source)) {
+        return result;
+    }
+    m_graphs.remove(fileName);
+
+    if (m_pending.contains(fileName)) {
+        return {};
+    }
+
+    auto graph = std::make_shared<ContractionHierarchy>();
+    if (graph->load(fileName) && isUpToDate(*graph, source)) {
+        m_graphs.insert(fileName, graph);
+        return graph;
+    }
+
+    scheduleBuild(source, profile, fileName);
+    return {};
+}
+
+bool OfflineRoutingGraphCache::isUpToDate(const ContractionHierarchy &graph, const QFileInfo &source)
+{
+    return graph.isValid() && graph.header().sourceSize == source.size() && graph.header().sourceModified == source.lastModified().toMSecsSinceEpoch();
+}
+
+void OfflineRoutingGraphCache::scheduleBuild(const QFileInfo &source, const OfflineRoutingProfile &profile, const QString &fileName)
+{
+    mDebug() << "Scheduling preprocessing of" << source.fileName() << "for" << profile.id();
+    m_pending.insert(fileName);
+    m_threadPool.start([this, source, profile, fileName]() {
+        buildGraph(source, profile, fileName, &m_canceled);
+
+        // Failed builds are retried by the next request
+        QMutexLocker locker(&m_mutex);
+        m_pending.remove(fileName);
+    });
+}
+
+bool OfflineRoutingGraphCache::buildGraph(const QFileInfo &source, const OfflineRoutingProfile &profile, const QString &fileName, const QAtomicInt *canceled)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(source.absoluteFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        mDebug() << "Cannot open" << source.absoluteFilePath();
+        return false;
+    }
+
+    ContractionHierarchyBuilder builder;
+    PbfRoadNetworkReader reader(profile);
+    if (!reader.read(&file, &builder, canceled)) {
+        mDebug() << "Cannot read the road network of" << source.fileName();
+        return false;
+    }
+    mDebug() << "Extracted" << builder.nodeCount() << "nodes for" << profile.id() << "in" << timer.restart() << "ms";
+
+    if (!builder.contract(canceled)) {
+        return false;
+    }
+    mDebug() << "Contracted" << source.fileName() << "in" << timer.elapsed() << "ms";
+
+    return builder.write(fileName, source.size(), source.lastModified().toMSecsSinceEpoch());
+}
+
+}
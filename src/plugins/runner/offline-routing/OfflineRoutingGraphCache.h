@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_OFFLINEROUTINGGRAPHCACHE_H
+#define MARBLE_OFFLINEROUTINGGRAPHCACHE_H
+
+#include <QAtomicInt>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QThreadPool>
+
+#include <memory>
+
+namespace Marble
+{
+
+class ContractionHierarchy;
+class OfflineRoutingProfile;
+
+/**
+ * Shares the routing graphs of all extracts between runners.
+ *
+ * Route requests only ever map graph files that exist already. Missing or
+ * outdated graphs are built in the background, one at a time since
+ * preprocessing a large extract needs a lot of memory, and get used by the
+ * route requests issued after they are done.
+ */
+class OfflineRoutingGraphCache
+{
+public:
+    static OfflineRoutingGraphCache &instance();
+
+    /**
+     * Returns the graph of source for profile, or a null pointer if it is not
+     * there yet. In that case it is scheduled for building.
+     */
+    std::shared_ptr<const ContractionHierarchy> graph(const QFileInfo &source, const OfflineRoutingProfile &profile);
+
+    static QString graphFileName(const QFileInfo &source, const OfflineRoutingProfile &profile);
+
+    /**
+     * Builds the graph of source for profile and writes it to fileName. Returns
+     * false on errors or if it was canceled by setting canceled to a non-zero value.
+     */
+    static bool buildGraph(const QFileInfo &source, const OfflineRoutingProfile &profile, const QString &fileName, const QAtomicInt *canceled = nullptr);
+
+private:
+    OfflineRoutingGraphCache();
+
+    ~OfflineRoutingGraphCache();
+
+    Q_DISABLE_COPY(OfflineRoutingGraphCache)
+
+    static bool isUpToDate(const ContractionHierarchy &graph, const QFileInfo &source);
+
+    void scheduleBuild(const QFileInfo &source, const OfflineRoutingProfile &profile, const QString &fileName);
+
+    QMutex m_mutex;
+    QHash<QString, std::shared_ptr<const ContractionHierarchy>> m_graphs;
+    QSet<QString> m_pending;
+    QAtomicInt m_canceled;
+    QThreadPool m_threadPool;
+};
+
+}
+
+#endif
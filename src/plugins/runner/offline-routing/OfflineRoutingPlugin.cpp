@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "OfflineRoutingPlugin.h"
+#include "OfflineRoutingRunner.h"
+
+namespace Marble
+{
+
+OfflineRoutingPlugin::OfflineRoutingPlugin(QObject *parent)
+    : RoutingRunnerPlugin(parent)
+{
+    setSupportedCelestialBodies(QStringList(QStringLiteral("earth")));
+    setCanWorkOffline(true);
+}
+
+QString OfflineRoutingPlugin::name() const
+{
+    return tr("Offline OSM Routing");
+}
+
+QString OfflineRoutingPlugin::guiString() const
+{
+    return tr("Offline OSM");
+}
+
+QString OfflineRoutingPlugin::nameId() const
+{
+    return QStringLiteral("offline-routing");
+}
+
+QString OfflineRoutingPlugin::version() const
+{
+    return QStringLiteral("1.0");
+}
+
+QString OfflineRoutingPlugin::description() const
+{
+    return tr("Calculates routes from OpenStreetMap extracts without network access or external tools");
+}
+
+QString OfflineRoutingPlugin::copyrightYears() const
+{
+    return QStringLiteral("2026");
+}
+
+QList<PluginAuthor> OfflineRoutingPlugin::pluginAuthors() const
+{
+    return QList<PluginAuthor>() << PluginAuthor(QStringLiteral("Marble Authors"), QStringLiteral("marble-devel@kde.org"));
+}
+
+RoutingRunner *OfflineRoutingPlugin::newRunner() const
+{
+    return new OfflineRoutingRunner;
+}
+
+bool OfflineRoutingPlugin::supportsTemplate(RoutingProfilesModel::ProfileTemplate profileTemplate) const
+{
+    return (profileTemplate == RoutingProfilesModel::CarFastestTemplate) || (profileTemplate == RoutingProfilesModel::CarShortestTemplate)
+        || (profileTemplate == RoutingProfilesModel::BicycleTemplate) || (profileTemplate == RoutingProfilesModel::PedestrianTemplate);
+}
+
+QHash<QString, QVariant> OfflineRoutingPlugin::templateSettings(RoutingProfilesModel::ProfileTemplate profileTemplate) const
+{
+    QHash<QString, QVariant> result;
+    switch (profileTemplate) {
+    case RoutingProfilesModel::CarFastestTemplate:
+        result.insert(QStringLiteral("transport"), QStringLiteral("motorcar"));
+        result.insert(QStringLiteral("method"), QStringLiteral("fastest"));
+        break;
+    case RoutingProfilesModel::CarShortestTemplate:
+        result.insert(QStringLiteral("transport"), QStringLiteral("motorcar"));
+        result.insert(QStringLiteral("method"), QStringLiteral("shortest"));
+        break;
+    case RoutingProfilesModel::CarEcologicalTemplate:
+        break;
+    case RoutingProfilesModel::BicycleTemplate:
+        result.insert(QStringLiteral("transport"), QStringLiteral("bicycle"));
+        result.insert(QStringLiteral("method"), QStringLiteral("fastest"));
+        break;
+    case RoutingProfilesModel::PedestrianTemplate:
+        result.insert(QStringLiteral("transport"), QStringLiteral("foot"));
+        result.insert(QStringLiteral("method"), QStringLiteral("shortest"));
+        break;
+    case RoutingProfilesModel::LastTemplate:
+        Q_ASSERT(false);
+        break;
+    }
+    return result;
+}
+
+bool OfflineRoutingPlugin::canWork() const
+{
+    return !OfflineRoutingRunner::sourceFiles().isEmpty();
+}
+
+}
+
+#include "moc_OfflineRoutingPlugin.cpp"
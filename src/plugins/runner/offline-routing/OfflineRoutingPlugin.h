@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_OFFLINEROUTINGPLUGIN_H
+#define MARBLE_OFFLINEROUTINGPLUGIN_H
+
+#include "RoutingRunnerPlugin.h"
+
+namespace Marble
+{
+
+/**
+ * Offline routing without external tools. OSM PBF extracts placed in the map
+ * directory are preprocessed into a contraction hierarchy per routing profile
+ * in the background, starting with the first route request that needs it.
+ */
+class OfflineRoutingPlugin : public RoutingRunnerPlugin
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID "org.kde.marble.OfflineRoutingPlugin" FILE "OfflineRoutingPlugin.json")
+    Q_INTERFACES(Marble::RoutingRunnerPlugin)
+
+public:
+    explicit OfflineRoutingPlugin(QObject *parent = nullptr);
+
+    QString name() const override;
+
+    QString guiString() const override;
+
+    QString nameId() const override;
+
+    QString version() const override;
+
+    QString description() const override;
+
+    QString copyrightYears() const override;
+
+    QList<PluginAuthor> pluginAuthors() const override;
+
+    RoutingRunner *newRunner() const override;
+
+    bool supportsTemplate(RoutingProfilesModel::ProfileTemplate profileTemplate) const override;
+
+    QHash<QString, QVariant> templateSettings(RoutingProfilesModel::ProfileTemplate profileTemplate) const override;
+
+    bool canWork() const override;
+};
+
+}
+
+#endif
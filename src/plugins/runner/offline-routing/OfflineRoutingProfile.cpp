@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "OfflineRoutingProfile.h"
+
+#include "osm/OsmPlacemarkData.h"
+
+#include <QStringList>
+
+namespace Marble
+{
+
+namespace
+{
+using SpeedTable = QHash<QString, qreal>;
+
+const SpeedTable &motorcarSpeeds()
+{
+    static const SpeedTable speeds = {
+        {QStringLiteral("motorway"), 120.0},
+        {QStringLiteral("motorway_link"), 60.0},
+        {QStringLiteral("trunk"), 100.0},
+        {QStringLiteral("trunk_link"), 50.0},
+        {QStringLiteral("primary"), 80.0},
+        {QStringLiteral("primary_link"), 40.0},
+        {QStringLiteral("secondary"), 70.0},
+        {QStringLiteral("secondary_link"), 35.0},
+        {QStringLiteral("tertiary"), 60.0},
+        {QStringLiteral("tertiary_link"), 30.0},
+        {QStringLiteral("unclassified"), 40.0},
+        {QStringLiteral("road"), 30.0},
+        {QStringLiteral("residential"), 30.0},
+        {QStringLiteral("living_street"), 10.0},
+        {QStringLiteral("service"), 15.0},
+        {QStringLiteral("track"), 10.0},
+    };
+    return speeds;
+}
+
+const SpeedTable &bicycleSpeeds()
+{
+    static const SpeedTable speeds = {
+        {QStringLiteral("cycleway"), 18.0},
+        {QStringLiteral("primary"), 16.0},
+        {QStringLiteral("primary_link"), 16.0},
+        {QStringLiteral("secondary"), 16.0},
+        {QStringLiteral("secondary_link"), 16.0},
+        {QStringLiteral("tertiary"), 16.0},
+        {QStringLiteral("tertiary_link"), 16.0},
+        {QStringLiteral("unclassified"), 16.0},
+        {QStringLiteral("road"), 16.0},
+        {QStringLiteral("residential"), 16.0},
+        {QStringLiteral("living_street"), 12.0},
+        {QStringLiteral("service"), 14.0},
+        {QStringLiteral("track"), 12.0},
+        {QStringLiteral("path"), 12.0},
+        {QStringLiteral("bridleway"), 8.0},
+        {QStringLiteral("pedestrian"), 6.0},
+        {QStringLiteral("footway"), 6.0},
+    };
+    return speeds;
+}
+
+const SpeedTable &footSpeeds()
+{
+    static const SpeedTable speeds = {
+        {QStringLiteral("primary"), 5.0},
+        {QStringLiteral("primary_link"), 5.0},
+        {QStringLiteral("secondary"), 5.0},
+        {QStringLiteral("secondary_link"), 5.0},
+        {QStringLiteral("tertiary"), 5.0},
+        {QStringLiteral("tertiary_link"), 5.0},
+        {QStringLiteral("unclassified"), 5.0},
+        {QStringLiteral("road"), 5.0},
+        {QStringLiteral("residential"), 5.0},
+        {QStringLiteral("living_street"), 5.0},
+        {QStringLiteral("service"), 5.0},
+        {QStringLiteral("track"), 5.0},
+        {QStringLiteral("path"), 5.0},
+        {QStringLiteral("bridleway"), 5.0},
+        {QStringLiteral("cycleway"), 5.0},
+        {QStringLiteral("pedestrian"), 5.0},
+        {QStringLiteral("footway"), 5.0},
+        {QStringLiteral("steps"), 3.0},
+    };
+    return speeds;
+}
+
+bool isTrue(const QString &value)
+{
+    return value == QLatin1StringView("yes") || value == QLatin1StringView("true") || value == QLatin1StringView("1");
+}
+
+bool isDenied(const QString &value)
+{
+    return value == QLatin1StringView("no") || value == QLatin1StringView("private");
+}
+}
+
+OfflineRoutingProfile::OfflineRoutingProfile(const QHash<QString, QVariant> &settings)
+    : m_transport(Motorcar)
+    , m_fastest(settings.value(QStringLiteral("method")).toString() != QLatin1StringView("shortest"))
+{
+    const QString transport = settings.value(QStringLiteral("transport")).toString();
+    if (transport == QLatin1StringView("bicycle")) {
+        m_transport = Bicycle;
+    } else if (transport == QLatin1StringView("foot")) {
+        m_transport = Foot;
+    }
+}
+
+OfflineRoutingProfile::Transport OfflineRoutingProfile::transport() const
+{
+    return m_transport;
+}
+
+bool OfflineRoutingProfile::isFastest() const
+{
+    return m_fastest;
+}
+
+QString OfflineRoutingProfile::id() const
+{
+    QString result;
+    switch (m_transport) {
+    case Motorcar:
+        result = QStringLiteral("motorcar");
+        break;
+    case Bicycle:
+        result = QStringLiteral("bicycle");
+        break;
+    case Foot:
+        result = QStringLiteral("foot");
+        break;
+    }
+    return result + (m_fastest ? QLatin1StringView("-fastest") : QLatin1StringView("-shortest"));
+}
+
+qreal OfflineRoutingProfile::speed(const OsmPlacemarkData &way) const
+{
+    const QString highway = way.tagValue(QStringLiteral("highway"));
+    if (highway.isEmpty() || !isAccessible(way)) {
+        return 0.0;
+    }
+
+    switch (m_transport) {
+    case Motorcar: {
+        const qreal defaultSpeed = motorcarSpeeds().value(highway, 0.0);
+        if (defaultSpeed <= 0.0) {
+            return 0.0;
+        }
+        const qreal maxSpeed = parseMaxSpeed(way.tagValue(QStringLiteral("maxspeed")));
+        return maxSpeed > 0.0 ? maxSpeed : defaultSpeed;
+    }
+    case Bicycle:
+        if (highway == QLatin1StringView("footway") || highway == QLatin1StringView("pedestrian")) {
+            // Pushing the bike is allowed, riding only if explicitly tagged
+            return isTrue(way.tagValue(QStringLiteral("bicycle"))) ? bicycleSpeeds().value(QStringLiteral("path")) : bicycleSpeeds().value(highway);
+        }
+        return bicycleSpeeds().value(highway, 0.0);
+    case Foot:
+        return footSpeeds().value(highway, 0.0);
+    }
+
+    return 0.0;
+}
+
+OfflineRoutingProfile::Directions OfflineRoutingProfile::directions(const OsmPlacemarkData &way) const
+{
+    if (m_transport == Foot) {
+        return BothDirections;
+    }
+
+    QString oneway = way.tagValue(QStringLiteral("oneway"));
+    if (m_transport == Bicycle && way.containsTagKey(QStringLiteral("oneway:bicycle"))) {
+        oneway = way.tagValue(QStringLiteral("oneway:bicycle"));
+    }
+
+    if (oneway == QLatin1StringView("-1") || oneway == QLatin1StringView("reverse")) {
+        return BackwardDirection;
+    }
+    if (isTrue(oneway)) {
+        return ForwardDirection;
+    }
+    if (oneway == QLatin1StringView("no")) {
+        return BothDirections;
+    }
+
+    const QString highway = way.tagValue(QStringLiteral("highway"));
+    if (way.containsTag(QStringLiteral("junction"), QStringLiteral("roundabout")) || highway == QLatin1StringView("motorway")) {
+        return ForwardDirection;
+    }
+    return BothDirections;
+}
+
+bool OfflineRoutingProfile::isAccessible(const OsmPlacemarkData &way) const
+{
+    if (way.containsTag(QStringLiteral("area"), QStringLiteral("yes"))) {
+        return false;
+    }
+
+    QStringList keys;
+    switch (m_transport) {
+    case Motorcar:
+        keys << QStringLiteral("motorcar") << QStringLiteral("motor_vehicle") << QStringLiteral("vehicle");
+        break;
+    case Bicycle:
+        keys << QStringLiteral("bicycle") << QStringLiteral("vehicle");
+        break;
+    case Foot:
+        keys << QStringLiteral("foot");
+        break;
+    }
+    keys << QStringLiteral("access");
+
+    // The most specific access tag wins
+    for (const QString &key : std::as_const(keys)) {
+        const auto tag = way.findTag(key);
+        if (tag != way.tagsEnd()) {
+            return !isDenied(tag.value());
+        }
+    }
+    return true;
+}
+
+qreal OfflineRoutingProfile::parseMaxSpeed(const QString &maxSpeed)
+{
+    const QStringList fields = maxSpeed.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+    if (fields.isEmpty()) {
+        return 0.0;
+    }
+    bool ok = false;
+    const qreal speed = fields.first().toDouble(&ok);
+    if (!ok || speed <= 0.0) {
+        return 0.0;
+    }
+    return fields.size() > 1 && fields.at(1) == QLatin1StringView("mph") ? speed * 1.609344 : speed;
+}
+
+}
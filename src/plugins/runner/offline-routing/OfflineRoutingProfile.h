@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_OFFLINEROUTINGPROFILE_H
+#define MARBLE_OFFLINEROUTINGPROFILE_H
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+
+namespace Marble
+{
+
+class OsmPlacemarkData;
+
+/**
+ * Decides which OSM ways are usable by a means of transport, how fast they can
+ * be travelled and in which direction. Every profile results in its own
+ * contraction hierarchy.
+ */
+class OfflineRoutingProfile
+{
+public:
+    enum Transport {
+        Motorcar,
+        Bicycle,
+        Foot
+    };
+
+    enum Directions {
+        NoDirection = 0x0,
+        ForwardDirection = 0x1,
+        BackwardDirection = 0x2,
+        BothDirections = ForwardDirection | BackwardDirection
+    };
+
+    explicit OfflineRoutingProfile(const QHash<QString, QVariant> &settings);
+
+    Transport transport() const;
+
+    /** Whether edge weights are travel times (fastest route) or distances (shortest route) */
+    bool isFastest() const;
+
+    /** Unique identifier of the profile, used in graph file names */
+    QString id() const;
+
+    /** Returns the speed in km/h on the given way, 0 if it cannot be used */
+    qreal speed(const OsmPlacemarkData &way) const;
+
+    /** Returns the directions the given way can be travelled in, relative to its node order */
+    Directions directions(const OsmPlacemarkData &way) const;
+
+private:
+    bool isAccessible(const OsmPlacemarkData &way) const;
+
+    static qreal parseMaxSpeed(const QString &maxSpeed);
+
+    Transport m_transport;
+    bool m_fastest;
+};
+
+}
+
+#endif
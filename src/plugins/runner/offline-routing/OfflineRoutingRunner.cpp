@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "OfflineRoutingRunner.h"
+
+#include "ContractionHierarchy.h"
+#include "OfflineRoutingGraphCache.h"
+#include "OfflineRoutingProfile.h"
+
+#include "GeoDataData.h"
+#include "GeoDataDocument.h"
+#include "GeoDataExtendedData.h"
+#include "GeoDataLatLonBox.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+#include "MarbleDebug.h"
+#include "MarbleDirs.h"
+#include "routing/RouteRequest.h"
+#include "routing/instructions/InstructionTransformation.h"
+
+#include <QDir>
+#include <QTime>
+#include <QtMath>
+
+namespace Marble
+{
+
+namespace
+{
+// Route requests further away from the road network are not handled by an extract
+const qreal MaximumSnapDistance = 5000.0;
+}
+
+class OfflineRoutingRunnerPrivate
+{
+public:
+    static bool covers(const ContractionHierarchy &graph, const RouteRequest *route);
+
+    static QList<GeoDataPlacemark *> instructions(const ContractionHierarchy &graph, const QList<quint32> &path, const QList<quint32> &ways);
+};
+
+bool OfflineRoutingRunnerPrivate::covers(const ContractionHierarchy &graph, const RouteRequest *route)
+{
+    // Cheap test before looking for the nearest nodes, grown by the snap distance
+    GeoDataLatLonBox box = graph.boundingBox();
+    const qreal margin = MaximumSnapDistance / EARTH_RADIUS;
+    const qreal longitudeMargin = margin / qMax(qCos(qMax(qAbs(box.north()), qAbs(box.south())) + margin), 0.01);
+    if (box.width() + 2 * longitudeMargin >= 2 * M_PI) {
+        return true;
+    }
+    box.setBoundaries(qMin(box.north() + margin, M_PI / 2),
+                      qMax(box.south() - margin, -M_PI / 2),
+                      GeoDataCoordinates::normalizeLon(box.east() + longitudeMargin),
+                      GeoDataCoordinates::normalizeLon(box.west() - longitudeMargin));
+    for (int i = 0; i < route->size(); ++i) {
+        if (!box.contains(route->at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QList<GeoDataPlacemark *> OfflineRoutingRunnerPrivate::instructions(const ContractionHierarchy &graph, const QList<quint32> &path, const QList<quint32> &ways)
+{
+    Q_ASSERT(ways.size() == path.size() - 1);
+
+    RoutingWaypoints waypoints;
+    for (int i = 0; i < path.size(); ++i) {
+        // Each point belongs to the road leaving it, the destination to the one arriving
+        const quint32 way = ways.isEmpty() ? ContractionHierarchy::InvalidWay : ways[qMin(i, ways.size() - 1)];
+        const QString type = graph.wayType(way);
+        RoutingWaypoint::JunctionType junction = RoutingWaypoint::None;
+        if (graph.isJunction(path[i])) {
+            junction = type == QLatin1StringView("roundabout") ? RoutingWaypoint::Roundabout : RoutingWaypoint::Other;
+        }
+        const GeoDataCoordinates coordinates = graph.coordinates(path[i]);
+        const RoutingPoint point(coordinates.longitude(GeoDataCoordinates::Degree), coordinates.latitude(GeoDataCoordinates::Degree));
+        waypoints << RoutingWaypoint(point, junction, QString(), type, -1, graph.wayName(way));
+    }
+
+    QList<GeoDataPlacemark *> result;
+    const RoutingInstructions directions = InstructionTransformation::process(waypoints);
+    for (const RoutingInstruction &direction : directions) {
+        auto placemark = new GeoDataPlacemark(direction.instructionText());
+        GeoDataExtendedData extendedData;
+        GeoDataData turnType;
+        turnType.setName(QStringLiteral("turnType"));
+        turnType.setValue(QVariant::fromValue(int(direction.turnType())));
+        extendedData.addValue(turnType);
+        GeoDataData roadName;
+        roadName.setName(QStringLiteral("roadName"));
+        roadName.setValue(direction.roadName());
+        extendedData.addValue(roadName);
+        placemark->setExtendedData(extendedData);
+
+        auto geometry = new GeoDataLineString;
+        const QList<RoutingWaypoint> points = direction.points();
+        for (const RoutingWaypoint &waypoint : points) {
+            geometry->append(GeoDataCoordinates(waypoint.point().lon(), waypoint.point().lat(), 0.0, GeoDataCoordinates::Degree));
+        }
+        placemark->setGeometry(geometry);
+        result << placemark;
+    }
+    return result;
+}
+
+GeoDataDocument *OfflineRoutingRunner::createDocument(GeoDataLineString *routeWaypoints, const QList<GeoDataPlacemark *> &instructions, quint32 duration) const
+{
+    auto result = new GeoDataDocument;
+    auto routePlacemark = new GeoDataPlacemark;
+    routePlacemark->setName(QStringLiteral("Route"));
+    routePlacemark->setGeometry(routeWaypoints);
+
+    const qreal length = routeWaypoints->length(EARTH_RADIUS);
+    const QTime time = QTime(0, 0, 0).addSecs(qRound(duration / 10.0));
+    routePlacemark->setExtendedData(routeData(length, time));
+    result->setName(nameString(QStringLiteral("Offline"), length, time));
+    result->append(routePlacemark);
+    for (GeoDataPlacemark *placemark : instructions) {
+        result->append(placemark);
+    }
+    return result;
+}
+
+OfflineRoutingRunner::OfflineRoutingRunner(QObject *parent)
+    : RoutingRunner(parent)
+    , d(new OfflineRoutingRunnerPrivate)
+{
+    // nothing to do
+}
+
+OfflineRoutingRunner::~OfflineRoutingRunner()
+{
+    delete d;
+}
+
+QString OfflineRoutingRunner::mapDirectory()
+{
+    return MarbleDirs::localPath() + QLatin1StringView("/maps/earth/offline-routing/");
+}
+
+QFileInfoList OfflineRoutingRunner::sourceFiles()
+{
+    return QDir(mapDirectory()).entryInfoList(QStringList() << QStringLiteral("*.pbf"), QDir::Files | QDir::Readable, QDir::Name);
+}
+
+void OfflineRoutingRunner::retrieveRoute(const RouteRequest *route)
+{
+    if (route->size() < 2) {
+        Q_EMIT routeCalculated(nullptr);
+        return;
+    }
+
+    const QHash<QString, QVariant> settings = route->routingProfile().pluginSettings()[QStringLiteral("offline-routing")];
+    const OfflineRoutingProfile profile(settings);
+
+    const QFileInfoList sources = sourceFiles();
+    for (const QFileInfo &source : sources) {
+        // Graphs not preprocessed yet are built in the background meanwhile
+        const std::shared_ptr<const ContractionHierarchy> graph = OfflineRoutingGraphCache::instance().graph(source, profile);
+        if (!graph || !OfflineRoutingRunnerPrivate::covers(*graph, route)) {
+            continue;
+        }
+
+        QList<quint32> viaNodes;
+        for (int i = 0; i < route->size(); ++i) {
+            qreal distance = 0.0;
+            const quint32 node = graph->nearestNode(route->at(i), &distance);
+            if (node == ContractionHierarchy::InvalidNode || distance > MaximumSnapDistance) {
+                break;
+            }
+            viaNodes << node;
+        }
+        if (viaNodes.size() != route->size()) {
+            // Not covered by this extract, try the next one
+            continue;
+        }
+
+        QList<quint32> routePath;
+        QList<quint32> routeWays;
+        quint32 totalDuration = 0;
+        for (int i = 1; i < viaNodes.size(); ++i) {
+            quint32 duration = 0;
+            QList<quint32> ways;
+            const QList<quint32> path = graph->shortestPath(viaNodes[i - 1], viaNodes[i], &duration, &ways);
+            if (path.isEmpty()) {
+                mDebug() << "No route between via points" << i - 1 << "and" << i;
+                Q_EMIT routeCalculated(nullptr);
+                return;
+            }
+            // Subsequent legs start where the previous one ended
+            routePath << path.mid(routePath.isEmpty() ? 0 : 1);
+            routeWays << ways;
+            totalDuration += duration;
+        }
+
+        auto routeWaypoints = new GeoDataLineString;
+        for (quint32 node : std::as_const(routePath)) {
+            routeWaypoints->append(graph->coordinates(node));
+        }
+        const QList<GeoDataPlacemark *> instructions = OfflineRoutingRunnerPrivate::instructions(*graph, routePath, routeWays);
+        Q_EMIT routeCalculated(createDocument(routeWaypoints, instructions, totalDuration));
+        return;
+    }
+
+    Q_EMIT routeCalculated(nullptr);
+}
+
+} // namespace Marble
+
+#include "moc_OfflineRoutingRunner.cpp"
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_OFFLINEROUTINGRUNNER_H
+#define MARBLE_OFFLINEROUTINGRUNNER_H
+
+#include "RoutingRunner.h"
+
+#include <QFileInfo>
+
+namespace Marble
+{
+
+class GeoDataLineString;
+class GeoDataPlacemark;
+class OfflineRoutingRunnerPrivate;
+
+class OfflineRoutingRunner : public RoutingRunner
+{
+    Q_OBJECT
+public:
+    explicit OfflineRoutingRunner(QObject *parent = nullptr);
+
+    ~OfflineRoutingRunner() override;
+
+    // Overriding MarbleAbstractRunner
+    void retrieveRoute(const RouteRequest *request) override;
+
+    /** The directory holding the OSM PBF extracts and the preprocessed graphs */
+    static QString mapDirectory();
+
+    /** The OSM PBF extracts available for routing */
+    static QFileInfoList sourceFiles();
+
+private:
+    GeoDataDocument *createDocument(GeoDataLineString *routeWaypoints, const QList<GeoDataPlacemark *> &instructions, quint32 duration) const;
+
+    OfflineRoutingRunnerPrivate *const d;
+};
+
+}
+
+#endif
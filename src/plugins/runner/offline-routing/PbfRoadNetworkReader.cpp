@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include "PbfRoadNetworkReader.h"
+
+#include "ContractionHierarchyBuilder.h"
+
+#include "GeoDataCoordinates.h"
+#include "MarbleDebug.h"
+#include "MarbleGlobal.h"
+#include "osm/OsmPlacemarkData.h"
+
+#include "fileformat.pb.h"
+#include "osmformat.pb.h"
+
+#include <QAtomicInt>
+#include <QIODevice>
+#include <QtEndian>
+
+#include <zlib.h>
+
+namespace Marble
+{
+
+namespace
+{
+// Limits of the OSM PBF specification
+const qint32 MaximumBlobHeaderSize = 64 * 1024;
+const qint32 MaximumBlobSize = 32 * 1024 * 1024;
+
+QString blockString(const OSMPBF::PrimitiveBlock &block, int index)
+{
+    const std::string &string = block.stringtable().s(index);
+    return QString::fromUtf8(string.data(), qsizetype(string.size()));
+}
+}
+
+PbfRoadNetworkReader::PbfRoadNetworkReader(const OfflineRoutingProfile &profile)
+    : m_profile(profile)
+    , m_builder(nullptr)
+{
+    // nothing to do
+}
+
+bool PbfRoadNetworkReader::read(QIODevice *device, ContractionHierarchyBuilder *builder, const QAtomicInt *canceled)
+{
+    m_builder = builder;
+    m_roads.clear();
+    m_references.clear();
+    m_nodeIndices.clear();
+
+    if (!readPass(device, WayPass, canceled) || !device->seek(0) || !readPass(device, NodePass, canceled)) {
+        return false;
+    }
+
+    addArcs();
+    m_buffer.clear();
+    return true;
+}
+
+bool PbfRoadNetworkReader::readPass(QIODevice *device, Pass pass, const QAtomicInt *canceled)
+{
+    QByteArray type;
+    QByteArray data;
+    while (!device->atEnd()) {
+        if (canceled && canceled->loadRelaxed()) {
+            return false;
+        }
+        if (!readBlob(device, type, data)) {
+            mDebug() << "Broken blob in OSM PBF file at" << device->pos();
+            return false;
+        }
+        if (type != "OSMData") {
+            continue;
+        }
+
+        OSMPBF::PrimitiveBlock block;
+        if (!block.ParseFromArray(data.constData(), int(data.size()))) {
+            return false;
+        }
+        if (pass == WayPass) {
+            readWays(block);
+        } else {
+            readNodes(block);
+        }
+    }
+    return true;
+}
+
+bool PbfRoadNetworkReader::readBlob(QIODevice *device, QByteArray &type, QByteArray &data)
+{
+    quint32 headerSize = 0;
+    if (device->read(reinterpret_cast<char *>(&headerSize), sizeof(headerSize)) != qint64(sizeof(headerSize))) {
+        return false;
+    }
+    headerSize = qFromBigEndian(headerSize);
+    if (headerSize > quint32(MaximumBlobHeaderSize)) {
+        return false;
+    }
+
+    m_buffer = device->read(headerSize);
+    OSMPBF::BlobHeader blobHeader;
+    if (m_buffer.size() != qsizetype(headerSize) || !blobHeader.ParseFromArray(m_buffer.constData(), int(m_buffer.size()))) {
+        return false;
+    }
+    if (blobHeader.datasize() < 0 || blobHeader.datasize() > MaximumBlobSize) {
+        return false;
+    }
+
+    m_buffer = device->read(blobHeader.datasize());
+    OSMPBF::Blob blob;
+    if (m_buffer.size() != qsizetype(blobHeader.datasize()) || !blob.ParseFromArray(m_buffer.constData(), int(m_buffer.size()))) {
+        return false;
+    }
+
+    type = QByteArray::fromStdString(blobHeader.type());
+    if (blob.has_raw()) {
+        data = QByteArray::fromStdString(blob.raw());
+        return true;
+    }
+    if (!blob.has_zlib_data() || blob.raw_size() < 0 || blob.raw_size() > MaximumBlobSize) {
+        return false;
+    }
+
+    data.resize(blob.raw_size());
+    z_stream stream;
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(blob.zlib_data().data()));
+    stream.avail_in = uInt(blob.zlib_data().size());
+    stream.next_out = reinterpret_cast<Bytef *>(data.data());
+    stream.avail_out = uInt(data.size());
+    stream.zalloc = nullptr;
+    stream.zfree = nullptr;
+    stream.opaque = nullptr;
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+    const int result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
+
+void PbfRoadNetworkReader::readWays(const OSMPBF::PrimitiveBlock &block)
+{
+    for (int i = 0; i < block.primitivegroup_size(); ++i) {
+        const OSMPBF::PrimitiveGroup &group = block.primitivegroup(i);
+        for (int j = 0; j < group.ways_size(); ++j) {
+            const OSMPBF::Way &way = group.ways(j);
+            if (way.refs_size() < 2) {
+                continue;
+            }
+
+            OsmPlacemarkData tags;
+            for (int k = 0; k < way.keys_size() && k < way.vals_size(); ++k) {
+                tags.addTag(blockString(block, way.keys(k)), blockString(block, way.vals(k)));
+            }
+            const qreal speed = m_profile.speed(tags);
+            if (speed <= 0.0) {
+                continue;
+            }
+
+            QString name = tags.tagValue(QStringLiteral("name"));
+            if (name.isEmpty()) {
+                name = tags.tagValue(QStringLiteral("ref"));
+            }
+            const bool isRoundabout = tags.containsTag(QStringLiteral("junction"), QStringLiteral("roundabout"));
+
+            Road road;
+            road.firstReference = qsizetype(m_references.size());
+            road.referenceCount = way.refs_size();
+            road.way = m_builder->addWay(name, tags.tagValue(QStringLiteral("highway")), isRoundabout);
+            road.speed = float(speed);
+            road.directions = m_profile.directions(tags);
+            m_roads.push_back(road);
+
+            qint64 id = 0;
+            for (int k = 0; k < way.refs_size(); ++k) {
+                id += way.refs(k);
+                m_references.push_back(id);
+                m_nodeIndices.insert(id, ContractionHierarchy::InvalidNode);
+            }
+        }
+    }
+}
+
+void PbfRoadNetworkReader::readNodes(const OSMPBF::PrimitiveBlock &block)
+{
+    const qint64 granularity = block.granularity();
+    const qint64 latitudeOffset = block.lat_offset();
+    const qint64 longitudeOffset = block.lon_offset();
+
+    for (int i = 0; i < block.primitivegroup_size(); ++i) {
+        const OSMPBF::PrimitiveGroup &group = block.primitivegroup(i);
+        for (int j = 0; j < group.nodes_size(); ++j) {
+            const OSMPBF::Node &node = group.nodes(j);
+            addNode(node.id(), latitudeOffset + granularity * node.lat(), longitudeOffset + granularity * node.lon());
+        }
+
+        if (group.has_dense()) {
+            const OSMPBF::DenseNodes &dense = group.dense();
+            qint64 id = 0;
+            qint64 latitude = 0;
+            qint64 longitude = 0;
+            for (int j = 0; j < dense.id_size() && j < dense.lat_size() && j < dense.lon_size(); ++j) {
+                id += dense.id(j);
+                latitude += dense.lat(j);
+                longitude += dense.lon(j);
+                addNode(id, latitudeOffset + granularity * latitude, longitudeOffset + granularity * longitude);
+            }
+        }
+    }
+}
+
+void PbfRoadNetworkReader::addNode(qint64 id, qint64 latitude, qint64 longitude)
+{
+    const auto it = m_nodeIndices.find(id);
+    if (it == m_nodeIndices.end() || *it != ContractionHierarchy::InvalidNode) {
+        return;
+    }
+
+    // Coordinates are stored in nanodegrees, the graph uses 1e-7 degree
+    *it = m_builder->addNode(qint32(latitude / 100), qint32(longitude / 100));
+}
+
+void PbfRoadNetworkReader::addArcs()
+{
+    for (const Road &road : m_roads) {
+        const qreal metersPerDecisecond = road.speed / 36.0;
+        quint32 previous = ContractionHierarchy::InvalidNode;
+        for (qsizetype i = road.firstReference; i < road.firstReference + road.referenceCount; ++i) {
+            const quint32 node = m_nodeIndices.value(m_references[i], ContractionHierarchy::InvalidNode);
+            if (previous != ContractionHierarchy::InvalidNode && node != ContractionHierarchy::InvalidNode) {
+                const qreal distance = m_builder->coordinates(previous).sphericalDistanceTo(m_builder->coordinates(node)) * EARTH_RADIUS;
+                const quint32 duration = qMax(1, qRound(distance / metersPerDecisecond));
+                const quint32 weight = m_profile.isFastest() ? duration : quint32(qMax(1, qRound(distance * 10.0)));
+                if (road.directions & OfflineRoutingProfile::ForwardDirection) {
+                    m_builder->addArc(previous, node, weight, duration, road.way);
+                }
+                if (road.directions & OfflineRoutingProfile::BackwardDirection) {
+                    m_builder->addArc(node, previous, weight, duration, road.way);
+                }
+            }
+            previous = node;
+        }
+    }
+}
+
+}
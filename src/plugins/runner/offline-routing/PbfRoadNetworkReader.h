@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#ifndef MARBLE_PBFROADNETWORKREADER_H
+#define MARBLE_PBFROADNETWORKREADER_H
+
+#include "OfflineRoutingProfile.h"
+
+#include <QByteArray>
+#include <QHash>
+
+#include <vector>
+
+class QAtomicInt;
+class QIODevice;
+
+namespace OSMPBF
+{
+class PrimitiveBlock;
+}
+
+namespace Marble
+{
+
+class ContractionHierarchyBuilder;
+
+/**
+ * Extracts the road network usable by a routing profile from an OSM PBF file.
+ *
+ * The file is read one blob at a time in two passes: the first one collects
+ * the routable ways, the second one the coordinates of the nodes they refer
+ * to. Only the road network is kept in memory, not the whole extract.
+ */
+class PbfRoadNetworkReader
+{
+public:
+    explicit PbfRoadNetworkReader(const OfflineRoutingProfile &profile);
+
+    /**
+     * Reads the road network from device, which must be seekable, and adds it
+     * to builder. Returns false if the file is broken or reading was canceled
+     * by setting canceled to a non-zero value.
+     */
+    bool read(QIODevice *device, ContractionHierarchyBuilder *builder, const QAtomicInt *canceled = nullptr);
+
+private:
+    enum Pass {
+        WayPass,
+        NodePass
+    };
+
+    struct Road {
+        qsizetype firstReference;
+        qsizetype referenceCount;
+        quint32 way;
+        float speed;
+        OfflineRoutingProfile::Directions directions;
+    };
+
+    bool readBlob(QIODevice *device, QByteArray &type, QByteArray &data);
+
+    bool readPass(QIODevice *device, Pass pass, const QAtomicInt *canceled);
+
+    void readWays(const OSMPBF::PrimitiveBlock &block);
+
+    void readNodes(const OSMPBF::PrimitiveBlock &block);
+
+    void addNode(qint64 id, qint64 latitude, qint64 longitude);
+
+    void addArcs();
+
+    const OfflineRoutingProfile m_profile;
+    ContractionHierarchyBuilder *m_builder;
+    std::vector<Road> m_roads;
+    std::vector<qint64> m_references;
+    /// Builder indices of the nodes referenced by roads
+    QHash<qint64, quint32> m_nodeIndices;
+    QByteArray m_buffer;
+};
+
+}
+
+#endif
@@ -14,7 +14,7 @@ namespace Marble
 class OSRMPlugin : public RoutingRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.OSRMPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.OSRMPlugin" FILE "OSRMPlugin.json")
     Q_INTERFACES(Marble::RoutingRunnerPlugin)
 
 public:
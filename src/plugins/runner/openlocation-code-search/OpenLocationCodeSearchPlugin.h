@@ -13,7 +13,7 @@ namespace Marble
 class OpenLocationCodeSearchPlugin : public SearchRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.OpenLocationCodeSearchPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.OpenLocationCodeSearchPlugin" FILE "OpenLocationCodeSearchPlugin.json")
     Q_INTERFACES(Marble::SearchRunnerPlugin)
 
 public:
@@ -13,7 +13,7 @@ namespace Marble
 class OsmPlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.OsmPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.OsmPlugin" FILE "OsmPlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
@@ -13,7 +13,7 @@ namespace Marble
 class Pn2Plugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.Pn2Plugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.Pn2Plugin" FILE "Pn2Plugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
@@ -13,7 +13,7 @@ namespace Marble
 class PntPlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.PntPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.PntPlugin" FILE "PntPlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
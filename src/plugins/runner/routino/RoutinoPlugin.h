@@ -14,7 +14,7 @@ namespace Marble
 class RoutinoPlugin : public RoutingRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.RoutinoPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.RoutinoPlugin" FILE "RoutinoPlugin.json")
     Q_INTERFACES(Marble::RoutingRunnerPlugin)
 
 public:
@@ -13,7 +13,7 @@ namespace Marble
 class ShpPlugin : public ParseRunnerPlugin
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.ShpPlugin")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.ShpPlugin" FILE "ShpPlugin.json")
     Q_INTERFACES(Marble::ParseRunnerPlugin)
 
 public:
@@ -28,7 +28,7 @@ namespace Marble
 class FITemplateFloatItem : public AbstractFloatItem
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kde.marble.FITemplateFloatItem")
+    Q_PLUGIN_METADATA(IID "org.kde.marble.FITemplateFloatItem" FILE "FITemplateFloatItem.json")
     Q_INTERFACES(Marble::RenderPluginInterface)
     MARBLE_PLUGIN(FITemplateFloatItem)
 
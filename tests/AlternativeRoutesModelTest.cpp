@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QPointF>
+#include <QTest>
+
+#include "GeoDataDocument.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+#include "routing/AlternativeRoutesModel.h"
+
+#include <memory>
+
+using PointList = QList<QPointF>;
+
+namespace Marble
+{
+
+class AlternativeRoutesModelTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void similarity_data();
+    void similarity();
+    void withoutWaypoints();
+    void filterSimilarRoutes();
+
+private:
+    /** A route document along the given points, x is the longitude and y the latitude in degree */
+    static GeoDataDocument *createRoute(const PointList &points);
+};
+
+GeoDataDocument *AlternativeRoutesModelTest::createRoute(const PointList &points)
+{
+    auto lineString = new GeoDataLineString;
+    for (const QPointF &point : points) {
+        lineString->append(GeoDataCoordinates(point.x(), point.y(), 0.0, GeoDataCoordinates::Degree));
+    }
+    auto placemark = new GeoDataPlacemark(QStringLiteral("Route"));
+    placemark->setGeometry(lineString);
+    auto document = new GeoDataDocument;
+    document->append(placemark);
+    return document;
+}
+
+void AlternativeRoutesModelTest::similarity_data()
+{
+    QTest::addColumn<PointList>("routeA");
+    QTest::addColumn<PointList>("routeB");
+    QTest::addColumn<qreal>("minimum");
+    QTest::addColumn<qreal>("maximum");
+
+    const PointList straight = {QPointF(8.0, 50.0), QPointF(8.1, 50.0)};
+    QTest::newRow("identical") << straight << straight << 1.0 << 1.0;
+    QTest::newRow("more vertices") << straight << PointList{QPointF(8.0, 50.0), QPointF(8.03, 50.0), QPointF(8.07, 50.0), QPointF(8.1, 50.0)} << 1.0 << 1.0;
+    QTest::newRow("contained") << straight << PointList{QPointF(8.0, 50.0), QPointF(8.09, 50.0)} << 0.95 << 1.0;
+    QTest::newRow("disjoint") << straight << PointList{QPointF(8.0, 50.1), QPointF(8.1, 50.1)} << 0.0 << 0.0;
+    QTest::newRow("crossing") << straight << PointList{QPointF(8.05, 49.95), QPointF(8.05, 50.05)} << 0.0 << 0.1;
+
+    // Half of the straight route is shared, the rest of the detour is not
+    const PointList detour = {QPointF(8.0, 50.0), QPointF(8.05, 50.0), QPointF(8.05, 50.05)};
+    QTest::newRow("partly overlapping") << straight << detour << 0.45 << 0.6;
+    QTest::newRow("partly overlapping reversed arguments") << detour << straight << 0.45 << 0.6;
+}
+
+void AlternativeRoutesModelTest::similarity()
+{
+    QFETCH(PointList, routeA);
+    QFETCH(PointList, routeB);
+    QFETCH(qreal, minimum);
+    QFETCH(qreal, maximum);
+
+    const std::unique_ptr<GeoDataDocument> documentA(createRoute(routeA));
+    const std::unique_ptr<GeoDataDocument> documentB(createRoute(routeB));
+    const qreal similarity = AlternativeRoutesModel::similarity(documentA.get(), documentB.get());
+    QVERIFY2(similarity >= minimum - 1.0e-9 && similarity <= maximum + 1.0e-9, qPrintable(QString::number(similarity)));
+}
+
+void AlternativeRoutesModelTest::withoutWaypoints()
+{
+    const std::unique_ptr<GeoDataDocument> route(createRoute({QPointF(8.0, 50.0), QPointF(8.1, 50.0)}));
+    const GeoDataDocument empty;
+    QCOMPARE(AlternativeRoutesModel::similarity(route.get(), &empty), 0.0);
+    QCOMPARE(AlternativeRoutesModel::similarity(&empty, route.get()), 0.0);
+}
+
+void AlternativeRoutesModelTest::filterSimilarRoutes()
+{
+    AlternativeRoutesModel model;
+    model.addRoute(createRoute({QPointF(8.0, 50.0), QPointF(8.09, 50.0)}));
+    QCOMPARE(model.rowCount(), 1);
+
+    // A longer route along the same roads is dropped, the model does not take it over
+    GeoDataDocument *const similar = createRoute({QPointF(8.0, 50.0), QPointF(8.05, 50.0), QPointF(8.1, 50.0)});
+    model.addRoute(similar);
+    QCOMPARE(model.rowCount(), 1);
+    QVERIFY(model.route(0) != similar);
+    delete similar;
+
+    model.addRoute(createRoute({QPointF(8.0, 50.0), QPointF(8.05, 50.05), QPointF(8.1, 50.0)}));
+    QCOMPARE(model.rowCount(), 2);
+}
+
+}
+
+QTEST_MAIN(Marble::AlternativeRoutesModelTest)
+
+#include "AlternativeRoutesModelTest.moc"
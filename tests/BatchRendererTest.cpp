@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "BatchRenderer.h"
+#include "GeoPainter.h"
+#include "MarbleMap.h"
+#include "MarbleModel.h"
+
+#include <algorithm>
+
+namespace Marble
+{
+
+class BatchRendererTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    // Runs first, so that the workers set up the first maps of the process
+    void coldStart();
+    void render();
+    void matchesMarbleMap();
+    void cancel();
+
+private:
+    /** Renders @p job with a MarbleMap on the GUI thread, like BatchRenderer does on its workers */
+    static QImage renderReference(const BatchRenderJob &job, bool &complete);
+};
+
+QImage BatchRendererTest::renderReference(const BatchRenderJob &job, bool &complete)
+{
+    MarbleModel model;
+    MarbleMap map(&model);
+    map.setMapThemeId(job.mapThemeId);
+    map.setProjection(job.projection);
+    map.setSize(job.size);
+    map.setRadius(job.radius);
+    map.centerOn(job.longitude, job.latitude);
+
+    QSignalSpy repaintSpy(&map, &MarbleMap::repaintNeeded);
+    QImage image(job.size, QImage::Format_ARGB32_Premultiplied);
+    QElapsedTimer timer;
+    timer.start();
+    while (true) {
+        repaintSpy.clear();
+        image.fill(Qt::transparent);
+        {
+            GeoPainter painter(&image, map.viewport(), map.mapQuality());
+            map.paint(painter, QRect());
+        }
+
+        complete = map.renderStatus() == Complete;
+        if (complete || timer.hasExpired(30000)) {
+            return image;
+        }
+        if (repaintSpy.isEmpty()) {
+            repaintSpy.wait(1000);
+        }
+    }
+}
+
+void BatchRendererTest::coldStart()
+{
+    BatchRenderer renderer;
+    renderer.setThreadCount(4);
+    renderer.setTimeout(30000);
+
+    // Identical jobs on workers that build their maps at the same time
+    BatchRenderJob job;
+    job.mapThemeId = QStringLiteral("earth/plain/plain.dgml");
+    job.radius = 150;
+    job.size = QSize(200, 150);
+    const QList<BatchRenderJob> jobs(renderer.threadCount(), job);
+
+    QSignalSpy jobSpy(&renderer, &BatchRenderer::jobFinished);
+    QSignalSpy finishedSpy(&renderer, &BatchRenderer::finished);
+    renderer.render(jobs);
+    QVERIFY(finishedSpy.wait(120000));
+    QCOMPARE(jobSpy.size(), jobs.size());
+
+    QImage first;
+    for (const QList<QVariant> &arguments : std::as_const(jobSpy)) {
+        const BatchRenderResult result = arguments.at(0).value<BatchRenderResult>();
+        QVERIFY(result.complete);
+        if (first.isNull()) {
+            first = result.image;
+        } else {
+            QCOMPARE(result.image, first);
+        }
+    }
+}
+
+void BatchRendererTest::render()
+{
+    BatchRenderer renderer;
+    renderer.setThreadCount(2);
+    renderer.setTimeout(5000);
+
+    QList<BatchRenderJob> jobs;
+    for (int i = 0; i < 3; ++i) {
+        BatchRenderJob job;
+        job.mapThemeId = QStringLiteral("earth/plain/plain.dgml");
+        job.projection = i == 1 ? Equirectangular : Spherical;
+        job.longitude = 30.0 * i;
+        job.radius = 100;
+        job.size = QSize(120 + i, 80);
+        jobs << job;
+    }
+
+    QSignalSpy jobSpy(&renderer, &BatchRenderer::jobFinished);
+    QSignalSpy finishedSpy(&renderer, &BatchRenderer::finished);
+
+    renderer.render(jobs);
+    QVERIFY(renderer.isRunning());
+    QVERIFY(finishedSpy.wait(60000));
+    QVERIFY(!renderer.isRunning());
+    QCOMPARE(jobSpy.size(), jobs.size());
+
+    QList<int> indices;
+    for (const QList<QVariant> &arguments : std::as_const(jobSpy)) {
+        const BatchRenderResult result = arguments.at(0).value<BatchRenderResult>();
+        QVERIFY(result.index >= 0 && result.index < jobs.size());
+        QCOMPARE(result.image.size(), jobs.at(result.index).size);
+        QVERIFY(result.setupTime >= 0 && result.waitTime >= 0 && result.paintTime >= 0);
+        indices << result.index;
+    }
+    std::sort(indices.begin(), indices.end());
+    QCOMPARE(indices, QList<int>({0, 1, 2}));
+}
+
+void BatchRendererTest::matchesMarbleMap()
+{
+    BatchRenderer renderer;
+    renderer.setThreadCount(2);
+    renderer.setTimeout(30000);
+
+    QList<BatchRenderJob> jobs;
+    const QList<Projection> projections = {Spherical, Equirectangular, Mercator, Stereographic};
+    for (int i = 0; i < projections.size(); ++i) {
+        BatchRenderJob job;
+        job.mapThemeId = QStringLiteral("earth/plain/plain.dgml");
+        job.projection = projections.at(i);
+        job.longitude = 40.0 * i - 60.0;
+        job.latitude = 10.0 * i;
+        job.radius = 150;
+        job.size = QSize(320, 240);
+        jobs << job;
+    }
+
+    QSignalSpy jobSpy(&renderer, &BatchRenderer::jobFinished);
+    QSignalSpy finishedSpy(&renderer, &BatchRenderer::finished);
+    renderer.render(jobs);
+    QVERIFY(finishedSpy.wait(120000));
+    QCOMPARE(jobSpy.size(), jobs.size());
+
+    for (const QList<QVariant> &arguments : std::as_const(jobSpy)) {
+        const BatchRenderResult result = arguments.at(0).value<BatchRenderResult>();
+        QVERIFY(result.complete);
+
+        bool complete = false;
+        const QImage reference = renderReference(jobs.at(result.index), complete);
+        QVERIFY(complete);
+        QCOMPARE(result.image.size(), reference.size());
+        QCOMPARE(result.image.format(), reference.format());
+
+        // Cached float items are antialiased slightly differently than those painted directly on worker threads
+        int differentPixels = 0;
+        for (int y = 0; y < reference.height(); ++y) {
+            const auto expected = reinterpret_cast<const QRgb *>(reference.constScanLine(y));
+            const auto actual = reinterpret_cast<const QRgb *>(result.image.constScanLine(y));
+            for (int x = 0; x < reference.width(); ++x) {
+                if (qAbs(qRed(expected[x]) - qRed(actual[x])) > 8 || qAbs(qGreen(expected[x]) - qGreen(actual[x])) > 8
+                    || qAbs(qBlue(expected[x]) - qBlue(actual[x])) > 8 || qAbs(qAlpha(expected[x]) - qAlpha(actual[x])) > 8) {
+                    ++differentPixels;
+                }
+            }
+        }
+        QVERIFY2(differentPixels * 100 <= reference.width() * reference.height(),
+                 qPrintable(QStringLiteral("Job %1: %2 pixels differ").arg(result.index).arg(differentPixels)));
+    }
+}
+
+void BatchRendererTest::cancel()
+{
+    BatchRenderer renderer;
+    renderer.setThreadCount(1);
+
+    BatchRenderJob job;
+    job.mapThemeId = QStringLiteral("earth/plain/plain.dgml");
+    job.size = QSize(64, 64);
+
+    QSignalSpy finishedSpy(&renderer, &BatchRenderer::finished);
+
+    renderer.render(QList<BatchRenderJob>(20, job));
+    renderer.cancel();
+
+    // Jobs started already still get finished
+    if (renderer.isRunning()) {
+        QVERIFY(finishedSpy.wait(60000));
+    }
+    QCOMPARE(finishedSpy.size(), 1);
+    QVERIFY(!renderer.isRunning());
+}
+
+}
+
+QTEST_MAIN(Marble::BatchRendererTest)
+
+#include "BatchRendererTest.moc"
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QFile>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "ContractionHierarchy.h"
+#include "ContractionHierarchyBuilder.h"
+#include "GeoDataCoordinates.h"
+#include "GeoDataLatLonBox.h"
+
+#include <limits>
+
+namespace Marble
+{
+
+class ContractionHierarchyTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void nearestNode();
+    void junctions();
+    void wayAttributes();
+    void shortestPaths();
+    void unreachable();
+    void incompatibleFile();
+
+private:
+    struct Arc {
+        quint32 weight;
+        quint32 way;
+    };
+
+    static quint64 key(quint32 from, quint32 to);
+
+    /** The distances from source in the uncontracted grid, in file indices */
+    QList<quint32> dijkstra(quint32 source) const;
+
+    static const int Size = 12;
+
+    QTemporaryDir m_directory;
+    ContractionHierarchy m_graph;
+    /// File index of the builder nodes
+    QList<quint32> m_indices;
+    /// The arcs of the grid by file indices
+    QHash<quint64, Arc> m_arcs;
+    quint32 m_isolated;
+    QList<quint32> m_ways;
+};
+
+quint64 ContractionHierarchyTest::key(quint32 from, quint32 to)
+{
+    return (quint64(from) << 32) | to;
+}
+
+void ContractionHierarchyTest::initTestCase()
+{
+    QVERIFY(m_directory.isValid());
+
+    // A street grid with a few one-way streets, random weights and one isolated node
+    ContractionHierarchyBuilder builder;
+    for (int row = 0; row < Size; ++row) {
+        for (int column = 0; column < Size; ++column) {
+            builder.addNode(480000000 + row * 10000, 80000000 + column * 10000);
+        }
+    }
+    const quint32 isolated = builder.addNode(490000000, 90000000);
+
+    for (int i = 0; i < Size; ++i) {
+        m_ways << builder.addWay(QStringLiteral("Row %1").arg(i), QStringLiteral("residential"), false);
+    }
+    for (int i = 0; i < Size; ++i) {
+        m_ways << builder.addWay(QStringLiteral("Column %1").arg(i), QStringLiteral("tertiary"), i == 0);
+    }
+
+    struct BuilderArc {
+        quint32 from;
+        quint32 to;
+        quint32 weight;
+        quint32 way;
+    };
+    QList<BuilderArc> arcs;
+    QRandomGenerator random(42);
+    for (int row = 0; row < Size; ++row) {
+        for (int column = 0; column < Size; ++column) {
+            const quint32 node = row * Size + column;
+            if (column + 1 < Size) {
+                const quint32 weight = 10 + random.bounded(90);
+                arcs << BuilderArc{node, node + 1, weight, m_ways[row]};
+                if (row % 4 != 1) {
+                    arcs << BuilderArc{node + 1, node, weight, m_ways[row]};
+                }
+            }
+            if (row + 1 < Size) {
+                const quint32 weight = 10 + random.bounded(90);
+                arcs << BuilderArc{node + Size, node, weight, m_ways[Size + column]};
+                if (column % 5 != 2) {
+                    arcs << BuilderArc{node, node + Size, weight, m_ways[Size + column]};
+                }
+            }
+        }
+    }
+    for (const BuilderArc &arc : std::as_const(arcs)) {
+        builder.addArc(arc.from, arc.to, arc.weight, 2 * arc.weight, arc.way);
+    }
+
+    QVERIFY(builder.contract());
+    const QString fileName = m_directory.filePath(QStringLiteral("grid.ch"));
+    QVERIFY(builder.write(fileName, 1234, 5678));
+    QVERIFY(m_graph.load(fileName));
+    QCOMPARE(m_graph.nodeCount(), builder.nodeCount());
+    QCOMPARE(m_graph.header().sourceSize, qint64(1234));
+    QCOMPARE(m_graph.header().sourceModified, qint64(5678));
+
+    // Nodes are reordered when writing, find them by their position
+    for (quint32 node = 0; node < builder.nodeCount(); ++node) {
+        qreal distance = 1.0;
+        m_indices << m_graph.nearestNode(builder.coordinates(node), &distance);
+        QVERIFY(m_indices.last() != ContractionHierarchy::InvalidNode);
+        QVERIFY(distance < 0.1);
+    }
+    m_isolated = m_indices[isolated];
+
+    for (const BuilderArc &arc : std::as_const(arcs)) {
+        m_arcs.insert(key(m_indices[arc.from], m_indices[arc.to]), Arc{arc.weight, arc.way});
+    }
+}
+
+void ContractionHierarchyTest::nearestNode()
+{
+    const GeoDataCoordinates position(8.0021, 48.0039, 0.0, GeoDataCoordinates::Degree);
+    qreal distance = 0.0;
+    const quint32 node = m_graph.nearestNode(position, &distance);
+    QCOMPARE(node, m_indices[4 * Size + 2]);
+    QVERIFY(distance > 0.0 && distance < 20.0);
+
+    const GeoDataLatLonBox box = m_graph.boundingBox();
+    QCOMPARE(box.south(GeoDataCoordinates::Degree), 48.0);
+    QCOMPARE(box.north(GeoDataCoordinates::Degree), 49.0);
+    QCOMPARE(box.west(GeoDataCoordinates::Degree), 8.0);
+    QCOMPARE(box.east(GeoDataCoordinates::Degree), 9.0);
+
+    ContractionHierarchy empty;
+    QCOMPARE(empty.nearestNode(position), ContractionHierarchy::InvalidNode);
+}
+
+void ContractionHierarchyTest::junctions()
+{
+    QVERIFY(!m_graph.isJunction(m_indices[0]));
+    QVERIFY(m_graph.isJunction(m_indices[1]));
+    QVERIFY(m_graph.isJunction(m_indices[Size + 1]));
+    QVERIFY(!m_graph.isJunction(m_isolated));
+}
+
+void ContractionHierarchyTest::wayAttributes()
+{
+    QCOMPARE(m_graph.wayName(m_ways[3]), QStringLiteral("Row 3"));
+    QCOMPARE(m_graph.wayType(m_ways[3]), QStringLiteral("residential"));
+    QCOMPARE(m_graph.wayName(m_ways[Size + 1]), QStringLiteral("Column 1"));
+    QCOMPARE(m_graph.wayType(m_ways[Size + 1]), QStringLiteral("tertiary"));
+    QCOMPARE(m_graph.wayType(m_ways[Size]), QStringLiteral("roundabout"));
+    QVERIFY(m_graph.wayName(ContractionHierarchy::InvalidWay).isEmpty());
+}
+
+QList<quint32> ContractionHierarchyTest::dijkstra(quint32 source) const
+{
+    const quint32 infinity = std::numeric_limits<quint32>::max();
+    QList<quint32> distances(m_graph.nodeCount(), infinity);
+    QList<bool> settled(m_graph.nodeCount(), false);
+    distances[source] = 0;
+    while (true) {
+        quint32 node = ContractionHierarchy::InvalidNode;
+        for (quint32 i = 0; i < m_graph.nodeCount(); ++i) {
+            if (!settled[i] && distances[i] != infinity && (node == ContractionHierarchy::InvalidNode || distances[i] < distances[node])) {
+                node = i;
+            }
+        }
+        if (node == ContractionHierarchy::InvalidNode) {
+            return distances;
+        }
+        settled[node] = true;
+        for (auto it = m_arcs.cbegin(); it != m_arcs.cend(); ++it) {
+            if (quint32(it.key() >> 32) == node) {
+                const quint32 target = quint32(it.key());
+                distances[target] = qMin(distances[target], distances[node] + it->weight);
+            }
+        }
+    }
+}
+
+void ContractionHierarchyTest::shortestPaths()
+{
+    QRandomGenerator random(7);
+    for (int i = 0; i < 20; ++i) {
+        const quint32 source = m_indices[random.bounded(Size * Size)];
+        const QList<quint32> distances = dijkstra(source);
+        for (int j = 0; j < Size * Size; j += 7) {
+            const quint32 target = m_indices[j];
+            quint32 duration = 0;
+            QList<quint32> ways;
+            const QList<quint32> path = m_graph.shortestPath(source, target, &duration, &ways);
+            QVERIFY(!path.isEmpty());
+            QCOMPARE(path.first(), source);
+            QCOMPARE(path.last(), target);
+            QCOMPARE(ways.size(), path.size() - 1);
+
+            // The unpacked path consists of original arcs and is as short as the reference
+            quint32 weight = 0;
+            for (int k = 1; k < path.size(); ++k) {
+                const auto arc = m_arcs.constFind(key(path[k - 1], path[k]));
+                QVERIFY(arc != m_arcs.constEnd());
+                QCOMPARE(ways[k - 1], arc->way);
+                weight += arc->weight;
+            }
+            QCOMPARE(weight, distances[target]);
+            QCOMPARE(duration, 2 * weight);
+        }
+    }
+}
+
+void ContractionHierarchyTest::unreachable()
+{
+    QVERIFY(m_graph.shortestPath(m_indices[0], m_isolated).isEmpty());
+    QVERIFY(m_graph.shortestPath(m_isolated, m_indices[0]).isEmpty());
+    QVERIFY(m_graph.shortestPath(m_indices[0], m_graph.nodeCount()).isEmpty());
+
+    const QList<quint32> path = m_graph.shortestPath(m_isolated, m_isolated);
+    QCOMPARE(path.size(), 1);
+}
+
+void ContractionHierarchyTest::incompatibleFile()
+{
+    const QString fileName = m_directory.filePath(QStringLiteral("broken.ch"));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(256, 'x'));
+    file.close();
+
+    ContractionHierarchy graph;
+    QVERIFY(!graph.load(fileName));
+    QVERIFY(!graph.isValid());
+    QVERIFY(!graph.load(m_directory.filePath(QStringLiteral("missing.ch"))));
+}
+
+}
+
+QTEST_MAIN(Marble::ContractionHierarchyTest)
+
+#include "ContractionHierarchyTest.moc"
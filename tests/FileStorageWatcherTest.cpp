@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "FileStorageWatcher.h"
+
+namespace Marble
+{
+
+class FileStorageWatcherTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void deleteValidatorsWithTiles();
+
+private:
+    /// Writes size bytes to fileName below directory, last modified at modified
+    static void writeFile(const QString &fileName, int size, const QDateTime &modified);
+};
+
+void FileStorageWatcherTest::writeFile(const QString &fileName, int size, const QDateTime &modified)
+{
+    QVERIFY(QDir().mkpath(QFileInfo(fileName).path()));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(QByteArray(size, 'x')), qint64(size));
+    QVERIFY(file.setFileTime(modified, QFileDevice::FileModificationTime));
+}
+
+void FileStorageWatcherTest::deleteValidatorsWithTiles()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString tileDirectory = directory.path() + QLatin1StringView("/maps/earth/theme/5/0/");
+    const QDateTime now = QDateTime::currentDateTime();
+
+    // Three tiles with validators, the oldest first
+    QStringList tiles;
+    for (int i = 0; i < 3; ++i) {
+        tiles << tileDirectory + QStringLiteral("%1.png").arg(i);
+        writeFile(tiles.last(), 1000, now.addDays(i - 3));
+        writeFile(tiles.last() + QLatin1StringView(".validators"), 100, now.addDays(i - 3));
+    }
+    const QString orphan = tileDirectory + QLatin1StringView("3.png.validators");
+    writeFile(orphan, 100, now);
+
+    FileStorageWatcherThread watcher(directory.path());
+    watcher.getCurrentCacheSize();
+    QVERIFY(!QFileInfo::exists(orphan));
+
+    // Only the validators push the cache over its limit
+    watcher.setCacheLimit(3100);
+    QTRY_VERIFY(!QFileInfo::exists(tiles.at(0)));
+    QVERIFY(!QFileInfo::exists(tiles.at(0) + QLatin1StringView(".validators")));
+    for (int i = 1; i < 3; ++i) {
+        QVERIFY(QFileInfo::exists(tiles.at(i)));
+        QVERIFY(QFileInfo::exists(tiles.at(i) + QLatin1StringView(".validators")));
+    }
+}
+
+}
+
+QTEST_MAIN(Marble::FileStorageWatcherTest)
+
+#include "FileStorageWatcherTest.moc"
@@ -21,6 +21,7 @@ private Q_SLOTS:
     void defaultConstructor();
     void setRootDocument();
     void addDocument();
+    void childIndex();
 };
 
 void GeoDataTreeModelTest::defaultConstructor()
@@ -70,6 +71,53 @@ void GeoDataTreeModelTest::addDocument()
 
 }
 
+void GeoDataTreeModelTest::childIndex()
+{
+    GeoDataTreeModel model;
+    auto document = new GeoDataDocument;
+    model.addDocument(document);
+
+    const int count = 1000;
+    QList<GeoDataPlacemark *> placemarks;
+    for (int i = 0; i < count; ++i) {
+        auto placemark = new GeoDataPlacemark;
+        placemarks << placemark;
+        model.addFeature(document, placemark);
+    }
+
+    const QModelIndex documentIndex = model.index(document);
+    QCOMPARE(documentIndex.row(), 0);
+    QCOMPARE(model.rowCount(documentIndex), count);
+
+    for (int i = 0; i < count; i += 97) {
+        const QModelIndex index = model.index(placemarks[i]);
+        QCOMPARE(index.row(), i);
+        QCOMPARE(index.internalPointer(), static_cast<void *>(placemarks[i]));
+        QCOMPARE(model.parent(index), documentIndex);
+        QCOMPARE(document->childPosition(placemarks[i]), i);
+    }
+
+    // Positions behind a removed child move up
+    QCOMPARE(model.removeFeature(placemarks[10]), 10);
+    delete placemarks.takeAt(10);
+    QCOMPARE(model.index(placemarks[10]).row(), 10);
+    QCOMPARE(model.index(placemarks.last()).row(), count - 2);
+
+    // Inserting in front moves them down again
+    auto first = new GeoDataPlacemark;
+    QCOMPARE(model.addFeature(document, first, 0), 0);
+    QCOMPARE(model.index(first).row(), 0);
+    QCOMPARE(model.index(placemarks.last()).row(), count - 1);
+
+    // Elements that are not part of the tree have no index
+    GeoDataPlacemark orphan;
+    QCOMPARE(model.index(&orphan), QModelIndex());
+    GeoDataDocument detached;
+    auto detachedPlacemark = new GeoDataPlacemark;
+    detached.append(detachedPlacemark);
+    QCOMPARE(model.index(detachedPlacemark), QModelIndex());
+}
+
 QTEST_MAIN(Marble::GeoDataTreeModelTest)
 
 #include "GeoDataTreeModelTest.moc"
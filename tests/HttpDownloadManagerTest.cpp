@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "DownloadPolicy.h"
+#include "FileStoragePolicy.h"
+#include "GeoDataLatLonBox.h"
+#include "GeoSceneTextureTileDataset.h"
+#include "GeoSceneTypes.h"
+#include "HttpDownloadManager.h"
+#include "MergedLayerDecorator.h"
+#include "TileId.h"
+#include "TileLoader.h"
+
+namespace Marble
+{
+
+/**
+ * Serves a single file, answering conditional requests for its current
+ * version with "304 Not Modified".
+ */
+class TileServer : public QTcpServer
+{
+public:
+    TileServer()
+    {
+        connect(this, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() {
+                    m_pending[socket] += socket->readAll();
+                    if (m_pending[socket].contains("\r\n\r\n")) {
+                        respond(socket, m_pending.take(socket));
+                    }
+                });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+
+    static const QByteArray content;
+    QList<QByteArray> requests;
+
+private:
+    void respond(QTcpSocket *socket, const QByteArray &request)
+    {
+        requests << request;
+
+        if (request.contains("If-None-Match: \"v1\"")) {
+            socket->write("HTTP/1.1 304 Not Modified\r\nETag: \"v1\"\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        } else {
+            socket->write("HTTP/1.1 200 OK\r\nETag: \"v1\"\r\nLast-Modified: Tue, 06 Oct 2026 08:00:00 GMT\r\nContent-Length: "
+                          + QByteArray::number(content.size()) + "\r\nConnection: close\r\n\r\n" + content);
+        }
+        socket->disconnectFromHost();
+    }
+
+    QHash<QTcpSocket *, QByteArray> m_pending;
+};
+
+const QByteArray TileServer::content("tile content");
+
+class HttpDownloadManagerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void revalidateTile();
+    void unconditionalDownload();
+    void queueOrder();
+    void cancelOutOfView();
+    void severalViews();
+    void cancelledTileSource();
+
+private:
+    /// A box of size degrees around the given center
+    static GeoDataLatLonBox box(qreal lon, qreal lat, qreal size = 2.0);
+
+    /// Adds a policy allowing a single download at a time, so that waiting jobs queue up
+    static void addSerialPolicy(HttpDownloadManager *manager);
+
+    /// The file paths requested from the server, in order
+    static QStringList requestedPaths(const TileServer &server);
+};
+
+GeoDataLatLonBox HttpDownloadManagerTest::box(qreal lon, qreal lat, qreal size)
+{
+    return GeoDataLatLonBox(lat + size / 2, lat - size / 2, lon + size / 2, lon - size / 2, GeoDataCoordinates::Degree);
+}
+
+void HttpDownloadManagerTest::addSerialPolicy(HttpDownloadManager *manager)
+{
+    DownloadPolicy policy(DownloadPolicyKey(QStringLiteral("127.0.0.1"), DownloadBrowse));
+    policy.setMaximumConnections(1);
+    manager->addDownloadPolicy(policy);
+}
+
+QStringList HttpDownloadManagerTest::requestedPaths(const TileServer &server)
+{
+    QStringList result;
+    for (const QByteArray &request : server.requests) {
+        result << QString::fromLatin1(request.split(' ').value(1));
+    }
+    return result;
+}
+
+void HttpDownloadManagerTest::revalidateTile()
+{
+    TileServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/0/0/0.png").arg(server.serverPort()));
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    FileStoragePolicy storagePolicy(directory.path());
+    HttpDownloadManager manager(&storagePolicy);
+    QSignalSpy completeSpy(&manager, SIGNAL(downloadComplete(QString, QString)));
+    QSignalSpy removedSpy(&manager, &HttpDownloadManager::jobRemoved);
+
+    const QString fileName = QStringLiteral("0/0/0.png");
+    const QString filePath = directory.path() + QLatin1StringView("/0/0/0.png");
+
+    // The first download stores the validators along with the tile
+    manager.addTileJob(url, fileName, QStringLiteral("tile"), DownloadBrowse, GeoDataLatLonBox(), 0);
+    QVERIFY(completeSpy.wait());
+    QCOMPARE(server.requests.size(), 1);
+    QVERIFY(!server.requests.at(0).contains("If-None-Match"));
+    QCOMPARE(storagePolicy.validators(fileName).eTag, QByteArray("\"v1\""));
+    QCOMPARE(storagePolicy.validators(fileName).lastModified, QByteArray("Tue, 06 Oct 2026 08:00:00 GMT"));
+
+    // Let the tile expire
+    const QDateTime expired = QDateTime::currentDateTime().addDays(-30);
+    {
+        QFile file(filePath);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(expired, QFileDevice::FileModificationTime));
+    }
+
+    // Downloading it again only refreshes the time stamp
+    removedSpy.clear();
+    manager.addTileJob(url, fileName, QStringLiteral("tile"), DownloadBrowse, GeoDataLatLonBox(), 0);
+    QVERIFY(removedSpy.wait());
+    QCOMPARE(server.requests.size(), 2);
+    QVERIFY(server.requests.at(1).contains("If-None-Match: \"v1\""));
+    QVERIFY(server.requests.at(1).contains("If-Modified-Since: Tue, 06 Oct 2026 08:00:00 GMT"));
+    QCOMPARE(completeSpy.size(), 1);
+    QVERIFY(QFileInfo(filePath).lastModified() > expired.addDays(1));
+
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), TileServer::content);
+}
+
+void HttpDownloadManagerTest::unconditionalDownload()
+{
+    TileServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/data.json").arg(server.serverPort()));
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    FileStoragePolicy storagePolicy(directory.path());
+    HttpDownloadManager manager(&storagePolicy);
+    QSignalSpy completeSpy(&manager, SIGNAL(downloadComplete(QString, QString)));
+
+    const QString fileName = QStringLiteral("data.json");
+    manager.addJob(url, fileName, QStringLiteral("data"), DownloadBrowse);
+    QVERIFY(completeSpy.wait());
+
+    // Other files are expected to be delivered in full every time, no validators are kept for them
+    QVERIFY(storagePolicy.validators(fileName).isEmpty());
+    QVERIFY(!QFileInfo::exists(directory.path() + QLatin1StringView("/data.json.validators")));
+    manager.addJob(url, fileName, QStringLiteral("data"), DownloadBrowse);
+    QVERIFY(completeSpy.wait());
+    QCOMPARE(server.requests.size(), 2);
+    QVERIFY(!server.requests.at(1).contains("If-None-Match"));
+}
+
+}
+
+void HttpDownloadManagerTest::queueOrder()
+{
+    TileServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    const QString baseUrl = QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort());
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    FileStoragePolicy storagePolicy(directory.path());
+    HttpDownloadManager manager(&storagePolicy);
+    addSerialPolicy(&manager);
+    QSignalSpy completeSpy(&manager, SIGNAL(downloadComplete(QString, QString)));
+
+    QObject view;
+    manager.setViewport(&view, box(5.0, 5.0, 10.0), 3);
+
+    // The first job is downloaded right away, the others wait for it
+    const auto addTile = [&](const QString &name, const GeoDataLatLonBox &tileBox, int tileLevel) {
+        manager.addTileJob(QUrl(baseUrl + name), name, name, DownloadBrowse, tileBox, tileLevel);
+    };
+    addTile(QStringLiteral("first"), GeoDataLatLonBox(), 3);
+    addTile(QStringLiteral("far"), box(13.0, 13.0), 3);
+    addTile(QStringLiteral("center"), box(5.0, 5.0), 3);
+    addTile(QStringLiteral("centerOtherLevel"), box(5.0, 5.0), 6);
+    addTile(QStringLiteral("border"), box(9.0, 9.0), 3);
+    QCOMPARE(manager.pendingJobCount(), 5);
+
+    QTRY_COMPARE(completeSpy.size(), 5);
+    const QStringList expected = {QStringLiteral("/first"),
+                                  QStringLiteral("/center"),
+                                  QStringLiteral("/border"),
+                                  QStringLiteral("/centerOtherLevel"),
+                                  QStringLiteral("/far")};
+    QCOMPARE(requestedPaths(server), expected);
+}
+
+void HttpDownloadManagerTest::cancelOutOfView()
+{
+    TileServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    const QString baseUrl = QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort());
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    FileStoragePolicy storagePolicy(directory.path());
+    HttpDownloadManager manager(&storagePolicy);
+    addSerialPolicy(&manager);
+    QSignalSpy completeSpy(&manager, SIGNAL(downloadComplete(QString, QString)));
+    QSignalSpy cancelledSpy(&manager, &HttpDownloadManager::downloadCancelled);
+
+    manager.addTileJob(QUrl(baseUrl + QLatin1StringView("first")), QStringLiteral("first"), QStringLiteral("first"), DownloadBrowse, GeoDataLatLonBox(), 3);
+    manager.addTileJob(QUrl(baseUrl + QLatin1StringView("browse")), QStringLiteral("browse"), QStringLiteral("browse"), DownloadBrowse, box(50.0, 50.0), 3);
+    manager.addTileJob(QUrl(baseUrl + QLatin1StringView("near")), QStringLiteral("near"), QStringLiteral("near"), DownloadBrowse, box(14.0, 5.0), 3);
+    manager.addTileJob(QUrl(baseUrl + QLatin1StringView("other")), QStringLiteral("other"), QStringLiteral("other"), DownloadBrowse, GeoDataLatLonBox(), -1);
+
+    // Only waiting browse downloads of tiles outside twice the view are dropped
+    QObject view;
+    manager.setViewport(&view, box(5.0, 5.0, 10.0), 3);
+    QCOMPARE(cancelledSpy.size(), 1);
+    QCOMPARE(cancelledSpy.at(0).at(0).toString(), QStringLiteral("browse"));
+    QCOMPARE(manager.pendingJobCount(), 3);
+
+    QTRY_COMPARE(completeSpy.size(), 3);
+    QVERIFY(!requestedPaths(server).contains(QStringLiteral("/browse")));
+}
+
+void HttpDownloadManagerTest::severalViews()
+{
+    TileServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    const QString baseUrl = QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort());
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    FileStoragePolicy storagePolicy(directory.path());
+    HttpDownloadManager manager(&storagePolicy);
+    addSerialPolicy(&manager);
+    QSignalSpy completeSpy(&manager, SIGNAL(downloadComplete(QString, QString)));
+    QSignalSpy cancelledSpy(&manager, &HttpDownloadManager::downloadCancelled);
+
+    QObject view;
+    auto otherView = new QObject;
+    manager.setViewport(&view, box(5.0, 5.0, 10.0), 3);
+    manager.setViewport(otherView, box(105.0, 5.0, 10.0), 3);
+
+    const auto addTile = [&](const QString &name, const GeoDataLatLonBox &tileBox) {
+        manager.addTileJob(QUrl(baseUrl + name), name, name, DownloadBrowse, tileBox, 3);
+    };
+    addTile(QStringLiteral("first"), GeoDataLatLonBox());
+    addTile(QStringLiteral("border"), box(9.0, 9.0));
+    addTile(QStringLiteral("otherCenter"), box(105.0, 5.0));
+    addTile(QStringLiteral("otherBorder"), box(109.0, 9.0));
+    addTile(QStringLiteral("nowhere"), box(-100.0, -50.0));
+
+    // Updating one view keeps the tiles of the other one
+    manager.setViewport(&view, box(6.0, 5.0, 10.0), 3);
+    QCOMPARE(cancelledSpy.size(), 1);
+    QCOMPARE(cancelledSpy.at(0).at(0).toString(), QStringLiteral("nowhere"));
+
+    // Tiles are as urgent as for the closest view
+    QTRY_COMPARE(completeSpy.size(), 4);
+    const QStringList expected = {QStringLiteral("/first"), QStringLiteral("/otherCenter"), QStringLiteral("/border"), QStringLiteral("/otherBorder")};
+    QCOMPARE(requestedPaths(server), expected);
+
+    // The tiles of a view that is gone are dropped
+    addTile(QStringLiteral("second"), GeoDataLatLonBox());
+    addTile(QStringLiteral("otherAgain"), box(105.0, 5.0));
+    delete otherView;
+    QCOMPARE(cancelledSpy.size(), 2);
+    QCOMPARE(cancelledSpy.at(1).at(0).toString(), QStringLiteral("otherAgain"));
+
+    QTRY_COMPARE(completeSpy.size(), 5);
+}
+
+void HttpDownloadManagerTest::cancelledTileSource()
+{
+    HttpDownloadManager manager(nullptr);
+    addSerialPolicy(&manager);
+    TileLoader tileLoader(&manager, nullptr);
+    QSignalSpy cancelledSpy(&tileLoader, &TileLoader::tileCancelled);
+
+    GeoSceneTextureTileDataset texture(QStringLiteral("texture"));
+    texture.setSourceDir(QStringLiteral("earth/bluemarble"));
+    MergedLayerDecorator decorator(&tileLoader, nullptr);
+    decorator.setTextureLayers({&texture});
+
+    // Elevation and texture tiles with the same coordinates share a download manager
+    const QString textureType = QString::fromLatin1(GeoSceneTypes::GeoSceneTextureTileType);
+    const QString url = QStringLiteral("http://127.0.0.1:1/");
+    manager.addTileJob(QUrl(url + QLatin1StringView("first")), QStringLiteral("first"), QStringLiteral("first"), DownloadBrowse, GeoDataLatLonBox(), -1);
+    manager.addTileJob(QUrl(url + QLatin1StringView("texture")),
+                       QStringLiteral("texture"),
+                       textureType + QLatin1StringView(":earth/bluemarble:3:1:2"),
+                       DownloadBrowse,
+                       box(50.0, 50.0),
+                       3);
+    manager.addTileJob(QUrl(url + QLatin1StringView("elevation")),
+                       QStringLiteral("elevation"),
+                       textureType + QLatin1StringView(":earth/srtm2:3:1:2"),
+                       DownloadBrowse,
+                       box(50.0, 50.0),
+                       3);
+
+    QObject view;
+    manager.setViewport(&view, box(5.0, 5.0, 10.0), 3);
+    QCOMPARE(cancelledSpy.size(), 2);
+
+    int textureTiles = 0;
+    for (const QList<QVariant> &arguments : std::as_const(cancelledSpy)) {
+        const auto tileId = arguments.at(0).value<TileId>();
+        QCOMPARE(tileId.zoomLevel(), 3);
+        QCOMPARE(tileId.x(), 1);
+        QCOMPARE(tileId.y(), 2);
+        if (decorator.isTextureLayerTile(tileId)) {
+            ++textureTiles;
+            QCOMPARE(tileId, TileId(QStringLiteral("earth/bluemarble"), 3, 1, 2));
+        }
+    }
+    QCOMPARE(textureTiles, 1);
+}
+
+QTEST_MAIN(Marble::HttpDownloadManagerTest)
+
+#include "HttpDownloadManagerTest.moc"
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QTest>
+
+#include "GeoDataCoordinates.h"
+#include "InverseProjectionGrid.h"
+#include "MarbleGlobal.h"
+#include "ViewportParams.h"
+
+#include <qmath.h>
+
+Q_DECLARE_METATYPE(Marble::Projection)
+
+namespace Marble
+{
+
+class InverseProjectionGridTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void geoCoordinates_data();
+    void geoCoordinates();
+};
+
+void InverseProjectionGridTest::geoCoordinates_data()
+{
+    QTest::addColumn<Marble::Projection>("projection");
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<qreal>("centerLon");
+    QTest::addColumn<qreal>("centerLat");
+
+    // The projections mapped by GenericScanlineTextureMapper
+    const QList<QPair<QString, Projection>> projections = {{QStringLiteral("Gnomonic"), Gnomonic},
+                                                           {QStringLiteral("Stereographic"), Stereographic},
+                                                           {QStringLiteral("LambertAzimuthal"), LambertAzimuthal},
+                                                           {QStringLiteral("AzimuthalEquidistant"), AzimuthalEquidistant},
+                                                           {QStringLiteral("VerticalPerspective"), VerticalPerspective}};
+
+    for (const auto &projection : projections) {
+        // The whole globe, a view of the north pole with the dateline and a zoomed view
+        QTest::addRow("%s globe", qPrintable(projection.first)) << projection.second << 120 << 0.3 << 0.2;
+        QTest::addRow("%s pole", qPrintable(projection.first)) << projection.second << 250 << M_PI << 1.4;
+        QTest::addRow("%s zoomed", qPrintable(projection.first)) << projection.second << 4000 << -1.2 << -0.7;
+    }
+}
+
+void InverseProjectionGridTest::geoCoordinates()
+{
+    QFETCH(Projection, projection);
+    QFETCH(int, radius);
+    QFETCH(qreal, centerLon);
+    QFETCH(qreal, centerLat);
+
+    const ViewportParams viewport(projection, centerLon, centerLat, radius, QSize(400, 300));
+
+    // Half a pixel on the globe, as used by GenericScanlineTextureMapper for textures that are not coarser
+    const qreal tolerance = 0.5 / radius;
+    InverseProjectionGrid grid(&viewport, tolerance);
+
+    // The blocks of rows as handed out by the row scheduler
+    const int blockHeight = 32;
+    int validPixels = 0;
+    for (int top = 0; top < viewport.height(); top += blockHeight) {
+        const QRect block(0, top, viewport.width(), qMin(blockHeight, viewport.height() - top));
+        grid.reset(block);
+
+        for (int y = block.top(); y <= block.bottom(); ++y) {
+            for (int x = block.left(); x <= block.right(); ++x) {
+                qreal exactLon;
+                qreal exactLat;
+                if (!viewport.geoCoordinates(x, y, exactLon, exactLat, GeoDataCoordinates::Radian)) {
+                    continue;
+                }
+                ++validPixels;
+
+                qreal lon;
+                qreal lat;
+                grid.geoCoordinates(x, y, lon, lat);
+                QVERIFY(lon >= -M_PI && lon <= M_PI);
+
+                qreal deltaLon = lon - exactLon;
+                if (deltaLon > M_PI) {
+                    deltaLon -= 2 * M_PI;
+                } else if (deltaLon < -M_PI) {
+                    deltaLon += 2 * M_PI;
+                }
+                deltaLon *= cos(exactLat);
+                const qreal error = sqrt(deltaLon * deltaLon + (lat - exactLat) * (lat - exactLat));
+                QVERIFY2(error <= tolerance, qPrintable(QStringLiteral("%1 at %2,%3 exceeds %4").arg(error).arg(x).arg(y).arg(tolerance)));
+            }
+        }
+    }
+    QVERIFY(validPixels > 0);
+}
+
+}
+
+QTEST_MAIN(Marble::InverseProjectionGridTest)
+
+#include "InverseProjectionGridTest.moc"
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QTest>
+
+#include "LabelAtlas.h"
+
+namespace Marble
+{
+
+class LabelAtlasTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void packing();
+    void sharedShelves();
+    void emptyLabels();
+    void eviction();
+    void pagesOfCurrentFrame();
+
+private:
+    static LabelAtlas::Key key(const QString &text, const QFont &font);
+
+    /** A label that needs more than half of a page in both directions, so that every page holds one of them */
+    LabelAtlas::Key largeKey(int index) const;
+
+    QFont m_largeFont;
+};
+
+LabelAtlas::Key LabelAtlasTest::key(const QString &text, const QFont &font)
+{
+    LabelAtlas::Key result;
+    result.text = text;
+    result.font = font;
+    result.color = Qt::black;
+    return result;
+}
+
+LabelAtlas::Key LabelAtlasTest::largeKey(int index) const
+{
+    return key(QStringLiteral("%1%1").arg(index), m_largeFont);
+}
+
+void LabelAtlasTest::initTestCase()
+{
+    m_largeFont.setPixelSize(600);
+    const QSize size = LabelAtlas::labelSize(largeKey(0));
+    QVERIFY2(size.height() > 512 && size.height() <= 1024 && size.width() > 512 && size.width() <= 1024, qPrintable(QStringLiteral("%1x%2").arg(size.width()).arg(size.height())));
+}
+
+void LabelAtlasTest::packing()
+{
+    LabelAtlas atlas;
+    QList<LabelAtlas::Key> keys;
+    for (int i = 0; i < 500; ++i) {
+        QFont font;
+        font.setPixelSize(10 + i % 7);
+        keys << key(QStringLiteral("Label %1").arg(i), font);
+    }
+
+    const QList<LabelAtlas::Entry> entries = atlas.prepare(keys);
+    QCOMPARE(entries.size(), keys.size());
+    for (int i = 0; i < entries.size(); ++i) {
+        const LabelAtlas::Entry &entry = entries.at(i);
+        QVERIFY(entry.page >= 0 && entry.page < atlas.pageCount());
+        QCOMPARE(entry.rect.size(), LabelAtlas::labelSize(keys.at(i)));
+        QVERIFY(QRect(QPoint(0, 0), atlas.page(entry.page).size()).contains(entry.rect));
+        for (int j = 0; j < i; ++j) {
+            QVERIFY(entries.at(j).page != entry.page || !entries.at(j).rect.intersects(entry.rect));
+        }
+    }
+
+    // Labels stay where they are while they fit
+    QList<LabelAtlas::Key> reversed(keys.crbegin(), keys.crend());
+    const QList<LabelAtlas::Entry> again = atlas.prepare(reversed);
+    for (int i = 0; i < again.size(); ++i) {
+        QCOMPARE(again.at(i).page, entries.at(entries.size() - 1 - i).page);
+        QCOMPARE(again.at(i).rect, entries.at(entries.size() - 1 - i).rect);
+    }
+}
+
+void LabelAtlasTest::sharedShelves()
+{
+    LabelAtlas atlas;
+    QFont font;
+    font.setPixelSize(12);
+    QFont largerFont;
+    largerFont.setPixelSize(30);
+
+    const QList<LabelAtlas::Entry> entries = atlas.prepare({key(QStringLiteral("One"), font),
+                                                            key(QStringLiteral("Two"), font),
+                                                            key(QStringLiteral("Three"), largerFont),
+                                                            key(QStringLiteral("One"), font)});
+    QCOMPARE(entries.size(), 4);
+    QCOMPARE(atlas.pageCount(), 1);
+
+    // Labels of the same font are placed side by side, much taller ones get a shelf of their own
+    QCOMPARE(entries.at(1).rect.top(), entries.at(0).rect.top());
+    QCOMPARE(entries.at(1).rect.left(), entries.at(0).rect.right() + 1);
+    QCOMPARE(entries.at(2).rect.left(), 0);
+    QVERIFY(entries.at(2).rect.top() > entries.at(0).rect.bottom());
+
+    // Placemarks with the same label share it
+    QCOMPARE(entries.at(3).page, entries.at(0).page);
+    QCOMPARE(entries.at(3).rect, entries.at(0).rect);
+}
+
+void LabelAtlasTest::emptyLabels()
+{
+    LabelAtlas atlas;
+    const QList<LabelAtlas::Entry> entries = atlas.prepare({key(QString(), QFont())});
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries.at(0).page, -1);
+    QCOMPARE(atlas.pageCount(), 0);
+}
+
+void LabelAtlasTest::eviction()
+{
+    LabelAtlas atlas;
+    const QList<LabelAtlas::Entry> entries = atlas.prepare({largeKey(0), largeKey(1), largeKey(2), largeKey(3)});
+    QCOMPARE(atlas.pageCount(), 4);
+    for (int i = 0; i < entries.size(); ++i) {
+        QCOMPARE(entries.at(i).page, i);
+    }
+
+    // The first label is used again, so the page of the second one is the least recently used
+    atlas.prepare({largeKey(0)});
+    QList<LabelAtlas::Entry> result = atlas.prepare({largeKey(4)});
+    QCOMPARE(atlas.pageCount(), 4);
+    QCOMPARE(result.at(0).page, 1);
+
+    // The second label is rendered again and takes the page of the third one
+    result = atlas.prepare({largeKey(1)});
+    QCOMPARE(atlas.pageCount(), 4);
+    QCOMPARE(result.at(0).page, 2);
+
+    // Labels on pages that were kept stay in place
+    result = atlas.prepare({largeKey(0), largeKey(3), largeKey(4)});
+    QCOMPARE(atlas.pageCount(), 4);
+    QCOMPARE(result.at(0).page, 0);
+    QCOMPARE(result.at(0).rect, entries.at(0).rect);
+    QCOMPARE(result.at(1).page, 3);
+    QCOMPARE(result.at(2).page, 1);
+
+    atlas.clear();
+    QCOMPARE(atlas.pageCount(), 0);
+}
+
+void LabelAtlasTest::pagesOfCurrentFrame()
+{
+    // Pages needed by the current frame are never cleared, the atlas grows instead
+    LabelAtlas atlas;
+    QList<LabelAtlas::Key> keys;
+    for (int i = 0; i < 6; ++i) {
+        keys << largeKey(i);
+    }
+    const QList<LabelAtlas::Entry> entries = atlas.prepare(keys);
+    QCOMPARE(atlas.pageCount(), 6);
+    for (int i = 0; i < entries.size(); ++i) {
+        QCOMPARE(entries.at(i).page, i);
+    }
+}
+
+}
+
+QTEST_MAIN(Marble::LabelAtlasTest)
+
+#include "LabelAtlasTest.moc"
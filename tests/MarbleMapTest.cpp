@@ -4,15 +4,49 @@
 //
 
 #include "MarbleMap.h"
+#include "AbstractFloatItem.h"
 #include "GeoPainter.h"
+#include "LayerInterface.h"
 #include "MarbleModel.h"
 #include "TestUtils.h"
 
+#include <QSignalSpy>
 #include <QThreadPool>
 
 namespace Marble
 {
 
+class CountingLayer : public LayerInterface
+{
+public:
+    explicit CountingLayer(const QString &renderPosition)
+        : m_renderPosition(renderPosition)
+        , m_renderCount(0)
+    {
+    }
+
+    QStringList renderPosition() const override
+    {
+        return QStringList(m_renderPosition);
+    }
+
+    bool render(GeoPainter *painter, ViewportParams *, const QString &, GeoSceneLayer *) override
+    {
+        ++m_renderCount;
+        painter->fillRect(QRect(0, 0, 50, 50), Qt::red);
+        return true;
+    }
+
+    int renderCount() const
+    {
+        return m_renderCount;
+    }
+
+private:
+    const QString m_renderPosition;
+    int m_renderCount;
+};
+
 class MarbleMapTest : public QObject
 {
     Q_OBJECT
@@ -61,6 +95,10 @@ private Q_SLOTS:
     void paint_data();
     void paint();
 
+    void backBuffers();
+
+    void visibilityMarksLayersDirty();
+
 private:
     MarbleModel m_model;
 };
@@ -589,6 +627,105 @@ void MarbleMapTest::paint()
     QThreadPool::globalInstance()->waitForDone(); // wait for all runners to terminate
 }
 
+void MarbleMapTest::backBuffers()
+{
+    MarbleMap map;
+    map.setMapThemeId(QStringLiteral("earth/plain/plain.dgml"));
+    map.setSize(200, 200);
+    map.setBackBuffersEnabled(true);
+
+    CountingLayer orbitLayer(QStringLiteral("ORBIT"));
+    CountingLayer topLayer(QStringLiteral("ALWAYS_ON_TOP"));
+    map.addLayer(&orbitLayer);
+    map.addLayer(&topLayer);
+
+    QImage image(map.size(), QImage::Format_ARGB32_Premultiplied);
+    const QRect dirtyRect(10, 10, 20, 20);
+
+    // The first repaint of a part fills the back buffers
+    for (int i = 0; i < 2; ++i) {
+        image.fill(Qt::transparent);
+        GeoPainter painter(&image, map.viewport(), map.mapQuality());
+        map.paint(painter, QRect());
+        map.setLayersDirty(QStringList(QStringLiteral("ORBIT")), dirtyRect);
+    }
+    QCOMPARE(orbitLayer.renderCount(), 2);
+    QCOMPARE(topLayer.renderCount(), 2);
+
+    QVERIFY(map.dirtyRenderPositions().contains(QStringLiteral("ORBIT")));
+    QVERIFY(!map.dirtyRenderPositions().contains(QStringLiteral("ALWAYS_ON_TOP")));
+    QVERIFY(map.dirtyRegion().contains(dirtyRect));
+
+    // Then only the dirty render position gets rendered
+    image.fill(Qt::transparent);
+    {
+        GeoPainter painter(&image, map.viewport(), map.mapQuality());
+        map.paint(painter, QRect());
+    }
+    QCOMPARE(orbitLayer.renderCount(), 3);
+    QCOMPARE(topLayer.renderCount(), 2);
+    QVERIFY(!map.dirtyRenderPositions().contains(QStringLiteral("ORBIT")));
+
+    // The layers outside of the dirty region are composed from the back buffers
+    QCOMPARE(image.pixel(40, 40), QColor(Qt::red).rgb());
+
+    // Render positions that changed completely are rendered directly
+    map.setLayersDirty(QStringList(QStringLiteral("ALWAYS_ON_TOP")));
+    image.fill(Qt::transparent);
+    {
+        GeoPainter painter(&image, map.viewport(), map.mapQuality());
+        map.paint(painter, QRect());
+    }
+    QCOMPARE(topLayer.renderCount(), 3);
+    QCOMPARE(image.pixel(40, 40), QColor(Qt::red).rgb());
+
+    map.removeLayer(&orbitLayer);
+    map.removeLayer(&topLayer);
+
+    QThreadPool::globalInstance()->waitForDone();
+}
+
+void MarbleMapTest::visibilityMarksLayersDirty()
+{
+    MarbleMap map;
+    map.setMapThemeId(QStringLiteral("earth/plain/plain.dgml"));
+    map.setSize(200, 200);
+    if (map.renderPlugins().isEmpty()) {
+        QSKIP("No render plugins installed");
+    }
+
+    QImage image(map.size(), QImage::Format_ARGB32_Premultiplied);
+    QSignalSpy repaintSpy(&map, &MarbleMap::repaintNeeded);
+
+    // Toggling a plugin has to repaint all of its render positions, not just the surface
+    for (RenderPlugin *plugin : map.renderPlugins()) {
+        if (!plugin->enabled()) {
+            continue;
+        }
+        const QStringList renderPositions = qobject_cast<AbstractFloatItem *>(plugin) ? QStringList(QStringLiteral("FLOAT_ITEM")) : plugin->renderPosition();
+
+        for (int i = 0; i < 2; ++i) {
+            {
+                GeoPainter painter(&image, map.viewport(), map.mapQuality());
+                map.paint(painter, QRect());
+            }
+            // Layers loading data may have asked for another repaint already
+            const QStringList dirtyBefore = map.dirtyRenderPositions();
+
+            repaintSpy.clear();
+            plugin->setVisible(!plugin->visible());
+            QVERIFY(!repaintSpy.isEmpty());
+            for (const QString &renderPosition : renderPositions) {
+                if (map.renderPositions().contains(renderPosition) && !dirtyBefore.contains(renderPosition)) {
+                    QVERIFY2(map.dirtyRenderPositions().contains(renderPosition), qPrintable(plugin->nameId() + QLatin1Char(' ') + renderPosition));
+                }
+            }
+        }
+    }
+
+    QThreadPool::globalInstance()->waitForDone();
+}
+
 }
 
 QTEST_MAIN(Marble::MarbleMapTest)
@@ -4,6 +4,8 @@
 //
 
 #include "MarbleWidget.h"
+#include "GeoPainter.h"
+#include "LayerInterface.h"
 #include "MarbleDirs.h"
 #include "TestUtils.h"
 #include <QTestEvent>
@@ -15,6 +17,37 @@
 namespace Marble
 {
 
+class CountingWidgetLayer : public LayerInterface
+{
+public:
+    explicit CountingWidgetLayer(const QString &renderPosition)
+        : m_renderPosition(renderPosition)
+        , m_renderCount(0)
+    {
+    }
+
+    QStringList renderPosition() const override
+    {
+        return QStringList(m_renderPosition);
+    }
+
+    bool render(GeoPainter *painter, ViewportParams *, const QString &, GeoSceneLayer *) override
+    {
+        ++m_renderCount;
+        painter->fillRect(QRect(0, 0, 20, 20), Qt::red);
+        return true;
+    }
+
+    int renderCount() const
+    {
+        return m_renderCount;
+    }
+
+private:
+    const QString m_renderPosition;
+    int m_renderCount;
+};
+
 class MarbleWidgetTest : public QObject
 {
     Q_OBJECT
@@ -42,6 +75,8 @@ private Q_SLOTS:
     void paintEvent();
 
     void runMultipleWidgets();
+
+    void repaintLayers();
 };
 
 void MarbleWidgetTest::initTestCase()
@@ -135,6 +170,38 @@ void MarbleWidgetTest::runMultipleWidgets()
     QThreadPool::globalInstance()->waitForDone();
 }
 
+void MarbleWidgetTest::repaintLayers()
+{
+    MarbleWidget widget;
+    widget.setMapThemeId(QStringLiteral("earth/plain/plain.dgml"));
+    widget.resize(200, 200);
+
+    CountingWidgetLayer orbitLayer(QStringLiteral("ORBIT"));
+    CountingWidgetLayer topLayer(QStringLiteral("ALWAYS_ON_TOP"));
+    widget.addLayer(&orbitLayer);
+    widget.addLayer(&topLayer);
+
+    widget.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&widget));
+    QTRY_VERIFY(topLayer.renderCount() > 0);
+    QTest::qWait(500);
+
+    // The layers that did not change are composed from their back buffers
+    const int orbitCount = orbitLayer.renderCount();
+    const int topCount = topLayer.renderCount();
+    widget.repaintLayers(QStringList(QStringLiteral("ORBIT")));
+    QTRY_VERIFY(orbitLayer.renderCount() > orbitCount);
+    QCOMPARE(topLayer.renderCount(), topCount);
+
+    // Nothing tells what changed for other repaints, so all layers get rendered
+    widget.update();
+    QTRY_VERIFY(topLayer.renderCount() > topCount);
+
+    widget.removeLayer(&orbitLayer);
+    widget.removeLayer(&topLayer);
+    QThreadPool::globalInstance()->waitForDone();
+}
+
 }
 
 QTEST_MAIN(Marble::MarbleWidgetTest)
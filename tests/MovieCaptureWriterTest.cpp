@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThread>
+
+#include "MovieCaptureWriter.h"
+
+#include <memory>
+
+namespace Marble
+{
+
+class MovieCaptureWriterTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void packedRows();
+    void dropAndWait();
+    void cancelWhileWaiting();
+
+private:
+    /** A frame whose pixels encode their position and @p index */
+    static QImage frame(int index, QImage::Format format = QImage::Format_ARGB32);
+
+    /** The frame as the encoder expects it, rgb24 without any row padding */
+    static QByteArray packed(const QImage &frame);
+
+    /** Fills the queue of @p writer while the encoder does not read, returns the number of frames accepted */
+    static int fillQueue(MovieCaptureWriter &writer);
+
+    QString goFile() const;
+
+    std::unique_ptr<QTemporaryDir> m_dir;
+    QString m_encoder;
+    QString m_destination;
+};
+
+// Odd, so that the rows of RGB888 images are padded
+static const QSize frameSize(101, 67);
+
+void MovieCaptureWriterTest::init()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The stub encoder is a shell script");
+#endif
+
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+    m_encoder = m_dir->filePath(QStringLiteral("encoder"));
+    m_destination = m_dir->filePath(QStringLiteral("movie"));
+
+    // Stands in for avconv/ffmpeg: once the go file exists, it copies the frames to the destination, the last argument
+    QFile encoder(m_encoder);
+    QVERIFY(encoder.open(QIODevice::WriteOnly));
+    encoder.write(
+        "#!/bin/sh\n"
+        "for destination; do :; done\n"
+        "while [ ! -e \"$0.go\" ]; do sleep 0.01; done\n"
+        "exec cat > \"$destination\"\n");
+    encoder.close();
+    QVERIFY(encoder.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ExeOwner));
+}
+
+QString MovieCaptureWriterTest::goFile() const
+{
+    return m_encoder + QStringLiteral(".go");
+}
+
+QImage MovieCaptureWriterTest::frame(int index, QImage::Format format)
+{
+    QImage result(frameSize, QImage::Format_ARGB32);
+    for (int y = 0; y < result.height(); ++y) {
+        for (int x = 0; x < result.width(); ++x) {
+            result.setPixel(x, y, qRgb((2 * x + index) % 256, (3 * y + index) % 256, (7 * index) % 256));
+        }
+    }
+    return result.convertToFormat(format);
+}
+
+QByteArray MovieCaptureWriterTest::packed(const QImage &frame)
+{
+    QByteArray result;
+    for (int y = 0; y < frame.height(); ++y) {
+        for (int x = 0; x < frame.width(); ++x) {
+            const QRgb pixel = frame.pixel(x, y);
+            result.append(char(qRed(pixel)));
+            result.append(char(qGreen(pixel)));
+            result.append(char(qBlue(pixel)));
+        }
+    }
+    return result;
+}
+
+int MovieCaptureWriterTest::fillQueue(MovieCaptureWriter &writer)
+{
+    // The frames being written fill the pipe, the queue fills up behind them
+    int accepted = 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (!writer.enqueue(frame(accepted), false)) {
+            return accepted;
+        }
+        ++accepted;
+        QThread::msleep(5);
+    }
+    return -1;
+}
+
+void MovieCaptureWriterTest::packedRows()
+{
+    QFile go(goFile());
+    QVERIFY(go.open(QIODevice::WriteOnly));
+    go.close();
+
+    MovieCaptureWriter writer;
+    QSignalSpy writtenSpy(&writer, &MovieCaptureWriter::movieWritten);
+    writer.start(m_encoder, m_destination, 25);
+
+    const QList<QImage> frames = {frame(0), frame(1, QImage::Format_RGB32), frame(2, QImage::Format_RGB888)};
+    QByteArray expected;
+    for (const QImage &image : frames) {
+        QVERIFY(writer.enqueue(image, true));
+        expected += packed(image);
+    }
+    writer.finish();
+    QVERIFY(writer.wait(30000));
+
+    QCOMPARE(writtenSpy.size(), 1);
+    QCOMPARE(writtenSpy.at(0).at(0).toInt(), 0);
+
+    QFile movie(m_destination);
+    QVERIFY(movie.open(QIODevice::ReadOnly));
+    const QByteArray data = movie.readAll();
+    QCOMPARE(data.size(), qsizetype(3) * frameSize.width() * frameSize.height() * 3);
+    QVERIFY(data == expected);
+}
+
+void MovieCaptureWriterTest::dropAndWait()
+{
+    MovieCaptureWriter writer;
+    QSignalSpy writtenSpy(&writer, &MovieCaptureWriter::movieWritten);
+    writer.start(m_encoder, m_destination, 25);
+
+    // Time driven recordings drop frames once the queue is full
+    const int accepted = fillQueue(writer);
+    QVERIFY(accepted >= MovieCaptureWriter::queueCapacity);
+
+    // Data driven recordings wait for room instead
+    bool enqueued = false;
+    QThread *const thread = QThread::create([&writer, &enqueued, accepted]() {
+        enqueued = writer.enqueue(frame(accepted), true);
+    });
+    thread->start();
+    QVERIFY(!thread->wait(300));
+
+    QFile go(goFile());
+    QVERIFY(go.open(QIODevice::WriteOnly));
+    go.close();
+    QVERIFY(thread->wait(30000));
+    delete thread;
+    QVERIFY(enqueued);
+
+    writer.finish();
+    QVERIFY(writer.wait(30000));
+    QCOMPARE(writtenSpy.size(), 1);
+    QCOMPARE(writtenSpy.at(0).at(0).toInt(), 0);
+
+    // All frames accepted are written in order, none of the dropped ones
+    QByteArray expected;
+    for (int i = 0; i <= accepted; ++i) {
+        expected += packed(frame(i));
+    }
+    QFile movie(m_destination);
+    QVERIFY(movie.open(QIODevice::ReadOnly));
+    const QByteArray data = movie.readAll();
+    QCOMPARE(data.size(), expected.size());
+    QVERIFY(data == expected);
+}
+
+void MovieCaptureWriterTest::cancelWhileWaiting()
+{
+    MovieCaptureWriter writer;
+    QSignalSpy writtenSpy(&writer, &MovieCaptureWriter::movieWritten);
+    writer.start(m_encoder, m_destination, 25);
+    QVERIFY(fillQueue(writer) >= MovieCaptureWriter::queueCapacity);
+
+    bool enqueued = true;
+    QThread *const thread = QThread::create([&writer, &enqueued]() {
+        enqueued = writer.enqueue(frame(0), true);
+    });
+    thread->start();
+    QVERIFY(!thread->wait(300));
+
+    // Canceling releases the recording and the writer, although the encoder never reads
+    writer.cancel();
+    QVERIFY(thread->wait(30000));
+    delete thread;
+    QVERIFY(enqueued);
+    QVERIFY(writer.isFinished());
+    QCOMPARE(writtenSpy.size(), 0);
+}
+
+}
+
+QTEST_MAIN(Marble::MovieCaptureWriterTest)
+
+#include "MovieCaptureWriterTest.moc"
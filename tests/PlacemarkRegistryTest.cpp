@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QTest>
+
+#include "PlacemarkRegistry.h"
+
+#include "GeoDataDocument.h"
+#include "GeoDataFolder.h"
+#include "GeoDataGroundOverlay.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPoint.h"
+#include "GeoDataTreeModel.h"
+
+namespace Marble
+{
+
+class PlacemarkRegistryTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void addAndRemove();
+    void existingDocuments();
+    void reset();
+};
+
+namespace
+{
+GeoDataPlacemark *createPlacemark(bool lineString)
+{
+    auto placemark = new GeoDataPlacemark;
+    if (lineString) {
+        auto line = new GeoDataLineString;
+        line->append(GeoDataCoordinates(0, 0));
+        line->append(GeoDataCoordinates(1, 1));
+        placemark->setGeometry(line);
+    } else {
+        placemark->setCoordinate(GeoDataCoordinates(0, 0));
+    }
+    return placemark;
+}
+}
+
+void PlacemarkRegistryTest::addAndRemove()
+{
+    GeoDataTreeModel model;
+    PlacemarkRegistry registry(&model);
+
+    QList<const GeoDataPlacemark *> added;
+    QList<const GeoDataPlacemark *> removed;
+    QList<const GeoDataOverlay *> addedOverlays;
+    int addedSignals = 0;
+    connect(&registry, &PlacemarkRegistry::placemarksAdded, this, [&](const QList<const GeoDataPlacemark *> &placemarks) {
+        added += placemarks;
+        ++addedSignals;
+    });
+    connect(&registry, &PlacemarkRegistry::placemarksRemoved, this, [&](const QList<const GeoDataPlacemark *> &placemarks) {
+        removed += placemarks;
+    });
+    connect(&registry, &PlacemarkRegistry::overlaysAdded, this, [&](const QList<const GeoDataOverlay *> &overlays) {
+        addedOverlays += overlays;
+    });
+
+    auto document = new GeoDataDocument;
+    auto folder = new GeoDataFolder;
+    for (int i = 0; i < 10; ++i) {
+        document->append(createPlacemark(i % 2 == 0));
+        folder->append(createPlacemark(false));
+    }
+    document->append(folder);
+    document->append(new GeoDataGroundOverlay);
+
+    // The whole document is reported at once
+    model.addDocument(document);
+    QCOMPARE(addedSignals, 1);
+    QCOMPARE(added.size(), 20);
+    QCOMPARE(addedOverlays.size(), 1);
+    QCOMPARE(registry.placemarkCount(), 20);
+    QCOMPARE(registry.placemarks().size(), 20);
+    QCOMPARE(registry.placemarks(GeoDataLineStringId).size(), 5);
+    QCOMPARE(registry.placemarks(GeoDataPointId).size(), 15);
+    QCOMPARE(registry.placemarks(GeoDataPolygonId).size(), 0);
+    QCOMPARE(registry.overlays().size(), 1);
+
+    // Single placemarks are reported as they come in
+    auto placemark = createPlacemark(true);
+    model.addFeature(folder, placemark);
+    QCOMPARE(addedSignals, 2);
+    QVERIFY(added.last() == placemark);
+    QCOMPARE(registry.placemarks(GeoDataLineStringId).size(), 6);
+
+    // Removing a folder reports all placemarks in it
+    QVERIFY(model.removeFeature(folder) >= 0);
+    QCOMPARE(removed.size(), 11);
+    QVERIFY(removed.contains(placemark));
+    QCOMPARE(registry.placemarkCount(), 10);
+    QCOMPARE(registry.placemarks(GeoDataPointId).size(), 5);
+    QCOMPARE(registry.placemarks(GeoDataLineStringId).size(), 5);
+    QVERIFY(!registry.placemarks().contains(placemark));
+    delete folder;
+
+    model.removeDocument(document);
+    QCOMPARE(removed.size(), 21);
+    QCOMPARE(registry.placemarkCount(), 0);
+    QCOMPARE(registry.overlays().size(), 0);
+    delete document;
+}
+
+void PlacemarkRegistryTest::existingDocuments()
+{
+    GeoDataTreeModel model;
+    auto document = new GeoDataDocument;
+    document->append(createPlacemark(false));
+    document->append(createPlacemark(true));
+    model.addDocument(document);
+
+    const PlacemarkRegistry registry(&model);
+    QCOMPARE(registry.placemarkCount(), 2);
+    QCOMPARE(registry.placemarks(GeoDataPointId).size(), 1);
+    QCOMPARE(registry.placemarks(GeoDataLineStringId).size(), 1);
+}
+
+void PlacemarkRegistryTest::reset()
+{
+    GeoDataTreeModel model;
+    PlacemarkRegistry registry(&model);
+    auto document = new GeoDataDocument;
+    document->append(createPlacemark(false));
+    model.addDocument(document);
+    QCOMPARE(registry.placemarkCount(), 1);
+
+    int resets = 0;
+    connect(&registry, &PlacemarkRegistry::reset, this, [&resets]() {
+        ++resets;
+    });
+
+    GeoDataDocument root;
+    root.append(createPlacemark(true));
+    root.append(createPlacemark(true));
+    model.setRootDocument(&root);
+    QCOMPARE(resets, 1);
+    QCOMPARE(registry.placemarkCount(), 2);
+    QCOMPARE(registry.placemarks(GeoDataLineStringId).size(), 2);
+
+    model.setRootDocument(nullptr);
+    QCOMPARE(resets, 2);
+    QCOMPARE(registry.placemarkCount(), 0);
+}
+
+}
+
+QTEST_MAIN(Marble::PlacemarkRegistryTest)
+
+#include "PlacemarkRegistryTest.moc"
@@ -5,8 +5,14 @@
 
 #include "PluginManager.h"
 #include "MarbleDirs.h"
+#include "ParseRunnerPlugin.h"
 
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QPluginLoader>
+#include <QSet>
 #include <QTest>
+#include <QThreadPool>
 
 namespace Marble
 {
@@ -16,6 +22,9 @@ class PluginManagerTest : public QObject
     Q_OBJECT
 private Q_SLOTS:
     void loadPlugins();
+    void parsingRunnerPluginsForFile();
+    void parsingRunnerPluginsFromThreads();
+    void fileExtensionsMetaData();
 };
 
 void PluginManagerTest::loadPlugins()
@@ -38,6 +47,87 @@ void PluginManagerTest::loadPlugins()
     QCOMPARE(renderPlugins + positionPlugins + runnerPlugins, pluginNumber);
 }
 
+void PluginManagerTest::parsingRunnerPluginsForFile()
+{
+    MarbleDirs::setMarbleDataPath(DATA_PATH);
+    MarbleDirs::setMarblePluginPath(PLUGIN_PATH);
+
+    PluginManager pm;
+    const QList<const ParseRunnerPlugin *> kmlPlugins = pm.parsingRunnerPlugins(QStringLiteral("/tmp/Test.KML"));
+    for (const ParseRunnerPlugin *plugin : kmlPlugins) {
+        const QStringList extensions = plugin->fileExtensions();
+        QVERIFY(extensions.isEmpty() || extensions.contains(QStringLiteral("kml")));
+    }
+
+    // Loading the remaining plugins later on must not report the ones already loaded twice
+    const QList<const ParseRunnerPlugin *> allPlugins = pm.parsingRunnerPlugins();
+    QCOMPARE(QSet<const ParseRunnerPlugin *>(allPlugins.constBegin(), allPlugins.constEnd()).size(), allPlugins.size());
+    for (const ParseRunnerPlugin *plugin : kmlPlugins) {
+        QVERIFY(allPlugins.contains(plugin));
+    }
+    QCOMPARE(pm.parsingRunnerPlugins(QStringLiteral("Test.kml")), kmlPlugins);
+}
+
+void PluginManagerTest::parsingRunnerPluginsFromThreads()
+{
+    MarbleDirs::setMarbleDataPath(DATA_PATH);
+    MarbleDirs::setMarblePluginPath(PLUGIN_PATH);
+
+    PluginManager pm;
+    const QStringList fileNames = {QStringLiteral("Test.kml"), QStringLiteral("Test.gpx"), QStringLiteral("Test.osm"), QStringLiteral("Test.o5m")};
+    QList<QList<const ParseRunnerPlugin *>> results(16);
+
+    // Vector tiles look up parse runners from the thread pool
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    for (int i = 0; i < results.size(); ++i) {
+        pool.start([&pm, &results, &fileNames, i]() {
+            results[i] = pm.parsingRunnerPlugins(fileNames[i % fileNames.size()]);
+        });
+    }
+    pool.waitForDone();
+
+    for (int i = 0; i < results.size(); ++i) {
+        QCOMPARE(results[i], pm.parsingRunnerPlugins(fileNames[i % fileNames.size()]));
+        for (const ParseRunnerPlugin *plugin : std::as_const(results[i])) {
+            QCOMPARE(plugin->thread(), pm.thread());
+        }
+    }
+
+    const QList<const ParseRunnerPlugin *> allPlugins = pm.parsingRunnerPlugins();
+    QCOMPARE(QSet<const ParseRunnerPlugin *>(allPlugins.constBegin(), allPlugins.constEnd()).size(), allPlugins.size());
+}
+
+void PluginManagerTest::fileExtensionsMetaData()
+{
+    MarbleDirs::setMarbleDataPath(DATA_PATH);
+    MarbleDirs::setMarblePluginPath(PLUGIN_PATH);
+
+    // Parse runners are chosen by the extensions of their metadata before they are loaded
+    int parseRunners = 0;
+    const QStringList fileNames = MarbleDirs::pluginEntryList(QString(), QDir::Files);
+    for (const QString &fileName : fileNames) {
+        QPluginLoader loader(MarbleDirs::pluginPath(fileName));
+        const QJsonObject metaData = loader.metaData().value(QLatin1StringView("MetaData")).toObject();
+        if (metaData.value(QLatin1StringView("Type")).toString() != QLatin1StringView("ParseRunnerPlugin")) {
+            continue;
+        }
+
+        const auto plugin = qobject_cast<const ParseRunnerPlugin *>(loader.instance());
+        QVERIFY2(plugin, qPrintable(fileName));
+        ++parseRunners;
+
+        QSet<QString> declared;
+        const QJsonArray extensions = metaData.value(QLatin1StringView("FileExtensions")).toArray();
+        for (const QJsonValue &extension : extensions) {
+            declared << extension.toString();
+        }
+        const QStringList implemented = plugin->fileExtensions();
+        QCOMPARE(declared, QSet<QString>(implemented.constBegin(), implemented.constEnd()));
+    }
+    QVERIFY(parseRunners > 0);
+}
+
 }
 
 QTEST_MAIN(Marble::PluginManagerTest)
@@ -0,0 +1,600 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QItemSelectionModel>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "ClipPainter.h"
+#include "FileStoragePolicy.h"
+#include "GeoDataDocument.h"
+#include "GeoDataLatLonBox.h"
+#include "GeoDataLineString.h"
+#include "GeoDataParser.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataTreeModel.h"
+#include "GeoGraphicsScene.h"
+#include "GeoLineStringGraphicsItem.h"
+#include "GeoSceneTextureTileDataset.h"
+#include "HttpDownloadManager.h"
+#include "MarbleClock.h"
+#include "MarbleDirs.h"
+#include "MarbleMath.h"
+#include "MergedLayerDecorator.h"
+#include "ParsingRunnerManager.h"
+#include "PlacemarkLayout.h"
+#include "PlacemarkRegistry.h"
+#include "PluginManager.h"
+#include "ScanlineTextureMapperContext.h"
+#include "StackedTileLoader.h"
+#include "StyleBuilder.h"
+#include "TileLoader.h"
+#include "ViewportParams.h"
+#include "marble_version.h"
+
+#include "AbstractProjection.h"
+
+#include <algorithm>
+
+Q_DECLARE_METATYPE(Marble::Projection)
+
+namespace Marble
+{
+
+/**
+ * Collects the timings of the benchmarks. If the environment variable
+ * MARBLE_BENCHMARK_JSON names a file, the results are written to it as JSON
+ * once all benchmarks ran, so that releases can be compared to each other.
+ */
+class BenchmarkLog
+{
+public:
+    /// Times one iteration of a QBENCHMARK body
+    class Iteration
+    {
+    public:
+        explicit Iteration(BenchmarkLog &log)
+            : m_log(log)
+        {
+            m_timer.start();
+        }
+
+        ~Iteration()
+        {
+            m_log.m_samples << m_timer.nsecsElapsed();
+        }
+
+    private:
+        BenchmarkLog &m_log;
+        QElapsedTimer m_timer;
+    };
+
+    /**
+     * Stores the iterations timed since the last call as the result of the
+     * current benchmark, along with the amount of work done per iteration.
+     * QTest runs a benchmark repeatedly until its results are stable, so
+     * each run replaces the result of the previous one.
+     */
+    void record(qint64 workload);
+
+    bool save(const QString &fileName) const;
+
+private:
+    QList<qint64> m_samples;
+    QMap<QString, QJsonObject> m_results;
+};
+
+void BenchmarkLog::record(qint64 workload)
+{
+    if (m_samples.isEmpty()) {
+        return;
+    }
+
+    std::sort(m_samples.begin(), m_samples.end());
+    qint64 total = 0;
+    for (qint64 sample : std::as_const(m_samples)) {
+        total += sample;
+    }
+
+    const QString function = QString::fromLatin1(QTest::currentTestFunction());
+    const QString row = QString::fromLatin1(QTest::currentDataTag());
+    QJsonObject result;
+    result[QStringLiteral("benchmark")] = function;
+    result[QStringLiteral("row")] = row;
+    result[QStringLiteral("iterations")] = m_samples.size();
+    result[QStringLiteral("minimumNs")] = m_samples.first();
+    result[QStringLiteral("medianNs")] = m_samples.at(m_samples.size() / 2);
+    result[QStringLiteral("meanNs")] = total / m_samples.size();
+    result[QStringLiteral("workload")] = workload;
+    m_results.insert(function + QLatin1Char('/') + row, result);
+
+    m_samples.clear();
+}
+
+bool BenchmarkLog::save(const QString &fileName) const
+{
+    QJsonArray results;
+    for (const QJsonObject &result : m_results) {
+        results.append(result);
+    }
+
+    QJsonObject log;
+    log[QStringLiteral("marbleVersion")] = QStringLiteral(MARBLE_VERSION_STRING);
+    log[QStringLiteral("qtVersion")] = QString::fromLatin1(qVersion());
+    log[QStringLiteral("date")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    log[QStringLiteral("results")] = results;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray data = QJsonDocument(log).toJson();
+    return file.write(data) == data.size();
+}
+
+/**
+ * Benchmarks of the code paths that dominate rendering, on fixtures bundled
+ * with the tests: the srtm tiles of the source tree and the files in
+ * data/benchmark, which generate-fixtures.py creates reproducibly.
+ */
+class RenderBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void textureSampling_data();
+    void textureSampling();
+
+    void lineStringScreenCoordinates_data();
+    void lineStringScreenCoordinates();
+
+    void clipPolygons_data();
+    void clipPolygons();
+
+    void placemarkLayout_data();
+    void placemarkLayout();
+
+    void createStyle_data();
+    void createStyle();
+
+    void parseKml();
+    void parseO5m();
+
+    void sceneItems_data();
+    void sceneItems();
+
+private:
+    BenchmarkLog m_log;
+
+    GeoDataTreeModel *m_treeModel = nullptr;
+    GeoDataDocument *m_document = nullptr;
+    QList<const GeoDataLineString *> m_lineStrings;
+
+    PluginManager *m_pluginManager = nullptr;
+    FileStoragePolicy *m_storagePolicy = nullptr;
+    HttpDownloadManager *m_downloadManager = nullptr;
+    GeoSceneTextureTileDataset *m_textureDataset = nullptr;
+    TileLoader *m_tileLoader = nullptr;
+    MergedLayerDecorator *m_layerDecorator = nullptr;
+    StackedTileLoader *m_stackedTileLoader = nullptr;
+
+    StyleBuilder m_styleBuilder;
+    QList<GeoDataPlacemark *> m_stylePlacemarks;
+};
+
+namespace
+{
+
+QString fixturePath(const QString &fileName)
+{
+    return QStringLiteral(TESTSRCDIR "/data/benchmark/") + fileName;
+}
+
+/**
+ * Maps the whole globe to @p canvas like the equirectangular texture mapper
+ * does, interpolating @p step pixels between two exactly sampled ones.
+ */
+void mapTexture(StackedTileLoader *tileLoader, int tileLevel, bool highQuality, int step, QImage &canvas)
+{
+    ScanlineTextureMapperContext context(tileLoader, tileLevel);
+    const int width = canvas.width();
+    const qreal pixel2Rad = 2 * M_PI / width;
+
+    for (int y = 0; y < canvas.height(); ++y) {
+        auto scanLine = reinterpret_cast<QRgb *>(canvas.scanLine(y));
+        const qreal lat = M_PI / 2 - (y + 0.5) * pixel2Rad;
+        qreal lon = -M_PI;
+
+        for (int x = 0; x < width; ++x) {
+            if (step > 1 && x > 0 && x + step - 1 < width) {
+                x += step - 1;
+                lon += (step - 1) * pixel2Rad;
+                if (highQuality) {
+                    context.pixelValueApproxF(lon, lat, scanLine, step);
+                } else {
+                    context.pixelValueApprox(lon, lat, scanLine, step);
+                }
+                scanLine += step - 1;
+            }
+
+            if (highQuality) {
+                context.pixelValueF(lon, lat, scanLine);
+            } else {
+                context.pixelValue(lon, lat, scanLine);
+            }
+
+            ++scanLine;
+            lon += pixel2Rad;
+        }
+    }
+}
+
+/// Returns random walks of @p count points each, within @p area
+QList<QPolygonF> randomWalks(int walks, int count, const QRectF &area)
+{
+    QRandomGenerator random(1492);
+    QList<QPolygonF> result;
+    for (int i = 0; i < walks; ++i) {
+        QPolygonF polygon;
+        QPointF point(area.left() + random.bounded(area.width()), area.top() + random.bounded(area.height()));
+        for (int j = 0; j < count; ++j) {
+            point += QPointF(random.bounded(40.0) - 20.0, random.bounded(40.0) - 20.0);
+            point.setX(qBound(area.left(), point.x(), area.right()));
+            point.setY(qBound(area.top(), point.y(), area.bottom()));
+            polygon << point;
+        }
+        result << polygon;
+    }
+    return result;
+}
+
+}
+
+void RenderBenchmark::initTestCase()
+{
+    MarbleDirs::setMarbleDataPath(DATA_PATH);
+    MarbleDirs::setMarblePluginPath(PLUGIN_PATH);
+
+    QFile file(fixturePath(QStringLiteral("benchmark.kml")));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    GeoDataParser parser(GeoData_KML);
+    QVERIFY(parser.read(&file));
+    m_document = dynamic_cast<GeoDataDocument *>(parser.releaseDocument());
+    QVERIFY(m_document);
+
+    for (const GeoDataPlacemark *placemark : m_document->placemarkList()) {
+        if (const auto lineString = geodata_cast<GeoDataLineString>(placemark->geometry())) {
+            m_lineStrings << lineString;
+        }
+    }
+    QCOMPARE(m_lineStrings.size(), 150);
+
+    // The tree model owns the document from now on
+    m_treeModel = new GeoDataTreeModel;
+    m_treeModel->addDocument(m_document);
+
+    // The tiles are read from the source tree, nothing gets downloaded
+    m_textureDataset = new GeoSceneTextureTileDataset(QStringLiteral("srtm"));
+    m_textureDataset->setSourceDir(QStringLiteral(MARBLE_SRC_DIR "/data/maps/earth/srtm"));
+    m_textureDataset->setFileFormat(QStringLiteral("JPG"));
+    m_textureDataset->setMaximumTileLevel(2);
+    // Blending turns the grayscale tiles into 32 bit ones, like those of most themes
+    m_textureDataset->setBlending(QStringLiteral("OverpaintBlending"));
+
+    m_pluginManager = new PluginManager;
+    m_storagePolicy = new FileStoragePolicy(MarbleDirs::localPath());
+    m_downloadManager = new HttpDownloadManager(m_storagePolicy);
+    m_tileLoader = new TileLoader(m_downloadManager, m_pluginManager);
+    m_layerDecorator = new MergedLayerDecorator(m_tileLoader, nullptr);
+    m_layerDecorator->setTextureLayers({m_textureDataset});
+    m_stackedTileLoader = new StackedTileLoader(m_layerDecorator);
+
+    for (int i = GeoDataPlacemark::Default; i < GeoDataPlacemark::LastIndex; ++i) {
+        auto placemark = new GeoDataPlacemark(QStringLiteral("Placemark %1").arg(i));
+        placemark->setCoordinate(GeoDataCoordinates(13.4, 52.5, 0, GeoDataCoordinates::Degree));
+        placemark->setVisualCategory(GeoDataPlacemark::GeoDataVisualCategory(i));
+        m_stylePlacemarks << placemark;
+    }
+}
+
+void RenderBenchmark::cleanupTestCase()
+{
+    const QString fileName = qEnvironmentVariable("MARBLE_BENCHMARK_JSON");
+    if (!fileName.isEmpty()) {
+        QVERIFY2(m_log.save(fileName), qPrintable(fileName));
+    }
+
+    qDeleteAll(m_stylePlacemarks);
+    delete m_stackedTileLoader;
+    delete m_layerDecorator;
+    delete m_tileLoader;
+    delete m_downloadManager;
+    delete m_storagePolicy;
+    delete m_pluginManager;
+    delete m_textureDataset;
+    delete m_treeModel;
+}
+
+void RenderBenchmark::textureSampling_data()
+{
+    QTest::addColumn<int>("tileLevel");
+    QTest::addColumn<bool>("highQuality");
+    QTest::addColumn<int>("step");
+
+    QTest::newRow("level 1, nearest") << 1 << false << 1;
+    QTest::newRow("level 1, bilinear") << 1 << true << 1;
+    QTest::newRow("level 2, nearest") << 2 << false << 1;
+    QTest::newRow("level 2, bilinear") << 2 << true << 1;
+    QTest::newRow("level 2, nearest, interpolated") << 2 << false << 8;
+    QTest::newRow("level 2, bilinear, interpolated") << 2 << true << 8;
+}
+
+void RenderBenchmark::textureSampling()
+{
+    QFETCH(int, tileLevel);
+    QFETCH(bool, highQuality);
+    QFETCH(int, step);
+
+    QImage canvas(1024, 512, QImage::Format_ARGB32_Premultiplied);
+
+    // Loads the tiles, which stay cached while they are in use
+    mapTexture(m_stackedTileLoader, tileLevel, highQuality, step, canvas);
+
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        mapTexture(m_stackedTileLoader, tileLevel, highQuality, step, canvas);
+    }
+    m_log.record(qint64(canvas.width()) * canvas.height());
+
+    m_stackedTileLoader->clear();
+}
+
+void RenderBenchmark::lineStringScreenCoordinates_data()
+{
+    QTest::addColumn<Projection>("projection");
+
+    QTest::newRow("Spherical") << Spherical;
+    QTest::newRow("Equirectangular") << Equirectangular;
+    QTest::newRow("Mercator") << Mercator;
+    QTest::newRow("Gnomonic") << Gnomonic;
+    QTest::newRow("Stereographic") << Stereographic;
+    QTest::newRow("LambertAzimuthal") << LambertAzimuthal;
+    QTest::newRow("AzimuthalEquidistant") << AzimuthalEquidistant;
+    QTest::newRow("VerticalPerspective") << VerticalPerspective;
+}
+
+void RenderBenchmark::lineStringScreenCoordinates()
+{
+    QFETCH(Projection, projection);
+
+    const ViewportParams viewport(projection, 20 * DEG2RAD, 30 * DEG2RAD, 400, QSize(1024, 768));
+    const AbstractProjection *const abstractProjection = viewport.currentProjection();
+
+    int polygonCount = 0;
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        polygonCount = 0;
+        for (const GeoDataLineString *lineString : std::as_const(m_lineStrings)) {
+            QList<QPolygonF *> polygons;
+            abstractProjection->screenCoordinates(*lineString, &viewport, polygons);
+            polygonCount += polygons.size();
+            qDeleteAll(polygons);
+        }
+    }
+    QVERIFY(polygonCount > 0);
+    m_log.record(m_lineStrings.size());
+}
+
+void RenderBenchmark::clipPolygons_data()
+{
+    QTest::addColumn<bool>("closed");
+    QTest::addColumn<QRectF>("area");
+
+    const QRectF inside(0, 0, 1024, 768);
+    const QRectF crossing(-1024, -768, 3072, 2304);
+    QTest::newRow("polylines inside") << false << inside;
+    QTest::newRow("polylines crossing") << false << crossing;
+    QTest::newRow("polygons inside") << true << inside;
+    QTest::newRow("polygons crossing") << true << crossing;
+}
+
+void RenderBenchmark::clipPolygons()
+{
+    QFETCH(bool, closed);
+    QFETCH(QRectF, area);
+
+    const QList<QPolygonF> polygons = randomWalks(200, 500, area);
+    QImage image(1024, 768, QImage::Format_ARGB32_Premultiplied);
+    ClipPainter painter(&image, true);
+    // Nothing gets rasterized, so that the clipping is measured alone
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::NoBrush);
+
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        for (const QPolygonF &polygon : polygons) {
+            if (closed) {
+                painter.drawPolygon(polygon);
+            } else {
+                painter.drawPolyline(polygon);
+            }
+        }
+    }
+    m_log.record(polygons.size());
+}
+
+void RenderBenchmark::placemarkLayout_data()
+{
+    QTest::addColumn<qreal>("lon");
+    QTest::addColumn<qreal>("lat");
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<int>("tileLevel");
+
+    QTest::newRow("globe") << 0.0 << 0.0 << 300 << 3;
+    QTest::newRow("Europe") << 13.4 << 52.5 << 2500 << 6;
+    QTest::newRow("date line") << 180.0 << -20.0 << 1200 << 5;
+}
+
+void RenderBenchmark::placemarkLayout()
+{
+    QFETCH(qreal, lon);
+    QFETCH(qreal, lat);
+    QFETCH(int, radius);
+    QFETCH(int, tileLevel);
+
+    PlacemarkRegistry registry(m_treeModel);
+    QItemSelectionModel selectionModel(m_treeModel);
+    MarbleClock clock;
+    PlacemarkLayout layout(&registry, &selectionModel, &clock, &m_styleBuilder);
+    layout.resetCacheData();
+
+    const ViewportParams viewport(Spherical, lon * DEG2RAD, lat * DEG2RAD, radius, QSize(1024, 768));
+
+    // The first layout creates the visible placemarks, later ones reuse them
+    // like a repaint of an unchanged view does
+    int placemarkCount = layout.generateLayout(&viewport, tileLevel).size();
+    QVERIFY(placemarkCount > 0);
+
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        placemarkCount = layout.generateLayout(&viewport, tileLevel).size();
+    }
+    m_log.record(placemarkCount);
+}
+
+void RenderBenchmark::createStyle_data()
+{
+    QTest::addColumn<int>("tileLevel");
+
+    QTest::newRow("level 11") << 11;
+    QTest::newRow("level 17") << 17;
+}
+
+void RenderBenchmark::createStyle()
+{
+    QFETCH(int, tileLevel);
+
+    int styleCount = 0;
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        styleCount = 0;
+        for (const GeoDataPlacemark *placemark : std::as_const(m_stylePlacemarks)) {
+            styleCount += m_styleBuilder.createStyle(StyleParameters(placemark, tileLevel)) ? 1 : 0;
+        }
+    }
+    QVERIFY(styleCount > 0);
+    m_log.record(m_stylePlacemarks.size());
+}
+
+void RenderBenchmark::parseKml()
+{
+    QFile file(fixturePath(QStringLiteral("benchmark.kml")));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray data = file.readAll();
+
+    int placemarkCount = 0;
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        GeoDataParser parser(GeoData_KML);
+        parser.read(&buffer);
+        GeoDataDocument *const document = dynamic_cast<GeoDataDocument *>(parser.releaseDocument());
+        placemarkCount = document ? document->placemarkList().size() : 0;
+        delete document;
+    }
+    QCOMPARE(placemarkCount, 1650);
+    m_log.record(data.size());
+}
+
+void RenderBenchmark::parseO5m()
+{
+    const QString fileName = fixturePath(QStringLiteral("benchmark.o5m"));
+    ParsingRunnerManager runnerManager(m_pluginManager);
+
+    GeoDataDocument *document = runnerManager.openFile(fileName);
+    if (!document) {
+        QSKIP("The OSM runner plugin is not available");
+    }
+    delete document;
+
+    int featureCount = 0;
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        document = runnerManager.openFile(fileName);
+        featureCount = document ? document->size() : 0;
+        delete document;
+    }
+    QVERIFY(featureCount > 0);
+    m_log.record(QFileInfo(fileName).size());
+}
+
+void RenderBenchmark::sceneItems_data()
+{
+    QTest::addColumn<GeoDataLatLonBox>("box");
+    QTest::addColumn<int>("zoomLevel");
+
+    QTest::newRow("globe") << GeoDataLatLonBox(90, -90, 180, -180, GeoDataCoordinates::Degree) << 3;
+    QTest::newRow("Europe") << GeoDataLatLonBox(70, 35, 40, -10, GeoDataCoordinates::Degree) << 7;
+    QTest::newRow("city") << GeoDataLatLonBox(53, 52, 14, 13, GeoDataCoordinates::Degree) << 13;
+    QTest::newRow("date line") << GeoDataLatLonBox(0, -50, -170, 170, GeoDataCoordinates::Degree) << 7;
+}
+
+void RenderBenchmark::sceneItems()
+{
+    QFETCH(GeoDataLatLonBox, box);
+    QFETCH(int, zoomLevel);
+
+    // Cut the line strings into short pieces of differing importance, like
+    // the ones of vector tiles
+    const int minZoomLevels[] = {0, 5, 9, 13};
+    QList<GeoDataPlacemark *> placemarks;
+    GeoGraphicsScene scene;
+    for (const GeoDataLineString *lineString : std::as_const(m_lineStrings)) {
+        for (int i = 0; i + 1 < lineString->size(); i += 8) {
+            auto piece = new GeoDataLineString;
+            for (int j = i; j < qMin(i + 9, lineString->size()); ++j) {
+                piece->append(lineString->at(j));
+            }
+            auto placemark = new GeoDataPlacemark;
+            placemark->setGeometry(piece);
+            placemarks << placemark;
+
+            auto item = new GeoLineStringGraphicsItem(placemark, piece);
+            item->setMinZoomLevel(minZoomLevels[placemarks.size() % 4]);
+            scene.addItem(item);
+        }
+    }
+
+    int itemCount = 0;
+    QBENCHMARK {
+        const BenchmarkLog::Iteration iteration(m_log);
+        itemCount = scene.items(box, zoomLevel).size();
+    }
+    m_log.record(itemCount);
+
+    scene.clear();
+    qDeleteAll(placemarks);
+}
+
+}
+
+QTEST_MAIN(Marble::RenderBenchmark)
+
+#include "RenderBenchmark.moc"
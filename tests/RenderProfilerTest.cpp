@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+#include "RenderProfiler.h"
+
+namespace Marble
+{
+
+class RenderProfilerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void disabled();
+    void chromeTrace();
+    void csv();
+    void overwriteOldest();
+};
+
+void RenderProfilerTest::disabled()
+{
+    RenderProfiler profiler;
+    profiler.setEnabled(false);
+    profiler.beginFrame();
+    profiler.addDuration(QStringLiteral("Layer"), QStringLiteral("SURFACE"), 0, 1000);
+    profiler.addCounter(QStringLiteral("Counter"), 1);
+    profiler.endFrame();
+
+    QCOMPARE(profiler.toCsv().count('\n'), 1);
+}
+
+void RenderProfilerTest::chromeTrace()
+{
+    RenderProfiler profiler;
+    profiler.setEnabled(true);
+    profiler.beginFrame();
+    profiler.addDuration(QStringLiteral("Texture Tiles"), QStringLiteral("SURFACE"), 2000, 5000);
+    profiler.addCounter(QStringLiteral("Pending downloads"), 7);
+    profiler.endFrame();
+
+    const QJsonArray events = QJsonDocument::fromJson(profiler.toChromeTrace()).object().value(QStringLiteral("traceEvents")).toArray();
+    QCOMPARE(events.size(), 3);
+
+    const QJsonObject layer = events.at(0).toObject();
+    QCOMPARE(layer.value(QStringLiteral("name")).toString(), QStringLiteral("Texture Tiles"));
+    QCOMPARE(layer.value(QStringLiteral("cat")).toString(), QStringLiteral("SURFACE"));
+    QCOMPARE(layer.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+    QCOMPARE(layer.value(QStringLiteral("ts")).toDouble(), 2.0);
+    QCOMPARE(layer.value(QStringLiteral("dur")).toDouble(), 5.0);
+
+    const QJsonObject counter = events.at(1).toObject();
+    QCOMPARE(counter.value(QStringLiteral("ph")).toString(), QStringLiteral("C"));
+    QCOMPARE(counter.value(QStringLiteral("args")).toObject().value(QStringLiteral("value")).toInt(), 7);
+
+    QCOMPARE(events.at(2).toObject().value(QStringLiteral("name")).toString(), QStringLiteral("Frame"));
+}
+
+void RenderProfilerTest::csv()
+{
+    RenderProfiler profiler;
+    profiler.setEnabled(true);
+    profiler.beginFrame();
+    profiler.addDuration(QStringLiteral("Say \"cheese\""), QStringLiteral("PLACEMARKS"), 1000, 1500);
+    profiler.addCounter(QStringLiteral("Placemarks drawn"), 42);
+
+    const QList<QByteArray> lines = profiler.toCsv().split('\n');
+    QCOMPARE(lines.size(), 4);
+    QCOMPARE(lines.at(0), QByteArray("frame,type,category,name,start_us,duration_us,value"));
+    QCOMPARE(lines.at(1), QByteArray("1,duration,PLACEMARKS,\"Say \"\"cheese\"\"\",1.000,1.500,"));
+    QVERIFY(lines.at(2).startsWith("1,counter,Counter,\"Placemarks drawn\","));
+    QVERIFY(lines.at(2).endsWith(",,42"));
+    QVERIFY(lines.at(3).isEmpty());
+}
+
+void RenderProfilerTest::overwriteOldest()
+{
+    RenderProfiler profiler(4);
+    profiler.setEnabled(true);
+    for (int i = 0; i < 10; ++i) {
+        profiler.beginFrame();
+        profiler.addCounter(QStringLiteral("Counter"), i);
+    }
+
+    const QJsonArray events = QJsonDocument::fromJson(profiler.toChromeTrace()).object().value(QStringLiteral("traceEvents")).toArray();
+    QCOMPARE(events.size(), profiler.capacity());
+    for (int i = 0; i < events.size(); ++i) {
+        QCOMPARE(events.at(i).toObject().value(QStringLiteral("args")).toObject().value(QStringLiteral("value")).toInt(), 6 + i);
+    }
+
+    profiler.clear();
+    QCOMPARE(profiler.toCsv().count('\n'), 1);
+}
+
+}
+
+QTEST_MAIN(Marble::RenderProfilerTest)
+
+#include "RenderProfilerTest.moc"
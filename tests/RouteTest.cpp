@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "MarbleGlobal.h"
+#include "routing/Route.h"
+
+namespace Marble
+{
+
+class RouteTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void emptyRoute();
+    void currentSegment_data();
+    void currentSegment();
+    void matchesLinearScan();
+    void closestPathIndex();
+
+private:
+    Route m_route;
+};
+
+void RouteTest::initTestCase()
+{
+    // A zigzag of three segments with 100 points each
+    for (int segment = 0; segment < 3; ++segment) {
+        GeoDataLineString path;
+        for (int i = 0; i < 100; ++i) {
+            const qreal lon = segment + i * 0.01;
+            const qreal lat = 50.0 + (i % 2) * 0.005;
+            path << GeoDataCoordinates(lon, lat, 0.0, GeoDataCoordinates::Degree);
+        }
+        RouteSegment routeSegment;
+        routeSegment.setPath(path);
+        m_route.addRouteSegment(routeSegment);
+    }
+    QCOMPARE(m_route.size(), 3);
+    QCOMPARE(m_route.path().size(), 300);
+}
+
+void RouteTest::emptyRoute()
+{
+    Route route;
+    route.setPosition(GeoDataCoordinates(0.0, 0.0));
+    QVERIFY(!route.currentSegment().isValid());
+    QCOMPARE(route.closestPathIndex(GeoDataCoordinates(0.0, 0.0)), -1);
+}
+
+void RouteTest::currentSegment_data()
+{
+    QTest::addColumn<qreal>("lon");
+    QTest::addColumn<qreal>("lat");
+    QTest::addColumn<int>("segment");
+
+    QTest::newRow("start") << 0.0 << 50.0 << 0;
+    QTest::newRow("first") << 0.5 << 50.1 << 0;
+    QTest::newRow("second") << 1.5 << 49.9 << 1;
+    QTest::newRow("third") << 2.5 << 50.0 << 2;
+    QTest::newRow("beyond end") << 4.0 << 50.0 << 2;
+}
+
+void RouteTest::currentSegment()
+{
+    QFETCH(qreal, lon);
+    QFETCH(qreal, lat);
+    QFETCH(int, segment);
+
+    m_route.setPosition(GeoDataCoordinates(lon, lat, 0.0, GeoDataCoordinates::Degree));
+    QCOMPARE(m_route.indexOf(m_route.currentSegment()), segment);
+}
+
+void RouteTest::matchesLinearScan()
+{
+    QRandomGenerator random(42);
+    for (int i = 0; i < 200; ++i) {
+        const qreal lon = -0.5 + 4.0 * random.generateDouble();
+        const qreal lat = 49.5 + random.generateDouble();
+        const GeoDataCoordinates position(lon, lat, 0.0, GeoDataCoordinates::Degree);
+        m_route.setPosition(position);
+
+        qreal expected = -1.0;
+        GeoDataCoordinates closest;
+        GeoDataCoordinates interpolated;
+        for (int j = 0; j < m_route.size(); ++j) {
+            const qreal distance = m_route.at(j).distanceTo(position, closest, interpolated);
+            if (expected < 0.0 || distance < expected) {
+                expected = distance;
+            }
+        }
+
+        const qreal actual = EARTH_RADIUS * position.sphericalDistanceTo(m_route.positionOnRoute());
+        QVERIFY(qAbs(actual - expected) < 0.01);
+    }
+}
+
+void RouteTest::closestPathIndex()
+{
+    const GeoDataLineString &path = m_route.path();
+    for (int i = 0; i < path.size(); i += 7) {
+        const int index = m_route.closestPathIndex(path[i]);
+        QVERIFY(index >= 0);
+        QCOMPARE(path[index], path[i]);
+    }
+}
+
+}
+
+QTEST_MAIN(Marble::RouteTest)
+
+#include "RouteTest.moc"
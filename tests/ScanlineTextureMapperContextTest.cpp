@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QImage>
+#include <QTest>
+#include <QThread>
+
+#include "ScanlineTextureMapperContext.h"
+
+namespace Marble
+{
+
+class ScanlineTextureMapperContextTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void scrollCanvasImage_data();
+    void scrollCanvasImage();
+    void rowScheduler_data();
+    void rowScheduler();
+    void rowSchedulerFromThreads();
+
+private:
+    /** Checks that the blocks cover each row of the areas exactly once */
+    static void verifyBlocks(const QList<QRect> &areas, int blockHeight, const QList<QRect> &blocks);
+};
+
+void ScanlineTextureMapperContextTest::scrollCanvasImage_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<int>("dx");
+    QTest::addColumn<int>("dy");
+
+    const int width = 61;
+    const int height = 37;
+    const QList<QPoint> offsets = {QPoint(0, 0),
+                                   QPoint(1, 0),
+                                   QPoint(-1, 0),
+                                   QPoint(0, 1),
+                                   QPoint(0, -1),
+                                   QPoint(5, -3),
+                                   QPoint(-7, 2),
+                                   QPoint(width - 1, 0),
+                                   QPoint(-(width - 1), 0),
+                                   QPoint(0, height - 1),
+                                   QPoint(0, -(height - 1)),
+                                   QPoint(width - 1, height - 1),
+                                   QPoint(-(width - 1), -(height - 1)),
+                                   QPoint(width - 1, -(height - 1)),
+                                   QPoint(-(width - 1), height - 1)};
+
+    for (const QImage::Format format : {QImage::Format_RGB32, QImage::Format_ARGB32_Premultiplied}) {
+        for (const QPoint &offset : offsets) {
+            QTest::addRow("%d %d,%d", int(format), offset.x(), offset.y()) << format << offset.x() << offset.y();
+        }
+    }
+}
+
+void ScanlineTextureMapperContextTest::scrollCanvasImage()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(int, dx);
+    QFETCH(int, dy);
+
+    // Every pixel encodes its position
+    QImage canvas(61, 37, format);
+    for (int y = 0; y < canvas.height(); ++y) {
+        auto line = reinterpret_cast<QRgb *>(canvas.scanLine(y));
+        for (int x = 0; x < canvas.width(); ++x) {
+            line[x] = 0xff000000 | (x << 8) | y;
+        }
+    }
+    const QImage original = canvas.copy();
+
+    const QList<QRect> uncovered = ScanlineTextureMapperContext::scrollCanvasImage(&canvas, dx, dy);
+
+    for (int i = 0; i < uncovered.size(); ++i) {
+        QVERIFY(!uncovered.at(i).isEmpty());
+        QVERIFY(canvas.rect().contains(uncovered.at(i)));
+        for (int j = 0; j < i; ++j) {
+            QVERIFY(!uncovered.at(i).intersects(uncovered.at(j)));
+        }
+    }
+
+    // Pixels whose source is inside the canvas are moved, all others are reported as uncovered
+    for (int y = 0; y < canvas.height(); ++y) {
+        for (int x = 0; x < canvas.width(); ++x) {
+            const QPoint source(x - dx, y - dy);
+            bool isUncovered = false;
+            for (const QRect &rect : uncovered) {
+                isUncovered = isUncovered || rect.contains(x, y);
+            }
+            QCOMPARE(isUncovered, !canvas.rect().contains(source));
+            if (!isUncovered) {
+                QCOMPARE(canvas.pixel(x, y), original.pixel(source));
+            }
+        }
+    }
+}
+
+void ScanlineTextureMapperContextTest::verifyBlocks(const QList<QRect> &areas, int blockHeight, const QList<QRect> &blocks)
+{
+    QList<QList<int>> coverage;
+    for (const QRect &area : areas) {
+        coverage << QList<int>(qMax(0, area.height()), 0);
+    }
+
+    for (const QRect &block : blocks) {
+        QVERIFY(!block.isEmpty());
+        QVERIFY(block.height() <= qMax(2, blockHeight & ~1));
+
+        int area = -1;
+        for (int i = 0; i < areas.size(); ++i) {
+            if (areas.at(i).contains(block)) {
+                area = i;
+            }
+        }
+        QVERIFY(area >= 0);
+        QCOMPARE(block.left(), areas.at(area).left());
+        QCOMPARE(block.width(), areas.at(area).width());
+        // Interlaced mapping copies each mapped row into the row below
+        QCOMPARE((block.top() - areas.at(area).top()) % 2, 0);
+
+        for (int y = block.top(); y <= block.bottom(); ++y) {
+            ++coverage[area][y - areas.at(area).top()];
+        }
+    }
+
+    for (const QList<int> &rows : std::as_const(coverage)) {
+        for (int count : rows) {
+            QCOMPARE(count, 1);
+        }
+    }
+}
+
+void ScanlineTextureMapperContextTest::rowScheduler_data()
+{
+    QTest::addColumn<QList<QRect>>("areas");
+    QTest::addColumn<int>("blockHeight");
+
+    const QList<QRect> scrolled = {QRect(0, 0, 100, 7), QRect(93, 7, 7, 60)};
+    QTest::newRow("canvas") << (QList<QRect>() << QRect(0, 0, 100, 64)) << 16;
+    QTest::newRow("partial block") << (QList<QRect>() << QRect(0, 3, 100, 61)) << 16;
+    QTest::newRow("scrolled") << scrolled << 16;
+    QTest::newRow("odd block height") << scrolled << 5;
+    QTest::newRow("single rows") << (QList<QRect>() << QRect(0, 0, 10, 1) << QRect(0, 5, 10, 1)) << 1;
+    QTest::newRow("empty areas") << (QList<QRect>() << QRect() << QRect(0, 10, 10, 0) << QRect(0, 20, 10, 3)) << 16;
+    QTest::newRow("nothing") << QList<QRect>() << 16;
+}
+
+void ScanlineTextureMapperContextTest::rowScheduler()
+{
+    QFETCH(QList<QRect>, areas);
+    QFETCH(int, blockHeight);
+
+    ScanlineRowScheduler scheduler(areas, blockHeight);
+    QList<QRect> blocks;
+    QRect block;
+    while (scheduler.nextBlock(block)) {
+        blocks << block;
+    }
+    QCOMPARE(blocks.size(), scheduler.blockCount());
+    QVERIFY(!scheduler.nextBlock(block));
+
+    verifyBlocks(areas, blockHeight, blocks);
+}
+
+void ScanlineTextureMapperContextTest::rowSchedulerFromThreads()
+{
+    const QList<QRect> areas = {QRect(0, 0, 640, 480), QRect(0, 500, 640, 33)};
+    ScanlineRowScheduler scheduler(areas, 4);
+
+    QList<QList<QRect>> blocksOfThreads(8);
+    QList<QThread *> threads;
+    for (int i = 0; i < blocksOfThreads.size(); ++i) {
+        threads << QThread::create([&scheduler, &blocksOfThreads, i]() {
+            QRect block;
+            while (scheduler.nextBlock(block)) {
+                blocksOfThreads[i] << block;
+            }
+        });
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        thread->start();
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait(10000));
+    }
+    qDeleteAll(threads);
+
+    QList<QRect> blocks;
+    for (const QList<QRect> &blocksOfThread : std::as_const(blocksOfThreads)) {
+        blocks << blocksOfThread;
+    }
+    QCOMPARE(blocks.size(), scheduler.blockCount());
+    verifyBlocks(areas, 4, blocks);
+}
+
+}
+
+QTEST_MAIN(Marble::ScanlineTextureMapperContextTest)
+
+#include "ScanlineTextureMapperContextTest.moc"
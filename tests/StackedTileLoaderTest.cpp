@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QImage>
+#include <QRandomGenerator>
+#include <QTest>
+#include <QThread>
+
+#include "FileStoragePolicy.h"
+#include "GeoSceneTextureTileDataset.h"
+#include "HttpDownloadManager.h"
+#include "MarbleDirs.h"
+#include "MergedLayerDecorator.h"
+#include "PluginManager.h"
+#include "StackedTile.h"
+#include "StackedTileLoader.h"
+#include "TileId.h"
+#include "TileLoader.h"
+
+#include <memory>
+
+namespace Marble
+{
+
+class StackedTileLoaderTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void sameTileFromThreads();
+    void loadsDuringClearAndUpdate();
+
+private:
+    /** All stacked tiles of the levels 0 to 2 */
+    QList<TileId> tileIds() const;
+
+    std::unique_ptr<GeoSceneTextureTileDataset> m_textureDataset;
+    std::unique_ptr<PluginManager> m_pluginManager;
+    std::unique_ptr<FileStoragePolicy> m_storagePolicy;
+    std::unique_ptr<HttpDownloadManager> m_downloadManager;
+    std::unique_ptr<TileLoader> m_tileLoader;
+    std::unique_ptr<MergedLayerDecorator> m_layerDecorator;
+    std::unique_ptr<StackedTileLoader> m_stackedTileLoader;
+};
+
+void StackedTileLoaderTest::initTestCase()
+{
+    // The tiles are read from the source tree, nothing gets downloaded
+    m_textureDataset = std::make_unique<GeoSceneTextureTileDataset>(QStringLiteral("srtm"));
+    m_textureDataset->setSourceDir(QStringLiteral(MARBLE_SRC_DIR "/data/maps/earth/srtm"));
+    m_textureDataset->setFileFormat(QStringLiteral("JPG"));
+    m_textureDataset->setMaximumTileLevel(2);
+
+    m_pluginManager = std::make_unique<PluginManager>();
+    m_storagePolicy = std::make_unique<FileStoragePolicy>(MarbleDirs::localPath());
+    m_downloadManager = std::make_unique<HttpDownloadManager>(m_storagePolicy.get());
+    m_tileLoader = std::make_unique<TileLoader>(m_downloadManager.get(), m_pluginManager.get());
+    m_layerDecorator = std::make_unique<MergedLayerDecorator>(m_tileLoader.get(), nullptr);
+    m_layerDecorator->setTextureLayers({m_textureDataset.get()});
+    m_stackedTileLoader = std::make_unique<StackedTileLoader>(m_layerDecorator.get());
+}
+
+void StackedTileLoaderTest::cleanupTestCase()
+{
+    m_stackedTileLoader.reset();
+    m_layerDecorator.reset();
+    m_tileLoader.reset();
+    m_downloadManager.reset();
+    m_storagePolicy.reset();
+    m_pluginManager.reset();
+    m_textureDataset.reset();
+}
+
+void StackedTileLoaderTest::init()
+{
+    m_stackedTileLoader->clear();
+}
+
+QList<TileId> StackedTileLoaderTest::tileIds() const
+{
+    QList<TileId> result;
+    for (int level = 0; level <= 2; ++level) {
+        for (int y = 0; y < m_stackedTileLoader->tileRowCount(level); ++y) {
+            for (int x = 0; x < m_stackedTileLoader->tileColumnCount(level); ++x) {
+                result << TileId(0, level, x, y);
+            }
+        }
+    }
+    return result;
+}
+
+void StackedTileLoaderTest::sameTileFromThreads()
+{
+    const TileId tileId(0, 2, 3, 1);
+    const quint64 misses = m_stackedTileLoader->tileMissCount();
+
+    // All threads get the tile loaded by the first one
+    QList<const StackedTile *> tiles(8, nullptr);
+    QList<QThread *> threads;
+    for (int i = 0; i < tiles.size(); ++i) {
+        threads << QThread::create([this, &tiles, i, tileId]() {
+            tiles[i] = m_stackedTileLoader->loadTile(tileId);
+        });
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        thread->start();
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait(60000));
+    }
+    qDeleteAll(threads);
+
+    QCOMPARE(m_stackedTileLoader->tileMissCount(), misses + 1);
+    QVERIFY(tiles.first() != nullptr);
+    for (const StackedTile *tile : std::as_const(tiles)) {
+        QCOMPARE(tile, tiles.first());
+    }
+    QCOMPARE(m_stackedTileLoader->tileCount(), 1);
+    QCOMPARE(m_stackedTileLoader->visibleTiles(), QList<TileId>() << tileId);
+}
+
+void StackedTileLoaderTest::loadsDuringClearAndUpdate()
+{
+    const QList<TileId> ids = tileIds();
+    QImage image(m_stackedTileLoader->tileSize(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::red);
+
+    // The threads only check the tiles, they do not use them, as clear() deletes them
+    QAtomicInt stop(0);
+    QAtomicInt failures(0);
+    QList<QThread *> threads;
+    for (int i = 0; i < 6; ++i) {
+        threads << QThread::create([this, &ids, &stop, &failures, i]() {
+            QRandomGenerator random(i);
+            while (!stop.loadRelaxed()) {
+                if (!m_stackedTileLoader->loadTile(ids.at(random.bounded(ids.size())))) {
+                    failures.fetchAndAddRelaxed(1);
+                }
+            }
+        });
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        thread->start();
+    }
+
+    QRandomGenerator random(42);
+    for (int i = 0; i < 300; ++i) {
+        if (i % 10 == 0) {
+            m_stackedTileLoader->clear();
+        } else {
+            const TileId id = ids.at(random.bounded(ids.size()));
+            m_stackedTileLoader->updateTile(TileId(m_textureDataset->sourceDir(), id.zoomLevel(), id.x(), id.y()), image);
+        }
+        QThread::yieldCurrentThread();
+    }
+
+    stop.storeRelaxed(1);
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait(60000));
+    }
+    qDeleteAll(threads);
+    QCOMPARE(failures.loadRelaxed(), 0);
+
+    // No load of the threads above shows up after clearing
+    m_stackedTileLoader->cleanupTilehash();
+    m_stackedTileLoader->clear();
+    QCOMPARE(m_stackedTileLoader->tileCount(), 0);
+    QVERIFY(m_stackedTileLoader->visibleTiles().isEmpty());
+
+    // Every tile is loaded once and found in memory afterwards
+    QHash<TileId, const StackedTile *> tiles;
+    for (const TileId &id : ids) {
+        const StackedTile *const tile = m_stackedTileLoader->loadTile(id);
+        QVERIFY(tile != nullptr);
+        QVERIFY(tile->resultImage()->pixel(0, 0) != qRgb(255, 0, 0));
+        tiles.insert(id, tile);
+    }
+    const quint64 misses = m_stackedTileLoader->tileMissCount();
+    for (const TileId &id : ids) {
+        QCOMPARE(m_stackedTileLoader->loadTile(id), tiles.value(id));
+    }
+    QCOMPARE(m_stackedTileLoader->tileMissCount(), misses);
+    QCOMPARE(m_stackedTileLoader->tileCount(), int(ids.size()));
+    QCOMPARE(m_stackedTileLoader->visibleTiles().size(), ids.size());
+}
+
+}
+
+QTEST_MAIN(Marble::StackedTileLoaderTest)
+
+#include "StackedTileLoaderTest.moc"
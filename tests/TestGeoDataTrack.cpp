@@ -17,6 +17,7 @@
 #include <MarbleDebug.h>
 
 #include <QDateTime>
+#include <QTimeZone>
 
 using namespace Marble;
 
@@ -32,6 +33,10 @@ private Q_SLOTS:
     void removeAfterTest();
     void extendedDataParseTest();
     void withoutTimeTest();
+    void appendTest();
+    void decimationTest();
+    void decimationResolutionsTest();
+    void timeZoneTest();
 };
 
 void TestGeoDataTrack::initTestCase()
@@ -351,6 +356,134 @@ void TestGeoDataTrack::withoutTimeTest()
     delete dataDocument;
 }
 
+void TestGeoDataTrack::appendTest()
+{
+    GeoDataTrack track;
+    const QDateTime start(QDate(2014, 8, 16), QTime(8, 0, 0), Qt::UTC);
+    for (int i = 0; i < 10; ++i) {
+        track.addPoint(start.addSecs(i), GeoDataCoordinates(13.0 + i * 0.001, 52.0, 0, GeoDataCoordinates::Degree));
+    }
+    QCOMPARE(track.lineString()->size(), 10);
+
+    // appended points extend the line string
+    track.addPoint(start.addSecs(10), GeoDataCoordinates(13.01, 52.0, 0, GeoDataCoordinates::Degree));
+    QCOMPARE(track.lineString()->size(), 11);
+    QCOMPARE(track.lineString()->last(), GeoDataCoordinates(13.01, 52.0, 0, GeoDataCoordinates::Degree));
+
+    // points inserted out of order are sorted by time
+    track.addPoint(start.addMSecs(500), GeoDataCoordinates(13.0005, 52.0, 0, GeoDataCoordinates::Degree));
+    QCOMPARE(track.size(), 12);
+    QCOMPARE(track.lineString()->size(), 12);
+    QCOMPARE(track.lineString()->at(1), GeoDataCoordinates(13.0005, 52.0, 0, GeoDataCoordinates::Degree));
+    QCOMPARE(track.whenList().at(1), start.addMSecs(500));
+    QCOMPARE(track.whenList().at(1).timeSpec(), Qt::UTC);
+    QCOMPARE(track.coordinatesAt(start.addMSecs(500)), GeoDataCoordinates(13.0005, 52.0, 0, GeoDataCoordinates::Degree));
+
+    track.removeAfter(start.addSecs(5));
+    QCOMPARE(track.size(), 7);
+    QCOMPARE(track.lineString()->size(), 7);
+    QCOMPARE(track.lastWhen(), start.addSecs(5));
+
+    track.removeBefore(start.addSecs(1));
+    QCOMPARE(track.size(), 5);
+    QCOMPARE(track.lineString()->size(), 5);
+    QCOMPARE(track.firstWhen(), start.addSecs(1));
+
+    track.clear();
+    QCOMPARE(track.lineString()->size(), 0);
+}
+
+void TestGeoDataTrack::decimationTest()
+{
+    GeoDataTrack track;
+    const QDateTime start(QDate(2014, 8, 16), QTime(8, 0, 0), Qt::UTC);
+    // roughly 7 m between consecutive points
+    for (int i = 0; i < 1000; ++i) {
+        track.addPoint(start.addSecs(i), GeoDataCoordinates(13.0 + i * 0.0001, 52.0, 0, GeoDataCoordinates::Degree));
+    }
+
+    QCOMPARE(track.decimatedLineString(0.0), track.lineString());
+    QCOMPARE(track.decimatedLineString(0.0)->size(), 1000);
+
+    const qreal resolution = 0.001 * DEG2RAD;
+    const GeoDataLineString *decimated = track.decimatedLineString(resolution);
+    QVERIFY(decimated->size() > 2);
+    QVERIFY(decimated->size() < 100);
+    QCOMPARE(decimated->first(), track.coordinatesAt(0));
+    QCOMPARE(decimated->last(), track.coordinatesAt(999));
+
+    // appending keeps the last point of the decimated line string current
+    track.addPoint(start.addSecs(1000), GeoDataCoordinates(13.1, 52.0, 0, GeoDataCoordinates::Degree));
+    const int size = decimated->size();
+    decimated = track.decimatedLineString(resolution);
+    QVERIFY(decimated->size() - size <= 1);
+    QCOMPARE(decimated->last(), track.coordinatesAt(1000));
+
+    for (int i = 1; i < decimated->size() - 1; ++i) {
+        QVERIFY(decimated->at(i - 1).sphericalDistanceTo(decimated->at(i)) >= resolution / 2);
+    }
+}
+
+void TestGeoDataTrack::decimationResolutionsTest()
+{
+    GeoDataTrack track;
+    const QDateTime start(QDate(2014, 8, 16), QTime(8, 0, 0), Qt::UTC);
+    for (int i = 0; i < 1000; ++i) {
+        track.addPoint(start.addSecs(i), GeoDataCoordinates(13.0 + i * 0.0001, 52.0, 0, GeoDataCoordinates::Degree));
+    }
+
+    // two views at different zoom levels keep their own decimation
+    const qreal fine = 0.0005 * DEG2RAD;
+    const qreal coarse = 0.01 * DEG2RAD;
+    const GeoDataLineString *fineDecimated = track.decimatedLineString(fine);
+    const GeoDataLineString *coarseDecimated = track.decimatedLineString(coarse);
+    QVERIFY(fineDecimated != coarseDecimated);
+    QVERIFY(fineDecimated->size() > coarseDecimated->size());
+
+    const int fineSize = fineDecimated->size();
+    const int coarseSize = coarseDecimated->size();
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(track.decimatedLineString(fine), fineDecimated);
+        QCOMPARE(fineDecimated->size(), fineSize);
+        QCOMPARE(track.decimatedLineString(coarse), coarseDecimated);
+        QCOMPARE(coarseDecimated->size(), coarseSize);
+    }
+
+    // changing the track updates every cached resolution
+    track.removeAfter(start.addSecs(499));
+    QCOMPARE(track.decimatedLineString(fine)->last(), track.coordinatesAt(499));
+    QCOMPARE(track.decimatedLineString(coarse)->last(), track.coordinatesAt(499));
+    QVERIFY(track.decimatedLineString(fine)->size() < fineSize);
+}
+
+void TestGeoDataTrack::timeZoneTest()
+{
+    const QDateTime utc(QDate(2014, 8, 16), QTime(8, 0, 0), Qt::UTC);
+    const QDateTime offset(QDate(2014, 8, 16), QTime(9, 30, 0), QTimeZone::fromSecondsAheadOfUtc(7200));
+    const QDateTime later(QDate(2014, 8, 16), QTime(8, 45, 0), Qt::UTC);
+
+    // 7:30 UTC is before the first point, although its local time is later
+    GeoDataTrack track;
+    track.addPoint(utc, GeoDataCoordinates(13.0, 52.0, 0, GeoDataCoordinates::Degree));
+    track.addPoint(later, GeoDataCoordinates(13.2, 52.0, 0, GeoDataCoordinates::Degree));
+    track.addPoint(offset, GeoDataCoordinates(13.1, 52.0, 0, GeoDataCoordinates::Degree));
+    QCOMPARE(track.firstWhen(), offset);
+    QCOMPARE(track.lastWhen(), later);
+
+    // every value keeps the time zone it was added with
+    const QList<QDateTime> when = track.whenList();
+    QCOMPARE(when.size(), 3);
+    QCOMPARE(when.at(0).offsetFromUtc(), 7200);
+    QCOMPARE(when.at(0).time(), QTime(9, 30, 0));
+    QCOMPARE(when.at(1).timeSpec(), Qt::UTC);
+    QCOMPARE(when.at(2).timeSpec(), Qt::UTC);
+
+    QCOMPARE(track.coordinatesAt(offset), GeoDataCoordinates(13.1, 52.0, 0, GeoDataCoordinates::Degree));
+    track.removeBefore(utc);
+    QCOMPARE(track.size(), 2);
+    QCOMPARE(track.firstWhen().timeSpec(), Qt::UTC);
+}
+
 QTEST_MAIN(TestGeoDataTrack)
 
 #include "TestGeoDataTrack.moc"
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QObject>
+
+#include "TestUtils.h"
+#include <GeoDataDocument.h>
+#include <GeoDataFolder.h>
+#include <GeoDataLineString.h>
+#include <GeoDataPlacemark.h>
+#include <GeoDataTrack.h>
+#include <MarbleDebug.h>
+
+using namespace Marble;
+
+class TestKmlCoordinates : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void lineString_data();
+    void lineString();
+    void numbers_data();
+    void numbers();
+    void track();
+};
+
+namespace
+{
+GeoDataDocument *parseLineString(const QString &coordinates)
+{
+    const QString content = QStringLiteral(
+                                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                                "<kml xmlns=\"http://www.opengis.net/kml/2.2\">"
+                                "<Folder><Placemark><LineString><coordinates>%1</coordinates></LineString></Placemark></Folder>"
+                                "</kml>")
+                                .arg(coordinates);
+    return parseKml(content);
+}
+
+const GeoDataLineString *lineStringOf(GeoDataDocument *document)
+{
+    GeoDataFolder *folder = document->folderList().at(0);
+    return dynamic_cast<const GeoDataLineString *>(folder->placemarkList().at(0)->geometry());
+}
+}
+
+void TestKmlCoordinates::initTestCase()
+{
+    MarbleDebug::setEnabled(true);
+}
+
+void TestKmlCoordinates::lineString_data()
+{
+    QTest::addColumn<QString>("coordinates");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<qreal>("lastLongitude");
+
+    QTest::newRow("single") << "1,2,3" << 1 << 1.0;
+    QTest::newRow("two dimensional") << "1,2 3,4" << 2 << 3.0;
+    QTest::newRow("newlines") << "\n  1,2,3\n  4,5,6\n" << 2 << 4.0;
+    QTest::newRow("spaces around commas") << "1 , 2 ,3   4,  5 ,6" << 2 << 4.0;
+    QTest::newRow("tabs") << "1,2,3\t4,5,6" << 2 << 4.0;
+}
+
+void TestKmlCoordinates::lineString()
+{
+    QFETCH(QString, coordinates);
+    QFETCH(int, size);
+    QFETCH(qreal, lastLongitude);
+
+    GeoDataDocument *document = parseLineString(coordinates);
+    QVERIFY(document);
+    const GeoDataLineString *lineString = lineStringOf(document);
+    QVERIFY(lineString);
+    QCOMPARE(lineString->size(), size);
+    QFUZZYCOMPARE(lineString->at(0).longitude(GeoDataCoordinates::Degree), 1.0, 0.0001);
+    QFUZZYCOMPARE(lineString->at(0).latitude(GeoDataCoordinates::Degree), 2.0, 0.0001);
+    QFUZZYCOMPARE(lineString->last().longitude(GeoDataCoordinates::Degree), lastLongitude, 0.0001);
+
+    delete document;
+}
+
+void TestKmlCoordinates::numbers_data()
+{
+    QTest::addColumn<QString>("number");
+
+    QTest::newRow("integer") << "13";
+    QTest::newRow("negative") << "-122.207881";
+    QTest::newRow("positive sign") << "+0.5";
+    QTest::newRow("leading dot") << ".25";
+    QTest::newRow("trailing dot") << "7.";
+    QTest::newRow("many decimals") << "52.12345678901234567";
+    QTest::newRow("exponent") << "1.5e1";
+    QTest::newRow("rounding") << "0.1000000000000001";
+}
+
+void TestKmlCoordinates::numbers()
+{
+    QFETCH(QString, number);
+
+    GeoDataDocument *document = parseLineString(number + QLatin1StringView(",0,") + number);
+    QVERIFY(document);
+    const GeoDataLineString *lineString = lineStringOf(document);
+    QVERIFY(lineString);
+    QCOMPARE(lineString->size(), 1);
+    // The altitude is not converted, so it has to match Qt's conversion exactly
+    QCOMPARE(lineString->at(0).altitude(), number.toDouble());
+    QCOMPARE(lineString->at(0).longitude(), DEG2RAD * number.toDouble());
+
+    delete document;
+}
+
+void TestKmlCoordinates::track()
+{
+    const QString content = QStringLiteral(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        "<kml xmlns=\"http://www.opengis.net/kml/2.2\" xmlns:gx=\"http://www.google.com/kml/ext/2.2\">"
+        "<Folder><Placemark><gx:Track>"
+        "<gx:coord>-122.207881 37.371915 156.000000</gx:coord>"
+        "<gx:coord>  -122.205712   37.373288 </gx:coord>"
+        "</gx:Track></Placemark></Folder>"
+        "</kml>");
+
+    GeoDataDocument *document = parseKml(content);
+    QVERIFY(document);
+    GeoDataFolder *folder = document->folderList().at(0);
+    auto track = dynamic_cast<const GeoDataTrack *>(folder->placemarkList().at(0)->geometry());
+    QVERIFY(track);
+    QCOMPARE(track->size(), 2);
+    QCOMPARE(track->coordinatesAt(0).longitude(GeoDataCoordinates::Degree), -122.207881);
+    QCOMPARE(track->coordinatesAt(0).latitude(GeoDataCoordinates::Degree), 37.371915);
+    QCOMPARE(track->coordinatesAt(0).altitude(), 156.0);
+    QCOMPARE(track->coordinatesAt(1).longitude(GeoDataCoordinates::Degree), -122.205712);
+    QCOMPARE(track->coordinatesAt(1).altitude(), 0.0);
+
+    delete document;
+}
+
+QTEST_MAIN(TestKmlCoordinates)
+
+#include "TestKmlCoordinates.moc"
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// SPDX-FileCopyrightText: 2026 Marble Authors
+//
+
+#include <QImage>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "MarbleGlobal.h"
+#include "TileCreator.h"
+
+namespace Marble
+{
+
+class TileCreatorTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void topLevelTiles_data();
+    void topLevelTiles();
+    void lowerLevelTiles();
+    void clippedSource();
+
+private:
+    QString tileFileName(int tileLevel, int n, int m, const QString &tileDir = QStringLiteral("tiles")) const;
+
+    /** The tile as cut from @p source by the row based reference implementation */
+    static QImage referenceTile(const QImage &source, int n, int m);
+    QImage referenceTile(int n, int m) const;
+
+    // Scaled up to a maximum tile level of 1, 2 x 4 tiles
+    static const int Rows = 2;
+    static const int Columns = 4;
+
+    QTemporaryDir m_directory;
+    QImage m_source;
+};
+
+void TileCreatorTest::initTestCase()
+{
+    QVERIFY(m_directory.isValid());
+
+    // A noisy gradient so that misplaced rows and columns show up
+    QImage source(1500, 700, QImage::Format_RGB32);
+    QRandomGenerator random(42);
+    for (int y = 0; y < source.height(); ++y) {
+        auto line = reinterpret_cast<QRgb *>(source.scanLine(y));
+        for (int x = 0; x < source.width(); ++x) {
+            line[x] = qRgb(x * 255 / source.width(), y * 255 / source.height(), random.bounded(256));
+        }
+    }
+    QVERIFY(source.save(m_directory.filePath(QStringLiteral("source.png"))));
+    m_source = QImage(m_directory.filePath(QStringLiteral("source.png")));
+    QCOMPARE(m_source.size(), source.size());
+
+    TileCreator creator(m_directory.path(), QStringLiteral("source.png"), QStringLiteral("false"), m_directory.filePath(QStringLiteral("tiles")));
+    creator.setTileFormat(QStringLiteral("png"));
+    creator.start();
+    QVERIFY(creator.wait(60000));
+}
+
+QString TileCreatorTest::tileFileName(int tileLevel, int n, int m, const QString &tileDir) const
+{
+    return m_directory.filePath(QStringLiteral("%1/%2/%3/%3_%4.png")
+                                    .arg(tileDir)
+                                    .arg(tileLevel)
+                                    .arg(n, tileDigits, 10, QLatin1Char('0'))
+                                    .arg(m, tileDigits, 10, QLatin1Char('0')));
+}
+
+QImage TileCreatorTest::referenceTile(const QImage &source, int n, int m)
+{
+    const int tileSize = c_defaultTileSize;
+    const QRect rowRect(0, (int)((qreal)(n * source.height()) / (qreal)(Rows)), source.width(), (int)((qreal)(source.height()) / (qreal)(Rows)));
+    const QImage row = source.copy(rowRect).scaled(QSize(Columns * tileSize, tileSize), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    return row.copy(m * tileSize, 0, tileSize, tileSize).convertToFormat(QImage::Format_RGB32);
+}
+
+QImage TileCreatorTest::referenceTile(int n, int m) const
+{
+    return referenceTile(m_source, n, m);
+}
+
+void TileCreatorTest::topLevelTiles_data()
+{
+    QTest::addColumn<int>("n");
+    QTest::addColumn<int>("m");
+
+    for (int n = 0; n < Rows; ++n) {
+        for (int m = 0; m < Columns; ++m) {
+            QTest::addRow("%d/%d", n, m) << n << m;
+        }
+    }
+}
+
+void TileCreatorTest::topLevelTiles()
+{
+    QFETCH(int, n);
+    QFETCH(int, m);
+
+    const QImage tile = QImage(tileFileName(1, n, m)).convertToFormat(QImage::Format_RGB32);
+    QCOMPARE(tile.size(), QSize(c_defaultTileSize, c_defaultTileSize));
+    QCOMPARE(tile, referenceTile(n, m));
+}
+
+void TileCreatorTest::lowerLevelTiles()
+{
+    // Level 0 tiles average 2 x 2 pixels of their children
+    for (int m = 0; m < Columns / 2; ++m) {
+        const QImage tile = QImage(tileFileName(0, 0, m)).convertToFormat(QImage::Format_RGB32);
+        QCOMPARE(tile.size(), QSize(c_defaultTileSize, c_defaultTileSize));
+
+        const QImage child = referenceTile(0, 2 * m);
+        for (int y = 0; y < 100; y += 7) {
+            for (int x = 0; x < 100; x += 5) {
+                const QRgb a = child.pixel(2 * x, 2 * y);
+                const QRgb b = child.pixel(2 * x + 1, 2 * y);
+                const QRgb c = child.pixel(2 * x, 2 * y + 1);
+                const QRgb d = child.pixel(2 * x + 1, 2 * y + 1);
+                const QRgb expected = qRgb((qRed(a) + qRed(b) + qRed(c) + qRed(d) + 2) / 4,
+                                           (qGreen(a) + qGreen(b) + qGreen(c) + qGreen(d) + 2) / 4,
+                                           (qBlue(a) + qBlue(b) + qBlue(c) + qBlue(d) + 2) / 4);
+                QCOMPARE(tile.pixel(x, y), expected);
+            }
+        }
+    }
+}
+
+void TileCreatorTest::clippedSource()
+{
+    // JPEG sources are read in bands of rows instead of being decoded completely
+    const QString sourceName = QStringLiteral("source.jpg");
+    QVERIFY(m_source.save(m_directory.filePath(sourceName), "jpg", 95));
+    const QImage source(m_directory.filePath(sourceName));
+    QVERIFY(!source.isNull());
+
+    TileCreator creator(m_directory.path(), sourceName, QStringLiteral("false"), m_directory.filePath(QStringLiteral("clippedtiles")));
+    creator.setTileFormat(QStringLiteral("png"));
+    creator.start();
+    QVERIFY(creator.wait(60000));
+
+    for (int n = 0; n < Rows; ++n) {
+        for (int m = 0; m < Columns; ++m) {
+            const QImage tile = QImage(tileFileName(1, n, m, QStringLiteral("clippedtiles"))).convertToFormat(QImage::Format_RGB32);
+            QCOMPARE(tile, referenceTile(source, n, m));
+        }
+    }
+}
+
+}
+
+QTEST_MAIN(Marble::TileCreatorTest)
+
+#include "TileCreatorTest.moc"
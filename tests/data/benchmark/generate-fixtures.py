@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# Writes the fixtures used by RenderBenchmark: benchmark.kml with placemarks
+# clustered around a few cities plus long line strings, some of which cross
+# the date line, and benchmark.o5m with the streets, buildings and points of
+# interest of a small made up town.
+#
+# The data is random, but seeded, so running the script again produces the
+# very same files. Changing the fixtures invalidates earlier benchmark
+# results, so only do that together with a note in the release notes.
+#
+# SPDX-FileCopyrightText: 2026 Marble Authors
+#
+
+import math
+import os
+import random
+
+SEED = 1492
+
+CITIES = [
+    ("Berlin", 13.40, 52.52), ("Lisbon", -9.14, 38.72), ("Cairo", 31.24, 30.04),
+    ("Lagos", 3.38, 6.52), ("Mumbai", 72.88, 19.08), ("Beijing", 116.40, 39.90),
+    ("Tokyo", 139.69, 35.69), ("Sydney", 151.21, -33.87), ("Auckland", 174.76, -36.85),
+    ("Honolulu", -157.86, 21.31), ("Lima", -77.04, -12.05), ("Chicago", -87.63, 41.88),
+]
+
+
+def writeKml(rnd, fileName):
+    lines = ['<?xml version="1.0" encoding="UTF-8"?>',
+             '<kml xmlns="http://www.opengis.net/kml/2.2">',
+             '<Document>',
+             '<name>RenderBenchmark</name>']
+
+    for i in range(1500):
+        city, lon, lat = CITIES[i % len(CITIES)]
+        lon += rnd.gauss(0.0, 3.0)
+        lat = max(-85.0, min(85.0, lat + rnd.gauss(0.0, 2.0)))
+        lines.append('<Placemark><name>%s %d</name><Point><coordinates>%.4f,%.4f</coordinates></Point></Placemark>'
+                     % (city, i, lon, lat))
+
+    for i in range(150):
+        city, lon, lat = CITIES[i % len(CITIES)]
+        heading = rnd.uniform(0.0, 360.0)
+        coordinates = []
+        for j in range(rnd.randint(40, 120)):
+            heading += rnd.gauss(0.0, 15.0)
+            lon += 0.6 * math.cos(math.radians(heading))
+            lat = max(-80.0, min(80.0, lat + 0.4 * math.sin(math.radians(heading))))
+            if lon > 180.0:
+                lon -= 360.0
+            elif lon < -180.0:
+                lon += 360.0
+            coordinates.append('%.4f,%.4f' % (lon, lat))
+        lines.append('<Placemark><name>Track %d</name><LineString><coordinates>%s</coordinates></LineString></Placemark>'
+                     % (i, ' '.join(coordinates)))
+
+    lines += ['</Document>', '</kml>', '']
+    with open(fileName, 'w') as kml:
+        kml.write('\n'.join(lines))
+
+
+def unsignedNumber(value):
+    result = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            result.append(byte | 0x80)
+        else:
+            result.append(byte)
+            return bytes(result)
+
+
+def signedNumber(value):
+    return unsignedNumber(value << 1 if value >= 0 else ((-value - 1) << 1) | 1)
+
+
+def stringPair(key, value):
+    return b'\x00' + key.encode('utf-8') + b'\x00' + value.encode('utf-8') + b'\x00'
+
+
+class O5mWriter:
+    def __init__(self):
+        self.data = bytearray(b'\xff')
+        self.dataset(0xe0, b'o5m2')
+        self.nodeId = 0
+        self.lon = 0
+        self.lat = 0
+        self.wayId = 0
+        self.wayNodeId = 0
+
+    def dataset(self, type, payload):
+        self.data.append(type)
+        self.data += unsignedNumber(len(payload))
+        self.data += payload
+
+    def node(self, id, lon, lat, tags=()):
+        lon = int(round(lon * 1e7))
+        lat = int(round(lat * 1e7))
+        payload = signedNumber(id - self.nodeId) + b'\x00' + signedNumber(lon - self.lon) + signedNumber(lat - self.lat)
+        for key, value in tags:
+            payload += stringPair(key, value)
+        self.nodeId, self.lon, self.lat = id, lon, lat
+        self.dataset(0x10, payload)
+
+    def way(self, id, nodes, tags):
+        references = b''
+        for node in nodes:
+            references += signedNumber(node - self.wayNodeId)
+            self.wayNodeId = node
+        payload = signedNumber(id - self.wayId) + b'\x00' + unsignedNumber(len(references)) + references
+        for key, value in tags:
+            payload += stringPair(key, value)
+        self.wayId = id
+        self.dataset(0x11, payload)
+
+    def finish(self):
+        self.data.append(0xfe)
+        return bytes(self.data)
+
+
+def writeO5m(rnd, fileName):
+    writer = O5mWriter()
+    west, south, size = 8.38, 48.99, 0.04
+    ways = []
+    nodeId = 0
+
+    def addNode(lon, lat, tags=()):
+        nonlocal nodeId
+        nodeId += 1
+        writer.node(nodeId, lon, lat, tags)
+        return nodeId
+
+    # A grid of streets
+    highways = ["residential", "residential", "tertiary", "secondary", "primary"]
+    for i in range(24):
+        horizontal = i % 2 == 0
+        offset = (i // 2 + 0.5) / 12 * size
+        nodes = []
+        for j in range(30):
+            along = j / 29 * size
+            lon = west + (along if horizontal else offset) + rnd.gauss(0.0, 0.0001)
+            lat = south + (offset if horizontal else along) + rnd.gauss(0.0, 0.0001)
+            nodes.append(addNode(lon, lat))
+        ways.append((nodes, [("highway", rnd.choice(highways)), ("name", "Street %d" % i)]))
+
+    # Buildings between the streets
+    for i in range(1200):
+        lon = west + rnd.uniform(0.0, size)
+        lat = south + rnd.uniform(0.0, size)
+        width = rnd.uniform(0.00005, 0.0002)
+        height = rnd.uniform(0.00005, 0.0002)
+        corners = [addNode(lon, lat), addNode(lon + width, lat),
+                   addNode(lon + width, lat + height), addNode(lon, lat + height)]
+        tags = [("building", "yes")]
+        if i % 5 == 0:
+            tags.append(("addr:housenumber", str(i % 120 + 1)))
+        ways.append((corners + corners[:1], tags))
+
+    # Parks and water
+    for i in range(20):
+        lon = west + rnd.uniform(0.0, size)
+        lat = south + rnd.uniform(0.0, size)
+        ring = []
+        for j in range(24):
+            angle = j / 24 * 2 * math.pi
+            radius = rnd.uniform(0.001, 0.002)
+            ring.append(addNode(lon + radius * math.cos(angle), lat + radius * math.sin(angle)))
+        tags = [("leisure", "park")] if i % 2 else [("natural", "water")]
+        ways.append((ring + ring[:1], tags + [("name", "Area %d" % i)]))
+
+    # Points of interest
+    amenities = ["restaurant", "cafe", "pharmacy", "school", "post_office", "fuel", "bank"]
+    for i in range(800):
+        addNode(west + rnd.uniform(0.0, size), south + rnd.uniform(0.0, size),
+                [("amenity", rnd.choice(amenities)), ("name", "Place %d" % i)])
+
+    for wayId, (nodes, tags) in enumerate(ways, 1):
+        writer.way(wayId, nodes, tags)
+
+    with open(fileName, 'wb') as o5m:
+        o5m.write(writer.finish())
+
+
+if __name__ == '__main__':
+    directory = os.path.dirname(os.path.abspath(__file__))
+    writeKml(random.Random(SEED), os.path.join(directory, 'benchmark.kml'))
+    writeO5m(random.Random(SEED), os.path.join(directory, 'benchmark.o5m'))